@@ -0,0 +1,23 @@
+// name: array_fir.ck
+// desc: indexed float[] access: a 64-tap direct-form FIR over 4096
+//       samples, 60 passes, all in the first sample of the run
+//
+// run: ./ckbench array_fir.ck 1
+
+float x[4096];
+float h[64];
+float y[4096];
+
+for( 0 => int i; i < 4096; i++ ) Math.random2f( -1, 1 ) => x[i];
+for( 0 => int k; k < 64; k++ ) Math.sin( pi * ( k + 1 ) / 65 ) / 32 => h[k];
+
+for( 0 => int pass; pass < 60; pass++ )
+{
+    for( 64 => int n; n < 4096; n++ )
+    {
+        0 => float acc;
+        for( 0 => int k; k < 64; k++ )
+            x[n-k] * h[k] +=> acc;
+        acc => y[n];
+    }
+}
@@ -0,0 +1,16 @@
+// name: array_reads.ck
+// desc: indexed float[] access: sixteen reads and one write per
+//       iteration, 200000 iterations, all in the first sample of the run
+//
+// run: ./ckbench array_reads.ck 1
+
+float a[1024];
+for( 0 => int i; i < 1024; i++ ) i * .001 => a[i];
+
+for( 0 => int it; it < 200000; it++ )
+{
+    it & 1007 => int j;
+    a[j] + a[j+1] + a[j+2] + a[j+3] + a[j+4] + a[j+5] + a[j+6] + a[j+7]
+    + a[j+8] + a[j+9] + a[j+10] + a[j+11] + a[j+12] + a[j+13] + a[j+14]
+    + a[j+15] => a[j];
+}
@@ -0,0 +1,27 @@
+// name: chugen_tick.ck
+// desc: eight one-pole Chugens on noise, computed one sample per call
+//       with tick(float); compare with chugen_tickblock.ck
+//
+// run: ./ckbench -a 256 chugen_tick.ck 10
+
+class OnePole extends Chugen
+{
+    0.99 => float a;
+    0.0 => float y;
+
+    fun float tick( float x )
+    {
+        (1-a)*x + a*y => y;
+        return y;
+    }
+}
+
+Noise n;
+OnePole f[8];
+for( 0 => int i; i < f.size(); i++ )
+{
+    n => f[i] => dac;
+    0.1 => f[i].gain;
+}
+
+1::week => now;
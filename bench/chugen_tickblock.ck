@@ -0,0 +1,35 @@
+// name: chugen_tickblock.ck
+// desc: eight one-pole Chugens on noise, computed a block per call with
+//       tickBlock(float[], float[]); compare with chugen_tick.ck.  needs
+//       an adaptive block size (-a) to see blocks longer than one sample
+//
+// run: ./ckbench -a 256 chugen_tickblock.ck 10
+
+class OnePole extends Chugen
+{
+    0.99 => float a;
+    0.0 => float y;
+
+    fun void tickBlock( float in[], float out[] )
+    {
+        y => float s;
+        1 - a => float b;
+        in.size() => int n;
+        for( 0 => int i; i < n; i++ )
+        {
+            b*in[i] + a*s => s;
+            s => out[i];
+        }
+        s => y;
+    }
+}
+
+Noise n;
+OnePole f[8];
+for( 0 => int i; i < f.size(); i++ )
+{
+    n => f[i] => dac;
+    0.1 => f[i].gain;
+}
+
+1::week => now;
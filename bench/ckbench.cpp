@@ -0,0 +1,106 @@
+//-----------------------------------------------------------------------------
+// file: ckbench.cpp
+// desc: benchmark driver: runs ChucK programs faster than real time (no
+//       audio device) and reports the wall-clock time they took
+//
+// usage: ckbench [options] file.ck [file.ck ...] seconds
+//   -a N   adaptive block size N (default: per-sample)
+//   -w S   run S seconds of audio before starting the clock (setup)
+//   -c     time compiling the files only; nothing is run
+//
+// build: make linux-alsa (in this directory; builds ../core first)
+//-----------------------------------------------------------------------------
+#include "chuck.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <sys/resource.h>
+
+#define BENCH_FRAMES 512
+
+
+// wall-clock milliseconds
+static double now_ms()
+{
+    struct timeval t;
+    gettimeofday( &t, NULL );
+    return t.tv_sec * 1e3 + t.tv_usec / 1e3;
+}
+
+// peak resident set, in kB
+static long peak_kb()
+{
+    struct rusage ru;
+    getrusage( RUSAGE_SELF, &ru );
+    return ru.ru_maxrss;
+}
+
+// run this many seconds of audio
+static void run( ChucK * ck, double secs )
+{
+    SAMPLE in[BENCH_FRAMES*2];
+    SAMPLE out[BENCH_FRAMES*2];
+    memset( in, 0, sizeof(in) );
+    long blocks = (long)(secs * 44100 / BENCH_FRAMES + .5);
+    for( long i = 0; i < blocks; i++ )
+        ck->run( in, out, BENCH_FRAMES );
+}
+
+int main( int argc, char ** argv )
+{
+    int adaptive = 0;
+    double warmup = 0;
+    bool compile_only = false;
+    int i = 1;
+
+    // options
+    for( ; i < argc && argv[i][0] == '-'; i++ )
+    {
+        if( !strcmp( argv[i], "-a" ) && i+1 < argc ) adaptive = atoi( argv[++i] );
+        else if( !strcmp( argv[i], "-w" ) && i+1 < argc ) warmup = atof( argv[++i] );
+        else if( !strcmp( argv[i], "-c" ) ) compile_only = true;
+        else break;
+    }
+    if( argc - i < 2 )
+    {
+        fprintf( stderr, "usage: ckbench [-a N] [-w S] [-c] file.ck [file.ck ...] seconds\n" );
+        return 1;
+    }
+
+    ChucK * ck = new ChucK;
+    ck->setParam( CHUCK_PARAM_SAMPLE_RATE, (t_CKINT)44100 );
+    ck->setParam( CHUCK_PARAM_INPUT_CHANNELS, (t_CKINT)2 );
+    ck->setParam( CHUCK_PARAM_OUTPUT_CHANNELS, (t_CKINT)2 );
+    ck->setParam( CHUCK_PARAM_VM_ADAPTIVE, (t_CKINT)adaptive );
+    ck->init();
+
+    // compile
+    double t0 = now_ms();
+    for( ; i < argc - 1; i++ )
+        if( !ck->compileFile( argv[i], "" ) )
+            fprintf( stderr, "[ckbench] could not compile '%s'\n", argv[i] );
+    double compile = now_ms() - t0;
+
+    if( compile_only )
+    {
+        fprintf( stderr, "[ckbench] compiled in %.3f ms; peak rss %ld kB\n",
+                 compile, peak_kb() );
+        delete ck;
+        return 0;
+    }
+
+    // run
+    double secs = atof( argv[argc-1] );
+    ck->start();
+    if( warmup > 0 ) run( ck, warmup );
+    t0 = now_ms();
+    run( ck, secs );
+    double elapsed = now_ms() - t0;
+
+    fprintf( stderr, "[ckbench] %.3f s of audio in %.3f ms (%.1fx real time); peak rss %ld kB\n",
+             secs, elapsed, secs * 1e3 / elapsed, peak_kb() );
+
+    delete ck;
+    return 0;
+}
@@ -0,0 +1,16 @@
+#!/bin/sh
+# name: compile.sh
+# desc: compile time of a large program: generates compile_big.ck with
+#       compile_gen.ck, then times compiling it (parse, type check, emit;
+#       nothing is run) several times
+#
+# usage: ./compile.sh [runs]   (default 5)
+
+RUNS=${1:-5}
+
+./ckbench compile_gen.ck 0.01 || exit 1
+i=0
+while [ $i -lt $RUNS ]; do
+    ./ckbench -c compile_big.ck 1
+    i=$(( i + 1 ))
+done
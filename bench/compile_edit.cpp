@@ -0,0 +1,90 @@
+//-----------------------------------------------------------------------------
+// file: compile_edit.cpp
+// desc: recompiling an edited file: generates compile_edit_*.ck, 2000
+//       functions (14000 lines) in call chains of 20, then times compiling
+//       it from scratch, again after changing a constant in one function
+//       (every function is type checked, but only it and the 9 functions
+//       calling it are emitted again), and again after adding a line to it
+//       (every function below it has moved, so those are emitted again
+//       too). nothing is run
+//
+// usage: compile_edit [reps]   (default 5)
+//
+// build: make linux-alsa (in this directory; builds ../core first)
+//-----------------------------------------------------------------------------
+#include "chuck.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <string>
+using namespace std;
+
+#define NUM_FUNCS 2000
+#define CHAIN 20
+#define EDITED 1010
+
+
+static double now_ms()
+{
+    struct timeval t;
+    gettimeofday( &t, NULL );
+    return t.tv_sec * 1e3 + t.tv_usec / 1e3;
+}
+
+// write the file; 'value' goes into the edited function, and 'extra' adds
+// a line to it
+static void write_file( const char * name, int value, bool extra )
+{
+    FILE * f = fopen( name, "w" );
+    for( int k = 0; k < NUM_FUNCS; k++ )
+    {
+        fprintf( f, "fun int f%d( int a, float b ) {\n", k );
+        fprintf( f, "    int t; %d => t;\n", k == EDITED ? value : k );
+        if( k == EDITED && extra ) fprintf( f, "    t++;\n" );
+        fprintf( f, "    for( 0 => int i; i < a; i++ ) { i + t => t; b * 2 => b; }\n" );
+        fprintf( f, "    if( t > 100 ) { t / 2 => t; }\n" );
+        if( k % CHAIN ) fprintf( f, "    return t + f%d( a, b );\n", k - 1 );
+        else fprintf( f, "    return t;\n" );
+        fprintf( f, "}\n\n" );
+    }
+    fprintf( f, "<<< f%d( 3, 1.0 ) >>>;\n", NUM_FUNCS - 1 );
+    fclose( f );
+}
+
+// compile it, in ms
+static double compile( ChucK * ck, const char * name )
+{
+    double t0 = now_ms();
+    if( !ck->compileFile( name, "" ) )
+        fprintf( stderr, "[compile_edit] could not compile '%s'\n", name );
+    return now_ms() - t0;
+}
+
+int main( int argc, char ** argv )
+{
+    int reps = argc > 1 ? atoi( argv[1] ) : 5;
+
+    ChucK * ck = new ChucK;
+    ck->setParam( CHUCK_PARAM_SAMPLE_RATE, (t_CKINT)44100 );
+    ck->init();
+
+    for( int r = 0; r < reps; r++ )
+    {
+        // each rep starts from a file the compiler hasn't seen
+        char name[64];
+        sprintf( name, "compile_edit_%d.ck", r );
+        write_file( name, -1, false );
+        double full = compile( ck, name );
+        write_file( name, -2 - r, false );
+        double edit = compile( ck, name );
+        write_file( name, -2 - r, true );
+        double moved = compile( ck, name );
+        remove( name );
+
+        printf( "[compile_edit] %d functions: from scratch %.1f ms, one edited %.1f ms, "
+                "one edited + 1 line %.1f ms\n", NUM_FUNCS, full, edit, moved );
+    }
+
+    delete ck;
+    return 0;
+}
@@ -0,0 +1,30 @@
+// name: compile_gen.ck
+// desc: writes compile_big.ck for compile.sh: 2000 classes (54000 lines),
+//       each with twelve members, a member of the previous class, and
+//       three methods with nested scopes
+//
+// run: ./ckbench compile_gen.ck 0.01   (compile.sh does this)
+
+2000 => int N;
+FileIO f;
+f.open( "compile_big.ck", FileIO.WRITE );
+
+for( 0 => int c; c < N; c++ )
+{
+    f <= "class C" <= c <= " {" <= IO.newline();
+    for( 0 => int m; m < 6; m++ )
+        f <= "    int m" <= c <= "_" <= m <= "; float f" <= c <= "_" <= m <= ";" <= IO.newline();
+    if( c > 0 ) f <= "    C" <= c-1 <= " prev;" <= IO.newline();
+    for( 0 => int g; g < 3; g++ )
+    {
+        f <= "    fun int g" <= g <= "(int a, float b) {" <= IO.newline();
+        f <= "        int t; 0 => t;" <= IO.newline();
+        f <= "        for (0 => int i; i < a; i++) { i + t => t; b * 2 => b; }" <= IO.newline();
+        f <= "        if (t > m" <= c <= "_" <= g <= ") { t => m" <= c <= "_" <= g <= "; }" <= IO.newline();
+        f <= "        return t + m" <= c <= "_" <= g+1 <= ";" <= IO.newline();
+        f <= "    }" <= IO.newline();
+    }
+    f <= "}" <= IO.newline();
+}
+f <= "C" <= N-1 <= " x; <<< x.g0(3, 1.0) >>>;" <= IO.newline();
+f.close();
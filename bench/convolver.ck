@@ -0,0 +1,31 @@
+// name: convolver.ck
+// desc: partitioned convolution with a 3 second stereo impulse response
+//       (44.1k): one Convolver per channel of the file
+//
+// run: ./ckbench -w 3.5 convolver.ck 10
+//      (the first 3 seconds write the impulse response; -w keeps that
+//       out of the timing)
+
+// write a 3 second stereo impulse response: decaying noise
+Noise nl => Envelope el => WvOut2 w;
+Noise nr => Envelope er => w;
+el => dac.left; er => dac.right; // keep both pulled
+w => blackhole;
+"ir3s.wav" => w.wavFilename;
+1 => el.value => er.value;
+0 => el.target => er.target;
+3::second => el.duration => er.duration;
+3::second => now;
+w.closeFile();
+nl =< el; nr =< er;
+
+// convolve noise with it: left and right channels of the file
+Noise n => Convolver l => dac.left;
+n => Convolver r => dac.right;
+1 => r.channel;
+"ir3s.wav" => l.read;
+"ir3s.wav" => r.read;
+<<< "samples:", l.samples(), "partitions:", l.partitions(), r.partitions() >>>;
+
+// run until the driver stops
+while( true ) 1::second => now;
@@ -0,0 +1,20 @@
+// name: gc_churn.ck
+// desc: acyclic churn through traced objects, 200 per ms: the cost of
+//       buffering cycle candidates when there are no cycles to find
+//
+// run: ./ckbench -a 256 gc_churn.ck 10
+
+class Node { Node @ next; int v; }
+Node list[64];
+for( 0 => int i; i < 64; i++ ) new Node @=> list[i];
+
+while( true )
+{
+    for( 0 => int i; i < 200; i++ )
+    {
+        list[i%64] @=> Node @ x;
+        Node y; x @=> y.next;
+        y.next @=> list[(i+1)%64].next;
+    }
+    1::ms => now;
+}
@@ -0,0 +1,19 @@
+// name: gc_soak.ck
+// desc: cyclic garbage, every 10 ms: a three-node ring, a node whose
+//       member array points back at it, and an owner holding itself;
+//       with the cycle collector, memory stays flat however long it runs
+//
+// run: ./gc_soak.sh   (or ./ckbench -a 512 gc_soak.ck 3600)
+
+class Node { Node @ next; Node @ kids[]; float buf[256]; }
+class Owner { Node @ root; Owner @ self; }
+
+while( true )
+{
+    Node a; Node b; Node c;
+    b @=> a.next; c @=> b.next; a @=> c.next;
+    new Node[4] @=> a.kids;
+    for( 0 => int i; i < 4; i++ ) a @=> a.kids[i].next;
+    Owner o; a @=> o.root; o @=> o.self;
+    10::ms => now;
+}
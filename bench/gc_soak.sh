@@ -0,0 +1,31 @@
+#!/bin/sh
+# name: gc_soak.sh
+# desc: memory-growth soak: runs gc_soak.ck for a short and a long stretch
+#       of audio time and compares peak RSS; fails if the long run peaked
+#       more than 4 MB above the short one. (uncollected, the cycles would
+#       hold over 1 MB per second of audio; collected, the peak wanders by
+#       a MB or so)
+#
+# usage: ./gc_soak.sh [short long]   (seconds of audio; default 300 3600)
+
+SHORT=${1:-300}
+LONG=${2:-3600}
+
+rss()
+{
+    ./ckbench -a 512 gc_soak.ck $1 2>&1 | sed -n 's/.*peak rss \([0-9]*\) kB.*/\1/p'
+}
+
+A=`rss $SHORT`
+B=`rss $LONG`
+if [ -z "$A" ] || [ -z "$B" ]; then
+    echo "gc_soak: ckbench failed"
+    exit 1
+fi
+
+echo "gc_soak: peak rss ${A} kB after ${SHORT} s, ${B} kB after ${LONG} s"
+if [ $B -gt $(( A + 4096 )) ]; then
+    echo "gc_soak: FAILED, memory grew"
+    exit 1
+fi
+echo "gc_soak: ok"
@@ -0,0 +1,21 @@
+// name: midi_jitter.ck
+// desc: run by midi_jitter; logs the sample each MIDI message is
+//       received at, as "<id> <sample>" lines in midi_jitter.txt
+
+MidiIn min;
+MidiMsg msg;
+FileIO fout;
+
+// the driver's virtual output port
+if( !min.open( "RtMidi Output" ) ) me.exit();
+fout.open( "midi_jitter.txt", FileIO.WRITE );
+
+while( true )
+{
+    min => now;
+    while( min.recv( msg ) )
+    {
+        fout <= msg.data2 + 128 * msg.data3 <= " " <= now / samp <= IO.newline();
+    }
+    fout.flush();
+}
@@ -0,0 +1,124 @@
+//-----------------------------------------------------------------------------
+// file: midi_jitter.cpp
+// desc: MIDI input timing through a real loopback: sends note-ons at random
+//       3-20 ms intervals out of an RtMidi virtual port, which midi_jitter.ck
+//       receives with MidiIn and logs the sample it wakes at; the VM is run
+//       in blocks paced to the wall clock, as an audio callback would be.
+//       reports the spread of (wake sample - send time * srate), i.e. the
+//       jitter once the constant latency is taken out
+//
+// usage: midi_jitter [messages] [block]   (defaults: 300 512)
+//   needs the ALSA sequencer (or CoreMIDI); run from this directory
+//
+// build: make linux-alsa (in this directory; builds ../core first)
+//-----------------------------------------------------------------------------
+#include "chuck.h"
+#include "chuck_vm.h"
+#include "rtmidi.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <vector>
+
+#define SRATE 44100
+
+static RtMidiOut * g_out = NULL;
+static int g_count = 300;
+static std::vector<double> g_sent;
+static volatile bool g_done = false;
+
+
+// send the notes, recording when each went out
+static void * send( void * )
+{
+    // let the script open its port first
+    usleep( 500000 );
+    srand( 7 );
+    for( int i = 0; i < g_count; i++ )
+    {
+        usleep( 3000 + rand() % 17000 );
+        std::vector<unsigned char> m;
+        m.push_back( 0x90 );
+        m.push_back( i % 128 );
+        m.push_back( i / 128 );
+        g_sent.push_back( Chuck_VM::host_time() );
+        g_out->sendMessage( &m );
+    }
+    // a little while for the last ones to come in
+    usleep( 200000 );
+    g_done = true;
+    return NULL;
+}
+
+int main( int argc, char ** argv )
+{
+    if( argc > 1 ) g_count = atoi( argv[1] );
+    int block = argc > 2 ? atoi( argv[2] ) : 512;
+
+    try
+    {
+        g_out = new RtMidiOut;
+        g_out->openVirtualPort();
+    }
+    catch( RtMidiError & err )
+    {
+        fprintf( stderr, "midi_jitter: no virtual MIDI port: %s\n",
+                 err.getMessage().c_str() );
+        return 1;
+    }
+
+    ChucK * ck = new ChucK;
+    ck->setParam( CHUCK_PARAM_SAMPLE_RATE, (t_CKINT)SRATE );
+    ck->setParam( CHUCK_PARAM_INPUT_CHANNELS, (t_CKINT)2 );
+    ck->setParam( CHUCK_PARAM_OUTPUT_CHANNELS, (t_CKINT)2 );
+    ck->init();
+    if( !ck->compileFile( "midi_jitter.ck", "" ) ) return 1;
+    ck->start();
+
+    pthread_t t;
+    pthread_create( &t, NULL, send, NULL );
+
+    // run a block at a time, each when its audio would be due
+    std::vector<SAMPLE> in( block * 2 ), out( block * 2 );
+    double start = Chuck_VM::host_time();
+    for( long i = 0; !g_done; i++ )
+    {
+        ck->run( &in[0], &out[0], block );
+        double due = start + ( i + 1 ) * block / (double)SRATE;
+        double now;
+        while( ( now = Chuck_VM::host_time() ) < due )
+            if( due - now > .0005 ) usleep( (useconds_t)( ( due - now - .0003 ) * 1e6 ) );
+    }
+    pthread_join( t, NULL );
+
+    // match each logged wake with its send
+    FILE * f = fopen( "midi_jitter.txt", "r" );
+    if( !f ) { fprintf( stderr, "midi_jitter: nothing received\n" ); return 1; }
+    std::vector<double> offset;
+    int id;
+    double wake;
+    while( fscanf( f, "%d %lf", &id, &wake ) == 2 )
+        if( id >= 0 && id < (int)g_sent.size() )
+            offset.push_back( wake - ( g_sent[id] - start ) * SRATE );
+    fclose( f );
+    if( offset.empty() ) { fprintf( stderr, "midi_jitter: nothing received\n" ); return 1; }
+
+    double mean = 0, var = 0, lo = 1e30, hi = -1e30;
+    for( size_t i = 0; i < offset.size(); i++ ) mean += offset[i];
+    mean /= offset.size();
+    for( size_t i = 0; i < offset.size(); i++ )
+    {
+        double d = offset[i] - mean;
+        var += d * d;
+        if( d < lo ) lo = d;
+        if( d > hi ) hi = d;
+    }
+
+    printf( "[midi_jitter] %d/%d received, latency %.2f ms, jitter sd %.1f samples, p2p %.1f samples\n",
+            (int)offset.size(), g_count, mean * 1000 / SRATE,
+            sqrt( var / offset.size() ), hi - lo );
+    fflush( stdout );
+    _exit( 0 );
+}
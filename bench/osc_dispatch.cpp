@@ -0,0 +1,121 @@
+//-----------------------------------------------------------------------------
+// file: osc_dispatch.cpp
+// desc: OSC receive throughput: feeds prebuilt "/sensor/<k> ,f" messages to
+//       an OSC_Receiver (as its network thread would) while a second thread
+//       drains every listener, and reports messages per second
+//
+// usage: osc_dispatch listeners messages [wildcard]
+//   wildcard: send "/sensor/<k>*" instead, which takes the pattern path
+//
+// build: make linux-alsa (in this directory; builds ../core first)
+//-----------------------------------------------------------------------------
+#include "chuck.h"
+#include "util_opsc.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+
+static int g_num = 0;
+static OSC_Address_Space ** g_listeners = NULL;
+static volatile bool g_done = false;
+static long g_consumed = 0;
+
+
+// drain every listener until told to stop (stands in for the VM)
+static void * consume( void * )
+{
+    while( !g_done )
+    {
+        for( int i = 0; i < g_num; i++ )
+            while( g_listeners[i]->next_mesg() )
+            {
+                g_listeners[i]->next_float();
+                g_consumed++;
+            }
+    }
+    return NULL;
+}
+
+// copy an OSC string, padded to 4 bytes; returns the padded length
+static int pad( char * p, const char * s )
+{
+    int n = strlen( s ) + 1;
+    memcpy( p, s, n );
+    while( n % 4 ) p[n++] = 0;
+    return n;
+}
+
+int main( int argc, char ** argv )
+{
+    if( argc < 3 )
+    {
+        fprintf( stderr, "usage: osc_dispatch listeners messages [wildcard]\n" );
+        return 1;
+    }
+    g_num = atoi( argv[1] );
+    long count = atol( argv[2] );
+    bool wild = argc > 3;
+
+    ChucK * ck = new ChucK;
+    ck->init();
+    OSC_Receiver * recv = new OSC_Receiver( ck->vm() );
+
+    // one listener per address
+    g_listeners = new OSC_Address_Space *[g_num];
+    for( int i = 0; i < g_num; i++ )
+    {
+        char spec[64];
+        sprintf( spec, "/sensor/%d,f", i );
+        g_listeners[i] = new OSC_Address_Space( spec );
+        g_listeners[i]->SELF = g_listeners[i];
+        recv->add_address( g_listeners[i] );
+    }
+
+    // one message per listener, built up front
+    char (*msgs)[64] = new char[g_num][64];
+    int * lens = new int[g_num];
+    for( int i = 0; i < g_num; i++ )
+    {
+        char addr[32];
+        sprintf( addr, wild ? "/sensor/%d*" : "/sensor/%d", i );
+        int n = pad( msgs[i], addr );
+        n += pad( msgs[i] + n, ",f" );
+        float f = i;
+        unsigned u;
+        memcpy( &u, &f, 4 );
+        u = htonl( u );
+        memcpy( msgs[i] + n, &u, 4 );
+        lens[i] = n + 4;
+    }
+
+    pthread_t t;
+    pthread_create( &t, NULL, consume, NULL );
+
+    // handle_mesg() parses in place, so hand it a copy
+    char buf[64];
+    struct timeval a, b;
+    gettimeofday( &a, NULL );
+    for( long m = 0; m < count; m++ )
+    {
+        int k = m % g_num;
+        memcpy( buf, msgs[k], lens[k] );
+        recv->handle_mesg( buf, lens[k] );
+    }
+    gettimeofday( &b, NULL );
+    double secs = ( b.tv_sec - a.tv_sec ) + ( b.tv_usec - a.tv_usec ) / 1e6;
+
+    // let the consumer catch up
+    usleep( 100000 );
+    g_done = true;
+    pthread_join( t, NULL );
+
+    printf( "[osc_dispatch] %d listeners, %s: %.0f msgs/s (%ld deliveries for %ld sent)\n",
+            g_num, wild ? "wildcard" : "literal", count / secs, g_consumed, count );
+    fflush( stdout );
+    // the listeners are not torn down; skip the rest
+    _exit( 0 );
+}
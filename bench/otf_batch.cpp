@@ -0,0 +1,181 @@
+//-----------------------------------------------------------------------------
+// file: otf_batch.cpp
+// desc: on-the-fly add of 100 files over loopback: the one-file-at-a-time
+//       protocol against one streamed batch, from one client and from four
+//       at once. forks a VM with OTF enabled to send to; the files are
+//       generated (otf_gen_*.ck), 60 functions and a SinOsc each, and
+//       rewritten for every pass so none is a compile cache hit
+//
+// usage: otf_batch [reps]   (default 5)
+//
+// build: make linux-alsa (in this directory; builds ../core first)
+//-----------------------------------------------------------------------------
+#include "chuck.h"
+#include "chuck_otf.h"
+#include "chuck_errmsg.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <sys/time.h>
+#include <string>
+#include <vector>
+using namespace std;
+
+#define NUM_FILES 100
+#define PORT 18888
+
+static char g_names[NUM_FILES][32];
+static string g_bodies[NUM_FILES];
+
+
+static double now_ms()
+{
+    struct timeval t;
+    gettimeofday( &t, NULL );
+    return t.tv_sec * 1e3 + t.tv_usec / 1e3;
+}
+
+// write the files, keeping a copy of each
+static void generate( int pass )
+{
+    for( int i = 0; i < NUM_FILES; i++ )
+    {
+        char line[128];
+        sprintf( g_names[i], "otf_gen_%03d.ck", i );
+        sprintf( line, "// file %d, pass %d\n", i, pass );
+        g_bodies[i] = line;
+        for( int k = 0; k < 60; k++ )
+        {
+            sprintf( line, "fun float f%d( float x ) { return x * %d.0 + Math.sin(x); }\n", k, k );
+            g_bodies[i] += line;
+        }
+        g_bodies[i] += "SinOsc s => blackhole;\nwhile( true ) 1::second => now;\n";
+        FILE * f = fopen( g_names[i], "w" );
+        fputs( g_bodies[i].c_str(), f );
+        fclose( f );
+    }
+}
+
+// the server: run the VM as an audio callback would
+static void serve()
+{
+    ChucK * ck = new ChucK;
+    ck->setParam( CHUCK_PARAM_SAMPLE_RATE, (t_CKINT)44100 );
+    ck->setParam( CHUCK_PARAM_OTF_ENABLE, (t_CKINT)1 );
+    ck->setParam( CHUCK_PARAM_OTF_PORT, (t_CKINT)PORT );
+    ck->init();
+    ck->start();
+    SAMPLE in[64] = { 0 }, out[128];
+    while( true )
+    {
+        ck->run( in, out, 32 );
+        usleep( 200 );
+    }
+}
+
+// send a batch on its own connection
+static t_CKBOOL batch( const vector<Net_Op> & ops, string * reply = NULL )
+{
+    ck_socket s = otf_stream_connect( "127.0.0.1", PORT );
+    if( !s ) return FALSE;
+    t_CKBOOL ok = otf_send_batch( s, ops, reply );
+    ck_close( s );
+    return ok;
+}
+
+static void remove_all()
+{
+    vector<Net_Op> ops;
+    ops.push_back( Net_Op( MSG_REMOVEALL ) );
+    batch( ops );
+}
+
+// one file per message, as chuck + does
+static double legacy()
+{
+    double start = now_ms();
+    ck_socket s = otf_send_connect( "127.0.0.1", PORT );
+    for( int i = 0; i < NUM_FILES; i++ )
+    {
+        Net_Msg m;
+        m.type = MSG_ADD;
+        m.param = 1;
+        otf_send_file( g_names[i], m, "add", s );
+    }
+    Net_Msg m;
+    m.type = MSG_DONE;
+    otf_hton( &m );
+    ck_send( s, (char *)&m, sizeof(m) );
+    ck_recv_timeout( s, 0, 20000000 );
+    ck_recv( s, (char *)&m, sizeof(m) );
+    ck_close( s );
+    return now_ms() - start;
+}
+
+struct Range { int lo, hi; };
+
+static void * push( void * data )
+{
+    Range * r = (Range *)data;
+    vector<Net_Op> ops;
+    for( int i = r->lo; i < r->hi; i++ )
+    {
+        ops.push_back( Net_Op( MSG_ADD, 1 ) );
+        ops.back().name = g_names[i];
+        ops.back().body = g_bodies[i];
+    }
+    string reply;
+    if( !batch( ops, &reply ) )
+        fprintf( stderr, "otf_batch: batch failed: %s\n", reply.c_str() );
+    return NULL;
+}
+
+// the files split over some clients, each sending one batch
+static double stream( int clients )
+{
+    pthread_t t[16];
+    Range r[16];
+    double start = now_ms();
+    for( int c = 0; c < clients; c++ )
+    {
+        r[c].lo = NUM_FILES * c / clients;
+        r[c].hi = NUM_FILES * ( c + 1 ) / clients;
+        pthread_create( &t[c], NULL, push, &r[c] );
+    }
+    for( int c = 0; c < clients; c++ )
+        pthread_join( t[c], NULL );
+    return now_ms() - start;
+}
+
+int main( int argc, char ** argv )
+{
+    int reps = argc > 1 ? atoi( argv[1] ) : 5;
+
+    EM_setlog( 0 );
+
+    pid_t pid = fork();
+    if( pid == 0 ) serve();
+    // let the server come up
+    usleep( 500000 );
+
+    for( int r = 0; r < reps; r++ )
+    {
+        generate( 3 * r );
+        double l = legacy();
+        remove_all();
+        generate( 3 * r + 1 );
+        double s1 = stream( 1 );
+        remove_all();
+        generate( 3 * r + 2 );
+        double s4 = stream( 4 );
+        remove_all();
+        printf( "[otf_batch] %d files: one by one %.1f ms, batch %.1f ms, 4 batches at once %.1f ms\n",
+                NUM_FILES, l, s1, s4 );
+    }
+
+    fflush( stdout );
+    kill( pid, SIGKILL );
+    return 0;
+}
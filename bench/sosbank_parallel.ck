@@ -0,0 +1,14 @@
+// name: sosbank_parallel.ck
+// desc: one SOSBank of 64 band-pass sections in parallel on noise; the
+//       per-sample cost is the section loop the compiler vectorizes
+//
+// run: ./ckbench -a 256 sosbank_parallel.ck 10
+
+64 => int N;
+Noise n => SOSBank b => dac;
+b.size( N );
+0.05 => b.gain;
+for( 0 => int i; i < N; i++ )
+    b.bpf( i, 100 * Math.pow( 2, i * 7.0 / N ), 20 );
+
+1::week => now;
@@ -0,0 +1,14 @@
+// name: string_build.ck
+// desc: string building with +=>: 20 strings of 10000 appends each, all
+//       in the first sample of the run
+//
+// run: ./ckbench string_build.ck 1
+
+0 => int total;
+for( 0 => int r; r < 20; r++ )
+{
+    "" => string s;
+    for( 0 => int i; i < 10000; i++ )
+        "/k" + i +=> s;
+    s.length() +=> total;
+}
@@ -0,0 +1,12 @@
+// name: string_concat.ck
+// desc: 800000 four-part concatenations into a string variable, all in
+//       the first sample of the run; watch the peak rss as well as time
+//
+// run: ./ckbench string_concat.ck 1
+
+0 => int total;
+for( 0 => int r; r < 800000; r++ )
+{
+    "/synth/voice/" + r + "/freq/" + "and/more/path" => string k;
+    k.length() +=> total;
+}
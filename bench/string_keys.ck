@@ -0,0 +1,15 @@
+// name: string_keys.ck
+// desc: string building for map keys: 20 x 10000 keys made with + and
+//       stored into a float[] map, all in the first sample of the run
+//
+// run: ./ckbench string_keys.ck 1
+
+float m[0];
+for( 0 => int r; r < 20; r++ )
+{
+    for( 0 => int i; i < 10000; i++ )
+    {
+        "/synth/voice/" + i + "/freq" => string k;
+        i => m[k];
+    }
+}
@@ -0,0 +1,33 @@
+// name: vocoder_graph.ck
+// desc: 32-band vocoder built from ordinary ugens, five nodes per band;
+//       compare with vocoder_sosbank.ck
+//
+// run: ./ckbench -a 256 vocoder_graph.ck 10
+
+32 => int N;
+
+// carrier, and a crude modulator
+SawOsc car;
+110 => car.freq;
+SinOsc m1 => Gain mod;
+SinOsc m2 => mod;
+3 => m1.freq;
+440 => m2.freq;
+m1 => m2;
+2 => m2.sync;
+
+// per band: analysis filter, follower, synthesis filter, vca
+BPF ma[N]; FullRect fr[N]; OnePole lp[N]; BPF cb[N]; Gain vca[N];
+for( 0 => int i; i < N; i++ )
+{
+    100 * Math.pow( 2, i * 7.0 / N ) => float f;
+    mod => ma[i] => fr[i] => lp[i] => vca[i];
+    car => cb[i] => vca[i];
+    3 => vca[i].op;
+    0.999 => lp[i].pole;
+    f => ma[i].freq; 20 => ma[i].Q;
+    f => cb[i].freq; 20 => cb[i].Q;
+    vca[i] => dac;
+}
+
+1::week => now;
@@ -0,0 +1,38 @@
+// name: vocoder_sosbank.ck
+// desc: 32-band vocoder from two SOSBanks, with a shred copying the
+//       analysis envelopes to the synthesis mix every 64 samples; compare
+//       with vocoder_graph.ck
+//
+// run: ./ckbench -a 256 vocoder_sosbank.ck 10
+
+32 => int N;
+
+// carrier, and a crude modulator
+SawOsc car;
+110 => car.freq;
+SinOsc m1 => Gain mod;
+SinOsc m2 => mod;
+3 => m1.freq;
+440 => m2.freq;
+m1 => m2;
+2 => m2.sync;
+
+// analysis and synthesis banks
+mod => SOSBank ana => blackhole;
+car => SOSBank syn => dac;
+ana.size( N );
+syn.size( N );
+for( 0 => int i; i < N; i++ )
+{
+    100 * Math.pow( 2, i * 7.0 / N ) => float f;
+    ana.bpf( i, f, 20 );
+    syn.bpf( i, f, 20 );
+}
+ana.follow( 5::ms );
+syn.smooth( 64::samp );
+
+while( true )
+{
+    for( 0 => int i; i < N; i++ ) syn.mix( i, ana.env( i ) );
+    64::samp => now;
+}
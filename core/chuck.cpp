@@ -37,8 +37,11 @@
 #include "chuck.h"
 #include "chuck_errmsg.h"
 #include "chuck_otf.h"
+#include "midiio_rtmidi.h"
+#include "ugen_xxx.h"
 #include "ulib_machine.h"
 #include "util_network.h"
+#include "util_opsc.h"
 #include "util_string.h"
 
 #ifndef __PLATFORM_WIN32__
@@ -567,10 +570,10 @@ bool ChucK::initOTF()
         else
         {
 #if !defined(__PLATFORM_WIN32__) || defined(__WINDOWS_PTHREAD__)
-            pthread_create( &m_carrier->otf_thread, NULL, otf_cb, NULL );
+            pthread_create( &m_carrier->otf_thread, NULL, otf_cb, m_carrier );
 #else
             m_carrier->otf_thread = CreateThread( NULL, 0,
-                                                 (LPTHREAD_START_ROUTINE)otf_cb, NULL, 0, 0 );
+                                                 (LPTHREAD_START_ROUTINE)otf_cb, m_carrier, 0, 0 );
 #endif
         }
     }
@@ -604,6 +607,13 @@ bool ChucK::shutdown()
         }
     }
 
+    // detach MIDI input from the vm
+    if( m_carrier != NULL && m_carrier->vm != NULL )
+        MidiInManager::cleanup_buffer( m_carrier->vm );
+
+    // let queued OSC output go out
+    OSC_Send_Queue::drain( 250 );
+
     // free vm, compiler, friends
     // first, otf
     // REFACTOR-2017 TODO: le_cb?
@@ -633,6 +643,12 @@ bool ChucK::shutdown()
     SAFE_DELETE( m_carrier->vm );
     SAFE_DELETE( m_carrier->compiler );
     m_carrier->env = NULL;
+
+    // SndBufs are gone with the vm; stop streaming
+    sndbuf_streamer_shutdown();
+    // OscSends are gone too; the send queue is shared, so stop it with
+    // the last instance
+    if( o_numVMs <= 1 ) OSC_Send_Queue::shutdown();
     
     // flag
     m_init = FALSE;
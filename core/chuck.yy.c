@@ -710,7 +710,7 @@ c_str strip_lit( c_str str )
 // alloc_str()
 c_str alloc_str( c_str str )
 {
-    c_str s = (c_str)malloc( strlen(str) + 1 );
+    c_str s = (c_str)arena_alloc( strlen(str) + 1 );
     strcpy( s, str );
 
     return s;
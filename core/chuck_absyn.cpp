@@ -35,9 +35,84 @@
 #include "chuck_utils.h"
 
 
+
+
+//-----------------------------------------------------------------------------
+// AST arena: every node (and lexer string) of a parse is carved out of a few
+// large zeroed blocks, which are all freed together when the last holder of
+// the tree lets go
+//-----------------------------------------------------------------------------
+#define ARENA_BLOCK_SIZE 65536
+#define ARENA_ALIGN 8
+
+struct a_Arena_Block_ { struct a_Arena_Block_ * next; int size; int used; };
+struct a_Arena_ { struct a_Arena_Block_ * blocks; int refs; };
+
+#define ARENA_HEADER ((sizeof(struct a_Arena_Block_) + ARENA_ALIGN-1) & ~(ARENA_ALIGN-1))
+
+// arena new nodes come from (NULL: the heap)
+static a_Arena g_arena = NULL;
+
+a_Arena new_arena( )
+{
+    a_Arena a = (a_Arena)checked_malloc( sizeof( struct a_Arena_ ) );
+    a->refs = 1;
+
+    return a;
+}
+
+void arena_add_ref( a_Arena a )
+{
+    if( a ) a->refs++;
+}
+
+void arena_release( a_Arena a )
+{
+    if( !a || --a->refs > 0 ) return;
+
+    struct a_Arena_Block_ * b = a->blocks, * next;
+    while( b )
+    {
+        next = b->next;
+        free( b );
+        b = next;
+    }
+    free( a );
+}
+
+void use_arena( a_Arena a )
+{
+    g_arena = a;
+}
+
+void * arena_alloc( int size )
+{
+    if( !g_arena ) return checked_malloc( size );
+
+    size = (size + ARENA_ALIGN-1) & ~(ARENA_ALIGN-1);
+    struct a_Arena_Block_ * b = g_arena->blocks;
+    if( !b || b->used + size > b->size )
+    {
+        // oversized requests get a block to themselves, behind the current one
+        int bytes = size > ARENA_BLOCK_SIZE/4 ? size : ARENA_BLOCK_SIZE;
+        struct a_Arena_Block_ * nb = (struct a_Arena_Block_ *)checked_malloc( ARENA_HEADER + bytes );
+        nb->size = bytes;
+        if( b && bytes == size ) { nb->next = b->next; b->next = nb; }
+        else { nb->next = b; g_arena->blocks = nb; }
+        b = nb;
+    }
+
+    // blocks come zeroed from checked_malloc and are never reused
+    void * p = (char *)b + ARENA_HEADER + b->used;
+    b->used += size;
+
+    return p;
+}
+
+
 a_Program new_program( a_Section section, int pos )
 {
-    a_Program a = (a_Program)checked_malloc( sizeof( struct a_Program_ ) );
+    a_Program a = (a_Program)arena_alloc( sizeof( struct a_Program_ ) );
     a->section = section;
     a->linepos = pos;
 
@@ -55,7 +130,7 @@ a_Program prepend_program( a_Section section, a_Program program, int pos )
 
 a_Section new_section_stmt( a_Stmt_List list, int pos )
 {
-    a_Section a = (a_Section)checked_malloc( sizeof( struct a_Section_ ) );
+    a_Section a = (a_Section)arena_alloc( sizeof( struct a_Section_ ) );
     a->s_type = ae_section_stmt;
     a->stmt_list = list;
     a->linepos = pos;
@@ -65,7 +140,7 @@ a_Section new_section_stmt( a_Stmt_List list, int pos )
 
 a_Section new_section_func_def( a_Func_Def func_def, int pos )
 {
-    a_Section a = (a_Section)checked_malloc( sizeof( struct a_Section_) );
+    a_Section a = (a_Section)arena_alloc( sizeof( struct a_Section_) );
     a->s_type = ae_section_func;
     a->func_def = func_def;
     a->linepos = pos;
@@ -75,7 +150,7 @@ a_Section new_section_func_def( a_Func_Def func_def, int pos )
 
 a_Section new_section_class_def( a_Class_Def class_def, int pos )
 {
-    a_Section a = (a_Section)checked_malloc( sizeof( struct a_Section_) );
+    a_Section a = (a_Section)arena_alloc( sizeof( struct a_Section_) );
     a->s_type = ae_section_class;
     a->class_def = class_def;
     a->linepos = pos;
@@ -85,7 +160,7 @@ a_Section new_section_class_def( a_Class_Def class_def, int pos )
 
 a_Stmt_List new_stmt_list( a_Stmt stmt, int pos )
 {
-    a_Stmt_List a = (a_Stmt_List)checked_malloc( sizeof( struct a_Stmt_List_ ) );
+    a_Stmt_List a = (a_Stmt_List)arena_alloc( sizeof( struct a_Stmt_List_ ) );
     a->stmt = stmt;
     a->next = NULL;
     a->linepos = pos;
@@ -104,7 +179,7 @@ a_Stmt_List prepend_stmt_list( a_Stmt stmt, a_Stmt_List stmt_list, int pos )
 
 a_Stmt new_stmt_from_expression( a_Exp exp, int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_exp;
     a->stmt_exp = exp;
     a->linepos = pos;
@@ -114,7 +189,7 @@ a_Stmt new_stmt_from_expression( a_Exp exp, int pos )
 
 a_Stmt new_stmt_from_code( a_Stmt_List stmt_list, int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_code;
     a->stmt_code.stmt_list = stmt_list;
     a->linepos = pos;
@@ -126,7 +201,7 @@ a_Stmt new_stmt_from_code( a_Stmt_List stmt_list, int pos )
 
 a_Stmt new_stmt_from_if( a_Exp cond, a_Stmt if_body, a_Stmt else_body, int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_if;
     a->stmt_if.cond = cond;
     a->stmt_if.if_body = if_body;
@@ -140,7 +215,7 @@ a_Stmt new_stmt_from_if( a_Exp cond, a_Stmt if_body, a_Stmt else_body, int pos )
 
 a_Stmt new_stmt_from_while( a_Exp cond, a_Stmt body, int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_while;
     a->stmt_while.is_do = 0;
     a->stmt_while.cond = cond;
@@ -154,7 +229,7 @@ a_Stmt new_stmt_from_while( a_Exp cond, a_Stmt body, int pos )
 
 a_Stmt new_stmt_from_do_while( a_Exp cond, a_Stmt body, int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_while;
     a->stmt_while.is_do = 1;
     a->stmt_while.cond = cond;
@@ -168,7 +243,7 @@ a_Stmt new_stmt_from_do_while( a_Exp cond, a_Stmt body, int pos )
 
 a_Stmt new_stmt_from_until( a_Exp cond, a_Stmt body, int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_until;
     a->stmt_until.is_do = 0;
     a->stmt_until.cond = cond;
@@ -182,7 +257,7 @@ a_Stmt new_stmt_from_until( a_Exp cond, a_Stmt body, int pos )
 
 a_Stmt new_stmt_from_do_until( a_Exp cond, a_Stmt body, int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_until;
     a->stmt_until.is_do = 1;
     a->stmt_until.cond = cond;
@@ -196,7 +271,7 @@ a_Stmt new_stmt_from_do_until( a_Exp cond, a_Stmt body, int pos )
 
 a_Stmt new_stmt_from_for( a_Stmt c1, a_Stmt c2, a_Exp c3, a_Stmt body, int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_for;
     a->stmt_for.c1 = c1;
     a->stmt_for.c2 = c2;
@@ -211,7 +286,7 @@ a_Stmt new_stmt_from_for( a_Stmt c1, a_Stmt c2, a_Exp c3, a_Stmt body, int pos )
 
 a_Stmt new_stmt_from_loop( a_Exp cond, a_Stmt body, int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_loop;
     a->stmt_loop.cond = cond;
     a->stmt_loop.body = body;
@@ -224,7 +299,7 @@ a_Stmt new_stmt_from_loop( a_Exp cond, a_Stmt body, int pos )
 
 a_Stmt new_stmt_from_switch( a_Exp val, int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_switch;
     a->stmt_switch.val = val;
     a->linepos = pos;
@@ -236,7 +311,7 @@ a_Stmt new_stmt_from_switch( a_Exp val, int pos )
 
 a_Stmt new_stmt_from_break( int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_break;
     a->linepos = pos;
     a->stmt_break.linepos = pos;
@@ -247,7 +322,7 @@ a_Stmt new_stmt_from_break( int pos )
 
 a_Stmt new_stmt_from_continue( int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_continue;
     a->linepos = pos;
     a->stmt_continue.linepos = pos;
@@ -258,7 +333,7 @@ a_Stmt new_stmt_from_continue( int pos )
 
 a_Stmt new_stmt_from_return( a_Exp exp, int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_return;
     a->stmt_return.val = exp;
     a->linepos = pos;
@@ -270,7 +345,7 @@ a_Stmt new_stmt_from_return( a_Exp exp, int pos )
 
 a_Stmt new_stmt_from_label( c_str xid, int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_gotolabel;
     a->stmt_gotolabel.name = insert_symbol( xid );
     a->linepos = pos;
@@ -282,7 +357,7 @@ a_Stmt new_stmt_from_label( c_str xid, int pos )
 
 a_Stmt new_stmt_from_case( a_Exp exp, int pos )
 {
-    a_Stmt a = (a_Stmt)checked_malloc( sizeof( struct a_Stmt_ ) );
+    a_Stmt a = (a_Stmt)arena_alloc( sizeof( struct a_Stmt_ ) );
     a->s_type = ae_stmt_case;
     a->stmt_case.exp = exp;
     a->linepos = pos;
@@ -300,7 +375,7 @@ a_Exp prepend_expression( a_Exp exp, a_Exp list, int pos )
 
 a_Exp new_exp_from_binary( a_Exp lhs, ae_Operator oper, a_Exp rhs, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_binary;
     a->s_meta = ae_meta_value;
     a->binary.lhs = lhs;
@@ -315,7 +390,7 @@ a_Exp new_exp_from_binary( a_Exp lhs, ae_Operator oper, a_Exp rhs, int pos )
 
 a_Exp new_exp_from_unary( ae_Operator oper, a_Exp exp, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_unary;
     a->s_meta = exp->s_meta;
     a->unary.op = oper;
@@ -330,7 +405,7 @@ a_Exp new_exp_from_unary( ae_Operator oper, a_Exp exp, int pos )
 a_Exp new_exp_from_unary2( ae_Operator oper, a_Type_Decl type, 
                            a_Array_Sub array, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_unary;
     a->s_meta = ae_meta_value;
     a->unary.op = oper;
@@ -345,7 +420,7 @@ a_Exp new_exp_from_unary2( ae_Operator oper, a_Type_Decl type,
 
 a_Exp new_exp_from_unary3( ae_Operator oper, a_Stmt code, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_unary;
     a->s_meta = ae_meta_value;
     a->unary.op = oper;
@@ -359,7 +434,7 @@ a_Exp new_exp_from_unary3( ae_Operator oper, a_Stmt code, int pos )
 
 a_Exp new_exp_from_cast( a_Type_Decl type, a_Exp exp, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_cast;
     a->s_meta = ae_meta_value;
     a->cast.type = type;
@@ -373,7 +448,7 @@ a_Exp new_exp_from_cast( a_Type_Decl type, a_Exp exp, int pos )
 
 a_Exp new_exp_from_array( a_Exp base, a_Array_Sub indices, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_array;
     a->s_meta = ae_meta_var;
     a->array.base = base;
@@ -387,7 +462,7 @@ a_Exp new_exp_from_array( a_Exp base, a_Array_Sub indices, int pos )
 
 a_Exp new_exp_from_func_call( a_Exp base, a_Exp args, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_func_call;
     a->s_meta = ae_meta_value;
     a->func_call.func = base;
@@ -401,7 +476,7 @@ a_Exp new_exp_from_func_call( a_Exp base, a_Exp args, int pos )
 
 a_Exp new_exp_from_member_dot( a_Exp base, c_str xid, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_dot_member;
     a->s_meta = ae_meta_var;
     a->dot_member.base = base;
@@ -415,7 +490,7 @@ a_Exp new_exp_from_member_dot( a_Exp base, c_str xid, int pos )
 
 a_Exp new_exp_from_postfix( a_Exp base, ae_Operator op, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_postfix;
     a->s_meta = ae_meta_var;
     a->postfix.exp = base;
@@ -429,7 +504,7 @@ a_Exp new_exp_from_postfix( a_Exp base, ae_Operator op, int pos )
 
 a_Exp new_exp_from_dur( a_Exp base, a_Exp unit, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_dur;
     a->s_meta = ae_meta_value;
     a->dur.base = base;
@@ -443,7 +518,7 @@ a_Exp new_exp_from_dur( a_Exp base, a_Exp unit, int pos )
 
 a_Exp new_exp_from_id( c_str xid, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_primary;
     a->s_meta = ae_meta_var;
     a->primary.s_type = ae_primary_var;
@@ -457,7 +532,7 @@ a_Exp new_exp_from_id( c_str xid, int pos )
 
 a_Exp new_exp_from_int( long num, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_primary;
     a->s_meta = ae_meta_value;
     a->primary.s_type = ae_primary_num;
@@ -471,7 +546,7 @@ a_Exp new_exp_from_int( long num, int pos )
 
 a_Exp new_exp_from_float( double num, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_primary;
     a->s_meta = ae_meta_value;
     a->primary.s_type = ae_primary_float;
@@ -485,7 +560,7 @@ a_Exp new_exp_from_float( double num, int pos )
 
 a_Exp new_exp_from_str( c_str str, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_primary;
     a->s_meta = ae_meta_value;
     a->primary.s_type = ae_primary_str;
@@ -499,7 +574,7 @@ a_Exp new_exp_from_str( c_str str, int pos )
 
 a_Exp new_exp_from_char( c_str chr, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_primary;
     a->s_meta = ae_meta_value;
     a->primary.s_type = ae_primary_char;
@@ -513,7 +588,7 @@ a_Exp new_exp_from_char( c_str chr, int pos )
 
 a_Exp new_exp_from_array_lit( a_Array_Sub exp_list, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_primary;
     a->s_meta = ae_meta_value;
     a->primary.s_type = ae_primary_array;
@@ -527,7 +602,7 @@ a_Exp new_exp_from_array_lit( a_Array_Sub exp_list, int pos )
 
 a_Exp new_exp_from_if( a_Exp cond, a_Exp if_exp, a_Exp else_exp, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_if;
     a->s_meta = ( ( if_exp->s_meta == ae_meta_var && 
         else_exp->s_meta == ae_meta_var ) ? ae_meta_var : ae_meta_value );
@@ -551,7 +626,7 @@ a_Exp new_exp_decl_external( a_Type_Decl type, a_Var_Decl_List var_decl_list, in
 
 a_Exp new_exp_decl( a_Type_Decl type, a_Var_Decl_List var_decl_list, int is_static, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_decl;
     a->s_meta = ae_meta_var;
     a->decl.type = type;
@@ -566,7 +641,7 @@ a_Exp new_exp_decl( a_Type_Decl type, a_Var_Decl_List var_decl_list, int is_stat
 
 a_Exp new_exp_from_hack( a_Exp exp, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_primary;
     a->s_meta = ae_meta_value;
     a->primary.s_type = ae_primary_hack;
@@ -580,7 +655,7 @@ a_Exp new_exp_from_hack( a_Exp exp, int pos )
 
 a_Exp new_exp_from_complex( a_Complex exp, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_primary;
     a->s_meta = ae_meta_value;
     a->primary.s_type = ae_primary_complex;
@@ -595,7 +670,7 @@ a_Exp new_exp_from_complex( a_Complex exp, int pos )
 
 a_Exp new_exp_from_polar( a_Polar exp, int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_primary;
     a->s_meta = ae_meta_value;
     a->primary.s_type = ae_primary_polar;
@@ -610,7 +685,7 @@ a_Exp new_exp_from_polar( a_Polar exp, int pos )
 
 a_Exp new_exp_from_vec( a_Vec exp, int pos ) // ge: added 1.3.5.3
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_primary;
     a->s_meta = ae_meta_value;
     a->primary.s_type = ae_primary_vec;
@@ -625,7 +700,7 @@ a_Exp new_exp_from_vec( a_Vec exp, int pos ) // ge: added 1.3.5.3
 
 a_Exp new_exp_from_nil( int pos )
 {
-    a_Exp a = (a_Exp)checked_malloc( sizeof( struct a_Exp_ ) );
+    a_Exp a = (a_Exp)arena_alloc( sizeof( struct a_Exp_ ) );
     a->s_type = ae_exp_primary;
     a->s_meta = ae_meta_value;
     a->primary.s_type = ae_primary_nil;
@@ -638,7 +713,7 @@ a_Exp new_exp_from_nil( int pos )
 
 a_Var_Decl new_var_decl( c_constr xid, a_Array_Sub array, int pos )
 {
-    a_Var_Decl a = (a_Var_Decl)checked_malloc( sizeof( struct a_Var_Decl_ ) );
+    a_Var_Decl a = (a_Var_Decl)arena_alloc( sizeof( struct a_Var_Decl_ ) );
     a->xid = insert_symbol(xid);
     a->array = array;
     a->linepos = pos;
@@ -648,7 +723,7 @@ a_Var_Decl new_var_decl( c_constr xid, a_Array_Sub array, int pos )
 
 a_Var_Decl_List new_var_decl_list( a_Var_Decl var_decl, int pos )
 {
-    a_Var_Decl_List a = (a_Var_Decl_List)checked_malloc( 
+    a_Var_Decl_List a = (a_Var_Decl_List)arena_alloc( 
         sizeof( struct a_Var_Decl_List_ ) );
     a->var_decl = var_decl;
     a->linepos = pos;
@@ -666,7 +741,7 @@ a_Var_Decl_List prepend_var_decl_list( a_Var_Decl var_decl, a_Var_Decl_List list
 
 a_Type_Decl new_type_decl( a_Id_List type, int ref, int pos )
 {
-    a_Type_Decl a = (a_Type_Decl)checked_malloc(
+    a_Type_Decl a = (a_Type_Decl)arena_alloc(
         sizeof( struct a_Type_Decl_ ) );
     a->xid = type;
     a->ref = ref;
@@ -685,7 +760,7 @@ a_Type_Decl add_type_decl_array( a_Type_Decl a, a_Array_Sub array, int pos )
 
 a_Arg_List new_arg_list( a_Type_Decl type_decl, a_Var_Decl var_decl, int pos )
 {
-    a_Arg_List a = (a_Arg_List)checked_malloc(
+    a_Arg_List a = (a_Arg_List)arena_alloc(
         sizeof( struct a_Arg_List_ ) );
     a->type_decl = type_decl;
     a->var_decl = var_decl;
@@ -709,7 +784,7 @@ a_Func_Def new_func_def( ae_Keyword func_decl, ae_Keyword static_decl,
                          a_Type_Decl type_decl, c_str name,
                          a_Arg_List arg_list, a_Stmt code, int pos )
 {
-    a_Func_Def a = (a_Func_Def)checked_malloc(
+    a_Func_Def a = (a_Func_Def)arena_alloc(
         sizeof( struct a_Func_Def_ ) );
     a->func_decl = func_decl;
     a->static_decl = static_decl;
@@ -726,7 +801,7 @@ a_Func_Def new_func_def( ae_Keyword func_decl, ae_Keyword static_decl,
 a_Class_Def new_class_def( ae_Keyword class_decl, a_Id_List name, 
                            a_Class_Ext ext, a_Class_Body body, int pos )
 {
-    a_Class_Def a = (a_Class_Def)checked_malloc( sizeof( struct a_Class_Def_ ) );
+    a_Class_Def a = (a_Class_Def)arena_alloc( sizeof( struct a_Class_Def_ ) );
     a->decl = class_decl;
     a->name = name;
     a->ext = ext;
@@ -747,7 +822,7 @@ a_Class_Def new_iface_def( ae_Keyword class_decl, a_Id_List name,
 
 a_Class_Body new_class_body( a_Section section, int pos )
 {
-    a_Class_Body a = (a_Class_Body)checked_malloc( sizeof( struct a_Class_Body_ ) );
+    a_Class_Body a = (a_Class_Body)arena_alloc( sizeof( struct a_Class_Body_ ) );
     a->section = section;
     a->linepos = pos;
 
@@ -765,7 +840,7 @@ a_Class_Body prepend_class_body( a_Section section, a_Class_Body body, int pos )
 
 a_Class_Ext new_class_ext( a_Id_List extend_id, a_Id_List impl_list, int pos )
 {
-    a_Class_Ext a = (a_Class_Ext)checked_malloc( sizeof( struct a_Class_Ext_ ) );
+    a_Class_Ext a = (a_Class_Ext)arena_alloc( sizeof( struct a_Class_Ext_ ) );
     a->extend_id = extend_id;
     a->impl_list = impl_list;
     a->linepos = pos;
@@ -775,7 +850,7 @@ a_Class_Ext new_class_ext( a_Id_List extend_id, a_Id_List impl_list, int pos )
 
 a_Id_List new_id_list( c_constr xid, int pos )
 {
-    a_Id_List a = (a_Id_List)checked_malloc( sizeof( struct a_Id_List_ ) );
+    a_Id_List a = (a_Id_List)arena_alloc( sizeof( struct a_Id_List_ ) );
     a->xid = insert_symbol( xid );
     a->next = NULL;
     a->linepos = pos;
@@ -794,14 +869,15 @@ a_Id_List prepend_id_list( c_constr xid, a_Id_List list, int pos )
 
 void clean_exp( a_Exp exp )
 {
-    if( !exp ) return;
+    // nodes from an arena go with the arena
+    if( !exp || g_arena ) return;
     clean_exp( exp->next );
     free( exp );    
 }
 
 a_Array_Sub new_array_sub( a_Exp exp, int pos )
 {
-    a_Array_Sub a = (a_Array_Sub)checked_malloc( sizeof( struct a_Array_Sub_ ) );
+    a_Array_Sub a = (a_Array_Sub)arena_alloc( sizeof( struct a_Array_Sub_ ) );
     a->exp_list = exp;
     a->depth = 1;
     a->linepos = pos;
@@ -870,7 +946,7 @@ error:
 
 a_Complex new_complex( a_Exp re, int pos )
 {
-    a_Complex a = (a_Complex)checked_malloc( sizeof( struct a_Complex_ ) );
+    a_Complex a = (a_Complex)arena_alloc( sizeof( struct a_Complex_ ) );
     a->re = re;
     if( re ) a->im = re->next;
     a->linepos = pos;
@@ -880,7 +956,7 @@ a_Complex new_complex( a_Exp re, int pos )
 
 a_Polar new_polar( a_Exp mod, int pos )
 {
-    a_Polar a = (a_Polar)checked_malloc( sizeof( struct a_Polar_ ) );
+    a_Polar a = (a_Polar)arena_alloc( sizeof( struct a_Polar_ ) );
     a->mod = mod;
     if( mod ) a->phase = mod->next;
     a->linepos = pos;
@@ -890,7 +966,7 @@ a_Polar new_polar( a_Exp mod, int pos )
 
 a_Vec new_vec( a_Exp e, int pos ) // ge: added 1.3.5.3
 {
-    a_Vec a = (a_Vec)checked_malloc( sizeof( struct a_Vec_ ) );
+    a_Vec a = (a_Vec)arena_alloc( sizeof( struct a_Vec_ ) );
     a->args = e;
     while( e ) // count number of dims
     {
@@ -904,7 +980,8 @@ a_Vec new_vec( a_Exp e, int pos ) // ge: added 1.3.5.3
 
 void delete_id_list( a_Id_List x )
 {
-    if( !x ) return;
+    // nodes from an arena go with the arena
+    if( !x || g_arena ) return;
 
     a_Id_List curr = x, next = x->next, temp;
 
@@ -204,6 +204,16 @@ a_Func_Def new_func_def( ae_Keyword func_decl, ae_Keyword static_decl,
 
 void delete_id_list( a_Id_List x );
 
+// AST arena: holds the nodes of one parse; starts with one reference
+typedef struct a_Arena_ * a_Arena;
+a_Arena new_arena( );
+void arena_add_ref( a_Arena a );
+void arena_release( a_Arena a );
+// allocate new nodes from this arena (NULL: from the heap, one by one)
+void use_arena( a_Arena a );
+// zeroed memory from the arena in use
+void * arena_alloc( int size );
+
 
 
 
@@ -373,6 +383,7 @@ struct a_Func_Def_ {
     unsigned int s_type;
     unsigned int stack_depth;
     void * dl_func_ptr;  // should be not NULL iff s_type == ae_func_builtin
+    t_CKVMCODE ck_vm_code;  // code kept from an earlier compile of the same text
     int linepos;
 };
 
@@ -52,7 +52,10 @@
 #endif
 //#if defined(__WINDOWS_PTHREAD__)
 #include <sys/stat.h>
+#include <string.h>
 //#endif
+#include <ctype.h>
+#include <algorithm>
 
 using namespace std;
 
@@ -66,6 +69,38 @@ t_CKBOOL load_external_modules( Chuck_Compiler * compiler,
                                 std::list<std::string> & chugin_search_paths,
                                 std::list<std::string> & named_dls);
 t_CKBOOL load_module( Chuck_Compiler * compiler, Chuck_Env * env, f_ck_query query, const char * name, const char * nspc );
+static t_CKBOOL read_source( const string & path, FILE * fd, const char * str_src,
+                             string & out, string & name );
+static void release_recent( Chuck_Recent * recent );
+
+
+// a file-level function or class, as found in the source text
+struct Chuck_Src_Unit
+{
+    t_CKBOOL is_class;
+    string name;
+    // its definition in the parse tree (functions)
+    a_Func_Def def;
+};
+
+// source text split into file-level functions, classes, and the rest
+struct Chuck_Src_Split
+{
+    // in order
+    std::vector<Chuck_Src_Unit> units;
+    // the functions, by name, as they'd be kept in a Chuck_Recent
+    std::map<string, Chuck_Recent_Func> funcs;
+    std::map<string, string> classes;
+    // the rest
+    string top;
+};
+
+static size_t skip_source( const char * s, size_t n, size_t i, t_CKINT & line );
+static void scan_names( const string & src, std::vector<S_Symbol> & out );
+static t_CKBOOL split_source( const string & src, Chuck_Src_Split & out );
+static t_CKBOOL match_source( a_Program prog, Chuck_Src_Split & split );
+static void find_reusable( Chuck_Recent * recent, Chuck_Src_Split & split,
+                           std::set<string> & reuse );
 
 
 
@@ -167,6 +202,10 @@ void Chuck_Compiler::shutdown()
     emitter = NULL;
     code = NULL;
     m_auto_depend = FALSE;
+    // let go of cached compiles
+    std::map<string, Chuck_Recent *>::iterator iter;
+    for( iter = m_recent.begin(); iter != m_recent.end(); iter++ )
+        release_recent( (*iter).second );
     m_recent.clear();
     
     for(std::list<Chuck_DLL *>::iterator i = m_dlls.begin();
@@ -270,6 +309,8 @@ t_CKBOOL Chuck_Compiler::go( const string & filename, FILE * fd, const char * st
     {
         // normal (note: full_path added 1.3.0.0)
         ret = this->do_normal( filename, fd, str_src, full_path );
+        // done with the parse tree (what was compiled from it keeps its own hold)
+        release_parse();
         return ret;
     }
     else // auto
@@ -280,14 +321,14 @@ t_CKBOOL Chuck_Compiler::go( const string & filename, FILE * fd, const char * st
 
         // make the context
         context = type_engine_make_context( g_program, filename );
-        if( !context ) return FALSE;
+        if( !context ) { release_parse(); return FALSE; }
 
         // reset the env
         env()->reset();
 
         // load the context
         if( !type_engine_load_context( env(), context ) )
-            return FALSE;
+        { release_parse(); return FALSE; }
 
         // do entire file
         if( !do_entire_file( context ) )
@@ -312,9 +353,12 @@ cleanup:
         if( !type_engine_unload_context( env() ) )
         {
             EM_error2( 0, "internal error unloading context...\n" );
-            return FALSE;
+            ret = FALSE;
         }
 
+        // done with the parse tree
+        release_parse();
+
         return ret;
     }
 }
@@ -455,11 +499,56 @@ t_CKBOOL Chuck_Compiler::do_normal( const string & filename, FILE * fd, const ch
 {
     t_CKBOOL ret = TRUE;
     Chuck_Context * context = NULL;
+    Chuck_Recent * recent = NULL;
+    Chuck_Src_Split split;
+    std::set<string> reuse;
+    string source;
+    string name;
+
+    // get the source text up front, to compare against the last compile
+    t_CKBOOL have_source = read_source( filename, fd, str_src, source, name );
+    // last time around, if it was compiled against this same env
+    recent = find_recent_path( filename );
+    if( recent && ( recent->context->full_path != full_path ||
+                    recent->env_version != env()->version() ) )
+        recent = NULL;
+    // same source, same path, and nothing it can see has changed: reuse
+    if( have_source && recent && recent->source == source )
+    {
+        // log
+        EM_log( CK_LOG_FINE, "reusing code compiled from unchanged '%s'...",
+                filename.c_str() );
+        code = recent->context->code();
+        // callers append to the name; start it over
+        code->name = "";
+        return TRUE;
+    }
 
-    // parse the code
-    if( !chuck_parse( filename.c_str(), fd, str_src ) )
+    // parse the code (from the text already in hand, if any)
+    if( !( have_source ? chuck_parse( name.c_str(), NULL, source.c_str() )
+                       : chuck_parse( filename.c_str(), fd, str_src ) ) )
         return FALSE;
 
+    // find its functions and classes in the text; those functions that
+    // haven't changed, and use nothing that has, keep their code
+    t_CKBOOL have_split = have_source && split_source( source, split ) &&
+                          match_source( g_program, split );
+    if( have_split && recent ) find_reusable( recent, split, reuse );
+    if( reuse.size() )
+    {
+        // still type checked; the emitter skips their bodies
+        std::map<string, t_CKUINT> nth;
+        for( t_CKUINT i = 0; i < split.units.size(); i++ )
+        {
+            Chuck_Src_Unit & unit = split.units[i];
+            if( unit.is_class || !reuse.count( unit.name ) ) continue;
+            unit.def->ck_vm_code = recent->funcs[unit.name].code[nth[unit.name]++];
+        }
+        // log
+        EM_log( CK_LOG_FINE, "reusing code for %d function(s) unchanged in '%s'...",
+                (int)reuse.size(), filename.c_str() );
+    }
+
     // make the context
     context = type_engine_make_context( g_program, filename );
     if( !context ) return FALSE;
@@ -501,6 +590,26 @@ cleanup:
     // or rollback
     else env()->global()->rollback();
 
+    // remember it, for when the same (or nearly the same) source comes again
+    if( ret && have_source )
+    {
+        recent = new Chuck_Recent;
+        recent->context = context;
+        recent->source = source;
+        if( have_split )
+        {
+            for( t_CKUINT i = 0; i < split.units.size(); i++ )
+                if( !split.units[i].is_class )
+                    split.funcs[split.units[i].name].code.push_back(
+                        split.units[i].def->ck_func->code );
+            recent->funcs.swap( split.funcs );
+            recent->classes.swap( split.classes );
+            recent->top.swap( split.top );
+        }
+        if( !add_recent_path( filename, recent ) )
+            delete recent;
+    }
+
     // unload the context from the type-checker
     if( !type_engine_unload_context( env() ) )
     {
@@ -518,9 +627,10 @@ cleanup:
 // name: find_recent_path()
 // desc: find recent context by path
 //-----------------------------------------------------------------------------
-Chuck_Context * Chuck_Compiler::find_recent_path( const string & path )
+Chuck_Recent * Chuck_Compiler::find_recent_path( const string & path )
 {
-    return NULL;
+    std::map<string, Chuck_Recent *>::iterator iter = m_recent.find( path );
+    return iter != m_recent.end() ? (*iter).second : NULL;
 }
 
 
@@ -543,14 +653,433 @@ Chuck_Context * Chuck_Compiler::find_recent_type( const string & type )
 // desc: add recent context by path
 //-----------------------------------------------------------------------------
 t_CKBOOL Chuck_Compiler::add_recent_path( const string & path,
-                                          Chuck_Context * context )
+                                          Chuck_Recent * recent )
+{
+    Chuck_Context * context = recent->context;
+
+    // a public class can only be defined once, so its file can't be reused
+    if( context->public_class_def ) return FALSE;
+    // static data of a class belongs to the compile that defined it
+    for( t_CKUINT i = 0; i < context->new_types.size(); i++ )
+    {
+        Chuck_Type * type = (Chuck_Type *)context->new_types[i];
+        if( type->info && type->info->class_data_size ) return FALSE;
+    }
+
+    // replace the last one for this path
+    Chuck_Recent * last = find_recent_path( path );
+    if( last ) release_recent( last );
+
+    // what it was checked against
+    recent->env_version = env()->version();
+    // the code is all that's needed from here on
+    arena_release( context->parse_arena );
+    context->parse_arena = NULL;
+    context->parse_tree = NULL;
+
+    // hold on to it
+    context->add_ref();
+    context->code()->add_ref();
+    std::map<string, Chuck_Recent_Func>::iterator iter;
+    for( iter = recent->funcs.begin(); iter != recent->funcs.end(); iter++ )
+        for( t_CKUINT i = 0; i < (*iter).second.code.size(); i++ )
+            (*iter).second.code[i]->add_ref();
+    m_recent[path] = recent;
+
+    return TRUE;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: release_recent()
+// desc: let go of a compile held for reuse
+//-----------------------------------------------------------------------------
+static void release_recent( Chuck_Recent * recent )
+{
+    std::map<string, Chuck_Recent_Func>::iterator iter;
+    for( iter = recent->funcs.begin(); iter != recent->funcs.end(); iter++ )
+        for( t_CKUINT i = 0; i < (*iter).second.code.size(); i++ )
+            (*iter).second.code[i]->release();
+    recent->context->code()->release();
+    recent->context->release();
+    delete recent;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: read_source()
+// desc: get the text a compile would parse, and the name the parser would
+//       give it; FALSE if it can't be had
+//-----------------------------------------------------------------------------
+static t_CKBOOL read_source( const string & path, FILE * fd, const char * str_src,
+                             string & out, string & name )
+{
+    // from memory
+    name = path;
+    if( str_src ) { out = str_src; return TRUE; }
+
+    // from a file, opened the way the parser would
+    t_CKBOOL clo = FALSE;
+    if( !fd )
+    {
+        char buf[1024];
+        if( path.length() + 4 > sizeof(buf) ) return FALSE;
+        strcpy( buf, path.c_str() );
+        if( !(fd = open_cat_ck( buf )) ) return FALSE;
+        name = buf;
+        clo = TRUE;
+    }
+
+    // read all of it
+    out.clear();
+    char chunk[4096];
+    size_t n;
+    fseek( fd, 0, SEEK_SET );
+    while( (n = fread( chunk, 1, sizeof(chunk), fd )) > 0 )
+        out.append( chunk, n );
+    t_CKBOOL ok = !ferror( fd );
+
+    // done with it; the parser gets the text
+    if( clo ) fclose( fd );
+
+    return ok;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: skip_source()
+// desc: skip a comment, literal, or number at i in source text, as the lexer
+//       would, counting lines; returns where it ends (i if none is there)
+//-----------------------------------------------------------------------------
+static size_t skip_source( const char * s, size_t n, size_t i, t_CKINT & line )
+{
+    char c = s[i];
+    char c1 = i + 1 < n ? s[i+1] : '\0';
+    char c2 = i + 2 < n ? s[i+2] : '\0';
+
+    // line comments
+    if( ( c == '/' && c1 == '/' ) || ( c == '<' && c1 == '-' && c2 == '-' ) )
+    {
+        while( i < n && s[i] != '\n' && s[i] != '\r' ) i++;
+    }
+    // block comments
+    else if( c == '/' && c1 == '*' )
+    {
+        for( i += 2; i < n && !( s[i] == '*' && i + 1 < n && s[i+1] == '/' ); i++ )
+            if( s[i] == '\n' ) line++;
+        i += 2;
+    }
+    // string and char literals
+    else if( c == '"' || c == '`' || c == '\'' )
+    {
+        for( i++; i < n && s[i] != c; i++ )
+        {
+            if( s[i] == '\\' && i + 1 < n ) i++;
+            if( s[i] == '\n' ) line++;
+        }
+        i++;
+    }
+    // numbers
+    else if( isdigit( c ) )
+    {
+        while( i < n && ( isalnum( s[i] ) || s[i] == '_' ) ) i++;
+    }
+
+    return i < n ? i : n;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: scan_names()
+// desc: the identifiers in source text, sorted
+//-----------------------------------------------------------------------------
+static void scan_names( const string & src, std::vector<S_Symbol> & out )
+{
+    const char * s = src.c_str();
+    size_t n = src.length(), i = 0, b = 0, e = 0;
+    t_CKINT line = 0;
+    char buf[256];
+
+    while( i < n )
+    {
+        if( (e = skip_source( s, n, i, line )) != i ) { i = e; continue; }
+        if( !isalpha( s[i] ) && s[i] != '_' ) { i++; continue; }
+        for( b = i; i < n && ( isalnum( s[i] ) || s[i] == '_' ); i++ ) ;
+        if( i - b < sizeof(buf) )
+        {
+            memcpy( buf, s + b, i - b );
+            buf[i - b] = '\0';
+            out.push_back( insert_symbol( buf ) );
+        }
+        else out.push_back( insert_symbol( src.substr( b, i - b ).c_str() ) );
+    }
+
+    std::sort( out.begin(), out.end() );
+    out.erase( std::unique( out.begin(), out.end() ), out.end() );
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: split_source()
+// desc: find the file-level functions and classes in source text; FALSE if
+//       it can't
+//-----------------------------------------------------------------------------
+static t_CKBOOL split_source( const string & src, Chuck_Src_Split & out )
 {
+    const char * s = src.c_str();
+    size_t n = src.length(), i = 0, b = 0, e = 0, from = 0, start = 0;
+    size_t last = 0, last_len = 0;
+    t_CKINT depth = 0, line = 1, start_line = 0;
+    t_CKBOOL in_unit = FALSE, want_name = FALSE;
+    Chuck_Src_Unit unit;
+    char buf[32];
+
+    while( i < n )
+    {
+        char c = s[i];
+
+        // comments, literals, numbers
+        if( (e = skip_source( s, n, i, line )) != i ) { i = e; continue; }
+
+        // identifiers
+        if( isalpha( c ) || c == '_' )
+        {
+            for( b = i; i < n && ( isalnum( s[i] ) || s[i] == '_' ); i++ ) ;
+            // only those outside any braces matter here
+            if( depth ) continue;
+            string id( s + b, i - b );
+            // a function or class starts here
+            if( !in_unit &&
+                ( id == "fun" || id == "function" || id == "public" || id == "private" ||
+                  id == "protected" || id == "class" || id == "interface" ) )
+            {
+                out.top.append( s + from, b - from );
+                unit.is_class = FALSE;
+                unit.name.clear();
+                unit.def = NULL;
+                in_unit = TRUE;
+                start = b;
+                start_line = line;
+            }
+            if( in_unit )
+            {
+                // class name follows the keyword
+                if( want_name ) { unit.name = id; want_name = FALSE; }
+                if( unit.name.empty() && ( id == "class" || id == "interface" ) )
+                { unit.is_class = TRUE; want_name = TRUE; }
+                last = b;
+                last_len = i - b;
+            }
+            continue;
+        }
+
+        // line
+        if( c == '\n' ) line++;
+        // function name is the last identifier before the arguments
+        else if( c == '(' && in_unit && depth == 0 && !unit.is_class && unit.name.empty() )
+            unit.name.assign( s + last, last_len );
+        else if( c == '{' ) depth++;
+        else if( c == '}' && --depth < 0 ) return FALSE;
+        i++;
+
+        // the end of a function or class
+        if( in_unit && depth == 0 && ( c == '}' || ( c == ';' && !unit.is_class ) ) )
+        {
+            if( unit.name.empty() ) return FALSE;
+            if( unit.is_class ) out.classes[unit.name].assign( s + start, i - start );
+            else
+            {
+                // overloads go together
+                string & text = out.funcs[unit.name].text;
+                sprintf( buf, "%ld:", (long)start_line );
+                text += buf;
+                text.append( s + start, i - start );
+            }
+            out.units.push_back( unit );
+            // where it was, among the rest
+            out.top += '\0';
+            out.top += unit.name;
+            out.top += '\0';
+            in_unit = FALSE;
+            from = i;
+        }
+    }
+
+    // left open
+    if( in_unit ) return FALSE;
+    out.top.append( s + from, n - from );
+
     return TRUE;
 }
 
 
 
 
+//-----------------------------------------------------------------------------
+// name: match_source()
+// desc: pair the functions and classes found in the text with the parse
+//       tree; FALSE if they don't line up
+//-----------------------------------------------------------------------------
+static t_CKBOOL match_source( a_Program prog, Chuck_Src_Split & split )
+{
+    t_CKUINT i = 0;
+    for( ; prog; prog = prog->next )
+    {
+        a_Section section = prog->section;
+        if( section->s_type == ae_section_stmt ) continue;
+        if( i >= split.units.size() ) return FALSE;
+        Chuck_Src_Unit & unit = split.units[i++];
+        if( section->s_type == ae_section_func )
+        {
+            if( unit.is_class || unit.name != S_name(section->func_def->name) )
+                return FALSE;
+            unit.def = section->func_def;
+        }
+        else if( !unit.is_class || unit.name != S_name(section->class_def->name->xid) )
+            return FALSE;
+    }
+
+    return i == split.units.size();
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: find_reusable()
+// desc: names of the functions that can keep their code from the last
+//       compile: their text (and where it starts) is the same, and so is
+//       everything they mention -- the functions they call, and the
+//       file-level variables they use.  classes are always compiled anew
+//       (each compile makes new types), so anything naming one is too, and
+//       a class whose text changed may have moved or retyped its members,
+//       so anything using a name from it is too.
+//-----------------------------------------------------------------------------
+static void find_reusable( Chuck_Recent * recent, Chuck_Src_Split & split,
+                           std::set<string> & reuse )
+{
+    std::map<string, Chuck_Recent_Func> & funcs = split.funcs;
+    std::map<string, Chuck_Recent_Func>::iterator iter, old;
+    std::map<S_Symbol, std::vector<const string *> > callers;
+    std::vector<const string *> changed;
+    std::vector<S_Symbol> names;
+    std::vector<S_Symbol>::iterator name;
+    std::set<S_Symbol> fnames, bad, cnames;
+    std::map<string, string>::iterator cls, other;
+    std::map<string, std::vector<S_Symbol> > cuses;
+    t_CKBOOL more = TRUE;
+
+    // functions, then and now, by symbol
+    for( iter = funcs.begin(); iter != funcs.end(); iter++ )
+        fnames.insert( insert_symbol( (*iter).first.c_str() ) );
+    for( old = recent->funcs.begin(); old != recent->funcs.end(); old++ )
+    {
+        S_Symbol f = insert_symbol( (*old).first.c_str() );
+        // gone since last time
+        if( !fnames.count( f ) ) bad.insert( f );
+    }
+    // classes, then and now; those new, gone, or with different text changed
+    for( cls = recent->classes.begin(); cls != recent->classes.end(); cls++ )
+    {
+        S_Symbol c = insert_symbol( (*cls).first.c_str() );
+        bad.insert( c );
+        other = split.classes.find( (*cls).first );
+        if( other == split.classes.end() || (*other).second != (*cls).second )
+        {
+            cnames.insert( c );
+            scan_names( (*cls).second, names );
+        }
+    }
+    for( cls = split.classes.begin(); cls != split.classes.end(); cls++ )
+    {
+        S_Symbol c = insert_symbol( (*cls).first.c_str() );
+        bad.insert( c );
+        if( cnames.count( c ) ) scan_names( (*cls).second, names );
+        else if( !recent->classes.count( (*cls).first ) )
+        {
+            cnames.insert( c );
+            scan_names( (*cls).second, names );
+        }
+        else scan_names( (*cls).second, cuses[(*cls).first] );
+    }
+    // a class naming a changed one (extending it, say) changed with it
+    while( more )
+    {
+        more = FALSE;
+        std::map<string, std::vector<S_Symbol> >::iterator u;
+        for( u = cuses.begin(); u != cuses.end(); u++ )
+        {
+            S_Symbol c = insert_symbol( (*u).first.c_str() );
+            if( cnames.count( c ) ) continue;
+            for( name = (*u).second.begin(); name != (*u).second.end(); name++ )
+                if( cnames.count( *name ) ) break;
+            if( name == (*u).second.end() ) continue;
+            cnames.insert( c );
+            names.insert( names.end(), (*u).second.begin(), (*u).second.end() );
+            more = TRUE;
+        }
+    }
+    // what changed classes declare (and use) is bad
+    bad.insert( names.begin(), names.end() );
+    names.clear();
+
+    // the rest of the file changed: its variables may have moved or changed
+    // type, so anything mentioning a name used there, then or now, changed
+    // (calling a function from there doesn't change the function)
+    if( recent->top != split.top )
+    {
+        scan_names( recent->top, names );
+        scan_names( split.top, names );
+        for( name = names.begin(); name != names.end(); name++ )
+            if( !fnames.count( *name ) ) bad.insert( *name );
+    }
+
+    // functions that are new, whose text differs, or that mention something
+    // bad; and who calls whom
+    for( iter = funcs.begin(); iter != funcs.end(); iter++ )
+    {
+        old = recent->funcs.find( (*iter).first );
+        if( old == recent->funcs.end() || (*old).second.text != (*iter).second.text )
+        { changed.push_back( &(*iter).first ); continue; }
+        names.clear();
+        scan_names( (*iter).second.text, names );
+        for( name = names.begin(); name != names.end(); name++ )
+        {
+            if( bad.count( *name ) ) break;
+            if( fnames.count( *name ) ) callers[*name].push_back( &(*iter).first );
+        }
+        if( name != names.end() ) changed.push_back( &(*iter).first );
+    }
+
+    // whatever calls something that changed, changed
+    std::set<string> dirty;
+    while( changed.size() )
+    {
+        const string * f = changed.back();
+        changed.pop_back();
+        if( !dirty.insert( *f ).second ) continue;
+        std::vector<const string *> & c = callers[insert_symbol( f->c_str() )];
+        changed.insert( changed.end(), c.begin(), c.end() );
+    }
+
+    // the rest are the same as last time
+    for( iter = funcs.begin(); iter != funcs.end(); iter++ )
+        if( !dirty.count( (*iter).first ) ) reuse.insert( (*iter).first );
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: output()
 // desc: get the code generated by the last do()
@@ -641,6 +1170,8 @@ t_CKBOOL load_internal_modules( Chuck_Compiler * compiler )
     if( !load_module( compiler, env, libstd_query, "Std", "global" ) ) goto error;
     EM_log( CK_LOG_SEVERE, "class 'math'..." );
     if( !load_module( compiler, env, libmath_query, "Math", "global" ) ) goto error;
+    EM_log( CK_LOG_SEVERE, "class 'Vec'..." );
+    if( !load_module( compiler, env, libvec_query, "Vec", "global" ) ) goto error;
 
 // ge: these currently don't compile on "modern" windows versions (1.3.5.3)
 #ifndef __WINDOWS_MODERN__
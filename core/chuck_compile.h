@@ -39,6 +39,7 @@
 #include "chuck_emit.h"
 #include "chuck_vm.h"
 #include <list>
+#include <set>
 
 
 // forward reference
@@ -47,6 +48,48 @@ struct Chuck_DLL;
 
 
 
+//-----------------------------------------------------------------------------
+// name: struct Chuck_Recent_Func
+// desc: a file-level function (with its overloads) from the last compile of
+//       a file, kept so that if it hasn't changed it needn't be emitted again
+//       (it is still type checked)
+//-----------------------------------------------------------------------------
+struct Chuck_Recent_Func
+{
+    // its definitions, each with the line it starts on
+    std::string text;
+    // code emitted for each definition, in order
+    std::vector<Chuck_VM_Code *> code;
+};
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: struct Chuck_Recent
+// desc: the last successful compile of a file
+//-----------------------------------------------------------------------------
+struct Chuck_Recent
+{
+    // what was compiled
+    Chuck_Context * context;
+    // source text and env version it was compiled from
+    std::string source;
+    t_CKUINT env_version;
+    // the text outside functions and classes (with their names, in order)
+    std::string top;
+    // its classes' text, by name
+    std::map<std::string, std::string> classes;
+    // its functions, by name
+    std::map<std::string, Chuck_Recent_Func> funcs;
+
+    // constructor
+    Chuck_Recent() { context = NULL; env_version = 0; }
+};
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: struct Chuck_Compiler
 // desc: the sum of the components in compilation
@@ -76,8 +119,8 @@ public: // data
 
     // auto-depend flag
     t_CKBOOL m_auto_depend;
-    // recent map
-    std::map<std::string, Chuck_Context *> m_recent;
+    // recent map: last successful compile of each path, kept for reuse
+    std::map<std::string, Chuck_Recent *> m_recent;
     
     std::list<Chuck_DLL *> m_dlls;
     std::list<std::string> m_cklibs_to_preload;
@@ -121,11 +164,11 @@ protected: // internal
     t_CKBOOL do_normal( const std::string & path, FILE * fd = NULL, 
                         const char * str_src = NULL, const std::string & full_path = "" );
     // look up in recent
-    Chuck_Context * find_recent_path( const std::string & path );
+    Chuck_Recent * find_recent_path( const std::string & path );
     // look up in recent
     Chuck_Context * find_recent_type( const std::string & type );
     // add to recent
-    t_CKBOOL add_recent_path( const std::string & path, Chuck_Context * context );
+    t_CKBOOL add_recent_path( const std::string & path, Chuck_Recent * recent );
 };
 
 
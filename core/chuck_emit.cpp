@@ -3331,7 +3331,19 @@ t_CKBOOL emit_engine_emit_exp_array( Chuck_Emitter * emit, a_Exp_Array array )
         if( is_str )
             emit->append( instr = new Chuck_Instr_Array_Map_Access( getkindof(emit->env, type), is_var ) );
         else
-            emit->append( instr = new Chuck_Instr_Array_Access( getkindof(emit->env, type), is_var ) );
+        {
+            // specialized by element kind
+            switch( getkindof( emit->env, type ) )
+            {
+            case kindof_INT: instr = new Chuck_Instr_Array_Access_Int( is_var ); break;
+            case kindof_FLOAT: instr = new Chuck_Instr_Array_Access_Float( is_var ); break;
+            case kindof_COMPLEX: instr = new Chuck_Instr_Array_Access_Complex( is_var ); break;
+            case kindof_VEC3: instr = new Chuck_Instr_Array_Access_Vec3( is_var ); break;
+            case kindof_VEC4: instr = new Chuck_Instr_Array_Access_Vec4( is_var ); break;
+            default: instr = new Chuck_Instr_Array_Access( getkindof(emit->env, type), is_var ); break;
+            }
+            emit->append( instr );
+        }
         instr->set_linepos( array->linepos );
     }
     else
@@ -4363,6 +4375,14 @@ t_CKBOOL emit_engine_emit_func_def( Chuck_Emitter * emit, a_Func_Def func_def )
         emit->append( new Chuck_Instr_Mem_Set_Imm( value->offset, (t_CKUINT)func ) );
     }
 
+    // code kept from an earlier compile of the same text (see do_normal())
+    if( func_def->ck_vm_code )
+    {
+        func->code = func_def->ck_vm_code;
+        func->code->add_ref();
+        return TRUE;
+    }
+
     // set the func
     emit->env->func = func;
     // push the current code
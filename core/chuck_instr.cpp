@@ -1611,6 +1611,28 @@ void Chuck_Instr_vec4_Divide_float_Assign::execute( Chuck_VM * vm, Chuck_VM_Shre
 #pragma mark === String Arithmetic ===
 
 
+//-----------------------------------------------------------------------------
+// name: new_temp_string()
+// desc: make the result string of a string arithmetic instruction
+//-----------------------------------------------------------------------------
+static inline Chuck_String * new_temp_string( Chuck_VM * vm, Chuck_VM_Shred * shred )
+{
+    Chuck_String * str = (Chuck_String *)instantiate_and_initialize_object( vm->env()->t_string, shred );
+    str->m_is_temp = TRUE;
+    return str;
+}
+
+
+//-----------------------------------------------------------------------------
+// name: release_temp_string()
+// desc: free an operand once consumed, if it is an unreferenced temporary
+//-----------------------------------------------------------------------------
+static inline void release_temp_string( Chuck_String * str )
+{
+    if( str->is_temp() ) { str->add_ref(); str->release(); }
+}
+
+
 //-----------------------------------------------------------------------------
 // name: execute()
 // desc: string + string
@@ -1632,12 +1654,23 @@ void Chuck_Instr_Add_string::execute( Chuck_VM * vm, Chuck_VM_Shred * shred )
     // make sure no null
     if( !rhs || !lhs ) goto null_pointer;
 
-    // make new string
-    result = (Chuck_String *)instantiate_and_initialize_object( vm->env()->t_string, shred );
-
-    // concat
-    // result->str = lhs->str + rhs->str;
-    result->set( lhs->str() + rhs->str() );
+    // a temporary on the left (e.g., from a + b + c) is extended in place
+    if( lhs->is_temp() && lhs != rhs )
+    {
+        result = lhs;
+        result->append( rhs->str() );
+        release_temp_string( rhs );
+    }
+    else
+    {
+        // make new string
+        result = new_temp_string( vm, shred );
+        // concat
+        // result->str = lhs->str + rhs->str;
+        result->set( lhs->str(), rhs->str() );
+        release_temp_string( lhs );
+        if( rhs != lhs ) release_temp_string( rhs );
+    }
 
     // push the reference value to reg stack
     push_( reg_sp, (t_CKUINT)(result) );
@@ -1678,11 +1711,12 @@ void Chuck_Instr_Add_string_Assign::execute( Chuck_VM * vm, Chuck_VM_Shred * shr
     lhs = (Chuck_String *)(*(reg_sp));
 
     // make sure no null
-    if( !(*rhs_ptr) ) goto null_pointer;
+    if( !(*rhs_ptr) || !lhs ) goto null_pointer;
 
-    // concat
+    // concat, in place
     // (*rhs_ptr)->str += lhs->str;
-    (*rhs_ptr)->set( (*rhs_ptr)->str() + lhs->str() );
+    (*rhs_ptr)->append( lhs->str() );
+    release_temp_string( lhs );
 
     // push the reference value to reg stack
     push_( reg_sp, (t_CKUINT)(*rhs_ptr) );
@@ -1726,12 +1760,20 @@ void Chuck_Instr_Add_string_int::execute( Chuck_VM * vm, Chuck_VM_Shred * shred
     // make sure no null
     if( !lhs ) goto null_pointer;
 
-    // make new string
-    result = (Chuck_String *)instantiate_and_initialize_object( vm->env()->t_string, shred );
-
-    // concat
-    // result->str = lhs->str + ::itoa(rhs);
-    result->set( lhs->str() + ::itoa( rhs ) );
+    // a temporary on the left is extended in place
+    if( lhs->is_temp() )
+    {
+        result = lhs;
+        result->append( ::itoa( rhs ) );
+    }
+    else
+    {
+        // make new string
+        result = new_temp_string( vm, shred );
+        // concat
+        // result->str = lhs->str + ::itoa(rhs);
+        result->set( lhs->str(), ::itoa( rhs ) );
+    }
 
     // push the reference value to reg stack
     push_( reg_sp, (t_CKUINT)(result) );
@@ -1775,12 +1817,20 @@ void Chuck_Instr_Add_string_float::execute( Chuck_VM * vm, Chuck_VM_Shred * shre
     // make sure no null
     if( !lhs ) goto null_pointer;
 
-    // make new string
-    result = (Chuck_String *)instantiate_and_initialize_object( vm->env()->t_string, shred );
-
-    // concat
-    // result->str = lhs->str + ::ftoa(rhs, 4);
-    result->set( lhs->str() + ::ftoa( rhs, 4 ) );
+    // a temporary on the left is extended in place
+    if( lhs->is_temp() )
+    {
+        result = lhs;
+        result->append( ::ftoa( rhs, 4 ) );
+    }
+    else
+    {
+        // make new string
+        result = new_temp_string( vm, shred );
+        // concat
+        // result->str = lhs->str + ::ftoa(rhs, 4);
+        result->set( lhs->str(), ::ftoa( rhs, 4 ) );
+    }
 
     // push the reference value to reg stack
     push_( reg_sp, (t_CKUINT)(result) );
@@ -1824,12 +1874,20 @@ void Chuck_Instr_Add_int_string::execute( Chuck_VM * vm, Chuck_VM_Shred * shred
     // make sure no null
     if( !rhs ) goto null_pointer;
 
-    // make new string
-    result = (Chuck_String *)instantiate_and_initialize_object( vm->env()->t_string, shred );
-
-    // concat
-    // result->str = ::itoa(lhs) + rhs->str;
-    result->set( ::itoa(lhs) + rhs->str() );
+    // a temporary on the right is extended in place
+    if( rhs->is_temp() )
+    {
+        result = rhs;
+        result->prepend( ::itoa(lhs) );
+    }
+    else
+    {
+        // make new string
+        result = new_temp_string( vm, shred );
+        // concat
+        // result->str = ::itoa(lhs) + rhs->str;
+        result->set( ::itoa(lhs), rhs->str() );
+    }
 
     // push the reference value to reg stack
     push_( reg_sp, (t_CKUINT)(result) );
@@ -1873,12 +1931,20 @@ void Chuck_Instr_Add_float_string::execute( Chuck_VM * vm, Chuck_VM_Shred * shre
     // make sure no null
     if( !rhs ) goto null_pointer;
 
-    // make new string
-    result = (Chuck_String *)instantiate_and_initialize_object( vm->env()->t_string, shred );
-
-    // concat
-    // result->str = ::ftoa(lhs, 4) + rhs->str;
-    result->set( ::ftoa( lhs, 4 ) + rhs->str() );
+    // a temporary on the right is extended in place
+    if( rhs->is_temp() )
+    {
+        result = rhs;
+        result->prepend( ::ftoa( lhs, 4 ) );
+    }
+    else
+    {
+        // make new string
+        result = new_temp_string( vm, shred );
+        // concat
+        // result->str = ::ftoa(lhs, 4) + rhs->str;
+        result->set( ::ftoa( lhs, 4 ), rhs->str() );
+    }
 
     // push the reference value to reg stack
     push_( reg_sp, (t_CKUINT)(result) );
@@ -1921,9 +1987,9 @@ void Chuck_Instr_Add_int_string_Assign::execute( Chuck_VM * vm, Chuck_VM_Shred *
     // make sure no null
     if( !(*rhs_ptr) ) goto null_pointer;
 
-    // concat
+    // concat, in place
     // (*rhs_ptr)->str += ::itoa(lhs);
-    (*rhs_ptr)->set( (*rhs_ptr)->str() + ::itoa(lhs) );
+    (*rhs_ptr)->append( ::itoa(lhs) );
 
     // push the reference value to reg stack
     push_( reg_sp, (t_CKUINT)(*rhs_ptr) );
@@ -1966,9 +2032,9 @@ void Chuck_Instr_Add_float_string_Assign::execute( Chuck_VM * vm, Chuck_VM_Shred
     // make sure no null
     if( !(*rhs_ptr) ) goto null_pointer;
 
-    // concat
+    // concat, in place
     // (*rhs_ptr)->str += ::ftoa(lhs, 4);
-    (*rhs_ptr)->set( (*rhs_ptr)->str() + ::ftoa(lhs, 4) );
+    (*rhs_ptr)->append( ::ftoa(lhs, 4) );
 
     // push the reference value to reg stack
     push_( reg_sp, (t_CKUINT)(*rhs_ptr) );
@@ -3636,22 +3702,22 @@ t_CKBOOL initialize_object( Chuck_Object * object, Chuck_Type * type )
     assert( type != NULL );
     assert( type->info != NULL );
 
-    // allocate virtual table
-    object->vtable = new Chuck_VTable;
-    if( !object->vtable ) goto out_of_memory;
-    // copy the object's virtual table
-    object->vtable->funcs = type->info->obj_v_table.funcs;
+    // share the type's virtual table (never changed once objects exist)
+    object->vtable = &type->info->obj_v_table;
     // set the type reference
     // TODO: reference count
     object->type_ref = type;
     object->type_ref->add_ref();
+    // traced by the cycle collector if it has object members
+    for( Chuck_Type * t = type; t != NULL && !object->m_gc_traced; t = t->parent )
+        if( t->obj_mvar_offsets.size() ) object->m_gc_traced = TRUE;
     // get the size
     object->size = type->obj_size;
     // allocate memory
     if( object->size )
     {
         // check to ensure enough memory
-        object->data = new t_CKBYTE[object->size];
+        object->data = (t_CKBYTE *)Chuck_VM_Alloc::instance()->alloc_block( object->size );
         if( !object->data ) goto out_of_memory;
         // zero it out
         memset( object->data, 0, object->size );
@@ -3700,8 +3766,8 @@ out_of_memory:
         "[chuck](VM): OutOfMemory: while instantiating object '%s'\n",
         type->c_name() );
 
-    // delete
-    if( object ) SAFE_DELETE( object->vtable );
+    // not ours
+    if( object ) object->vtable = NULL;
 
     // return FALSE
     return FALSE;
@@ -4119,7 +4185,9 @@ void Chuck_Instr_Assign_String::execute( Chuck_VM * vm, Chuck_VM_Shred * shred )
     // release any previous reference
     if( *rhs_ptr )
     {
-        if( lhs ) (*rhs_ptr)->set( lhs->str() );
+        // a temporary gives up its contents instead of being copied
+        if( lhs && lhs->is_temp() ) { (*rhs_ptr)->take( lhs ); release_temp_string( lhs ); }
+        else if( lhs ) (*rhs_ptr)->set( lhs->str() );
         else
         {
             // release reference
@@ -4129,8 +4197,14 @@ void Chuck_Instr_Assign_String::execute( Chuck_VM * vm, Chuck_VM_Shred * shred )
     }
     else
     {
+        // a temporary can simply be kept
+        if( lhs != NULL && lhs->is_temp() )
+        {
+            (*rhs_ptr) = lhs;
+            (*rhs_ptr)->add_ref();
+        }
         // if left is not null, yes
-        if( lhs != NULL )
+        else if( lhs != NULL )
         {
             (*rhs_ptr) = (Chuck_String *)instantiate_and_initialize_object( vm->env()->t_string, shred );
             // add ref
@@ -5448,6 +5522,132 @@ done:
 
 
 
+//-----------------------------------------------------------------------------
+// name: except()
+// desc: array access exception
+//-----------------------------------------------------------------------------
+void Chuck_Instr_Array_Access::except( Chuck_VM_Shred * shred, t_CKUINT err, t_CKINT i )
+{
+    if( err == 1 )
+    {
+        CK_FPRINTF_STDERR( 
+            "[chuck](VM): NullPointerException: (array access) on line[%lu] in shred[id=%lu:%s]\n",
+            m_linepos, shred->xid, shred->name.c_str() );
+    }
+    else
+    {
+        CK_FPRINTF_STDERR( 
+            "[chuck](VM): ArrayOutofBounds: on line[%lu] in shred[id=%lu:%s], index=[%ld]\n",
+            m_linepos, shred->xid, shred->name.c_str(), i );
+    }
+
+    // do something!
+    shred->is_running = FALSE;
+    shred->is_done = TRUE;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: array_access()
+// desc: body of the array access instructions, for array class A of T;
+//       returns 0, or 1 if the array is null, 2 if i is out of bounds
+//-----------------------------------------------------------------------------
+template <class A, class T>
+static inline t_CKUINT array_access( Chuck_VM_Shred * shred, t_CKUINT emit_addr, t_CKINT & i )
+{
+    // reg stack pointer
+    t_CKUINT *& sp = (t_CKUINT *&)shred->reg->sp;
+
+    // pop array and index
+    pop_( sp, 2 );
+    A * arr = (A *)(*sp);
+    if( !arr ) return 1;
+    i = (t_CKINT)(*(sp+1));
+    // one check (negative wraps around to large)
+    if( (t_CKUINT)i >= arr->m_vector.size() ) return 2;
+
+    // push the addr (writing) or the value
+    if( emit_addr ) { push_( sp, (t_CKUINT)&arr->m_vector[i] ); }
+    else { push_( ((T *&)sp), arr->m_vector[i] ); }
+
+    return 0;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: execute()
+// desc: ...
+//-----------------------------------------------------------------------------
+void Chuck_Instr_Array_Access_Int::execute( Chuck_VM * vm, Chuck_VM_Shred * shred )
+{
+    t_CKINT i = 0;
+    t_CKUINT err = array_access<Chuck_Array4, t_CKUINT>( shred, m_emit_addr, i );
+    if( err ) except( shred, err, i );
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: execute()
+// desc: ...
+//-----------------------------------------------------------------------------
+void Chuck_Instr_Array_Access_Float::execute( Chuck_VM * vm, Chuck_VM_Shred * shred )
+{
+    t_CKINT i = 0;
+    t_CKUINT err = array_access<Chuck_Array8, t_CKFLOAT>( shred, m_emit_addr, i );
+    if( err ) except( shred, err, i );
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: execute()
+// desc: ...
+//-----------------------------------------------------------------------------
+void Chuck_Instr_Array_Access_Complex::execute( Chuck_VM * vm, Chuck_VM_Shred * shred )
+{
+    t_CKINT i = 0;
+    t_CKUINT err = array_access<Chuck_Array16, t_CKCOMPLEX>( shred, m_emit_addr, i );
+    if( err ) except( shred, err, i );
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: execute()
+// desc: ...
+//-----------------------------------------------------------------------------
+void Chuck_Instr_Array_Access_Vec3::execute( Chuck_VM * vm, Chuck_VM_Shred * shred )
+{
+    t_CKINT i = 0;
+    t_CKUINT err = array_access<Chuck_Array24, t_CKVEC3>( shred, m_emit_addr, i );
+    if( err ) except( shred, err, i );
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: execute()
+// desc: ...
+//-----------------------------------------------------------------------------
+void Chuck_Instr_Array_Access_Vec4::execute( Chuck_VM * vm, Chuck_VM_Shred * shred )
+{
+    t_CKINT i = 0;
+    t_CKUINT err = array_access<Chuck_Array32, t_CKVEC4>( shred, m_emit_addr, i );
+    if( err ) except( shred, err, i );
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: execute()
 // desc: ...
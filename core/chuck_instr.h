@@ -3190,6 +3190,10 @@ public:
                m_kind, m_emit_addr, m_istr );
       return buffer; }
 
+protected:
+    // null pointer (err 1) or out of bounds (err 2): stop the shred
+    void except( Chuck_VM_Shred * shred, t_CKUINT err, t_CKINT i );
+
 protected:
     t_CKUINT m_kind;
     t_CKUINT m_emit_addr;
@@ -3199,6 +3203,91 @@ protected:
 
 
 
+//-----------------------------------------------------------------------------
+// name: struct Chuck_Instr_Array_Access_Int
+// desc: array access, for int (and object) elements
+//-----------------------------------------------------------------------------
+struct Chuck_Instr_Array_Access_Int : public Chuck_Instr_Array_Access
+{
+public:
+    Chuck_Instr_Array_Access_Int( t_CKUINT emit_addr )
+        : Chuck_Instr_Array_Access( kindof_INT, emit_addr ) { }
+
+public:
+    virtual void execute( Chuck_VM * vm, Chuck_VM_Shred * shred );
+};
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: struct Chuck_Instr_Array_Access_Float
+// desc: array access, for float elements
+//-----------------------------------------------------------------------------
+struct Chuck_Instr_Array_Access_Float : public Chuck_Instr_Array_Access
+{
+public:
+    Chuck_Instr_Array_Access_Float( t_CKUINT emit_addr )
+        : Chuck_Instr_Array_Access( kindof_FLOAT, emit_addr ) { }
+
+public:
+    virtual void execute( Chuck_VM * vm, Chuck_VM_Shred * shred );
+};
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: struct Chuck_Instr_Array_Access_Complex
+// desc: array access, for complex/polar elements
+//-----------------------------------------------------------------------------
+struct Chuck_Instr_Array_Access_Complex : public Chuck_Instr_Array_Access
+{
+public:
+    Chuck_Instr_Array_Access_Complex( t_CKUINT emit_addr )
+        : Chuck_Instr_Array_Access( kindof_COMPLEX, emit_addr ) { }
+
+public:
+    virtual void execute( Chuck_VM * vm, Chuck_VM_Shred * shred );
+};
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: struct Chuck_Instr_Array_Access_Vec3
+// desc: array access, for vec3 elements
+//-----------------------------------------------------------------------------
+struct Chuck_Instr_Array_Access_Vec3 : public Chuck_Instr_Array_Access
+{
+public:
+    Chuck_Instr_Array_Access_Vec3( t_CKUINT emit_addr )
+        : Chuck_Instr_Array_Access( kindof_VEC3, emit_addr ) { }
+
+public:
+    virtual void execute( Chuck_VM * vm, Chuck_VM_Shred * shred );
+};
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: struct Chuck_Instr_Array_Access_Vec4
+// desc: array access, for vec4 elements
+//-----------------------------------------------------------------------------
+struct Chuck_Instr_Array_Access_Vec4 : public Chuck_Instr_Array_Access
+{
+public:
+    Chuck_Instr_Array_Access_Vec4( t_CKUINT emit_addr )
+        : Chuck_Instr_Array_Access( kindof_VEC4, emit_addr ) { }
+
+public:
+    virtual void execute( Chuck_VM * vm, Chuck_VM_Shred * shred );
+};
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: struct Chuck_Instr_Array_Map_Access
 // desc: ...
@@ -86,6 +86,9 @@ const t_CKUINT Chuck_IO_Serial::TYPE_LINE = 6;
 const t_CKUINT Chuck_IO_Serial::TYPE_WRITE = 100;
 
 std::list<Chuck_IO_Serial *> Chuck_IO_Serial::s_serials;
+#ifndef WIN32
+std::map<Chuck_VM *, CBufferSimple *> Chuck_IO_Serial::s_event_buffers;
+#endif
 
 //    static const t_CKUINT TYPE_NONE = 0;
 //    static const t_CKUINT TYPE_BYTE = 1;
@@ -127,6 +130,14 @@ void Chuck_IO_Serial::shutdown()
     {
         (*i)->close();
     }
+
+#ifndef WIN32
+    for(std::map<Chuck_VM *, CBufferSimple *>::iterator i = s_event_buffers.begin(); i != s_event_buffers.end(); i++)
+    {
+        i->first->destroy_event_buffer(i->second);
+    }
+    s_event_buffers.clear();
+#endif
 }
 
 
@@ -153,6 +164,10 @@ m_writeBuffer(1024)
     m_do_write_thread = TRUE;
 
     m_do_exit = FALSE;
+    m_starved = FALSE;
+#ifndef WIN32
+    m_last_cr = FALSE;
+#endif
     
     s_serials.push_back(this);
     
@@ -163,17 +178,19 @@ Chuck_IO_Serial::~Chuck_IO_Serial()
 {
     m_do_read_thread = FALSE;
     m_do_write_thread = FALSE;
+#ifdef WIN32
     SAFE_DELETE(m_read_thread);
     if( m_event_buffer )
         m_vmRef->destroy_event_buffer( m_event_buffer );
+#endif
     
     close();
     
-    SAFE_DELETE(m_io_buf);
+    SAFE_DELETE_ARRAY(m_io_buf);
     m_io_buf_max = 0;
     m_io_buf_pos = m_io_buf_available = 0;
     
-    SAFE_DELETE(m_tmp_buf);
+    SAFE_DELETE_ARRAY(m_tmp_buf);
     m_tmp_buf_max = 0;
     
     s_serials.remove(this);
@@ -263,6 +280,13 @@ t_CKBOOL Chuck_IO_Serial::good()
 
 void Chuck_IO_Serial::close()
 {
+#ifndef WIN32
+    // once removed, the reactor won't call back for this port
+    m_do_exit = TRUE;
+    if( m_event_buffer )
+        XReactor::shared()->remove( m_fd );
+    close_int();
+#else
     if(m_iomode == MODE_SYNC)
     {
         close_int();
@@ -270,13 +294,10 @@ void Chuck_IO_Serial::close()
     else
     {
         m_do_exit = TRUE;
-#ifdef WIN32
         m_read_thread->wait(-1, TRUE);
         close_int();
-#else
-        m_read_thread->wait(-1, FALSE);
-#endif
     }
+#endif
 }
 
 void Chuck_IO_Serial::close_int()
@@ -500,7 +521,7 @@ void Chuck_IO_Serial::write( const std::string & val )
     
     if( m_iomode == MODE_ASYNC )
     {
-        start_read_thread();
+        start_async();
         
         int len = val.length();
         for(int i = 0; i < len; i++)
@@ -514,6 +535,7 @@ void Chuck_IO_Serial::write( const std::string & val )
         r.m_status = Request::RQ_STATUS_PENDING;
         
         m_asyncWriteRequests.put(r);
+        notify_async();
     }
     else if( m_iomode == MODE_SYNC )
     {
@@ -544,7 +566,7 @@ void Chuck_IO_Serial::write( t_CKINT val, t_CKINT size )
     
     if( m_iomode == MODE_ASYNC )
     {
-        start_read_thread();
+        start_async();
         
         if( m_flags & Chuck_IO_File::TYPE_ASCII )
         {
@@ -567,6 +589,7 @@ void Chuck_IO_Serial::write( t_CKINT val, t_CKINT size )
             r.m_status = Request::RQ_STATUS_PENDING;
             
             m_asyncWriteRequests.put(r);
+            notify_async();
         }
         else
         {
@@ -583,6 +606,7 @@ void Chuck_IO_Serial::write( t_CKINT val, t_CKINT size )
             r.m_status = Request::RQ_STATUS_PENDING;
             
             m_asyncWriteRequests.put(r);
+            notify_async();
         }
     }
     else if( m_iomode == MODE_SYNC )
@@ -610,7 +634,7 @@ void Chuck_IO_Serial::write( t_CKFLOAT val )
     
     if( m_iomode == MODE_ASYNC )
     {
-        start_read_thread();
+        start_async();
         
         if( m_flags & Chuck_IO_File::TYPE_ASCII )
         {
@@ -633,6 +657,7 @@ void Chuck_IO_Serial::write( t_CKFLOAT val )
             r.m_status = Request::RQ_STATUS_PENDING;
             
             m_asyncWriteRequests.put(r);
+            notify_async();
         }
         else
         {
@@ -649,6 +674,7 @@ void Chuck_IO_Serial::write( t_CKFLOAT val )
             r.m_status = Request::RQ_STATUS_PENDING;
             
             m_asyncWriteRequests.put(r);
+            notify_async();
         }
     }
     else if( m_iomode == MODE_SYNC )
@@ -677,7 +703,7 @@ void Chuck_IO_Serial::writeBytes( Chuck_Array4 * arr )
     
     if( m_iomode == MODE_ASYNC )
     {
-        start_read_thread();
+        start_async();
         
         int len = arr->size();
         for(int i = 0; i < len; i++)
@@ -695,6 +721,7 @@ void Chuck_IO_Serial::writeBytes( Chuck_Array4 * arr )
         r.m_status = Request::RQ_STATUS_PENDING;
         
         m_asyncWriteRequests.put(r);
+        notify_async();
     }
     else if( m_iomode == MODE_SYNC )
     {
@@ -709,8 +736,18 @@ void Chuck_IO_Serial::writeBytes( Chuck_Array4 * arr )
     }
 }
 
-void Chuck_IO_Serial::start_read_thread()
+void Chuck_IO_Serial::start_async()
 {
+#ifndef WIN32
+    if(m_event_buffer == NULL)
+    {
+        if(s_event_buffers.count(m_vmRef) == 0)
+            s_event_buffers[m_vmRef] = m_vmRef->create_event_buffer();
+        m_event_buffer = s_event_buffers[m_vmRef];
+        
+        XReactor::shared()->add(m_fd, XReactor::READ, reactor_cb, this);
+    }
+#else
     if(m_read_thread == NULL)
     {
         m_read_thread = new XThread();
@@ -722,6 +759,14 @@ void Chuck_IO_Serial::start_read_thread()
         assert(m_event_buffer == NULL);
         m_event_buffer = m_vmRef->create_event_buffer();
     }
+#endif
+}
+
+void Chuck_IO_Serial::notify_async()
+{
+#ifndef WIN32
+    XReactor::shared()->notify(m_fd);
+#endif
 }
 
 
@@ -733,7 +778,7 @@ t_CKBOOL Chuck_IO_Serial::readAsync( t_CKUINT type, t_CKUINT num )
         return FALSE;
     }
     
-    start_read_thread();
+    start_async();
     
     Request read;
     read.m_type = type;
@@ -744,6 +789,7 @@ t_CKBOOL Chuck_IO_Serial::readAsync( t_CKUINT type, t_CKUINT num )
     if(!m_asyncRequests.atMaximum() )
     {
         m_asyncRequests.put(read);
+        notify_async();
     }
     else
     {
@@ -955,12 +1001,19 @@ t_CKINT Chuck_IO_Serial::peek_buffer()
     
     if(m_io_buf_pos >= m_io_buf_available)
     {
+#ifndef WIN32
+        // never block the reactor; the request is retried after the next read
+        if(!m_do_exit && !m_eof)
+            m_starved = TRUE;
+        return -1;
+#else
         // refresh data
         while(!m_do_exit && !m_eof && !get_buffer(5))
             ;
         
         if(m_do_exit || m_eof)
             return -1;
+#endif
     }
     
     return m_io_buf[m_io_buf_pos];
@@ -974,17 +1027,33 @@ t_CKINT Chuck_IO_Serial::pull_buffer()
     
     if(m_io_buf_pos >= m_io_buf_available)
     {
+#ifndef WIN32
+        if(!m_do_exit && !m_eof)
+            m_starved = TRUE;
+        return -1;
+#else
         // refresh data
         while(!m_do_exit && !m_eof && !get_buffer(5))
             ;
         
         if(m_do_exit || m_eof)
             return -1;
+#endif
     }
     
     return m_io_buf[m_io_buf_pos++];
 }
 
+// is the next byte c? (with the reactor, only looks at bytes already read)
+t_CKBOOL Chuck_IO_Serial::next_is(t_CKINT c)
+{
+#ifndef WIN32
+    return m_io_buf_pos < m_io_buf_available && m_io_buf[m_io_buf_pos] == c;
+#else
+    return peek_buffer() == c;
+#endif
+}
+
 
 t_CKINT Chuck_IO_Serial::buffer_bytes_to_tmp(t_CKINT num_bytes)
 {
@@ -1015,7 +1084,7 @@ t_CKBOOL Chuck_IO_Serial::handle_line(Chuck_IO_Serial::Request &r)
         {
             // consume newline character
             pull_buffer();
-            if(peek_buffer() == '\n') pull_buffer(); // handle \r\n
+            if(next_is('\n')) pull_buffer(); // handle \r\n
             break;
         }
         
@@ -1023,7 +1092,7 @@ t_CKBOOL Chuck_IO_Serial::handle_line(Chuck_IO_Serial::Request &r)
         {
             // consume newline character
             pull_buffer();
-            if(peek_buffer() == '\r') pull_buffer(); // handle \n\r (unlikely)
+            if(next_is('\r')) pull_buffer(); // handle \n\r (unlikely)
             break;
         }
                 
@@ -1036,7 +1105,7 @@ t_CKBOOL Chuck_IO_Serial::handle_line(Chuck_IO_Serial::Request &r)
         }
     }
     
-    if(m_do_exit)
+    if(m_do_exit || m_starved)
         goto error;
     // TODO: eof
     
@@ -1103,7 +1172,7 @@ t_CKBOOL Chuck_IO_Serial::handle_float_ascii(Chuck_IO_Serial::Request & r)
         }
     }
     
-    if(m_do_exit || m_eof)
+    if(m_do_exit || m_eof || m_starved)
         goto error;
 
     r.m_num = numRead;
@@ -1153,7 +1222,7 @@ t_CKBOOL Chuck_IO_Serial::handle_int_ascii(Chuck_IO_Serial::Request & r)
         }
     }
     
-    if(m_do_exit || m_eof)
+    if(m_do_exit || m_eof || m_starved)
         goto error;
     
     r.m_num = numRead;
@@ -1187,7 +1256,7 @@ t_CKBOOL Chuck_IO_Serial::handle_byte(Chuck_IO_Serial::Request & r)
     
     t_CKINT len = buffer_bytes_to_tmp(num);
     
-    if(m_do_exit || m_eof)
+    if(m_do_exit || m_eof || m_starved)
         goto error;
 
     r.m_num = len;
@@ -1235,6 +1304,13 @@ t_CKBOOL Chuck_IO_Serial::handle_float_binary(Chuck_IO_Serial::Request & r)
     
     r.m_num = buffer_bytes_to_tmp(size*num)/size;
     
+    if(m_starved)
+    {
+        r.m_val = 0;
+        r.m_status = Chuck_IO_Serial::Request::RQ_STATUS_FAILURE;
+        return TRUE;
+    }
+    
     t_CKUINT val = 0;
     t_CKSINGLE * m_floats = (t_CKSINGLE *) m_tmp_buf;
     
@@ -1269,6 +1345,13 @@ t_CKBOOL Chuck_IO_Serial::handle_int_binary(Chuck_IO_Serial::Request & r)
     
     r.m_num = buffer_bytes_to_tmp(size*num)/size;
     
+    if(m_starved)
+    {
+        r.m_val = 0;
+        r.m_status = Chuck_IO_Serial::Request::RQ_STATUS_FAILURE;
+        return TRUE;
+    }
+    
     t_CKUINT val = 0;
     uint32_t * m_ints = (uint32_t *) m_tmp_buf;
     
@@ -1287,6 +1370,66 @@ t_CKBOOL Chuck_IO_Serial::handle_int_binary(Chuck_IO_Serial::Request & r)
 }
 
 
+t_CKBOOL Chuck_IO_Serial::handle_request(Chuck_IO_Serial::Request & r)
+{
+    if(m_flags & Chuck_IO_File::TYPE_ASCII)
+    {
+        switch(r.m_type)
+        {
+            case TYPE_LINE:
+                handle_line(r);
+                break;
+                
+            case TYPE_STRING:
+                handle_string(r);
+                break;
+                
+            case TYPE_INT:
+                handle_int_ascii(r);
+                break;
+                
+            case TYPE_FLOAT:
+                handle_float_ascii(r);
+                break;
+                
+            default:
+                // this shouldnt happen
+                r.m_type = TYPE_NONE;
+                r.m_num = 0;
+                r.m_status = Request::RQ_STATUS_INVALID;
+                r.m_val = 0;
+                EM_log(CK_LOG_WARNING, "SerialIO.read_cb: error: invalid request");
+        }
+    }
+    else
+    {
+        // binary
+        switch(r.m_type)
+        {
+            case TYPE_BYTE:
+                handle_byte(r);
+                break;
+            case TYPE_INT:
+                handle_int_binary(r);
+                break;
+            case TYPE_FLOAT:
+                handle_float_binary(r);
+                break;
+                
+            default:
+                // this shouldnt happen
+                r.m_type = TYPE_NONE;
+                r.m_num = 0;
+                r.m_status = Request::RQ_STATUS_INVALID;
+                r.m_val = 0;
+                EM_log(CK_LOG_WARNING, "SerialIO.read_cb: error: invalid request");
+        }
+    }
+    
+    return TRUE;
+}
+
+
 void Chuck_IO_Serial::read_cb()
 {
     m_do_read_thread = TRUE;
@@ -1311,59 +1454,7 @@ void Chuck_IO_Serial::read_cb()
                 continue;
             }
             
-            if(m_flags & Chuck_IO_File::TYPE_ASCII)
-            {
-                switch(r.m_type)
-                {
-                    case TYPE_LINE:
-                        handle_line(r);
-                        break;
-                        
-                    case TYPE_STRING:
-                        handle_string(r);
-                        break;
-                        
-                    case TYPE_INT:
-                        handle_int_ascii(r);
-                        break;
-                        
-                    case TYPE_FLOAT:
-                        handle_float_ascii(r);
-                        break;
-                        
-                    default:
-                        // this shouldnt happen
-                        r.m_type = TYPE_NONE;
-                        r.m_num = 0;
-                        r.m_status = Request::RQ_STATUS_INVALID;
-                        r.m_val = 0;
-                        EM_log(CK_LOG_WARNING, "SerialIO.read_cb: error: invalid request");
-                }
-            }
-            else
-            {
-                // binary
-                switch(r.m_type)
-                {
-                    case TYPE_BYTE:
-                        handle_byte(r);
-                        break;
-                    case TYPE_INT:
-                        handle_int_binary(r);
-                        break;
-                    case TYPE_FLOAT:
-                        handle_float_binary(r);
-                        break;
-                        
-                    default:
-                        // this shouldnt happen
-                        r.m_type = TYPE_NONE;
-                        r.m_num = 0;
-                        r.m_status = Request::RQ_STATUS_INVALID;
-                        r.m_val = 0;
-                        EM_log(CK_LOG_WARNING, "SerialIO.read_cb: error: invalid request");
-                }
-            }
+            handle_request(r);
             
             m_asyncResponses.put(r);
             num_responses++;
@@ -1422,6 +1513,162 @@ void Chuck_IO_Serial::write_cb()
 }
 
 
+#ifndef WIN32
+void Chuck_IO_Serial::reactor_cb( int fd, t_CKUINT events, void * data )
+{
+    Chuck_IO_Serial * cereal = (Chuck_IO_Serial *) data;
+    
+    if( events & XReactor::READ )
+        cereal->fill_buffer();
+    if( events & ( XReactor::WRITE | XReactor::NOTIFY ) )
+        cereal->flush_writes();
+    
+    cereal->service_requests();
+    
+    // gone (eof/error)?
+    if( cereal->m_eof )
+        return;
+    
+    // read while there is room, wait to write while bytes are pending
+    t_CKUINT watch = 0;
+    if( cereal->m_io_buf_available - cereal->m_io_buf_pos < cereal->m_io_buf_max )
+        watch |= XReactor::READ;
+    if( cereal->m_write_pending.size() )
+        watch |= XReactor::WRITE;
+    XReactor::shared()->modify( fd, watch );
+}
+
+// read everything available, in as few read()s as the buffer allows
+void Chuck_IO_Serial::fill_buffer()
+{
+    t_CKUINT count = 0;
+    
+    // keep unread bytes, at the front
+    if( m_io_buf_pos > 0 )
+    {
+        memmove( m_io_buf, m_io_buf + m_io_buf_pos, m_io_buf_available - m_io_buf_pos );
+        m_io_buf_available -= m_io_buf_pos;
+        m_io_buf_pos = 0;
+    }
+    
+    while( m_io_buf_available < m_io_buf_max )
+    {
+        ssize_t result = ::read( m_fd, m_io_buf + m_io_buf_available,
+                                 m_io_buf_max - m_io_buf_available );
+        if( result > 0 )
+        {
+            unsigned char * p = m_io_buf + m_io_buf_available;
+            t_CKUINT n = result;
+            
+            // ascii: read \r\n as \n, even when split across reads
+            if( m_flags & Chuck_IO_File::TYPE_ASCII )
+            {
+                t_CKUINT j = 0;
+                for( t_CKUINT i = 0; i < n; i++ )
+                {
+                    if( !( m_last_cr && p[i] == '\n' ) ) p[j++] = p[i];
+                    m_last_cr = p[i] == '\r';
+                }
+                // the \r stands in for the line end
+                n = j;
+            }
+            
+            m_io_buf_available += n;
+            count += result;
+            continue;
+        }
+        
+        if( result < 0 && errno == EINTR )
+            continue;
+        // nothing more for now
+        if( result < 0 && ( errno == EAGAIN || errno == EWOULDBLOCK ) )
+            break;
+        // readable but empty means end of file
+        if( result == 0 && count > 0 )
+            break;
+        
+        EM_log( CK_LOG_SEVERE, "(SerialIO): device '%s' closed or failed, no more reads",
+                m_path.c_str() );
+        m_eof = TRUE;
+        XReactor::shared()->remove( m_fd );
+        break;
+    }
+    
+    EM_log( CK_LOG_FINE, "(SerialIO::fill_buffer): read %i bytes", count );
+}
+
+// hand queued output to the device, as much as it takes
+void Chuck_IO_Serial::flush_writes()
+{
+    Request r;
+    char c;
+    
+    // the bytes of every write queued so far
+    while( m_asyncWriteRequests.get( r ) )
+        ;
+    while( m_writeBuffer.get( c ) )
+        m_write_pending.push_back( c );
+    
+    size_t done = 0;
+    while( done < m_write_pending.size() )
+    {
+        ssize_t result = ::write( m_fd, &m_write_pending[done], m_write_pending.size() - done );
+        if( result > 0 ) done += result;
+        else if( result < 0 && errno == EINTR ) continue;
+        else break; // full (or failed); wait to be writable
+    }
+    m_write_pending.erase( m_write_pending.begin(), m_write_pending.begin() + done );
+}
+
+// answer requests, in order, from what has been read
+void Chuck_IO_Serial::service_requests()
+{
+    Request r;
+    int num_responses = 0;
+    
+    while( m_asyncRequests.peek( r, 1 ) )
+    {
+        if( m_asyncResponses.atMaximum() )
+        {
+            EM_log(CK_LOG_SEVERE, "SerialIO.read_cb: error: response buffer overflow, dropping read");
+            m_asyncRequests.get( r );
+            continue;
+        }
+        
+        t_CKUINT pos = m_io_buf_pos;
+        m_starved = FALSE;
+        
+        handle_request( r );
+        
+        if( m_starved )
+        {
+            // not all here yet: put the bytes back and wait for more
+            m_io_buf_pos = pos;
+            m_starved = FALSE;
+            // buffer full of one unfinished request: make room
+            if( m_io_buf_pos == 0 && m_io_buf_available == m_io_buf_max )
+            {
+                unsigned char * buf = new unsigned char[m_io_buf_max * 2];
+                memcpy( buf, m_io_buf, m_io_buf_available );
+                delete[] m_io_buf;
+                m_io_buf = buf;
+                m_io_buf_max *= 2;
+            }
+            break;
+        }
+        
+        Request done;
+        m_asyncRequests.get( done );
+        m_asyncResponses.put( r );
+        num_responses++;
+    }
+    
+    if( num_responses > 0 )
+        queue_broadcast( m_event_buffer );
+}
+#endif
+
+
 t_CKBOOL Chuck_IO_Serial::setBaudRate( t_CKUINT rate )
 {
 #ifndef WIN32
@@ -1786,7 +2033,9 @@ CK_DLL_CTOR( serialio_ctor )
 CK_DLL_DTOR( serialio_dtor )
 {
     Chuck_IO_Serial * cereal = (Chuck_IO_Serial *) SELF;
-    if(cereal)
+    // from ~Chuck_Object (no shred), ~Chuck_IO_Serial has already closed
+    // the device, and cereal is no longer a whole Chuck_IO_Serial
+    if(cereal && SHRED)
     {
         SHRED->remove_serialio(cereal);
         cereal->close();
@@ -36,6 +36,7 @@
 #include "util_thread.h"
 #include "util_buffers.h"
 #include <list>
+#include <map>
 
 
 
@@ -136,7 +137,10 @@ public:
 
 protected:
     
-    void start_read_thread();
+    // start async I/O: the shared XReactor (posix) or read/write threads
+    void start_async();
+    // tell the async side there is a new request
+    void notify_async();
     XThread * m_read_thread;
     static void *shell_read_cb(void *);
     void read_cb();
@@ -147,11 +151,28 @@ protected:
     
     void close_int();
 
+#ifndef WIN32
+    // XReactor callback: read what is there, write what is queued, then
+    // answer the requests that can be answered
+    static void reactor_cb( int fd, t_CKUINT events, void * data );
+    void fill_buffer();
+    void flush_writes();
+    void service_requests();
+    // bytes the device has not taken yet
+    std::vector<char> m_write_pending;
+    // last byte read was \r (\r\n is read as \n)
+    t_CKBOOL m_last_cr;
+    // ports of a VM share one event buffer, fed by the reactor thread
+    static std::map<Chuck_VM *, CBufferSimple *> s_event_buffers;
+#endif
+
     t_CKBOOL get_buffer(t_CKINT timeout_ms = 1);
     t_CKINT peek_buffer();
     t_CKINT pull_buffer();
     t_CKINT buffer_bytes_to_tmp(t_CKINT num_bytes);
+    t_CKBOOL next_is(t_CKINT c);
     
+    t_CKBOOL handle_request(Request &);
     t_CKBOOL handle_line(Request &);
     t_CKBOOL handle_string(Request &);
     t_CKBOOL handle_float_ascii(Request &);
@@ -188,6 +209,8 @@ protected:
     t_CKBOOL m_eof;
     
     t_CKBOOL m_do_exit;
+    // a handler ran out of buffered bytes (reactor only)
+    t_CKBOOL m_starved;
     
     static std::list<Chuck_IO_Serial *> s_serials;
     
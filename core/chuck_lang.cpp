@@ -82,6 +82,8 @@ t_CKBOOL init_class_object( Chuck_Env * env, Chuck_Type * type )
     // init as base class
     if( !type_engine_import_class_begin( env, type, env->global(), object_ctor, object_dtor, doc ) )
         return FALSE;
+    // the dtor only lets go of the string: do that in place, free elsewhere
+    if( !type_engine_import_dtor_async( env, object_dtor ) ) goto error;
 
     // add member to hold string
     Object_offset_string = type_engine_import_mvar( env, "string", "@string", FALSE );
@@ -224,6 +226,8 @@ t_CKBOOL init_class_uana( Chuck_Env * env, Chuck_Type * type )
     // TODO: ctor/dtor, ugen's sometimes created internally?
     if( !type_engine_import_class_begin( env, type, env->global(), uana_ctor, uana_dtor, doc ) )
         return FALSE;
+    // dtor does nothing
+    if( !type_engine_import_dtor_async( env ) ) goto error;
 
     // add variables
     uana_offset_blob = type_engine_import_mvar( env, "UAnaBlob", "m_blob", FALSE );
@@ -308,6 +312,8 @@ t_CKBOOL init_class_blob( Chuck_Env * env, Chuck_Type * type )
     // TODO: ctor/dtor
     if( !type_engine_import_class_begin( env, type, env->global(), uanablob_ctor, uanablob_dtor, doc ) )
         return FALSE;
+    // the dtor only lets go of the arrays: do that in place, free elsewhere
+    if( !type_engine_import_dtor_async( env, uanablob_dtor ) ) goto error;
 
     // add variables
     uanablob_offset_when = type_engine_import_mvar( env, "time", "m_when", FALSE );
@@ -923,6 +929,29 @@ t_CKBOOL init_class_fileio( Chuck_Env * env, Chuck_Type * type )
     // func = make_new_mfun( "float", "readFloat", fileio_readfloat );
     // if( !type_engine_import_mfun( env, func ) ) goto error;
     
+    // add readFloats(float[],int)
+    func = make_new_mfun( "int", "readFloats", fileio_readfloats );
+    func->add_arg( "float[]", "dest" );
+    func->add_arg( "int", "count" );
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    
+    // add readInts(int[],int)
+    func = make_new_mfun( "int", "readInts", fileio_readints );
+    func->add_arg( "int[]", "dest" );
+    func->add_arg( "int", "count" );
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    
+    // add readInts(int[],int,int)
+    func = make_new_mfun( "int", "readInts", fileio_readintsflags );
+    func->add_arg( "int[]", "dest" );
+    func->add_arg( "int", "count" );
+    func->add_arg( "int", "flags" );
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    
+    // add can_wait()
+    func = make_new_mfun( "int", "can_wait", fileio_can_wait );
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    
     // add eof()
     func = make_new_mfun( "int", "eof", fileio_eof );
     if( !type_engine_import_mfun( env, func ) ) goto error;
@@ -976,6 +1005,10 @@ t_CKBOOL init_class_fileio( Chuck_Env * env, Chuck_Type * type )
     if( !type_engine_import_svar( env, "int", "BINARY",
                                   TRUE, (t_CKUINT)&Chuck_IO_File::TYPE_BINARY ) ) goto error;
     
+    // add FLAG_MMAP
+    if( !type_engine_import_svar( env, "int", "MMAP",
+                                  TRUE, (t_CKUINT)&Chuck_IO_File::FLAG_MMAP ) ) goto error;
+    
     // end the class import
     type_engine_import_class_end( env );
     
@@ -2206,6 +2239,7 @@ CK_DLL_DTOR( object_dtor )
     Chuck_String * str = (Chuck_String *)OBJ_MEMBER_UINT(SELF, Object_offset_string);
     // release
     SAFE_RELEASE( str );
+    OBJ_MEMBER_UINT(SELF, Object_offset_string) = 0;
 }
 
 
@@ -2618,14 +2652,14 @@ CK_DLL_DTOR( uanablob_dtor )
 {
     // get array
     Chuck_Array8 * arr8 = (Chuck_Array8 *)OBJ_MEMBER_INT(SELF, uanablob_offset_fvals);
-    // release it
-    arr8->release();
+    // release it (may have been already, see type_engine_import_dtor_async)
+    SAFE_RELEASE( arr8 );
     OBJ_MEMBER_INT(SELF, uanablob_offset_fvals) = 0;
     
     // get array
     Chuck_Array16 * arr16 = (Chuck_Array16 *)OBJ_MEMBER_INT(SELF, uanablob_offset_cvals);
     // release it
-    arr16->release();
+    SAFE_RELEASE( arr16 );
     OBJ_MEMBER_INT(SELF, uanablob_offset_cvals) = 0;
     
     OBJ_MEMBER_TIME(SELF, uanablob_offset_when) = 0;
@@ -3085,6 +3119,82 @@ CK_DLL_MFUN( fileio_readfloat )
     RETURN->v_float = ret;
 }
 
+CK_DLL_MFUN( fileio_readfloats )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    t_CKINT n = GET_NEXT_INT(ARGS);
+    Chuck_IO_File * f = (Chuck_IO_File *)SELF;
+    
+    if( !a ) { throw_exception( SHRED, "NullPointerException", "FileIO.readFloats: array is null" ); return; }
+    if( n < 0 ) n = 0;
+    
+    if (f->mode() == Chuck_IO::MODE_ASYNC)
+    {
+        // set up arguments
+        Chuck_IO::async_args *args = new Chuck_IO::async_args;
+        args->RETURN = (void *)RETURN;
+        args->fileio_obj = f;
+        args->arrayArg = a;
+        args->intArg = n;
+        // queue on the I/O pool; after `f => now` the count is the array size
+        f->start_async( Chuck_IO_File::readFloats_job, args );
+        RETURN->v_int = 0;
+    } else {
+        a->set_size( n );
+        t_CKINT count = n ? f->readFloats( &a->m_vector[0], n ) : 0;
+        a->set_size( count );
+        RETURN->v_int = count;
+    }
+}
+
+static void fileio_readints_impl( Chuck_Array4 * a, t_CKINT n, t_CKINT flags,
+                                  Chuck_IO_File * f, Chuck_DL_Return * RETURN,
+                                  Chuck_VM_Shred * SHRED )
+{
+    if( !a ) { throw_exception( SHRED, "NullPointerException", "FileIO.readInts: array is null" ); return; }
+    if( n < 0 ) n = 0;
+    
+    if (f->mode() == Chuck_IO::MODE_ASYNC)
+    {
+        // set up arguments
+        Chuck_IO::async_args *args = new Chuck_IO::async_args;
+        args->RETURN = (void *)RETURN;
+        args->fileio_obj = f;
+        args->arrayArg = a;
+        args->intArg = n;
+        args->flagsArg = flags;
+        // queue on the I/O pool; after `f => now` the count is the array size
+        f->start_async( Chuck_IO_File::readInts_job, args );
+        RETURN->v_int = 0;
+    } else {
+        a->set_size( n );
+        t_CKINT count = n ? f->readInts( (t_CKINT *)&a->m_vector[0], n, flags ) : 0;
+        a->set_size( count );
+        RETURN->v_int = count;
+    }
+}
+
+CK_DLL_MFUN( fileio_readints )
+{
+    Chuck_Array4 * a = (Chuck_Array4 *)GET_NEXT_OBJECT(ARGS);
+    t_CKINT n = GET_NEXT_INT(ARGS);
+    fileio_readints_impl( a, n, Chuck_IO::INT32, (Chuck_IO_File *)SELF, RETURN, SHRED );
+}
+
+CK_DLL_MFUN( fileio_readintsflags )
+{
+    Chuck_Array4 * a = (Chuck_Array4 *)GET_NEXT_OBJECT(ARGS);
+    t_CKINT n = GET_NEXT_INT(ARGS);
+    t_CKINT flags = GET_NEXT_INT(ARGS);
+    fileio_readints_impl( a, n, flags, (Chuck_IO_File *)SELF, RETURN, SHRED );
+}
+
+CK_DLL_MFUN( fileio_can_wait )
+{
+    Chuck_IO_File * f = (Chuck_IO_File *)SELF;
+    RETURN->v_int = f->can_wait();
+}
+
 CK_DLL_MFUN( fileio_eof )
 {
     Chuck_IO_File * f = (Chuck_IO_File *)SELF;
@@ -3110,22 +3220,10 @@ CK_DLL_MFUN( fileio_writestring )
         Chuck_IO::async_args *args = new Chuck_IO::async_args;
         args->RETURN = (void *)RETURN;
         args->fileio_obj = f;
+        args->arrayArg = NULL;
         args->stringArg = std::string(val);
-        // set shred to wait for I/O completion
-        assert( SHRED != NULL );
-        f->m_asyncEvent->wait( SHRED, SHRED->vm_ref );
-        // start thread
-        bool ret = f->m_thread->start( f->writeStr_thread, (void *)args );
-        if (!ret) {
-            // for some reason, the XThread object needs to be
-            // deleted and reconstructed every time after call #375
-            delete f->m_thread;
-            f->m_thread = new XThread;
-            ret = f->m_thread->start( f->writeStr_thread, (void *)args );
-            if (!ret) {
-                EM_error3( "(FileIO): failed to start thread for asynchronous mode I/O" );
-            }
-        }
+        // queue on the I/O pool; `f => now` waits for completion
+        f->start_async( Chuck_IO_File::writeStr_job, args );
     } else {
         f->write(val);
     }
@@ -3142,22 +3240,10 @@ CK_DLL_MFUN( fileio_writeint )
         Chuck_IO::async_args *args = new Chuck_IO::async_args;
         args->RETURN = (void *)RETURN;
         args->fileio_obj = f;
+        args->arrayArg = NULL;
         args->intArg = val;
-        // set shred to wait for I/O completion
-        assert( SHRED != NULL );
-        f->m_asyncEvent->wait( SHRED, SHRED->vm_ref );
-        // start thread
-        bool ret = f->m_thread->start( f->writeInt_thread, (void *)args );
-        if (!ret) {
-            // for some reason, the XThread object needs to be
-            // deleted and reconstructed every time after call #375
-            delete f->m_thread;
-            f->m_thread = new XThread;
-            ret = f->m_thread->start( f->writeInt_thread, (void *)args );
-            if (!ret) {
-                EM_error3( "(FileIO): failed to start thread for asynchronous mode I/O" );
-            }
-        }
+        // queue on the I/O pool; `f => now` waits for completion
+        f->start_async( Chuck_IO_File::writeInt_job, args );
     } else {
         f->write(val);
     }
@@ -3171,27 +3257,15 @@ CK_DLL_MFUN( fileio_writeintflags )
     Chuck_IO_File * f = (Chuck_IO_File *)SELF;
     if (f->mode() == Chuck_IO::MODE_ASYNC)
     {
-        // TODO: pass flags in args
         // set up arguments
         Chuck_IO::async_args *args = new Chuck_IO::async_args;
         args->RETURN = (void *)RETURN;
         args->fileio_obj = f;
+        args->arrayArg = NULL;
         args->intArg = val;
-        // set shred to wait for I/O completion
-        assert( SHRED != NULL );
-        f->m_asyncEvent->wait( SHRED, SHRED->vm_ref );
-        // start thread
-        bool ret = f->m_thread->start( f->writeInt_thread, (void *)args );
-        if (!ret) {
-            // for some reason, the XThread object needs to be
-            // deleted and reconstructed every time after call #375
-            delete f->m_thread;
-            f->m_thread = new XThread;
-            ret = f->m_thread->start( f->writeInt_thread, (void *)args );
-            if (!ret) {
-                EM_error3( "(FileIO): failed to start thread for asynchronous mode I/O" );
-            }
-        }
+        args->flagsArg = flags;
+        // queue on the I/O pool; `f => now` waits for completion
+        f->start_async( Chuck_IO_File::writeIntFlags_job, args );
     } else {
         f->write(val, flags);
     }
@@ -3208,22 +3282,10 @@ CK_DLL_MFUN( fileio_writefloat )
         Chuck_IO::async_args *args = new Chuck_IO::async_args;
         args->RETURN = (void *)RETURN;
         args->fileio_obj = f;
+        args->arrayArg = NULL;
         args->floatArg = val;
-        // set shred to wait for I/O completion
-        assert( SHRED != NULL );
-        f->m_asyncEvent->wait( SHRED, SHRED->vm_ref );
-        // start thread
-        bool ret = f->m_thread->start( f->writeFloat_thread, (void *)args );
-        if (!ret) {
-            // for some reason, the XThread object needs to be
-            // deleted and reconstructed every time after call #375
-            delete f->m_thread;
-            f->m_thread = new XThread;
-            ret = f->m_thread->start( f->writeFloat_thread, (void *)args );
-            if (!ret) {
-                EM_error3( "(FileIO): failed to start thread for asynchronous mode I/O" );
-            }
-        }
+        // queue on the I/O pool; `f => now` waits for completion
+        f->start_async( Chuck_IO_File::writeFloat_job, args );
     } else {
         f->write(val);
     }
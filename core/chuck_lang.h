@@ -234,6 +234,10 @@ CK_DLL_MFUN( fileio_readline );
 CK_DLL_MFUN( fileio_readint );
 CK_DLL_MFUN( fileio_readintflags );
 CK_DLL_MFUN( fileio_readfloat );
+CK_DLL_MFUN( fileio_readfloats );
+CK_DLL_MFUN( fileio_readints );
+CK_DLL_MFUN( fileio_readintsflags );
+CK_DLL_MFUN( fileio_can_wait );
 CK_DLL_MFUN( fileio_eof );
 CK_DLL_MFUN( fileio_more );
 CK_DLL_MFUN( fileio_writestring );
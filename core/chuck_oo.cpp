@@ -37,7 +37,9 @@
 #include "chuck_instr.h"
 #include "chuck_errmsg.h"
 #include "chuck_dl.h"
+#include "util_buffers.h"
 
+#include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -46,8 +48,27 @@ using namespace std;
 
 #if defined(__PLATFORM_WIN32__)
   #include "dirent_win32.h"
+#else
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
 #endif
 
+// graveyard: pushed by any thread, emptied whole by the reaper
+#if defined(__PLATFORM_WIN32__) && !defined(__GNUC__)
+  #define CK_CAS_PTR(p,o,n) ( InterlockedCompareExchangePointer( (PVOID volatile *)(p), (n), (o) ) == (o) )
+  #define CK_SWAP_PTR(p,n) InterlockedExchangePointer( (PVOID volatile *)(p), (n) )
+  #define CK_LOAD_PTR(p) InterlockedCompareExchangePointer( (PVOID volatile *)(p), NULL, NULL )
+#else
+  #define CK_CAS_PTR(p,o,n) __sync_bool_compare_and_swap( (p), (o), (n) )
+  #define CK_SWAP_PTR(p,n) __sync_lock_test_and_set( (p), (n) )
+  #define CK_LOAD_PTR(p) __sync_fetch_and_add( (p), 0 )
+#endif
+
+// cycle collector marks
+enum { GC_BLACK = 0, GC_GRAY, GC_WHITE };
+
 
 // initialize
 t_CKBOOL Chuck_VM_Object::our_locks_in_effect = TRUE;
@@ -62,6 +83,7 @@ const t_CKINT Chuck_IO_File::FLAG_WRITEONLY = 0x20;
 const t_CKINT Chuck_IO_File::FLAG_APPEND = 0x40;
 const t_CKINT Chuck_IO_File::TYPE_ASCII = 0x80;
 const t_CKINT Chuck_IO_File::TYPE_BINARY = 0x100;
+const t_CKINT Chuck_IO_File::FLAG_MMAP = 0x200;
 
 
 
@@ -78,6 +100,14 @@ void Chuck_VM_Object::init_ref()
     m_pooled = FALSE;
     // set to not locked
     m_locked = FALSE;
+    // not on the way out
+    m_unlinked = FALSE;
+    m_next_dead = NULL;
+    // not traced until initialized as such
+    m_gc_traced = FALSE;
+    m_gc_index = -1;
+    m_gc_color = GC_BLACK;
+    m_gc_count = 0;
     // set v ref
     m_v_ref = NULL;
     // add to vm allocator
@@ -87,6 +117,19 @@ void Chuck_VM_Object::init_ref()
 
 
 
+//-----------------------------------------------------------------------------
+// name: ~Chuck_VM_Object()
+// desc: normally out of the candidate buffer already (see free_object());
+//       not if deleted directly
+//-----------------------------------------------------------------------------
+Chuck_VM_Object::~Chuck_VM_Object()
+{
+    if( m_gc_index >= 0 ) Chuck_VM_Alloc::instance()->gc_forget( this );
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: add_ref()
 // desc: add reference
@@ -144,6 +187,11 @@ void Chuck_VM_Object::release()
         // tell the object manager to set this free
         Chuck_VM_Alloc::instance()->free_object( this );
     }
+    // still referenced, perhaps only from within a cycle
+    else if( m_gc_traced && m_gc_index < 0 )
+    {
+        Chuck_VM_Alloc::instance()->gc_candidate( this );
+    }
 }
 
 
@@ -251,6 +299,21 @@ void Chuck_VM_Alloc::free_object( Chuck_VM_Object * obj )
     }
 
     // remove it from map
+    if( obj->m_gc_index >= 0 ) gc_forget( obj );
+
+    // with the reaper running, leave the destructor to it if the object
+    // can detach itself here
+    if( m_reaper && obj->unlink() )
+    {
+        Chuck_VM_Object * head;
+        obj->m_unlinked = TRUE;
+        do {
+            head = (Chuck_VM_Object *)CK_LOAD_PTR( &m_graveyard );
+            obj->m_next_dead = head;
+        } while( !CK_CAS_PTR( &m_graveyard, head, obj ) );
+        m_num_deferred++;
+        return;
+    }
 
     // delete it
     delete obj;
@@ -259,12 +322,524 @@ void Chuck_VM_Alloc::free_object( Chuck_VM_Object * obj )
 
 
 
+//-----------------------------------------------------------------------------
+// name: start_reaper()
+// desc: start the reaper thread, if not already (one per VM that asks)
+//-----------------------------------------------------------------------------
+void Chuck_VM_Alloc::start_reaper()
+{
+    if( m_reaper_refs++ > 0 ) return;
+
+    // log
+    EM_log( CK_LOG_SYSTEM, "starting object reaper..." );
+
+    m_reaper = new XThread;
+    if( !m_reaper->start( reaper_cb, this ) )
+    {
+        // destroy in place then
+        EM_log( CK_LOG_SYSTEM, "(could not start reaper thread)" );
+        SAFE_DELETE( m_reaper );
+    }
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: stop_reaper()
+// desc: destroy what is left; the last VM to stop also ends the thread
+//-----------------------------------------------------------------------------
+void Chuck_VM_Alloc::stop_reaper()
+{
+    if( !m_reaper_refs ) return;
+
+    if( --m_reaper_refs == 0 && m_reaper )
+    {
+        // log
+        EM_log( CK_LOG_SYSTEM, "stopping object reaper..." );
+
+        // stop deferring, then wait for the thread
+        XThread * reaper = m_reaper;
+        m_reaper = NULL;
+        m_reaper_stop.post();
+        reaper->wait( -1, false );
+        reaper->clear();
+        SAFE_DELETE( reaper );
+    }
+
+    // anything still waiting
+    reap();
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: reap()
+// desc: destroy everything in the graveyard
+//-----------------------------------------------------------------------------
+t_CKUINT Chuck_VM_Alloc::reap()
+{
+    t_CKUINT count = 0;
+
+    m_reap_lock.acquire();
+    Chuck_VM_Object * dead = (Chuck_VM_Object *)CK_SWAP_PTR( &m_graveyard, NULL );
+    while( dead )
+    {
+        Chuck_VM_Object * next = dead->m_next_dead;
+        delete dead;
+        dead = next;
+        count++;
+    }
+    m_reap_lock.release();
+
+    return count;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: reaper_cb()
+// desc: reaper thread; not real-time, so frees never hold up the audio
+//-----------------------------------------------------------------------------
+THREAD_RETURN ( THREAD_TYPE Chuck_VM_Alloc::reaper_cb )( void * _thiss )
+{
+    Chuck_VM_Alloc * _this = (Chuck_VM_Alloc *)_thiss;
+    t_CKUINT reaped;
+
+    // go again at once while there is work; otherwise nap, until stopped
+    do {
+        reaped = _this->reap();
+    } while( !_this->m_reaper_stop.wait( reaped ? 0 : 5 ) );
+
+    return 0;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: gc_candidate()
+// desc: buffer an object whose count dropped to nonzero; if the rest of its
+//       references come from a cycle, collect() will find it from here
+//-----------------------------------------------------------------------------
+void Chuck_VM_Alloc::gc_candidate( Chuck_VM_Object * obj )
+{
+    m_gc_lock.acquire();
+    if( obj->m_gc_index < 0 )
+    {
+        obj->m_gc_index = m_candidates.size();
+        m_candidates.push_back( obj );
+    }
+    m_gc_lock.release();
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: gc_forget()
+// desc: take an object being freed out of the candidate buffer
+//-----------------------------------------------------------------------------
+void Chuck_VM_Alloc::gc_forget( Chuck_VM_Object * obj )
+{
+    m_gc_lock.acquire();
+    if( obj->m_gc_index >= 0 )
+    {
+        // move the last one into its place
+        Chuck_VM_Object * last = m_candidates.back();
+        m_candidates[obj->m_gc_index] = last;
+        last->m_gc_index = obj->m_gc_index;
+        m_candidates.pop_back();
+        obj->m_gc_index = -1;
+    }
+    m_gc_lock.release();
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: collect()
+// desc: one collector slice: take candidates until about budget objects have
+//       been visited (0: no limit), and free the cycles that nothing outside
+//       them references. each candidate's subgraph is traced whole, so a
+//       slice may overrun the budget by that much. trial counts are kept
+//       apart from the real ones, which are never touched while marking.
+//       only counted references are traced (object members declared in
+//       chuck, object array elements); all others count as from outside.
+//       references on shred stacks (a running member function's this,
+//       temporaries) are not counted, so each shred's stacks are scanned
+//       for words that point at marked objects (see gc_scan_stacks()).
+//       the candidates of all VMs share one buffer, and each VM changes
+//       counts on its own thread, so with more than one VM running a trace
+//       could see a graph mid-change: then nothing is collected (logged
+//       once), and cycles wait until one VM is left.
+//-----------------------------------------------------------------------------
+t_CKUINT Chuck_VM_Alloc::collect( t_CKUINT budget,
+                                  const std::vector<Chuck_VM_Shred *> & shreds )
+{
+    std::vector<Chuck_VM_Object *> & roots = m_gc_roots;
+    t_CKUINT visited = 0;
+    t_CKUINT i, j;
+
+    if( m_reaper_refs > 1 )
+    {
+        if( !m_gc_paused )
+            EM_log( CK_LOG_INFO, "cycle collection paused: more than one VM running" );
+        m_gc_paused = TRUE;
+        return 0;
+    }
+    m_gc_paused = FALSE;
+    if( !m_candidates.size() ) return 0;
+
+    m_gc_lock.acquire();
+    // mark: trial-delete the references from within each candidate's graph
+    while( m_candidates.size() && ( !budget || visited < budget ) )
+    {
+        Chuck_VM_Object * root = m_candidates.back();
+        m_candidates.pop_back();
+        root->m_gc_index = -1;
+        visited += gc_mark_gray( root );
+        roots.push_back( root );
+    }
+    // stacks: what a shred holds is referenced from outside
+    gc_scan_stacks( shreds );
+    // scan: anything with a count left is referenced from outside, and is
+    // live along with all it reaches; the rest is white
+    for( i = 0; i < roots.size(); i++ )
+        gc_scan( roots[i] );
+    // gather the white
+    for( i = 0; i < roots.size(); i++ )
+        gc_collect_white( roots[i] );
+    roots.clear();
+    m_gc_lock.release();
+
+    t_CKUINT count = m_gc_white.size();
+    if( !count ) return 0;
+
+    // hold all of it, so none is freed while references among it are dropped
+    for( i = 0; i < count; i++ )
+        m_gc_white[i]->add_ref();
+    // drop the references
+    for( i = 0; i < count; i++ )
+    {
+        m_gc_slots.clear();
+        m_gc_white[i]->gc_slots( m_gc_slots );
+        for( j = 0; j < m_gc_slots.size(); j++ )
+        {
+            Chuck_VM_Object * obj = (Chuck_VM_Object *)*m_gc_slots[j];
+            *m_gc_slots[j] = 0;
+            SAFE_RELEASE( obj );
+        }
+    }
+    // let go; each goes the usual way (destructor, reaper)
+    for( i = 0; i < count; i++ )
+        m_gc_white[i]->release();
+    m_gc_white.clear();
+    m_gc_slots.clear();
+
+    // log
+    EM_log( CK_LOG_FINE, "cycle collector freed %lu objects...", count );
+
+    m_num_collected += count;
+    return count;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: gc_mark_gray()
+// desc: mark everything reachable from root gray, taking each reference
+//       from within off the trial count of what it refers to; returns the
+//       number of objects visited
+//-----------------------------------------------------------------------------
+t_CKUINT Chuck_VM_Alloc::gc_mark_gray( Chuck_VM_Object * root )
+{
+    t_CKUINT visited = 0;
+
+    if( root->m_gc_color == GC_GRAY ) return 0;
+    // locked objects are always referenced from outside
+    root->m_gc_color = GC_GRAY;
+    root->m_gc_count = root->m_ref_count + root->m_locked;
+    m_gc_gray.push_back( root );
+    m_gc_stack.push_back( root );
+
+    while( m_gc_stack.size() )
+    {
+        Chuck_VM_Object * obj = m_gc_stack.back();
+        m_gc_stack.pop_back();
+        visited++;
+
+        m_gc_slots.clear();
+        obj->gc_slots( m_gc_slots );
+        for( t_CKUINT i = 0; i < m_gc_slots.size(); i++ )
+        {
+            Chuck_VM_Object * child = (Chuck_VM_Object *)*m_gc_slots[i];
+            if( !child ) continue;
+            if( child->m_gc_color != GC_GRAY )
+            {
+                child->m_gc_color = GC_GRAY;
+                child->m_gc_count = child->m_ref_count + child->m_locked;
+                m_gc_gray.push_back( child );
+                m_gc_stack.push_back( child );
+            }
+            if( child->m_gc_count ) child->m_gc_count--;
+        }
+    }
+
+    return visited;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: gc_scan_stacks()
+// desc: give an outside reference to each gray object a shred's stacks
+//       point at: the whole reg stack in use, and the mem stack up to the
+//       arguments (and this) of the function each shred is in. locals are
+//       counted already. scanning is conservative: a word that only looks
+//       like a pointer just keeps its object until a later slice
+//-----------------------------------------------------------------------------
+void Chuck_VM_Alloc::gc_scan_stacks( const std::vector<Chuck_VM_Shred *> & shreds )
+{
+    std::vector<Chuck_VM_Object *> & gray = m_gc_gray;
+    if( !gray.size() || !shreds.size() ) { gray.clear(); return; }
+
+    std::sort( gray.begin(), gray.end() );
+    Chuck_VM_Object * lo = gray.front();
+    Chuck_VM_Object * hi = gray.back();
+
+    for( t_CKUINT i = 0; i < shreds.size(); i++ )
+    {
+        Chuck_VM_Shred * shred = shreds[i];
+        Chuck_VM_Stack * stacks[2] = { shred->reg, shred->mem };
+        for( t_CKUINT k = 0; k < 2; k++ )
+        {
+            Chuck_VM_Stack * st = stacks[k];
+            if( !st || !st->stack ) continue;
+            t_CKBYTE * end = st->sp;
+            if( st == shred->mem && shred->code )
+                end += shred->code->stack_depth;
+            if( end > st->sp_max ) end = st->sp_max;
+
+            for( t_CKUINT * w = (t_CKUINT *)st->stack; w < (t_CKUINT *)end; w++ )
+            {
+                Chuck_VM_Object * obj = (Chuck_VM_Object *)*w;
+                if( obj < lo || obj > hi ) continue;
+                if( std::binary_search( gray.begin(), gray.end(), obj ) )
+                    obj->m_gc_count++;
+            }
+        }
+    }
+
+    gray.clear();
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: gc_scan()
+// desc: from root, blacken what is referenced from outside (and all it
+//       reaches), whiten the rest
+//-----------------------------------------------------------------------------
+void Chuck_VM_Alloc::gc_scan( Chuck_VM_Object * root )
+{
+    m_gc_stack.push_back( root );
+
+    while( m_gc_stack.size() )
+    {
+        Chuck_VM_Object * obj = m_gc_stack.back();
+        m_gc_stack.pop_back();
+        if( obj->m_gc_color != GC_GRAY ) continue;
+
+        if( obj->m_gc_count )
+        {
+            gc_scan_black( obj );
+            continue;
+        }
+
+        obj->m_gc_color = GC_WHITE;
+        m_gc_slots.clear();
+        obj->gc_slots( m_gc_slots );
+        for( t_CKUINT i = 0; i < m_gc_slots.size(); i++ )
+            if( *m_gc_slots[i] )
+                m_gc_stack.push_back( (Chuck_VM_Object *)*m_gc_slots[i] );
+    }
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: gc_scan_black()
+// desc: obj is live: blacken all it reaches, giving back the trial counts
+//       taken while marking (some may have been whitened already)
+//-----------------------------------------------------------------------------
+void Chuck_VM_Alloc::gc_scan_black( Chuck_VM_Object * obj )
+{
+    // on top of gc_scan()'s stack
+    t_CKUINT base = m_gc_stack.size();
+
+    obj->m_gc_color = GC_BLACK;
+    m_gc_stack.push_back( obj );
+
+    while( m_gc_stack.size() > base )
+    {
+        Chuck_VM_Object * live = m_gc_stack.back();
+        m_gc_stack.pop_back();
+
+        m_gc_slots.clear();
+        live->gc_slots( m_gc_slots );
+        for( t_CKUINT i = 0; i < m_gc_slots.size(); i++ )
+        {
+            Chuck_VM_Object * child = (Chuck_VM_Object *)*m_gc_slots[i];
+            if( !child ) continue;
+            child->m_gc_count++;
+            if( child->m_gc_color != GC_BLACK )
+            {
+                child->m_gc_color = GC_BLACK;
+                m_gc_stack.push_back( child );
+            }
+        }
+    }
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: gc_collect_white()
+// desc: gather the white reachable from root, blackening it again
+//-----------------------------------------------------------------------------
+void Chuck_VM_Alloc::gc_collect_white( Chuck_VM_Object * root )
+{
+    m_gc_stack.push_back( root );
+
+    while( m_gc_stack.size() )
+    {
+        Chuck_VM_Object * obj = m_gc_stack.back();
+        m_gc_stack.pop_back();
+        if( obj->m_gc_color != GC_WHITE ) continue;
+
+        obj->m_gc_color = GC_BLACK;
+        m_gc_white.push_back( obj );
+        m_gc_slots.clear();
+        obj->gc_slots( m_gc_slots );
+        for( t_CKUINT i = 0; i < m_gc_slots.size(); i++ )
+            if( *m_gc_slots[i] )
+                m_gc_stack.push_back( (Chuck_VM_Object *)*m_gc_slots[i] );
+    }
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: alloc_block()
+// desc: memory for an object or its data; from the size class's pool if
+//       one is free, else from the system
+//-----------------------------------------------------------------------------
+void * Chuck_VM_Alloc::alloc_block( size_t size )
+{
+    void * block = NULL;
+    t_CKUINT c = size ? ( size + POOL_GRAIN - 1 ) / POOL_GRAIN : 1;
+
+    m_pool_lock.acquire();
+    m_num_in_use++;
+    if( c <= POOL_NUM_CLASSES && m_free[c-1] )
+    {
+        // reuse
+        block = m_free[c-1];
+        m_free[c-1] = m_free[c-1]->next;
+        m_num_free[c-1]--;
+        m_num_recycled++;
+    }
+    else
+        m_num_system_allocs++;
+    m_pool_lock.release();
+
+    // whole size class, so any block of the class can come back
+    if( !block )
+        block = ::operator new( c <= POOL_NUM_CLASSES ? c * POOL_GRAIN : size );
+
+    return block;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: free_block()
+// desc: return memory from alloc_block(), of the same size
+//-----------------------------------------------------------------------------
+void Chuck_VM_Alloc::free_block( void * block, size_t size )
+{
+    t_CKUINT c = size ? ( size + POOL_GRAIN - 1 ) / POOL_GRAIN : 1;
+
+    if( !block ) return;
+
+    m_pool_lock.acquire();
+    m_num_in_use--;
+    if( c <= POOL_NUM_CLASSES && m_num_free[c-1] < POOL_MAX_FREE )
+    {
+        // keep
+        ((Block *)block)->next = m_free[c-1];
+        m_free[c-1] = (Block *)block;
+        m_num_free[c-1]++;
+        block = NULL;
+    }
+    m_pool_lock.release();
+
+    if( block )
+        ::operator delete( block );
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: operator new / delete
+// desc: vm objects, pooled by size
+//-----------------------------------------------------------------------------
+void * Chuck_VM_Object::operator new( size_t size )
+{
+    return Chuck_VM_Alloc::instance()->alloc_block( size );
+}
+
+void Chuck_VM_Object::operator delete( void * ptr, size_t size )
+{
+    Chuck_VM_Alloc::instance()->free_block( ptr, size );
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: Chuck_VM_Alloc()
 // desc: constructor
 //-----------------------------------------------------------------------------
 Chuck_VM_Alloc::Chuck_VM_Alloc()
-{ }
+{
+    for( t_CKUINT i = 0; i < POOL_NUM_CLASSES; i++ )
+    {
+        m_free[i] = NULL;
+        m_num_free[i] = 0;
+    }
+    m_num_system_allocs = 0;
+    m_num_recycled = 0;
+    m_num_in_use = 0;
+    m_graveyard = NULL;
+    m_reaper = NULL;
+    m_reaper_refs = 0;
+    m_num_deferred = 0;
+    m_gc_paused = FALSE;
+    m_num_collected = 0;
+}
 
 
 
@@ -301,6 +876,50 @@ Chuck_Object::Chuck_Object()
 
 
 
+//-----------------------------------------------------------------------------
+// name: unlink()
+// desc: the destructor may run elsewhere unless a native dtor has to run
+//       here; the type's reference count is only ever touched here
+//-----------------------------------------------------------------------------
+t_CKBOOL Chuck_Object::unlink()
+{
+    // last reference to the type: destroy in place
+    if( !type_ref || type_ref->m_ref_count < 2 )
+        return FALSE;
+
+    // native dtors that free more than their own memory
+    for( Chuck_Type * type = type_ref; type != NULL; type = type->parent )
+        if( type->has_destructor && !type->dtor_async )
+            return FALSE;
+
+    // what has to happen here, from child to parent
+    for( Chuck_Type * type = type_ref; type != NULL; type = type->parent )
+        if( type->dtor_unlink )
+            type->dtor_unlink( this, NULL, Chuck_DL_Api::Api::instance() );
+
+    // the type outlives us (it is held elsewhere); the dtors still read it
+    type_ref->release();
+
+    return TRUE;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: gc_slots()
+// desc: object members declared in chuck, for the cycle collector
+//-----------------------------------------------------------------------------
+void Chuck_Object::gc_slots( std::vector<t_CKUINT *> & slots )
+{
+    for( Chuck_Type * type = type_ref; type != NULL; type = type->parent )
+        for( t_CKUINT i = 0; i < type->obj_mvar_offsets.size(); i++ )
+            slots.push_back( (t_CKUINT *)(data + type->obj_mvar_offsets[i]) );
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: Chuck_Object()
 // desc: ...
@@ -324,10 +943,12 @@ Chuck_Object::~Chuck_Object()
         type = type->parent;
     }
     
-    // free
-    if( vtable ) { delete vtable; vtable = NULL; }
-    if( type_ref ) { type_ref->release(); type_ref = NULL; }
-    if( data ) { delete [] data; size = 0; data = NULL; }
+    // free (the vtable is the type's, shared; the type was already
+    // released if unlink() ran)
+    vtable = NULL;
+    if( type_ref && !m_unlinked ) type_ref->release();
+    type_ref = NULL;
+    if( data ) { Chuck_VM_Alloc::instance()->free_block( data, size ); size = 0; data = NULL; }
 }
 
 
@@ -341,6 +962,8 @@ Chuck_Array4::Chuck_Array4( t_CKBOOL is_obj, t_CKINT capacity )
 {
     // sanity check
     assert( capacity >= 0 );
+    // no associative part until used
+    m_map = NULL;
     // set size
     m_vector.resize( capacity );
     // clear (as non-object, so no releases)
@@ -348,6 +971,8 @@ Chuck_Array4::Chuck_Array4( t_CKBOOL is_obj, t_CKINT capacity )
     this->zero( 0, m_vector.capacity() );
     // is object (set after clear)
     m_is_obj = is_obj;
+    // elements may close a cycle
+    m_gc_traced = is_obj;
 }
 
 
@@ -359,24 +984,26 @@ Chuck_Array4::Chuck_Array4( t_CKBOOL is_obj, t_CKINT capacity )
 //-----------------------------------------------------------------------------
 Chuck_Array4::~Chuck_Array4()
 {
-    // do nothing
+    // associative part
+    SAFE_DELETE( m_map );
 }
 
 
 
 
 //-----------------------------------------------------------------------------
-// name: addr()
-// desc: ...
+// name: gc_slots()
+// desc: elements, if objects, for the cycle collector
 //-----------------------------------------------------------------------------
-t_CKUINT Chuck_Array4::addr( t_CKINT i )
+void Chuck_Array4::gc_slots( std::vector<t_CKUINT *> & slots )
 {
-    // bound check
-    if( i < 0 || i >= m_vector.capacity() )
-        return 0;
+    if( !m_is_obj ) return;
 
-    // get the addr
-    return (t_CKUINT)(&m_vector[i]);
+    for( t_CKUINT i = 0; i < m_vector.size(); i++ )
+        slots.push_back( &m_vector[i] );
+    if( !m_map ) return;
+    for( std::map<std::string, t_CKUINT>::iterator it = m_map->begin(); it != m_map->end(); it++ )
+        slots.push_back( &it->second );
 }
 
 
@@ -389,27 +1016,7 @@ t_CKUINT Chuck_Array4::addr( t_CKINT i )
 t_CKUINT Chuck_Array4::addr( const string & key )
 {
     // get the addr
-    return (t_CKUINT)(&m_map[key]);
-}
-
-
-
-
-//-----------------------------------------------------------------------------
-// name: get()
-// desc: ...
-//-----------------------------------------------------------------------------
-t_CKINT Chuck_Array4::get( t_CKINT i, t_CKUINT * val )
-{
-    // bound check
-    if( i < 0 || i >= m_vector.capacity() )
-        return 0;
-
-    // get the value
-    *val = m_vector[i];
-
-    // return good
-    return 1;
+    return (t_CKUINT)(&assoc()[key]);
 }
 
 
@@ -424,9 +1031,11 @@ t_CKINT Chuck_Array4::get( const string & key, t_CKUINT * val )
     // set to zero
     *val = 0;
     // find
-    map<string, t_CKUINT>::iterator iter = m_map.find( key );
+    // no string key used yet
+    if( !m_map ) return 1;
+    map<string, t_CKUINT>::iterator iter = m_map->find( key );
     // check
-    if( iter != m_map.end() ) *val = (*iter).second;
+    if( iter != m_map->end() ) *val = (*iter).second;
 
     // return good
     return 1;
@@ -442,7 +1051,7 @@ t_CKINT Chuck_Array4::get( const string & key, t_CKUINT * val )
 t_CKINT Chuck_Array4::set( t_CKINT i, t_CKUINT val )
 {
     // bound check
-    if( i < 0 || i >= m_vector.capacity() )
+    if( (t_CKUINT)i >= m_vector.size() )
         return 0;
 
     t_CKUINT v = m_vector[i];
@@ -470,14 +1079,17 @@ t_CKINT Chuck_Array4::set( t_CKINT i, t_CKUINT val )
 //-----------------------------------------------------------------------------
 t_CKINT Chuck_Array4::set( const string & key, t_CKUINT val )
 {
-    map<string, t_CKUINT>::iterator iter = m_map.find( key );
+    // nothing to remove, if no string key used yet
+    if( !val && !m_map ) return 1;
+
+    map<string, t_CKUINT>::iterator iter = assoc().find( key );
 
     // if obj
-    if( m_is_obj && iter != m_map.end() ) 
+    if( m_is_obj && iter != m_map->end() ) 
         ((Chuck_Object *)(*iter).second)->release();
 
-    if( !val ) m_map.erase( key );
-    else m_map[key] = val;
+    if( !val ) m_map->erase( key );
+    else (*m_map)[key] = val;
 
     // if obj
     if( m_is_obj && val ) ((Chuck_Object *)val)->add_ref();
@@ -495,7 +1107,7 @@ t_CKINT Chuck_Array4::set( const string & key, t_CKUINT val )
 //-----------------------------------------------------------------------------
 t_CKINT Chuck_Array4::find( const string & key )
 {
-    return m_map.find( key ) != m_map.end();
+    return m_map && m_map->find( key ) != m_map->end();
 }
 
 
@@ -507,15 +1119,18 @@ t_CKINT Chuck_Array4::find( const string & key )
 //-----------------------------------------------------------------------------
 t_CKINT Chuck_Array4::erase( const string & key )
 {
-    map<string, t_CKUINT>::iterator iter = m_map.find( key );
-    t_CKINT v = iter != m_map.end();
+    // no string key used yet
+    if( !m_map ) return 0;
+
+    map<string, t_CKUINT>::iterator iter = m_map->find( key );
+    t_CKINT v = iter != m_map->end();
 
     // if obj
-    if( m_is_obj && iter != m_map.end() ) 
+    if( m_is_obj && v ) 
         ((Chuck_Object *)(*iter).second)->release();
 
     // erase
-    if( v ) m_map.erase( key );
+    if( v ) m_map->erase( iter );
 
     return v;
 }
@@ -706,6 +1321,8 @@ Chuck_Array8::Chuck_Array8( t_CKINT capacity )
 {
     // sanity check
     assert( capacity >= 0 );
+    // no associative part until used
+    m_map = NULL;
     // set size
     m_vector.resize( capacity );
     // clear
@@ -721,24 +1338,8 @@ Chuck_Array8::Chuck_Array8( t_CKINT capacity )
 //-----------------------------------------------------------------------------
 Chuck_Array8::~Chuck_Array8()
 {
-    // do nothing
-}
-
-
-
-
-//-----------------------------------------------------------------------------
-// name: addr()
-// desc: ...
-//-----------------------------------------------------------------------------
-t_CKUINT Chuck_Array8::addr( t_CKINT i )
-{
-    // bound check
-    if( i < 0 || i >= m_vector.capacity() )
-        return 0;
-
-    // get the addr
-    return (t_CKUINT)(&m_vector[i]);
+    // associative part
+    SAFE_DELETE( m_map );
 }
 
 
@@ -751,27 +1352,7 @@ t_CKUINT Chuck_Array8::addr( t_CKINT i )
 t_CKUINT Chuck_Array8::addr( const string & key )
 {
     // get the addr
-    return (t_CKUINT)(&m_map[key]);
-}
-
-
-
-
-//-----------------------------------------------------------------------------
-// name: get()
-// desc: ...
-//-----------------------------------------------------------------------------
-t_CKINT Chuck_Array8::get( t_CKINT i, t_CKFLOAT * val )
-{
-    // bound check
-    if( i < 0 || i >= m_vector.capacity() )
-        return 0;
-
-    // get the value
-    *val = m_vector[i];
-
-    // return good
-    return 1;
+    return (t_CKUINT)(&assoc()[key]);
 }
 
 
@@ -787,10 +1368,12 @@ t_CKINT Chuck_Array8::get( const string & key, t_CKFLOAT * val )
     *val = 0.0;
 
     // iterator
-    map<string, t_CKFLOAT>::iterator iter = m_map.find( key );
+    // no string key used yet
+    if( !m_map ) return 1;
+    map<string, t_CKFLOAT>::iterator iter = m_map->find( key );
 
     // check
-    if( iter != m_map.end() )
+    if( iter != m_map->end() )
     {
         // get the value
         *val = (*iter).second;
@@ -810,7 +1393,7 @@ t_CKINT Chuck_Array8::get( const string & key, t_CKFLOAT * val )
 t_CKINT Chuck_Array8::set( t_CKINT i, t_CKFLOAT val )
 {
     // bound check
-    if( i < 0 || i >= m_vector.capacity() )
+    if( (t_CKUINT)i >= m_vector.size() )
         return 0;
 
     // set the value
@@ -836,7 +1419,7 @@ t_CKINT Chuck_Array8::set( const string & key, t_CKFLOAT val )
     // if( !val ) m_map.erase( key ); else
     
     // insert
-    m_map[key] = val;
+    assoc()[key] = val;
 
     // return good
     return 1;
@@ -851,7 +1434,7 @@ t_CKINT Chuck_Array8::set( const string & key, t_CKFLOAT val )
 //-----------------------------------------------------------------------------
 t_CKINT Chuck_Array8::find( const string & key )
 {
-    return m_map.find( key ) != m_map.end();
+    return m_map && m_map->find( key ) != m_map->end();
 }
 
 
@@ -862,7 +1445,7 @@ t_CKINT Chuck_Array8::find( const string & key )
 //-----------------------------------------------------------------------------
 t_CKINT Chuck_Array8::erase( const string & key )
 {
-    return m_map.erase( key );
+    return m_map ? m_map->erase( key ) : 0;
 }
 
 
@@ -1018,6 +1601,8 @@ Chuck_Array16::Chuck_Array16( t_CKINT capacity )
 {
     // sanity check
     assert( capacity >= 0 );
+    // no associative part until used
+    m_map = NULL;
     // set size
     m_vector.resize( capacity );
     // clear
@@ -1033,24 +1618,8 @@ Chuck_Array16::Chuck_Array16( t_CKINT capacity )
 //-----------------------------------------------------------------------------
 Chuck_Array16::~Chuck_Array16()
 {
-    // do nothing
-}
-
-
-
-
-//-----------------------------------------------------------------------------
-// name: addr()
-// desc: ...
-//-----------------------------------------------------------------------------
-t_CKUINT Chuck_Array16::addr( t_CKINT i )
-{
-    // bound check
-    if( i < 0 || i >= m_vector.capacity() )
-        return 0;
-
-    // get the addr
-    return (t_CKUINT)(&m_vector[i]);
+    // associative part
+    SAFE_DELETE( m_map );
 }
 
 
@@ -1063,27 +1632,7 @@ t_CKUINT Chuck_Array16::addr( t_CKINT i )
 t_CKUINT Chuck_Array16::addr( const string & key )
 {
     // get the addr
-    return (t_CKUINT)(&m_map[key]);
-}
-
-
-
-
-//-----------------------------------------------------------------------------
-// name: get()
-// desc: ...
-//-----------------------------------------------------------------------------
-t_CKINT Chuck_Array16::get( t_CKINT i, t_CKCOMPLEX * val )
-{
-    // bound check
-    if( i < 0 || i >= m_vector.capacity() )
-        return 0;
-
-    // get the value
-    *val = m_vector[i];
-
-    // return good
-    return 1;
+    return (t_CKUINT)(&assoc()[key]);
 }
 
 
@@ -1100,10 +1649,12 @@ t_CKINT Chuck_Array16::get( const string & key, t_CKCOMPLEX * val )
     val->im = 0.0;
 
     // iterator
-    map<string, t_CKCOMPLEX>::iterator iter = m_map.find( key );
+    // no string key used yet
+    if( !m_map ) return 1;
+    map<string, t_CKCOMPLEX>::iterator iter = m_map->find( key );
 
     // check
-    if( iter != m_map.end() )
+    if( iter != m_map->end() )
     {
         // get the value
         *val = (*iter).second;
@@ -1123,7 +1674,7 @@ t_CKINT Chuck_Array16::get( const string & key, t_CKCOMPLEX * val )
 t_CKINT Chuck_Array16::set( t_CKINT i, const t_CKCOMPLEX & val )
 {
     // bound check
-    if( i < 0 || i >= m_vector.capacity() )
+    if( (t_CKUINT)i >= m_vector.size() )
         return 0;
 
     // set the value
@@ -1147,7 +1698,7 @@ t_CKINT Chuck_Array16::set( const string & key, const t_CKCOMPLEX & val )
 
     // 1.3.5.3: removed this
     // if( val.re == 0 && val.im == 0 ) m_map.erase( key ); else
-    m_map[key] = val;
+    assoc()[key] = val;
 
     // return good
     return 1;
@@ -1162,7 +1713,7 @@ t_CKINT Chuck_Array16::set( const string & key, const t_CKCOMPLEX & val )
 //-----------------------------------------------------------------------------
 t_CKINT Chuck_Array16::find( const string & key )
 {
-    return m_map.find( key ) != m_map.end();
+    return m_map && m_map->find( key ) != m_map->end();
 }
 
 
@@ -1173,7 +1724,7 @@ t_CKINT Chuck_Array16::find( const string & key )
 //-----------------------------------------------------------------------------
 t_CKINT Chuck_Array16::erase( const string & key )
 {
-    return m_map.erase( key );
+    return m_map ? m_map->erase( key ) : 0;
 }
 
 
@@ -1331,6 +1882,8 @@ Chuck_Array24::Chuck_Array24( t_CKINT capacity )
 {
     // sanity check
     assert( capacity >= 0 );
+    // no associative part until used
+    m_map = NULL;
     // set size
     m_vector.resize( capacity );
     // clear
@@ -1344,59 +1897,23 @@ Chuck_Array24::Chuck_Array24( t_CKINT capacity )
 // name: ~Chuck_Array24()
 // desc: destructor
 //-----------------------------------------------------------------------------
-Chuck_Array24::~Chuck_Array24()
-{
-    // do nothing
-}
-
-
-
-
-//-----------------------------------------------------------------------------
-// name: addr()
-// desc: ...
-//-----------------------------------------------------------------------------
-t_CKUINT Chuck_Array24::addr( t_CKINT i )
-{
-    // bound check
-    if( i < 0 || i >= m_vector.capacity() )
-        return 0;
-    
-    // get the addr
-    return (t_CKUINT)(&m_vector[i]);
-}
-
-
-
-
-//-----------------------------------------------------------------------------
-// name: addr()
-// desc: ...
-//-----------------------------------------------------------------------------
-t_CKUINT Chuck_Array24::addr( const string & key )
+Chuck_Array24::~Chuck_Array24()
 {
-    // get the addr
-    return (t_CKUINT)(&m_map[key]);
+    // associative part
+    SAFE_DELETE( m_map );
 }
 
 
 
 
 //-----------------------------------------------------------------------------
-// name: get()
+// name: addr()
 // desc: ...
 //-----------------------------------------------------------------------------
-t_CKINT Chuck_Array24::get( t_CKINT i, t_CKVEC3 * val )
+t_CKUINT Chuck_Array24::addr( const string & key )
 {
-    // bound check
-    if( i < 0 || i >= m_vector.capacity() )
-        return 0;
-    
-    // get the value
-    *val = m_vector[i];
-    
-    // return good
-    return 1;
+    // get the addr
+    return (t_CKUINT)(&assoc()[key]);
 }
 
 
@@ -1412,10 +1929,12 @@ t_CKINT Chuck_Array24::get( const string & key, t_CKVEC3 * val )
     val->x = val->y = val->z = 0;
     
     // iterator
-    map<string, t_CKVEC3>::iterator iter = m_map.find( key );
+    // no string key used yet
+    if( !m_map ) return 1;
+    map<string, t_CKVEC3>::iterator iter = m_map->find( key );
     
     // check
-    if( iter != m_map.end() )
+    if( iter != m_map->end() )
     {
         // get the value
         *val = (*iter).second;
@@ -1435,7 +1954,7 @@ t_CKINT Chuck_Array24::get( const string & key, t_CKVEC3 * val )
 t_CKINT Chuck_Array24::set( t_CKINT i, const t_CKVEC3 & val )
 {
     // bound check
-    if( i < 0 || i >= m_vector.capacity() )
+    if( (t_CKUINT)i >= m_vector.size() )
         return 0;
     
     // set the value
@@ -1458,7 +1977,7 @@ t_CKINT Chuck_Array24::set( const string & key, const t_CKVEC3 & val )
     // map<string, t_CKVEC3>::iterator iter = m_map.find( key );
     
     // insert
-    m_map[key] = val;
+    assoc()[key] = val;
     
     // return good
     return 1;
@@ -1473,7 +1992,7 @@ t_CKINT Chuck_Array24::set( const string & key, const t_CKVEC3 & val )
 //-----------------------------------------------------------------------------
 t_CKINT Chuck_Array24::find( const string & key )
 {
-    return m_map.find( key ) != m_map.end();
+    return m_map && m_map->find( key ) != m_map->end();
 }
 
 
@@ -1484,7 +2003,7 @@ t_CKINT Chuck_Array24::find( const string & key )
 //-----------------------------------------------------------------------------
 t_CKINT Chuck_Array24::erase( const string & key )
 {
-    return m_map.erase( key );
+    return m_map ? m_map->erase( key ) : 0;
 }
 
 
@@ -1644,6 +2163,8 @@ Chuck_Array32::Chuck_Array32( t_CKINT capacity )
 {
     // sanity check
     assert( capacity >= 0 );
+    // no associative part until used
+    m_map = NULL;
     // set size
     m_vector.resize( capacity );
     // clear
@@ -1659,24 +2180,8 @@ Chuck_Array32::Chuck_Array32( t_CKINT capacity )
 //-----------------------------------------------------------------------------
 Chuck_Array32::~Chuck_Array32()
 {
-    // do nothing
-}
-
-
-
-
-//-----------------------------------------------------------------------------
-// name: addr()
-// desc: ...
-//-----------------------------------------------------------------------------
-t_CKUINT Chuck_Array32::addr( t_CKINT i )
-{
-    // bound check
-    if( i < 0 || i >= m_vector.capacity() )
-        return 0;
-    
-    // get the addr
-    return (t_CKUINT)(&m_vector[i]);
+    // associative part
+    SAFE_DELETE( m_map );
 }
 
 
@@ -1689,27 +2194,7 @@ t_CKUINT Chuck_Array32::addr( t_CKINT i )
 t_CKUINT Chuck_Array32::addr( const string & key )
 {
     // get the addr
-    return (t_CKUINT)(&m_map[key]);
-}
-
-
-
-
-//-----------------------------------------------------------------------------
-// name: get()
-// desc: ...
-//-----------------------------------------------------------------------------
-t_CKINT Chuck_Array32::get( t_CKINT i, t_CKVEC4 * val )
-{
-    // bound check
-    if( i < 0 || i >= m_vector.capacity() )
-        return 0;
-    
-    // get the value
-    *val = m_vector[i];
-    
-    // return good
-    return 1;
+    return (t_CKUINT)(&assoc()[key]);
 }
 
 
@@ -1725,10 +2210,12 @@ t_CKINT Chuck_Array32::get( const string & key, t_CKVEC4 * val )
     val->x = val->y = val->z = val->w;
     
     // iterator
-    map<string, t_CKVEC4>::iterator iter = m_map.find( key );
+    // no string key used yet
+    if( !m_map ) return 1;
+    map<string, t_CKVEC4>::iterator iter = m_map->find( key );
     
     // check
-    if( iter != m_map.end() )
+    if( iter != m_map->end() )
     {
         // get the value
         *val = (*iter).second;
@@ -1748,7 +2235,7 @@ t_CKINT Chuck_Array32::get( const string & key, t_CKVEC4 * val )
 t_CKINT Chuck_Array32::set( t_CKINT i, const t_CKVEC4 & val )
 {
     // bound check
-    if( i < 0 || i >= m_vector.capacity() )
+    if( (t_CKUINT)i >= m_vector.size() )
         return 0;
     
     // set the value
@@ -1774,7 +2261,7 @@ t_CKINT Chuck_Array32::set( const string & key, const t_CKVEC4 & val )
     // if( val.re == 0 && val.im == 0 ) m_map.erase( key ); else
 
     // insert
-    m_map[key] = val;
+    assoc()[key] = val;
     
     // return good
     return 1;
@@ -1789,7 +2276,7 @@ t_CKINT Chuck_Array32::set( const string & key, const t_CKVEC4 & val )
 //-----------------------------------------------------------------------------
 t_CKINT Chuck_Array32::find( const string & key )
 {
-    return m_map.find( key ) != m_map.end();
+    return m_map && m_map->find( key ) != m_map->end();
 }
 
 
@@ -1800,7 +2287,7 @@ t_CKINT Chuck_Array32::find( const string & key )
 //-----------------------------------------------------------------------------
 t_CKINT Chuck_Array32::erase( const string & key )
 {
-    return m_map.erase( key );
+    return m_map ? m_map->erase( key ) : 0;
 }
 
 
@@ -2001,7 +2488,7 @@ void Chuck_Event::signal()
 //-----------------------------------------------------------------------------
 t_CKBOOL Chuck_Event::remove( Chuck_VM_Shred * shred )
 {
-    queue<Chuck_VM_Shred *> temp;
+    Shred_Queue temp;
     t_CKBOOL removed = FALSE;
 
     // lock
@@ -2182,9 +2669,12 @@ Chuck_IO_File::Chuck_IO_File( Chuck_VM * vm )
     m_path = "";
     m_dir = NULL;
     m_dir_start = 0;
-    m_asyncEvent = new Chuck_Event;
-    initialize_object( m_asyncEvent, vm->env()->t_event );
-    m_thread = new XThread;
+    m_asyncPending = 0;
+    m_asyncWaiting = FALSE;
+    m_asyncBuffer = NULL;
+    m_mmapBuf = NULL;
+    m_mmapBase = NULL;
+    m_mmapSize = 0;
 }
 
 
@@ -2196,10 +2686,97 @@ Chuck_IO_File::Chuck_IO_File( Chuck_VM * vm )
 //-----------------------------------------------------------------------------
 Chuck_IO_File::~Chuck_IO_File()
 {
-    // clean up
+    // clean up (waits for queued operations, frees them)
     this->close();
-    delete m_asyncEvent;
-    delete m_thread;
+    if( m_asyncBuffer ) m_vmRef->destroy_event_buffer( m_asyncBuffer );
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: struct Chuck_IO_MemBuf
+// desc: read-only stream buffer over a memory-mapped file
+//-----------------------------------------------------------------------------
+struct Chuck_IO_MemBuf : public std::streambuf
+{
+    Chuck_IO_MemBuf( char * base, size_t size )
+    { setg( base, base, base + size ); }
+
+protected:
+    virtual pos_type seekoff( off_type off, std::ios_base::seekdir dir,
+                              std::ios_base::openmode which )
+    {
+        char * p = dir == std::ios_base::beg ? eback() + off :
+                   dir == std::ios_base::cur ? gptr() + off : egptr() + off;
+        if( p < eback() || p > egptr() ) return pos_type( off_type(-1) );
+        setg( eback(), p, egptr() );
+        return pos_type( p - eback() );
+    }
+
+    virtual pos_type seekpos( pos_type pos, std::ios_base::openmode which )
+    { return seekoff( off_type(pos), std::ios_base::beg, which ); }
+};
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: mmap_open()
+// desc: map the open file and read from the mapping from here on
+//-----------------------------------------------------------------------------
+t_CKBOOL Chuck_IO_File::mmap_open()
+{
+#ifndef __PLATFORM_WIN32__
+    int fd = ::open( m_path.c_str(), O_RDONLY );
+    if( fd < 0 ) return FALSE;
+
+    struct stat st;
+    if( fstat( fd, &st ) != 0 || st.st_size == 0 )
+    {
+        ::close( fd );
+        return FALSE;
+    }
+
+    void * base = ::mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0 );
+    ::close( fd );
+    if( base == MAP_FAILED ) return FALSE;
+
+    // mostly read front to back
+    madvise( base, st.st_size, MADV_SEQUENTIAL );
+
+    m_mmapBase = base;
+    m_mmapSize = st.st_size;
+    m_mmapBuf = new Chuck_IO_MemBuf( (char *)base, st.st_size );
+    // the fstream keeps its file open (for is_open) but reads go to the mapping
+    static_cast<std::ios &>( m_io ).rdbuf( m_mmapBuf );
+
+    return TRUE;
+#else
+    // not available; regular reads
+    return FALSE;
+#endif
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: mmap_close()
+// desc: ...
+//-----------------------------------------------------------------------------
+void Chuck_IO_File::mmap_close()
+{
+#ifndef __PLATFORM_WIN32__
+    if( !m_mmapBuf ) return;
+
+    // back to the file buffer
+    static_cast<std::ios &>( m_io ).rdbuf( m_io.rdbuf() );
+    SAFE_DELETE( m_mmapBuf );
+    ::munmap( m_mmapBase, m_mmapSize );
+    m_mmapBase = NULL;
+    m_mmapSize = 0;
+#endif
 }
 
 
@@ -2275,6 +2852,13 @@ t_CKBOOL Chuck_IO_File::open( const string & path, t_CKINT flags )
         EM_error3( "[chuck](via FileIO): conflicting flags: APPEND and FLAG_READ" );
         goto error;
     }
+
+    if ((flags & FLAG_MMAP) &&
+        !(flags & FLAG_READONLY))
+    {
+        EM_error3( "[chuck](via FileIO): MMAP requires READ only" );
+        goto error;
+    }
     
     // set open flags
     ios_base::openmode mode;
@@ -2346,6 +2930,14 @@ t_CKBOOL Chuck_IO_File::open( const string & path, t_CKINT flags )
     
     // set path
     m_path = path;
+
+    // map the file if asked; falls back to regular reads
+    if( (flags & FLAG_MMAP) && !mmap_open() )
+    {
+        EM_log( CK_LOG_INFO, "FileIO: cannot map '%s'; reading normally", path.c_str() );
+        flags &= ~FLAG_MMAP;
+    }
+
     // set flags
     m_flags = flags;
     if (!(flags & TYPE_BINARY))
@@ -2384,6 +2976,10 @@ void Chuck_IO_File::close()
 {
     // log
     EM_log( CK_LOG_INFO, "FileIO: closing file '%s'...", m_path.c_str() );
+    // finish queued operations first
+    async_wait();
+    // unmap
+    mmap_close();
     // close it
     m_io.close();
     m_flags = 0;
@@ -2466,6 +3062,8 @@ void Chuck_IO_File::mode( t_CKINT flag )
         return;
     }
     
+    // back to sync: queued operations come first
+    if( flag == Chuck_IO::MODE_SYNC ) async_wait();
     m_iomode = flag;
 }
 
@@ -2844,6 +3442,168 @@ t_CKBOOL Chuck_IO_File::readString( std::string & str )
 
 
 
+//-----------------------------------------------------------------------------
+// name: chuck_io_parse()
+// desc: parse one number at p, advancing p; FALSE if none
+//-----------------------------------------------------------------------------
+static inline t_CKBOOL chuck_io_parse( const char * & p, t_CKFLOAT & out )
+{ char * e; out = strtod( p, &e ); if( e == p ) return FALSE; p = e; return TRUE; }
+static inline t_CKBOOL chuck_io_parse( const char * & p, t_CKINT & out )
+{ char * e; out = strtol( p, &e, 10 ); if( e == p ) return FALSE; p = e; return TRUE; }
+
+static inline t_CKBOOL chuck_io_is_sep( char c )
+{ return isspace( (unsigned char)c ) || c == ',' || c == ';'; }
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: chuck_io_read_ascii()
+// desc: read up to n whitespace/comma/semicolon separated numbers; reads the
+//       stream in blocks and parses in place instead of one `>>` per value,
+//       then seeks back over whatever was read but not consumed
+//-----------------------------------------------------------------------------
+template <typename T>
+static t_CKINT chuck_io_read_ascii( std::iostream & io, T * dest, t_CKINT n )
+{
+    const t_CKINT CAP = 65536;
+    std::vector<char> buffer( CAP + 1 );
+    char * buf = &buffer[0];
+    t_CKINT len = 0, count = 0;
+    t_CKBOOL atEnd = FALSE, done = FALSE;
+
+    while( !done )
+    {
+        // fill behind whatever is left over from the last block
+        io.read( buf + len, CAP - len );
+        t_CKINT got = io.gcount();
+        atEnd = got < CAP - len;
+        len += got;
+        buf[len] = '\0';
+
+        const char * p = buf;
+        const char * end = buf + len;
+        while( count < n )
+        {
+            while( p < end && chuck_io_is_sep( *p ) ) p++;
+            if( p == end ) break;
+            // token may continue in the next block
+            const char * q = p;
+            while( q < end && !chuck_io_is_sep( *q ) ) q++;
+            if( q == end && !atEnd ) break;
+            if( !chuck_io_parse( p, dest[count] ) ) { done = TRUE; break; }
+            count++;
+        }
+
+        // keep the unconsumed tail
+        len = end - p;
+        memmove( buf, p, len );
+        if( count >= n || atEnd || len == CAP ) done = TRUE;
+    }
+
+    // give back what was read ahead (eof stays set if everything was used)
+    if( len > 0 )
+    {
+        io.clear();
+        io.seekg( -(std::streamoff)len, std::ios_base::cur );
+    }
+
+    return count;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: readFloats()
+// desc: read up to n floats into dest; ASCII values may be separated by
+//       whitespace, commas, or semicolons
+//-----------------------------------------------------------------------------
+t_CKINT Chuck_IO_File::readFloats( t_CKFLOAT * dest, t_CKINT n )
+{
+    // sanity
+    if (!(m_io.is_open())) {
+        EM_error3( "[chuck](via FileIO): cannot readFloats: no file open" );
+        return 0;
+    }
+    
+    if ( m_dir )
+    {
+        EM_error3( "[chuck](via FileIO): cannot read a directory" );
+        return 0;
+    }
+    
+    if (m_io.eof() || m_io.fail() || n <= 0)
+        return 0;
+    
+    t_CKINT count = 0;
+    if (m_flags & TYPE_BINARY) {
+        // binary: straight into the destination
+        m_io.read( (char *)dest, n * sizeof(t_CKFLOAT) );
+        count = m_io.gcount() / sizeof(t_CKFLOAT);
+    } else {
+        // ASCII: parse a chunk at a time
+        count = chuck_io_read_ascii( m_io, dest, n );
+    }
+    
+    return count;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: readInts()
+// desc: read up to n ints into dest; binary width from flags
+//-----------------------------------------------------------------------------
+t_CKINT Chuck_IO_File::readInts( t_CKINT * dest, t_CKINT n, t_CKINT flags )
+{
+    // sanity
+    if (!(m_io.is_open())) {
+        EM_error3( "[chuck](via FileIO): cannot readInts: no file open" );
+        return 0;
+    }
+    
+    if ( m_dir )
+    {
+        EM_error3( "[chuck](via FileIO): cannot read a directory" );
+        return 0;
+    }
+    
+    if (m_io.eof() || m_io.fail() || n <= 0)
+        return 0;
+    
+    t_CKINT count = 0;
+    if (m_flags & TYPE_BINARY) {
+        // read packed values in chunks, then widen
+        char buf[4096];
+        t_CKINT width = (flags & Chuck_IO::INT8) ? 1 : (flags & Chuck_IO::INT16) ? 2 : 4;
+        while( count < n )
+        {
+            t_CKINT want = ( n - count ) * width;
+            if( want > (t_CKINT)sizeof(buf) ) want = sizeof(buf);
+            m_io.read( buf, want );
+            t_CKINT got = m_io.gcount() / width;
+            for( t_CKINT i = 0; i < got; i++ )
+            {
+                if( width == 1 ) dest[count+i] = ((signed char *)buf)[i];
+                else if( width == 2 ) dest[count+i] = ((short *)buf)[i];
+                else dest[count+i] = ((int *)buf)[i];
+            }
+            count += got;
+            if( got * width < want ) break;
+        }
+    } else {
+        // ASCII: parse a chunk at a time
+        count = chuck_io_read_ascii( m_io, dest, n );
+    }
+    
+    return count;
+}
+
+
+
+
 /* (ATODO: doesn't look like asynchronous reads will work)
  
  THREAD_RETURN ( THREAD_TYPE Chuck_IO_File::read_thread ) ( void *data )
@@ -3069,36 +3829,211 @@ void Chuck_IO_File::write( t_CKFLOAT val )
 
 
 
-// static helper functions for writing asynchronously
-THREAD_RETURN ( THREAD_TYPE Chuck_IO_File::writeStr_thread ) ( void *data )
+//-----------------------------------------------------------------------------
+// name: start_async()
+// desc: queue an operation for the shared I/O pool; returns right away
+//-----------------------------------------------------------------------------
+void Chuck_IO_File::start_async( XThreadPool::Job job, async_args * args )
 {
-    async_args *args = (async_args *)data;
-    args->fileio_obj->write ( args->stringArg );
-    Chuck_Event *e = args->fileio_obj->m_asyncEvent;
-    delete args;
-    e->broadcast(); // wake up
+    // keep this read's array alive until the result is copied in
+    if( args->arrayArg ) args->arrayArg->add_ref();
+    // completions come back through this, read by the VM
+    if( !m_asyncBuffer ) m_asyncBuffer = m_vmRef->create_event_buffer();
     
-    return (THREAD_RETURN)0;
+    args->job = job;
+    
+    m_asyncLock.acquire();
+    m_asyncQueue.push_back( args );
+    // start a drain unless one is running
+    t_CKBOOL start = ( m_asyncPending++ == 0 );
+    m_asyncLock.release();
+    
+    if( start ) XThreadPool::shared()->submit( async_drain, this );
 }
 
-THREAD_RETURN ( THREAD_TYPE Chuck_IO_File::writeInt_thread ) ( void *data )
+
+
+
+//-----------------------------------------------------------------------------
+// name: async_drain()
+// desc: run queued operations in order; at most one drain per file
+//-----------------------------------------------------------------------------
+void Chuck_IO_File::async_drain( void * data )
 {
-    async_args *args = (async_args *)data;
-    args->fileio_obj->write ( args->intArg );
-    args->fileio_obj->m_asyncEvent->broadcast(); // wake up
-    delete args;
+    Chuck_IO_File * f = (Chuck_IO_File *)data;
+    
+    while( true )
+    {
+        f->m_asyncLock.acquire();
+        async_args * args = f->m_asyncQueue.front();
+        f->m_asyncLock.release();
+        
+        // do it
+        args->job( args );
+        
+        f->m_asyncLock.acquire();
+        f->m_asyncQueue.pop_front();
+        // results go to the VM side with the completion
+        f->m_asyncDone.push_back( args );
+        t_CKBOOL done = ( f->m_asyncPending == 1 );
+        // all done: wake waiting shreds, on the VM side; posted before the
+        // count drops so can_wait() never sees neither (and under the lock
+        // so the file can't go away first)
+        if( done ) f->m_vmRef->queue_event( f, 1, f->m_asyncBuffer );
+        f->m_asyncPending--;
+        // and whoever is blocked in async_wait()
+        if( done && f->m_asyncWaiting )
+        {
+            f->m_asyncWaiting = FALSE;
+            f->m_asyncIdle.post();
+        }
+        f->m_asyncLock.release();
+        
+        if( done ) break;
+    }
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: async_wait()
+// desc: VM side; block until queued operations are done
+//-----------------------------------------------------------------------------
+void Chuck_IO_File::async_wait()
+{
+    m_asyncLock.acquire();
+    t_CKBOOL busy = m_asyncPending > 0;
+    if( busy ) m_asyncWaiting = TRUE;
+    m_asyncLock.release();
+
+    if( busy )
+    {
+        // posted by the drain that finishes the last operation
+        m_asyncIdle.wait();
+        // let it step out
+        m_asyncLock.acquire();
+        m_asyncLock.release();
+    }
+
+    // hand over what was read
+    async_complete();
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: can_wait()
+// desc: whether `file => now` should block
+//-----------------------------------------------------------------------------
+t_CKBOOL Chuck_IO_File::can_wait()
+{
+    // wait while work is queued, or its completion is still on the way
+    m_asyncLock.acquire();
+    t_CKBOOL busy = m_asyncPending > 0 || ( m_asyncBuffer && !m_asyncBuffer->empty() );
+    m_asyncLock.release();
     
-    return (THREAD_RETURN)0;
+    return busy;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: async_complete()
+// desc: VM side only; the pool never touches the arrays, so they are sized
+//       and filled here
+//-----------------------------------------------------------------------------
+void Chuck_IO_File::async_complete()
+{
+    std::vector<async_args *> done;
+    m_asyncLock.acquire();
+    done.swap( m_asyncDone );
+    m_asyncLock.release();
+
+    for( t_CKUINT i = 0; i < done.size(); i++ )
+    {
+        async_args * args = done[i];
+        if( args->job == readFloats_job )
+        {
+            Chuck_Array8 * a = (Chuck_Array8 *)args->arrayArg;
+            a->set_size( args->floatsRead.size() );
+            std::copy( args->floatsRead.begin(), args->floatsRead.end(), a->m_vector.begin() );
+        }
+        else if( args->job == readInts_job )
+        {
+            Chuck_Array4 * a = (Chuck_Array4 *)args->arrayArg;
+            a->set_size( args->intsRead.size() );
+            std::copy( args->intsRead.begin(), args->intsRead.end(), a->m_vector.begin() );
+        }
+        if( args->arrayArg ) args->arrayArg->release();
+        delete args;
+    }
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: broadcast()
+// desc: VM side; results first, so woken shreds see them
+//-----------------------------------------------------------------------------
+void Chuck_IO_File::broadcast()
+{
+    async_complete();
+    Chuck_Event::broadcast();
 }
 
-THREAD_RETURN ( THREAD_TYPE Chuck_IO_File::writeFloat_thread ) ( void *data )
+
+
+
+// jobs for asynchronous mode
+void Chuck_IO_File::writeStr_job( void * data )
 {
     async_args *args = (async_args *)data;
-    args->fileio_obj->write ( args->floatArg );
-    args->fileio_obj->m_asyncEvent->broadcast(); // wake up
-    delete args;
-    
-    return (THREAD_RETURN)0;
+    Chuck_IO_File * f = args->fileio_obj;
+    f->write( args->stringArg );
+}
+
+void Chuck_IO_File::writeInt_job( void * data )
+{
+    async_args *args = (async_args *)data;
+    Chuck_IO_File * f = args->fileio_obj;
+    f->write( args->intArg );
+}
+
+void Chuck_IO_File::writeIntFlags_job( void * data )
+{
+    async_args *args = (async_args *)data;
+    Chuck_IO_File * f = args->fileio_obj;
+    f->write( args->intArg, args->flagsArg );
+}
+
+void Chuck_IO_File::writeFloat_job( void * data )
+{
+    async_args *args = (async_args *)data;
+    Chuck_IO_File * f = args->fileio_obj;
+    f->write( args->floatArg );
+}
+
+// up to intArg values, into args; async_complete() copies them to the array
+void Chuck_IO_File::readFloats_job( void * data )
+{
+    async_args *args = (async_args *)data;
+    Chuck_IO_File * f = args->fileio_obj;
+    args->floatsRead.resize( args->intArg );
+    t_CKINT n = args->intArg ? f->readFloats( &args->floatsRead[0], args->intArg ) : 0;
+    args->floatsRead.resize( n );
+}
+
+void Chuck_IO_File::readInts_job( void * data )
+{
+    async_args *args = (async_args *)data;
+    Chuck_IO_File * f = args->fileio_obj;
+    args->intsRead.resize( args->intArg );
+    t_CKINT n = args->intArg ? f->readInts( &args->intsRead[0], args->intArg, args->flagsArg ) : 0;
+    args->intsRead.resize( n );
 }
 
 Chuck_IO_Chout::Chuck_IO_Chout( Chuck_Carrier * carrier ) {
@@ -40,6 +40,8 @@
 #include <vector>
 #include <map>
 #include <queue>
+#include <deque>
+#include <new>
 #include <fstream>
 #include <sstream> // REFACTOR-2017: for custom output
 #include "util_thread.h" // added 1.3.0.0
@@ -76,7 +78,12 @@ struct Chuck_VM_Object
 {
 public:
     Chuck_VM_Object() { this->init_ref(); }
-    virtual ~Chuck_VM_Object() { }
+    virtual ~Chuck_VM_Object();
+
+public:
+    // memory comes from, and goes back to, Chuck_VM_Alloc's pools
+    static void * operator new( size_t size );
+    static void operator delete( void * ptr, size_t size );
 
 public:
     // add reference (ge: april 2013: made these virtual)
@@ -89,6 +96,17 @@ public:
     // NOTE: be careful when overriding these, should always
     // explicitly call up to ChucK_VM_Object (ge: 2013)
 
+public:
+    // first part of destruction, on the thread that dropped the last
+    // reference: detach from anything shared (e.g. the ugen graph); returns
+    // TRUE if the rest (the destructor) may then run on the reaper thread
+    virtual t_CKBOOL unlink() { return FALSE; }
+
+public:
+    // slots in this object holding counted references to other vm objects,
+    // followed by the cycle collector (see Chuck_VM_Alloc::collect())
+    virtual void gc_slots( std::vector<t_CKUINT *> & slots ) { }
+
 public:
     // unlock_all: dis/allow deletion of locked objects
     static void lock_all();
@@ -99,6 +117,12 @@ public:
     t_CKUINT m_ref_count; // reference count
     t_CKBOOL m_pooled; // if true, this allocates from a pool
     t_CKBOOL m_locked; // if true, this should never be deleted
+    t_CKBOOL m_unlinked; // if true, unlink() has run; only the dtor is left
+    Chuck_VM_Object * m_next_dead; // graveyard link, waiting for the reaper
+    t_CKBOOL m_gc_traced; // if true, may hold references in gc_slots()
+    t_CKINT m_gc_index; // position in the candidate buffer, or -1
+    t_CKUINT m_gc_color; // collector mark
+    t_CKUINT m_gc_count; // collector trial reference count
 
 public:
     // where
@@ -113,7 +137,9 @@ private:
 
 //-----------------------------------------------------------------------------
 // name: struct Chuck_VM_Alloc
-// desc: vm object manager
+// desc: vm object manager; also keeps freed object and data memory in
+//       per-size-class pools, so steady-state instantiation does not go
+//       back to the system allocator
 //-----------------------------------------------------------------------------
 struct Chuck_VM_Alloc
 {
@@ -124,6 +150,43 @@ public:
     void add_object( Chuck_VM_Object * obj );
     void free_object( Chuck_VM_Object * obj );
 
+public: // pooled memory; size must be the same for alloc and free
+    void * alloc_block( size_t size );
+    void free_block( void * block, size_t size );
+
+public: // deferred destruction (see unlink()); one reaper for all VMs
+    void start_reaper();
+    void stop_reaper();
+    // destroy everything in the graveyard now; returns how many
+    t_CKUINT reap();
+
+public: // cycle collection, by trial deletion (Bacon & Rajan) over the
+        // traced objects whose count last dropped to nonzero
+    // note a candidate cycle root (called from release())
+    void gc_candidate( Chuck_VM_Object * obj );
+    // no longer a candidate (on free)
+    void gc_forget( Chuck_VM_Object * obj );
+    // examine candidates until about budget objects have been visited
+    // (0: all of them), freeing unreachable cycles; returns how many freed.
+    // shreds are the VM's suspended shreds, whose stacks are roots. does
+    // nothing while more than one VM is running (see collect())
+    t_CKUINT collect( t_CKUINT budget,
+                      const std::vector<Chuck_VM_Shred *> & shreds );
+
+public: // counters, since start
+    // blocks that came from the system allocator
+    t_CKUINT num_system_allocs() const { return m_num_system_allocs; }
+    // blocks handed out again from a pool
+    t_CKUINT num_recycled() const { return m_num_recycled; }
+    // blocks currently handed out
+    t_CKUINT num_in_use() const { return m_num_in_use; }
+    // objects whose destructor was left to the reaper
+    t_CKUINT num_deferred() const { return m_num_deferred; }
+    // objects freed by the cycle collector
+    t_CKUINT num_collected() const { return m_num_collected; }
+    // candidates waiting for the cycle collector
+    t_CKUINT num_candidates() const { return m_candidates.size(); }
+
 protected:
     static Chuck_VM_Alloc * our_instance;
 
@@ -131,10 +194,104 @@ protected:
     Chuck_VM_Alloc();
     ~Chuck_VM_Alloc();
 
+    // reaper thread
+    static THREAD_RETURN ( THREAD_TYPE reaper_cb )( void * _thiss );
+
+    // cycle collector phases
+    t_CKUINT gc_mark_gray( Chuck_VM_Object * root );
+    void gc_scan_stacks( const std::vector<Chuck_VM_Shred *> & shreds );
+    void gc_scan( Chuck_VM_Object * root );
+    void gc_scan_black( Chuck_VM_Object * obj );
+    void gc_collect_white( Chuck_VM_Object * root );
+
+protected:
+    // size classes: multiples of POOL_GRAIN up to POOL_MAX_SIZE; larger
+    // blocks always go to the system; at most POOL_MAX_FREE kept per class
+    enum { POOL_GRAIN = 16, POOL_MAX_SIZE = 1024,
+           POOL_NUM_CLASSES = POOL_MAX_SIZE / POOL_GRAIN,
+           POOL_MAX_FREE = 4096 };
+    struct Block { Block * next; };
+
 protected: // data
     std::map<Chuck_VM_Object *, void *> m_objects;
+    // free blocks, by size class
+    Block * m_free[POOL_NUM_CLASSES];
+    t_CKUINT m_num_free[POOL_NUM_CLASSES];
+    // objects are made and freed on the audio, compiler, and i/o threads
+    XMutex m_pool_lock;
+    t_CKUINT m_num_system_allocs;
+    t_CKUINT m_num_recycled;
+    t_CKUINT m_num_in_use;
+
+    // unlinked objects, pushed lock-free by any thread, taken all at once
+    Chuck_VM_Object * volatile m_graveyard;
+    // held while destroying, so reap() returns only when all are gone
+    XMutex m_reap_lock;
+    XThread * m_reaper;
+    t_CKUINT m_reaper_refs;
+    // posted to end the reaper thread
+    XSemaphore m_reaper_stop;
+    t_CKUINT m_num_deferred;
+
+    // candidate cycle roots; objects know their index, for removal on free
+    std::vector<Chuck_VM_Object *> m_candidates;
+    // held for adding/removing candidates, and by the collector throughout
+    // marking
+    XMutex m_gc_lock;
+    // collect() is skipping (more than one VM); for logging it once
+    t_CKBOOL m_gc_paused;
+    // collector scratch: roots taken, objects marked gray, traversal stack,
+    // slots, garbage found
+    std::vector<Chuck_VM_Object *> m_gc_roots;
+    std::vector<Chuck_VM_Object *> m_gc_gray;
+    std::vector<Chuck_VM_Object *> m_gc_stack;
+    std::vector<t_CKUINT *> m_gc_slots;
+    std::vector<Chuck_VM_Object *> m_gc_white;
+    t_CKUINT m_num_collected;
+};
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: class Chuck_Pool_Allocator
+// desc: STL allocator on Chuck_VM_Alloc's pools, for containers that are
+//       made and dropped along with VM objects
+//-----------------------------------------------------------------------------
+template <class T>
+class Chuck_Pool_Allocator
+{
+public:
+    typedef T value_type;
+    typedef T * pointer;
+    typedef const T * const_pointer;
+    typedef T & reference;
+    typedef const T & const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+    template <class U> struct rebind { typedef Chuck_Pool_Allocator<U> other; };
+
+public:
+    Chuck_Pool_Allocator() { }
+    template <class U> Chuck_Pool_Allocator( const Chuck_Pool_Allocator<U> & ) { }
+
+public:
+    pointer address( reference x ) const { return &x; }
+    const_pointer address( const_reference x ) const { return &x; }
+    pointer allocate( size_type n, const void * = 0 )
+    { return (pointer)Chuck_VM_Alloc::instance()->alloc_block( n * sizeof(T) ); }
+    void deallocate( pointer p, size_type n )
+    { Chuck_VM_Alloc::instance()->free_block( p, n * sizeof(T) ); }
+    size_type max_size() const { return (size_type)-1 / sizeof(T); }
+    void construct( pointer p, const T & val ) { new( (void *)p ) T( val ); }
+    void destroy( pointer p ) { p->~T(); }
 };
 
+template <class T, class U>
+bool operator==( const Chuck_Pool_Allocator<T> &, const Chuck_Pool_Allocator<U> & ) { return true; }
+template <class T, class U>
+bool operator!=( const Chuck_Pool_Allocator<T> &, const Chuck_Pool_Allocator<U> & ) { return false; }
+
 
 
 
@@ -161,6 +318,12 @@ public:
     Chuck_Object();
     virtual ~Chuck_Object();
 
+public:
+    // deferrable unless a native dtor in the type chain must run in place
+    virtual t_CKBOOL unlink();
+    // object members declared in chuck, through the type chain
+    virtual void gc_slots( std::vector<t_CKUINT *> & slots );
+
 public:
     // virtual table
     Chuck_VTable * vtable;
@@ -225,9 +388,14 @@ public:
     virtual ~Chuck_Array4();
 
 public:
-    t_CKUINT addr( t_CKINT i );
+    // element address, or 0 if out of bounds
+    t_CKUINT addr( t_CKINT i )
+    { return (t_CKUINT)i < m_vector.size() ? (t_CKUINT)&m_vector[i] : 0; }
     t_CKUINT addr( const std::string & key );
-    t_CKINT get( t_CKINT i, t_CKUINT * val );
+    // element value, zeroed if out of bounds (then returns 0)
+    t_CKINT get( t_CKINT i, t_CKUINT * val )
+    { if( (t_CKUINT)i >= m_vector.size() ) { *val = 0; return 0; }
+      *val = m_vector[i]; return 1; }
     t_CKINT get( const std::string & key, t_CKUINT * val );
     t_CKINT set( t_CKINT i, t_CKUINT val );
     t_CKINT set( const std::string & key, t_CKUINT val );
@@ -246,9 +414,16 @@ public:
     virtual t_CKINT data_type_size( ) { return CHUCK_ARRAY4_DATASIZE; } 
     virtual t_CKINT data_type_kind( ) { return CHUCK_ARRAY4_DATAKIND; } 
 
+public:
+    // elements, if objects
+    virtual void gc_slots( std::vector<t_CKUINT *> & slots );
+
 public:
     std::vector<t_CKUINT> m_vector;
-    std::map<std::string, t_CKUINT> m_map;
+    // associative part, made on first use of a string key
+    std::map<std::string, t_CKUINT> * m_map;
+    std::map<std::string, t_CKUINT> & assoc()
+    { if( !m_map ) m_map = new std::map<std::string, t_CKUINT>; return *m_map; }
     t_CKBOOL m_is_obj;
     // t_CKINT m_size;
     // t_CKINT m_capacity;
@@ -268,9 +443,14 @@ public:
     virtual ~Chuck_Array8();
 
 public:
-    t_CKUINT addr( t_CKINT i );
+    // element address, or 0 if out of bounds
+    t_CKUINT addr( t_CKINT i )
+    { return (t_CKUINT)i < m_vector.size() ? (t_CKUINT)&m_vector[i] : 0; }
     t_CKUINT addr( const std::string & key );
-    t_CKINT get( t_CKINT i, t_CKFLOAT * val );
+    // element value, zeroed if out of bounds (then returns 0)
+    t_CKINT get( t_CKINT i, t_CKFLOAT * val )
+    { if( (t_CKUINT)i >= m_vector.size() ) { *val = 0.0; return 0; }
+      *val = m_vector[i]; return 1; }
     t_CKINT get( const std::string & key, t_CKFLOAT * val );
     t_CKINT set( t_CKINT i, t_CKFLOAT val );
     t_CKINT set( const std::string & key, t_CKFLOAT val );
@@ -291,7 +471,10 @@ public:
 
 public:
     std::vector<t_CKFLOAT> m_vector;
-    std::map<std::string, t_CKFLOAT> m_map;
+    // associative part, made on first use of a string key
+    std::map<std::string, t_CKFLOAT> * m_map;
+    std::map<std::string, t_CKFLOAT> & assoc()
+    { if( !m_map ) m_map = new std::map<std::string, t_CKFLOAT>; return *m_map; }
     // t_CKINT m_size;
     // t_CKINT m_capacity;
 };
@@ -310,9 +493,14 @@ public:
     virtual ~Chuck_Array16();
 
 public:
-    t_CKUINT addr( t_CKINT i );
+    // element address, or 0 if out of bounds
+    t_CKUINT addr( t_CKINT i )
+    { return (t_CKUINT)i < m_vector.size() ? (t_CKUINT)&m_vector[i] : 0; }
     t_CKUINT addr( const std::string & key );
-    t_CKINT get( t_CKINT i, t_CKCOMPLEX * val );
+    // element value, zeroed if out of bounds (then returns 0)
+    t_CKINT get( t_CKINT i, t_CKCOMPLEX * val )
+    { if( (t_CKUINT)i >= m_vector.size() ) { *val = t_CKCOMPLEX(); return 0; }
+      *val = m_vector[i]; return 1; }
     t_CKINT get( const std::string & key, t_CKCOMPLEX * val );
     t_CKINT set( t_CKINT i, const t_CKCOMPLEX & val );
     t_CKINT set( const std::string & key, const t_CKCOMPLEX & val );
@@ -333,7 +521,10 @@ public:
 
 public:
     std::vector<t_CKCOMPLEX> m_vector;
-    std::map<std::string, t_CKCOMPLEX> m_map;
+    // associative part, made on first use of a string key
+    std::map<std::string, t_CKCOMPLEX> * m_map;
+    std::map<std::string, t_CKCOMPLEX> & assoc()
+    { if( !m_map ) m_map = new std::map<std::string, t_CKCOMPLEX>; return *m_map; }
     // t_CKINT m_size;
     // t_CKINT m_capacity;
 };
@@ -352,9 +543,14 @@ public:
     virtual ~Chuck_Array24();
     
 public:
-    t_CKUINT addr( t_CKINT i );
+    // element address, or 0 if out of bounds
+    t_CKUINT addr( t_CKINT i )
+    { return (t_CKUINT)i < m_vector.size() ? (t_CKUINT)&m_vector[i] : 0; }
     t_CKUINT addr( const std::string & key );
-    t_CKINT get( t_CKINT i, t_CKVEC3 * val );
+    // element value, zeroed if out of bounds (then returns 0)
+    t_CKINT get( t_CKINT i, t_CKVEC3 * val )
+    { if( (t_CKUINT)i >= m_vector.size() ) { *val = t_CKVEC3(); return 0; }
+      *val = m_vector[i]; return 1; }
     t_CKINT get( const std::string & key, t_CKVEC3 * val );
     t_CKINT set( t_CKINT i, const t_CKVEC3 & val );
     t_CKINT set( const std::string & key, const t_CKVEC3 & val );
@@ -375,7 +571,10 @@ public:
     
 public:
     std::vector<t_CKVEC3> m_vector;
-    std::map<std::string, t_CKVEC3> m_map;
+    // associative part, made on first use of a string key
+    std::map<std::string, t_CKVEC3> * m_map;
+    std::map<std::string, t_CKVEC3> & assoc()
+    { if( !m_map ) m_map = new std::map<std::string, t_CKVEC3>; return *m_map; }
 };
 
 
@@ -392,9 +591,14 @@ public:
     virtual ~Chuck_Array32();
     
 public:
-    t_CKUINT addr( t_CKINT i );
+    // element address, or 0 if out of bounds
+    t_CKUINT addr( t_CKINT i )
+    { return (t_CKUINT)i < m_vector.size() ? (t_CKUINT)&m_vector[i] : 0; }
     t_CKUINT addr( const std::string & key );
-    t_CKINT get( t_CKINT i, t_CKVEC4 * val );
+    // element value, zeroed if out of bounds (then returns 0)
+    t_CKINT get( t_CKINT i, t_CKVEC4 * val )
+    { if( (t_CKUINT)i >= m_vector.size() ) { *val = t_CKVEC4(); return 0; }
+      *val = m_vector[i]; return 1; }
     t_CKINT get( const std::string & key, t_CKVEC4 * val );
     t_CKINT set( t_CKINT i, const t_CKVEC4 & val );
     t_CKINT set( const std::string & key, const t_CKVEC4 & val );
@@ -415,7 +619,10 @@ public:
     
 public:
     std::vector<t_CKVEC4> m_vector;
-    std::map<std::string, t_CKVEC4> m_map;
+    // associative part, made on first use of a string key
+    std::map<std::string, t_CKVEC4> * m_map;
+    std::map<std::string, t_CKVEC4> & assoc()
+    { if( !m_map ) m_map = new std::map<std::string, t_CKVEC4>; return *m_map; }
 };
 
 
@@ -429,7 +636,7 @@ struct Chuck_Event : Chuck_Object
 {
 public:
     void signal();
-    void broadcast();
+    virtual void broadcast();
     void wait( Chuck_VM_Shred * shred, Chuck_VM * vm );
     t_CKBOOL remove( Chuck_VM_Shred * shred );
 
@@ -441,7 +648,10 @@ public:
     static t_CKUINT our_can_wait;
 
 protected:
-    std::queue<Chuck_VM_Shred *> m_queue;
+    // waiting shreds (pooled: events come and go at audio rate)
+    typedef std::queue<Chuck_VM_Shred *, std::deque<Chuck_VM_Shred *,
+        Chuck_Pool_Allocator<Chuck_VM_Shred *> > > Shred_Queue;
+    Shred_Queue m_queue;
     XMutex m_queue_lock;
 };
 
@@ -456,17 +666,34 @@ struct Chuck_String : Chuck_Object
 {
 public:
     // constructor
-    Chuck_String( const std::string & s = "" ) { set( s ); }
+    Chuck_String( const std::string & s = "" ) : m_is_temp( FALSE ) { set( s ); }
     // destructor
     ~Chuck_String() { }
 
     // set string (makes copy)
     void set( const std::string & s ) { m_str = s; m_charptr = m_str.c_str(); }
+    // set to the concatenation of a and b, in one allocation
+    void set( const std::string & a, const std::string & b )
+    { m_str.reserve( a.size() + b.size() ); m_str.assign( a ); m_str.append( b ); m_charptr = m_str.c_str(); }
+    // append in place (amortized, like std::string)
+    void append( const std::string & s ) { m_str.append( s ); m_charptr = m_str.c_str(); }
+    // prepend in place
+    void prepend( const std::string & s ) { m_str.insert( 0, s ); m_charptr = m_str.c_str(); }
+    // take the contents of another string, leaving it empty
+    void take( Chuck_String * s ) { m_str.swap( s->m_str ); s->m_str.clear(); m_charptr = m_str.c_str(); s->m_charptr = s->m_str.c_str(); }
     // get as standard c++ string
     const std::string & str() { return m_str; }
     // get as C string (NOTE: use this in dynamical modules like chugins!)
     const char * c_str() { return m_charptr; }
 
+public:
+    // set on strings made by the string arithmetic instructions; while such
+    // a string is unreferenced it is an expression temporary that only the
+    // reg stack refers to, so its consumer may reuse or free it
+    t_CKBOOL m_is_temp;
+    // is this an unreferenced temporary?
+    t_CKBOOL is_temp() { return m_is_temp && m_ref_count == 0; }
+
 private:
     // c pointer | HACK: needed for ensure string passing in dynamic modules
     const char * m_charptr; // REFACTOR-2017
@@ -486,6 +713,8 @@ struct Chuck_IO : Chuck_Event
 public:
     Chuck_IO();
     virtual ~Chuck_IO();
+    // destroyed in place: closing may involve the i/o threads
+    virtual t_CKBOOL unlink() { return FALSE; }
     
 public:
     // meta
@@ -517,15 +746,20 @@ public:
     // asynchronous I/O members
     static const t_CKINT MODE_SYNC;
     static const t_CKINT MODE_ASYNC;
-    Chuck_Event * m_asyncEvent;
-    XThread * m_thread;
     struct async_args
     {
         Chuck_IO_File * fileio_obj;
         void *RETURN; // actually a Chuck_DL_Return
+        XThreadPool::Job job; // the operation; called with this
         t_CKINT intArg;
+        t_CKINT flagsArg;
         t_CKFLOAT floatArg;
         std::string stringArg;
+        Chuck_Object * arrayArg; // destination of bulk reads (VM side only)
+        // bulk reads land here on the pool thread; copied into arrayArg
+        // on the VM side when the completion is delivered
+        std::vector<t_CKFLOAT> floatsRead;
+        std::vector<t_CKINT> intsRead;
     };
 };
 
@@ -566,6 +800,10 @@ public:
     virtual t_CKFLOAT readFloat();
     virtual t_CKBOOL readString( std::string & str );
     virtual t_CKBOOL eof();
+
+    // reading -- bulk, up to n values into dest; returns number read
+    virtual t_CKINT readFloats( t_CKFLOAT * dest, t_CKINT n );
+    virtual t_CKINT readInts( t_CKINT * dest, t_CKINT n, t_CKINT flags );
     
     // reading -- async
     /* TODO: doesn't look like asynchronous reads will work
@@ -581,10 +819,21 @@ public:
     virtual void write( t_CKINT val, t_CKINT flags );
     virtual void write( t_CKFLOAT val );
     
-    // writing -- async
-    static THREAD_RETURN ( THREAD_TYPE writeStr_thread ) ( void *data );
-    static THREAD_RETURN ( THREAD_TYPE writeInt_thread ) ( void *data );
-    static THREAD_RETURN ( THREAD_TYPE writeFloat_thread ) ( void *data );
+    // async: queue an operation; operations on one file run in order on the
+    // shared I/O pool, and the file is broadcast once all of them are done
+    void start_async( XThreadPool::Job job, async_args * args );
+    // nothing queued, so waiting on the file would not return
+    t_CKBOOL can_wait();
+    // VM side: hand finished reads to their arrays, then wake waiters
+    virtual void broadcast();
+
+    // async jobs (run on a pool thread)
+    static void writeStr_job( void * data );
+    static void writeInt_job( void * data );
+    static void writeIntFlags_job( void * data );
+    static void writeFloat_job( void * data );
+    static void readFloats_job( void * data );
+    static void readInts_job( void * data );
     
 public:
     // constants
@@ -594,6 +843,18 @@ public:
     static const t_CKINT FLAG_APPEND;
     static const t_CKINT TYPE_ASCII;
     static const t_CKINT TYPE_BINARY;
+    static const t_CKINT FLAG_MMAP;
+
+protected:
+    // runs this file's queued operations (on a pool thread)
+    static void async_drain( void * data );
+    // block until queued operations are done
+    void async_wait();
+    // VM side: copy finished reads into their arrays, free their args
+    void async_complete();
+    // memory-mapped reading
+    t_CKBOOL mmap_open();
+    void mmap_close();
     
 protected:
     // open flags
@@ -610,6 +871,24 @@ protected:
     std::string m_path;
     // vm and shred
     Chuck_VM * m_vmRef;
+    // queued async operations, oldest first
+    std::deque<async_args *> m_asyncQueue;
+    // finished operations, for async_complete()
+    std::vector<async_args *> m_asyncDone;
+    // number queued and not yet finished
+    t_CKINT m_asyncPending;
+    // async_wait() is blocked on m_asyncIdle
+    t_CKBOOL m_asyncWaiting;
+    // guards the four above
+    XMutex m_asyncLock;
+    // posted when the last pending operation finishes, if someone waits
+    XSemaphore m_asyncIdle;
+    // completion events for this file's jobs (created on first use)
+    CBufferSimple * m_asyncBuffer;
+    // memory-mapped file, read through m_mmapBuf instead of the file buffer
+    std::streambuf * m_mmapBuf;
+    void * m_mmapBase;
+    t_CKINT m_mmapSize;
 };
 
 
@@ -41,6 +41,7 @@
 #include <sys/stat.h>
 #include <signal.h>
 #include <time.h>
+#include <stdint.h>
 
 #ifndef __PLATFORM_WIN32__
 #include <unistd.h>
@@ -53,6 +54,20 @@ using namespace std;
 // log level
 t_CKUINT g_otf_log = CK_LOG_INFO;
 
+// clients served at once
+#define OTF_NUM_WORKERS 4
+// compiling (the parser is not reentrant) and queueing
+static XMutex g_otf_mutex;
+// otf workers
+static XThreadPool * g_otf_pool = NULL;
+
+// one accepted client
+struct Otf_Session
+{
+    Chuck_Carrier * carrier;
+    ck_socket client;
+};
+
 
 
 
@@ -133,35 +148,31 @@ error:
 
 
 //-----------------------------------------------------------------------------
-// name: otf_process_msg()
-// desc: ...
+// name: otf_make_cmd()
+// desc: VM message for one operation; add/replace are compiled here, from
+//       fd or src if given, else from the named file
 //-----------------------------------------------------------------------------
-t_CKUINT otf_process_msg( Chuck_VM * vm, Chuck_Compiler * compiler, 
-                          Net_Msg * msg, t_CKBOOL immediate, void * data )
+static Chuck_Msg * otf_make_cmd( Chuck_Compiler * compiler, t_CKUINT type,
+                                 t_CKUINT param, const char * name,
+                                 FILE * fd, const char * src )
 {
     Chuck_Msg * cmd = new Chuck_Msg;
-    Chuck_VM_Code * code = NULL;
-    FILE * fd = NULL;
-    t_CKUINT ret = 0;
 
-    // CK_FPRINTF_STDERR( "UDP message recv...\n" );
-    if( msg->type == MSG_REPLACE || msg->type == MSG_ADD )
+    if( type == MSG_REPLACE || type == MSG_ADD )
     {
         string filename;
         vector<string> args;
 
         // parse out command line arguments
-        if( !extract_args( msg->buffer, filename, args ) )
+        if( !extract_args( name, filename, args ) )
         {
             // error
             CK_FPRINTF_STDERR( "[chuck]: malformed filename with argument list...\n" );
-            CK_FPRINTF_STDERR( "    -->  '%s'", msg->buffer );
+            CK_FPRINTF_STDERR( "    -->  '%s'", name );
             SAFE_DELETE(cmd);
-            goto cleanup;
+            return NULL;
         }
 
-        // copy de-escaped filename
-        strcpy( msg->buffer, filename.c_str() );
         // copy args if needed
         if( args.size() > 0 )
         {
@@ -169,63 +180,85 @@ t_CKUINT otf_process_msg( Chuck_VM * vm, Chuck_Compiler * compiler,
             *(cmd->args) = args;
         }
 
-        // see if entire file is on the way
-        if( msg->param2 && msg->param2 != NET_ERROR )
-        {
-            fd = recv_file( *msg, (ck_socket)data );
-            if( !fd )
-            {
-                CK_FPRINTF_STDERR( "[chuck]: incoming source transfer '%s' failed...\n",
-                    mini(msg->buffer) );
-                SAFE_DELETE(cmd);
-                goto cleanup;
-            }
-        }
-
         // construct full path to be associated with the file so me.sourceDir() works
         // (added 1.3.5.2)
-        std::string full_path = get_full_path( msg->buffer );
+        std::string full_path = get_full_path( filename );
         // parse, type-check, and emit
-        if( !compiler->go( msg->buffer, fd, NULL, full_path.c_str() ) )
+        if( !compiler->go( filename, fd, src, full_path ) )
         {
             SAFE_DELETE(cmd);
-            goto cleanup;
+            return NULL;
         }
 
         // get the code
-        code = compiler->output();
+        Chuck_VM_Code * code = compiler->output();
         // name it
-        code->name += string(msg->buffer);
+        code->name += filename;
 
         // set the flags for the command
-        cmd->type = msg->type;
+        cmd->type = type;
         cmd->code = code;
-        if( msg->type == MSG_REPLACE )
-            cmd->param = msg->param;
+        if( type == MSG_REPLACE )
+            cmd->param = param;
     }
-    else if( msg->type == MSG_STATUS || msg->type == MSG_REMOVE || msg->type == MSG_REMOVEALL
-             || msg->type == MSG_KILL || msg->type == MSG_TIME || msg->type == MSG_RESET_ID
-             || msg->type == MSG_CLEARVM )
+    else if( type == MSG_STATUS || type == MSG_REMOVE || type == MSG_REMOVEALL
+             || type == MSG_KILL || type == MSG_TIME || type == MSG_RESET_ID
+             || type == MSG_CLEARVM )
     {
-        cmd->type = msg->type;
-        cmd->param = msg->param;
+        cmd->type = type;
+        cmd->param = param;
     }
-    else if( msg->type == MSG_ABORT )
+    else
+    {
+        CK_FPRINTF_STDERR( "[chuck]: unrecognized incoming command from network: '%li'\n", type );
+        SAFE_DELETE(cmd);
+        return NULL;
+    }
+
+    return cmd;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: otf_process_msg()
+// desc: ...
+//-----------------------------------------------------------------------------
+t_CKUINT otf_process_msg( Chuck_VM * vm, Chuck_Compiler * compiler, 
+                          Net_Msg * msg, t_CKBOOL immediate, void * data )
+{
+    Chuck_Msg * cmd = NULL;
+    FILE * fd = NULL;
+    t_CKUINT ret = 0;
+
+    // CK_FPRINTF_STDERR( "UDP message recv...\n" );
+    if( msg->type == MSG_ABORT )
     {
         // halt and clear current shred
         vm->abort_current_shred();
         // short circuit
-        ret = 1;
-        SAFE_DELETE(cmd);
-        goto cleanup;
+        return 1;
     }
-    else
+
+    // see if entire file is on the way
+    if( ( msg->type == MSG_REPLACE || msg->type == MSG_ADD ) &&
+        msg->param2 && msg->param2 != NET_ERROR )
     {
-        CK_FPRINTF_STDERR( "[chuck]: unrecognized incoming command from network: '%li'\n", cmd->type );
-        SAFE_DELETE(cmd);
-        goto cleanup;
+        fd = recv_file( *msg, (ck_socket)data );
+        if( !fd )
+        {
+            CK_FPRINTF_STDERR( "[chuck]: incoming source transfer '%s' failed...\n",
+                mini(msg->buffer) );
+            return 0;
+        }
     }
 
+    cmd = otf_make_cmd( compiler, msg->type, msg->param, msg->buffer, fd, NULL );
+    // close file handle
+    if( fd ) fclose( fd );
+    if( !cmd ) return 0;
+
     // immediate
     if( immediate )
         ret = vm->process_msg( cmd );
@@ -237,16 +270,98 @@ t_CKUINT otf_process_msg( Chuck_VM * vm, Chuck_Compiler * compiler,
         ret = 1;
     }
 
-cleanup:
-    // close file handle
-    if( fd ) fclose( fd );
-
     return ret;
 }
 
 
 
 
+//-----------------------------------------------------------------------------
+// name: otf_send_all() / otf_recv_all()
+// desc: whole buffers over a stream socket
+//-----------------------------------------------------------------------------
+static t_CKBOOL otf_send_all( ck_socket sock, const char * data, size_t len )
+{
+    while( len > 0 )
+    {
+        int n = ck_send( sock, data, len > 0x40000000 ? 0x40000000 : (int)len );
+        if( n <= 0 ) return FALSE;
+        data += n;
+        len -= n;
+    }
+
+    return TRUE;
+}
+
+static t_CKBOOL otf_recv_all( ck_socket sock, char * data, size_t len )
+{
+    while( len > 0 )
+    {
+        int chunk = len > 0x40000000 ? 0x40000000 : (int)len;
+        if( ck_recv( sock, data, chunk ) != chunk ) return FALSE;
+        data += chunk;
+        len -= chunk;
+    }
+
+    return TRUE;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: otf_put_op()
+// desc: append op, as it goes on the wire
+//-----------------------------------------------------------------------------
+static void otf_put_op( string & out, const Net_Op & op )
+{
+    uint32_t words[4];
+    words[0] = htonl( (uint32_t)op.type );
+    words[1] = htonl( (uint32_t)op.param );
+    words[2] = htonl( (uint32_t)op.name.size() );
+    words[3] = htonl( (uint32_t)op.body.size() );
+
+    out.append( (const char *)words, sizeof(words) );
+    out.append( op.name );
+    out.append( op.body );
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: otf_get_op()
+// desc: read one op off the wire
+//-----------------------------------------------------------------------------
+static t_CKBOOL otf_get_op( ck_socket sock, Net_Op & op )
+{
+    uint32_t words[4];
+    if( !otf_recv_all( sock, (char *)words, sizeof(words) ) )
+        return FALSE;
+
+    op.type = ntohl( words[0] );
+    op.param = ntohl( words[1] );
+    t_CKUINT name_len = ntohl( words[2] );
+    t_CKUINT body_len = ntohl( words[3] );
+    // sanity check
+    if( name_len > NET_FRAME_MAX || body_len > NET_FRAME_MAX )
+    {
+        EM_log( CK_LOG_INFO, "(via otf): oversized operation (%lu/%lu bytes), dropping...",
+                name_len, body_len );
+        return FALSE;
+    }
+
+    op.name.resize( name_len );
+    op.body.resize( body_len );
+    if( name_len && !otf_recv_all( sock, &op.name[0], name_len ) ) return FALSE;
+    if( body_len && !otf_recv_all( sock, &op.body[0], body_len ) ) return FALSE;
+
+    return TRUE;
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: otf_send_file()
 // desc: ...
@@ -385,6 +500,131 @@ ck_socket otf_send_connect( const char * host, int port )
 
 
 
+//-----------------------------------------------------------------------------
+// name: otf_stream_connect()
+// desc: connect, and ask for the streaming protocol
+//-----------------------------------------------------------------------------
+ck_socket otf_stream_connect( const char * host, int port )
+{
+    ck_socket sock = otf_send_connect( host, port );
+    if( !sock ) return NULL;
+
+    uint32_t header = htonl( NET_STREAM_HEADER );
+    if( !otf_send_all( sock, (const char *)&header, sizeof(header) ) )
+    {
+        CK_FPRINTF_STDERR( "[chuck]: cannot send to %s:%i...\n", host, port );
+        ck_close( sock );
+        return NULL;
+    }
+
+    return sock;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: otf_send_batch()
+// desc: send ops in one write, to be compiled and sporked together; reply
+//       gets the remote reason on failure, and is empty if none came back
+//-----------------------------------------------------------------------------
+t_CKBOOL otf_send_batch( ck_socket sock, const vector<Net_Op> & ops, string * reply )
+{
+    Net_Op done( MSG_DONE );
+    string out;
+    size_t size = 16;
+
+    // one buffer for the whole batch
+    for( size_t i = 0; i < ops.size(); i++ )
+        size += 16 + ops[i].name.size() + ops[i].body.size();
+    out.reserve( size );
+    for( size_t i = 0; i < ops.size(); i++ )
+        otf_put_op( out, ops[i] );
+    otf_put_op( out, done );
+
+    // log
+    EM_log( CK_LOG_INFO, "otf sending %d operation(s), %d bytes...", (int)ops.size(), (int)out.size() );
+    if( reply ) reply->clear();
+    if( !otf_send_all( sock, out.data(), out.size() ) )
+        return FALSE;
+
+    // set timeout
+    ck_recv_timeout( sock, 0, 2000000 );
+    // log
+    EM_log( CK_LOG_INFO, "otf awaiting reply..." );
+    if( !otf_get_op( sock, done ) )
+        return FALSE;
+
+    if( reply ) *reply = done.body;
+    return done.param != 0;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: otf_read_file()
+// desc: check a file parses, and read it into op for sending
+//-----------------------------------------------------------------------------
+static t_CKBOOL otf_read_file( const char * fname, Net_Op & op, const char * what )
+{
+    FILE * fd = NULL;
+    string filename;
+    vector<string> args;
+    char buf[1024];
+
+    // parse out command line arguments
+    if( !extract_args( fname, filename, args ) )
+    {
+        // error
+        CK_FPRINTF_STDERR( "[chuck]: malformed filename + argument list...\n" );
+        CK_FPRINTF_STDERR( "    -->  '%s'", fname );
+        return FALSE;
+    }
+
+    // filename and any args
+    op.name = fname;
+
+    // test it
+    strcpy( buf, filename.c_str() );
+    fd = open_cat_ck( buf );
+    if( !fd )
+    {
+        CK_FPRINTF_STDERR( "[chuck]: cannot open file '%s' for [%s]...\n", filename.c_str(), what );
+        return FALSE;
+    }
+
+    if( !chuck_parse( (char *)filename.c_str(), fd ) )
+    {
+        CK_FPRINTF_STDERR( "[chuck]: skipping file '%s' for [%s]...\n", filename.c_str(), what );
+        fclose( fd );
+        return FALSE;
+    }
+
+    // the whole thing
+    fseek( fd, 0, SEEK_END );
+    long size = ftell( fd );
+    fseek( fd, 0, SEEK_SET );
+    op.body.resize( size > 0 ? size : 0 );
+    if( size > 0 && fread( &op.body[0], sizeof(char), size, fd ) != (size_t)size )
+    {
+        CK_FPRINTF_STDERR( "[chuck]: error while reading '%s'...\n", filename.c_str() );
+        fclose( fd );
+        return FALSE;
+    }
+
+    // log
+    EM_log( CK_LOG_INFO, "sending TCP file %s, size=%d", filename.c_str(), size );
+
+    // close
+    fclose( fd );
+
+    return TRUE;
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: otf_send_cmd()
 // desc: ...
@@ -392,10 +632,10 @@ ck_socket otf_send_connect( const char * host, int port )
 int otf_send_cmd( int argc, const char ** argv, t_CKINT & i, const char * host, int port,
                   int * is_otf )
 {
-    Net_Msg msg;
+    vector<Net_Op> ops;
+    string reason;
     // REFACTOR-2017 TODO: wat is global sigpipe mode
 //    g_sigpipe_mode = 1;
-    int tasks_total = 0, tasks_done = 0;
     ck_socket dest = NULL;
     if( is_otf ) *is_otf = TRUE;
 
@@ -407,183 +647,117 @@ int otf_send_cmd( int argc, const char ** argv, t_CKINT & i, const char * host,
         if( ++i >= argc )
         {
             CK_FPRINTF_STDERR( "[chuck]: not enough arguments following [add]...\n" );
-            goto error;
+            return 0;
         }
 
-        if( !(dest = otf_send_connect( host, port )) ) return 0;
         EM_pushlog();
         do {
             // log
             EM_log( CK_LOG_INFO, "sending file:args '%s' for add...", mini(argv[i]) );
-            msg.type = MSG_ADD;
-            msg.param = 1;
-            tasks_done += otf_send_file( argv[i], msg, "add", dest );
-            tasks_total++;
+            ops.push_back( Net_Op( MSG_ADD, 1 ) );
+            if( !otf_read_file( argv[i], ops.back(), "add" ) )
+                ops.pop_back();
         } while( ++i < argc );
         // log
         EM_poplog();
 
-        if( !tasks_done )
-            goto error;
+        if( ops.empty() )
+            return 0;
     }
     else if( !strcmp( argv[i], "--remove" ) || !strcmp( argv[i], "-" ) )
     {
         if( ++i >= argc )
         {
             CK_FPRINTF_STDERR( "[chuck]: not enough arguments following [remove]...\n" );
-            goto error;
+            return 0;
         }
 
-        if( !(dest = otf_send_connect( host, port )) ) return 0;
         EM_pushlog();
         do {
             // log
-            EM_log( CK_LOG_INFO, "requesting removal of shred '%i'..." );
-            msg.param = atoi( argv[i] );
-            msg.type = MSG_REMOVE;
-            otf_hton( &msg );
-            ck_send( dest, (char *)&msg, sizeof(msg) );
+            EM_log( CK_LOG_INFO, "requesting removal of shred '%s'...", argv[i] );
+            ops.push_back( Net_Op( MSG_REMOVE, atoi( argv[i] ) ) );
         } while( ++i < argc );
         // log
         EM_poplog();
     }
     else if( !strcmp( argv[i], "--" ) )
     {
-        if( !(dest = otf_send_connect( host, port )) ) return 0;
-        EM_pushlog();
         // log
         EM_log( CK_LOG_INFO, "requesting removal of last shred..." );
-        msg.param = 0xffffffff;
-        msg.type = MSG_REMOVE;
-        otf_hton( &msg );
-        ck_send( dest, (char *)&msg, sizeof(msg) );
-        // log
-        EM_poplog();
+        ops.push_back( Net_Op( MSG_REMOVE, 0xffffffff ) );
     }
     else if( !strcmp( argv[i], "--replace" ) || !strcmp( argv[i], "=" ) )
     {
         if( ++i >= argc )
         {
             CK_FPRINTF_STDERR( "[chuck]: not enough arguments following [replace]...\n" );
-            goto error;
+            return 0;
         }
 
-        if( i <= 0 )
-            msg.param = 0xffffffff;
-        else
-            msg.param = atoi( argv[i] );
+        ops.push_back( Net_Op( MSG_REPLACE, i <= 0 ? 0xffffffff : atoi( argv[i] ) ) );
 
         if( ++i >= argc )
         {
             CK_FPRINTF_STDERR( "[chuck]: not enough arguments following [replace]...\n" );
-            goto error;
+            return 0;
         }
 
-        if( !(dest = otf_send_connect( host, port )) ) return 0;
         EM_pushlog();
-        EM_log( CK_LOG_INFO, "requesting replace shred '%i' with '%s'...", msg.param, mini(argv[i]) );
-        msg.type = MSG_REPLACE;
-        if( !otf_send_file( argv[i], msg, "replace", dest ) )
-            goto error;
+        EM_log( CK_LOG_INFO, "requesting replace shred '%i' with '%s'...", ops.back().param, mini(argv[i]) );
+        t_CKBOOL ok = otf_read_file( argv[i], ops.back(), "replace" );
         EM_poplog();
+        if( !ok ) return 0;
     }
     else if( !strcmp( argv[i], "--removeall" ) || !strcmp( argv[i], "--remall" ) || !strcmp( argv[i], "--remove.all" ) )
     {
-        if( !(dest = otf_send_connect( host, port )) ) return 0;
-        EM_pushlog();
         EM_log( CK_LOG_INFO, "requesting removeall..." );
-        msg.type = MSG_REMOVEALL;
-        msg.param = 0;
-        otf_hton( &msg );
-        ck_send( dest, (char *)&msg, sizeof(msg) );
-        EM_poplog();
+        ops.push_back( Net_Op( MSG_REMOVEALL ) );
     }
     else if( !strcmp( argv[i], "--clear.vm" ) )
     {
-        if( !(dest = otf_send_connect( host, port )) ) return 0;
-        EM_pushlog();
         EM_log( CK_LOG_INFO, "requesting clearvm..." );
-        msg.type = MSG_CLEARVM;
-        msg.param = 0;
-        otf_hton( &msg );
-        ck_send( dest, (char *)&msg, sizeof(msg) );
-        EM_poplog();
+        ops.push_back( Net_Op( MSG_CLEARVM ) );
     }
     else if( !strcmp( argv[i], "--kill" ) )
     {
-        if( !(dest = otf_send_connect( host, port )) ) return 0;
-        msg.type = MSG_REMOVEALL;
-        msg.param = 0;
-        otf_hton( &msg );
-        ck_send( dest, (char *)&msg, sizeof(msg) );
-        msg.type = MSG_KILL;
-        msg.param = (i+1)<argc ? atoi(argv[++i]) : 0;
-        otf_hton( &msg );
-        ck_send( dest, (char *)&msg, sizeof(msg) );
+        ops.push_back( Net_Op( MSG_REMOVEALL ) );
+        ops.push_back( Net_Op( MSG_KILL, (i+1)<argc ? atoi(argv[++i]) : 0 ) );
     }
     else if( !strcmp( argv[i], "--time" ) )
     {
-        if( !(dest = otf_send_connect( host, port )) ) return 0;
-        msg.type = MSG_TIME;
-        msg.param = 0;
-        otf_hton( &msg );
-        ck_send( dest, (char *)&msg, sizeof(msg) );
+        ops.push_back( Net_Op( MSG_TIME ) );
     }
     else if( !strcmp( argv[i], "--rid" ) )
     {
-        if( !(dest = otf_send_connect( host, port )) ) return 0;
-        msg.type = MSG_RESET_ID;
-        msg.param = 0;
-        otf_hton( &msg );
-        ck_send( dest, (char *)&msg, sizeof(msg) );
+        ops.push_back( Net_Op( MSG_RESET_ID ) );
     }
     else if( !strcmp( argv[i], "--status" ) || !strcmp( argv[i], "^" ) )
     {
-        if( !(dest = otf_send_connect( host, port )) ) return 0;
-        msg.type = MSG_STATUS;
-        msg.param = 0;
-        otf_hton( &msg );
-        ck_send( dest, (char *)&msg, sizeof(msg) );
+        ops.push_back( Net_Op( MSG_STATUS ) );
     }
     else if( !strcmp( argv[i], "--abort.shred" ) )
     {
-        if( !(dest = otf_send_connect( host, port )) ) return 0;
-        msg.type = MSG_ABORT;
-        msg.param = 0;
-        otf_hton( &msg );
-        ck_send( dest, (char *)&msg, sizeof(msg) );
+        ops.push_back( Net_Op( MSG_ABORT ) );
     }
     else
     {
         if( is_otf ) *is_otf = FALSE;
         return 0;
     }
-        
-    // send
-    msg.type = MSG_DONE;
-    otf_hton( &msg );
-    // log
-    EM_log( CK_LOG_INFO, "otf sending request..." );
-    ck_send( dest, (char *)&msg, sizeof(msg) );
 
-    // set timeout
-    ck_recv_timeout( dest, 0, 2000000 );
-    // log
-    EM_log( CK_LOG_INFO, "otf awaiting reply..." );
-    // reply
-    if( ck_recv( dest, (char *)&msg, sizeof(msg) ) )
+    if( !(dest = otf_stream_connect( host, port )) ) return 0;
+
+    // send, and wait for the reply
+    if( otf_send_batch( dest, ops, &reason ) )
     {
-        otf_ntoh( &msg );
-        if( !msg.param )
-        {
-            CK_FPRINTF_STDERR( "[chuck(remote)]:operation failed (sorry)" );
-            CK_FPRINTF_STDERR( "...(reason: %s)\n", 
-                ( strstr( (char *)msg.buffer, ":" ) ? strstr( (char *)msg.buffer, ":" ) + 1 : (char *)msg.buffer ) );
-        }
-        else
-        {
-            EM_log( CK_LOG_INFO, "reply received..." );
-        }
+        EM_log( CK_LOG_INFO, "reply received..." );
+    }
+    else if( reason.size() )
+    {
+        CK_FPRINTF_STDERR( "[chuck(remote)]:operation failed (sorry)" );
+        CK_FPRINTF_STDERR( "...(reason: %s)\n", 
+            ( strstr( reason.c_str(), ":" ) ? strstr( reason.c_str(), ":" ) + 1 : reason.c_str() ) );
     }
     else
     {
@@ -591,41 +765,234 @@ int otf_send_cmd( int argc, const char ** argv, t_CKINT & i, const char * host,
     }
     // close the sock
     ck_close( dest );
-    
-    // exit
-    // exit( msg.param );
 
     return 1;
-    
-error:
-    
-    // if sock was opened
-    if( dest )
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: otf_run_batch()
+// desc: compile every op, then queue them all at once; on any failure
+//       nothing is queued and reason says why
+//-----------------------------------------------------------------------------
+static t_CKBOOL otf_run_batch( Chuck_Carrier * carrier, vector<Net_Op> & ops,
+                               string & reason )
+{
+    vector<Chuck_Msg *> cmds;
+    t_CKBOOL ok = TRUE;
+
+    // one client compiling at a time
+    g_otf_mutex.acquire();
+
+    if( !carrier->vm || !carrier->compiler )
     {
-        msg.type = MSG_DONE;
-        otf_hton( &msg );
-        ck_send( dest, (char *)&msg, sizeof(msg) );
-        ck_close( dest );
+        g_otf_mutex.release();
+        reason = "no virtual machine";
+        return FALSE;
     }
-    
-    // exit( 1 );
 
-    return 0;
+    for( size_t i = 0; i < ops.size(); i++ )
+    {
+        if( ops[i].type == MSG_ABORT )
+        {
+            // halt and clear current shred
+            carrier->vm->abort_current_shred();
+            continue;
+        }
+
+        // empty body: the file is on this machine
+        Chuck_Msg * cmd = otf_make_cmd( carrier->compiler, ops[i].type, ops[i].param,
+            ops[i].name.c_str(), NULL, ops[i].body.size() ? ops[i].body.c_str() : NULL );
+        if( !cmd )
+        {
+            reason = EM_lasterror();
+            ok = FALSE;
+            break;
+        }
+        cmds.push_back( cmd );
+    }
+
+    // all or nothing
+    if( ok && cmds.size() && !carrier->vm->queue_msgs( &cmds[0], cmds.size() ) )
+    {
+        reason = "VM message queue full";
+        ok = FALSE;
+    }
+
+    if( !ok )
+    {
+        for( size_t i = 0; i < cmds.size(); i++ )
+        {
+            // compiled, never sporked
+            SAFE_ADD_REF( cmds[i]->code );
+            SAFE_RELEASE( cmds[i]->code );
+            SAFE_DELETE( cmds[i] );
+        }
+    }
+
+    g_otf_mutex.release();
+
+    return ok;
 }
 
 
 
 
 //-----------------------------------------------------------------------------
-// name: otf_cb()
-// desc: ...
+// name: otf_serve_stream()
+// desc: batches of length-prefixed ops, each ended by MSG_DONE and answered
+//       with one reply; until the client hangs up
 //-----------------------------------------------------------------------------
-void * otf_cb( void * p )
+static void otf_serve_stream( Chuck_Carrier * carrier, ck_socket client )
+{
+    vector<Net_Op> ops;
+    string reason;
+    string out;
+
+    while( true )
+    {
+        ops.resize( ops.size() + 1 );
+        if( !otf_get_op( client, ops.back() ) )
+            break;
+        if( ops.back().type != MSG_DONE )
+        {
+            if( ops.size() > NET_BATCH_MAX )
+            {
+                CK_FPRINTF_STDERR( "[chuck]: more than %d operations in one batch, dropping...\n",
+                    NET_BATCH_MAX );
+                break;
+            }
+            continue;
+        }
+        ops.pop_back();
+
+        // reply
+        Net_Op ret( MSG_DONE );
+        ret.param = otf_run_batch( carrier, ops, reason );
+        ret.body = ret.param ? "success" : reason;
+        out.clear();
+        otf_put_op( out, ret );
+        if( !otf_send_all( client, out.data(), out.size() ) )
+            break;
+
+        ops.clear();
+    }
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: otf_serve_legacy()
+// desc: Net_Msg chunks, ended by MSG_DONE; first holds the header word
+//       already read
+//-----------------------------------------------------------------------------
+static void otf_serve_legacy( Chuck_Carrier * carrier, ck_socket client, uint32_t first )
 {
     Net_Msg msg;
     Net_Msg ret;
-    ck_socket client;
     int n;
+
+    msg.clear();
+    memcpy( (char *)&msg, &first, sizeof(first) );
+    n = ck_recv( client, (char *)&msg + sizeof(first), sizeof(msg) - sizeof(first) );
+    otf_ntoh( &msg );
+    if( n != sizeof(msg) - sizeof(first) )
+    {
+        CK_FPRINTF_STDERR( "[chuck]: 0-length packet...\n" );
+        usleep( 40000 );
+        return;
+    }
+
+    if( msg.header != NET_HEADER )
+    {
+        CK_FPRINTF_STDERR( "[chuck]: header mismatch - possible endian lunacy...\n" );
+        return;
+    }
+
+    while( msg.type != MSG_DONE )
+    {
+        if( carrier->vm )
+        {
+            g_otf_mutex.acquire();
+            t_CKUINT ok = otf_process_msg( carrier->vm, carrier->compiler, &msg, FALSE, client );
+            g_otf_mutex.release();
+
+            if( !ok )
+            {
+                ret.param = FALSE;
+                strcpy( (char *)ret.buffer, EM_lasterror() );
+                while( msg.type != MSG_DONE && n )
+                {
+                    n = ck_recv( client, (char *)&msg, sizeof(msg) );
+                    otf_ntoh( &msg );
+                }
+                break;
+            }
+            else
+            {
+                ret.param = TRUE;
+                strcpy( (char *)ret.buffer, "success" );
+                n = ck_recv( client, (char *)&msg, sizeof(msg) );
+                otf_ntoh( &msg );
+                // hung up
+                if( n != sizeof(msg) ) return;
+            }
+        }
+        else
+        {
+            usleep( 10000 );
+        }
+    }
+
+    otf_hton( &ret );
+    ck_send( client, (char *)&ret, sizeof(ret) );
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: otf_session_cb()
+// desc: one client, on an otf worker; the first word picks the protocol
+//-----------------------------------------------------------------------------
+static void otf_session_cb( void * data )
+{
+    Otf_Session * session = (Otf_Session *)data;
+    ck_socket client = session->client;
+    uint32_t first = 0;
+
+    // set time out
+    ck_recv_timeout( client, 0, 5000000 );
+    if( ck_recv( client, (char *)&first, sizeof(first) ) != sizeof(first) )
+    {
+        CK_FPRINTF_STDERR( "[chuck]: 0-length packet...\n" );
+    }
+    else if( ntohl( first ) == NET_STREAM_HEADER )
+    {
+        otf_serve_stream( session->carrier, client );
+    }
+    else
+    {
+        otf_serve_legacy( session->carrier, client, first );
+    }
+
+    ck_close( client );
+    delete session;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: otf_cb()
+// desc: accept clients, each served on an otf worker
+//-----------------------------------------------------------------------------
+void * otf_cb( void * p )
+{
+    ck_socket client;
     
     // REFACTOR-2017: get per-VM carrier
     Chuck_Carrier * carrier = (Chuck_Carrier *)p;
@@ -638,6 +1005,11 @@ void * otf_cb( void * p )
 //    signal( SIGPIPE, signal_pipe );
 #endif
 
+    // workers, shared by all listeners
+    g_otf_mutex.acquire();
+    if( !g_otf_pool ) g_otf_pool = new XThreadPool( OTF_NUM_WORKERS );
+    g_otf_mutex.release();
+
     while( true )
     {
         // REFACTOR-2017: change g_sock to per-VM socket
@@ -649,58 +1021,11 @@ void * otf_cb( void * p )
             ck_close( client );
             continue;
         }
-        msg.clear();
-        // set time out
-        ck_recv_timeout( client, 0, 5000000 );
-        n = ck_recv( client, (char *)&msg, sizeof(msg) );
-        otf_ntoh( &msg );
-        if( n != sizeof(msg) )
-        {
-            CK_FPRINTF_STDERR( "[chuck]: 0-length packet...\n" );
-            usleep( 40000 );
-            ck_close( client );
-            continue;
-        }
-        
-        if( msg.header != NET_HEADER )
-        {
-            CK_FPRINTF_STDERR( "[chuck]: header mismatch - possible endian lunacy...\n" );
-            ck_close( client );
-            continue;
-        }
 
-        while( msg.type != MSG_DONE )
-        {
-            if( carrier->vm )
-            {
-                if( !otf_process_msg( carrier->vm, carrier->compiler, &msg, FALSE, client ) )
-                {
-                    ret.param = FALSE;
-                    strcpy( (char *)ret.buffer, EM_lasterror() );
-                    while( msg.type != MSG_DONE && n )
-                    {
-                        n = ck_recv( client, (char *)&msg, sizeof(msg) );
-                        otf_ntoh( &msg );
-                    }
-                    break;
-                }
-                else
-                {
-                    ret.param = TRUE;
-                    strcpy( (char *)ret.buffer, "success" );
-                    n = ck_recv( client, (char *)&msg, sizeof(msg) );
-                    otf_ntoh( &msg );
-                }
-            }
-            else
-            {
-                usleep( 10000 );
-            }
-        }
-        
-        otf_hton( &ret );
-        ck_send( client, (char *)&ret, sizeof(ret) );
-        ck_close( client );
+        Otf_Session * session = new Otf_Session;
+        session->carrier = carrier;
+        session->client = client;
+        g_otf_pool->submit( otf_session_cb, session );
     }
     
     return NULL;
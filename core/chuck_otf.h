@@ -35,6 +35,8 @@
 #include "chuck_def.h"
 #include "util_network.h"
 #include <memory.h>
+#include <string>
+#include <vector>
 
 
 // defines
@@ -43,6 +45,12 @@
 #define NET_BUFFER_SIZE 512
 // error value
 #define NET_ERROR       0xffffffff
+// first word of a streaming (length-prefixed) connection
+#define NET_STREAM_HEADER 0x8c8cc8c9
+// most operations in one streamed batch
+#define NET_BATCH_MAX   512
+// largest name or file accepted in one streamed operation
+#define NET_FRAME_MAX   (64 * 1024 * 1024)
 // forward
 struct Chuck_VM;
 struct Chuck_Compiler;
@@ -68,6 +76,23 @@ struct Net_Msg
 };
 
 
+//-----------------------------------------------------------------------------
+// name: struct Net_Op()
+// desc: one operation of a streamed batch; on the wire, four 32-bit
+//       big-endian words (type, param, name length, body length), then the
+//       name ("file.ck:arg:arg") and the body (the whole source file)
+//-----------------------------------------------------------------------------
+struct Net_Op
+{
+    t_CKUINT type;
+    t_CKUINT param;
+    std::string name;
+    std::string body;
+
+    Net_Op( t_CKUINT t = 0, t_CKUINT p = 0 ) : type( t ), param( p ) { }
+};
+
+
 // host to network
 void otf_hton( Net_Msg * msg );
 // network to host
@@ -83,6 +108,11 @@ int otf_send_cmd( int argc, const char ** argv, t_CKINT & i, const char * host,
 int otf_send_file( const char * filename, Net_Msg & msg, const char * op, ck_socket sock );
 // connect
 ck_socket otf_send_connect( const char * host, int port );
+// connect for streaming
+ck_socket otf_stream_connect( const char * host, int port );
+// send ops as one batch (compiled and sporked together), wait for the reply
+t_CKBOOL otf_send_batch( ck_socket sock, const std::vector<Net_Op> & ops,
+                         std::string * reply = NULL );
 
 // callback
 void * otf_cb( void * p );
@@ -38,10 +38,17 @@ using namespace std;
 
 // global
 static char g_filename[1024] = "";
+// arena holding g_program
+a_Arena g_program_arena = NULL;
 
 // external
 extern "C" { 
     extern FILE *yyin;
+    typedef struct yy_buffer_state * YY_BUFFER_STATE;
+    YY_BUFFER_STATE yy_create_buffer( FILE * file, int size );
+    YY_BUFFER_STATE yy_scan_bytes( const char * bytes, size_t len );
+    void yy_switch_to_buffer( YY_BUFFER_STATE b );
+    void yy_delete_buffer( YY_BUFFER_STATE b );
 }
 
 
@@ -65,35 +72,6 @@ FILE * open_cat_ck( c_str fname )
 
 
 
-//-----------------------------------------------------------------------------
-// name: win32_tmpfile()
-// desc: replacement for broken tmpfile() on Windows Vista + 7
-//-----------------------------------------------------------------------------
-#ifdef __PLATFORM_WIN32__
-
-#include <windows.h>
-
-FILE *win32_tmpfile()
-{
-    char tmp_path[MAX_PATH];
-    char file_path[MAX_PATH];
-    FILE * file = NULL;
-    
-    if(GetTempPath(256, tmp_path) == 0)
-        return NULL;
-    
-    if(GetTempFileName(tmp_path, "mA", 0, file_path) == 0)
-        return NULL;
-    
-    file = fopen(file_path, "wb+D");
-    
-    return file;
-}
-
-#endif
-
-
-
 //-----------------------------------------------------------------------------
 // name: chuck_parse()
 // desc: ...
@@ -102,6 +80,7 @@ t_CKBOOL chuck_parse( c_constr fname, FILE * fd, c_constr code )
 {
 	t_CKBOOL clo = FALSE;
     t_CKBOOL ret = FALSE;
+    YY_BUFFER_STATE ybs = NULL;
 
     // sanity check
     if( fd && code )
@@ -110,82 +89,54 @@ t_CKBOOL chuck_parse( c_constr fname, FILE * fd, c_constr code )
         return FALSE;
     }
 
-    // prepare code
+    // remember filename
+    strcpy( g_filename, fname );
+
+    // lex straight from memory
     if( code )
     {
         // !
         assert( fd == NULL );
-        // generate temp file
-#ifdef __PLATFORM_WIN32__
-        fd = win32_tmpfile();
-#else
-        fd = tmpfile();
-#endif
-        // flag it to close
-        clo = TRUE;
-        // write
-        fwrite( code, sizeof(char), strlen(code), fd );
-    }
-
-    /*
-    // use code from memory buffer if its available
-    if( code )
-    {
-        // copy name
-        strcpy( g_filename, fname );
         // reset
         if( EM_reset( g_filename, NULL ) == FALSE ) goto cleanup;
-
-        // TODO: clean g_program
-        g_program = NULL;
-
-        // clean
-        yyrestart( NULL );
-
-        // load string (yy_scan_string will copy the C string)
-        YY_BUFFER_STATE ybs = yy_scan_string( code );
+        // load (copies the bytes)
+        ybs = yy_scan_bytes( code, strlen(code) );
         if( !ybs ) goto cleanup;
-
-        // parse
-        if( !( yyparse() == 0 ) ) goto cleanup;
-        
-        // delete the lexer buffer
-        yy_delete_buffer( ybs );
-
     }
-    */
-
-    // remember filename
-    strcpy( g_filename, fname );
-        
-    // test it
-    if( !fd ) {
-        fd = open_cat_ck( g_filename );
-        if( !fd ) strcpy( g_filename, fname );
-        else clo = TRUE;
-    }
-
-    // reset
-    if( EM_reset( g_filename, fd ) == FALSE ) goto cleanup;
+    else
+    {
+        // test it
+        if( !fd ) {
+            fd = open_cat_ck( g_filename );
+            if( !fd ) strcpy( g_filename, fname );
+            else clo = TRUE;
+        }
 
-    // lexer/parser
-    // TODO: if( yyin ) { fclose( yyin ); yyin = NULL; }
+        // reset
+        if( EM_reset( g_filename, fd ) == FALSE ) goto cleanup;
+
+        // if no fd, open
+        if( !fd ) { fd = fopen( g_filename, "r" ); if( fd ) clo = TRUE; }
+        // if still none
+        if( !fd ) { EM_error2( 0, "no such file or directory" ); goto cleanup; }
+        // set to beginning
+        else fseek( fd, 0, SEEK_SET );
+
+        // lex from fd, in a buffer of our own (deleted below, like the
+        // one for code, so switching between the two leaks neither)
+        ybs = yy_create_buffer( fd, 16384 );
+        if( !ybs ) goto cleanup;
+        yy_switch_to_buffer( ybs );
 
-    // if no fd, open
-    if( !fd ) { fd = fopen( g_filename, "r" ); if( fd ) clo = TRUE; }
-    // if still none
-    if( !fd ) { EM_error2( 0, "no such file or directory" ); goto cleanup; }
-    // set to beginning
-    else fseek( fd, 0, SEEK_SET );
+        // check
+        if( yyin == NULL ) goto cleanup;
+    }
 
-    // reset yyin to fd
-    yyrestart( fd );
-        
-    // check
-    if( yyin == NULL ) goto cleanup;
-        
-    // TODO: clean g_program
-    g_program = NULL;
+    // let go of the previous tree
+    release_parse();
+    // the new one goes into its own arena
+    g_program_arena = new_arena();
+    use_arena( g_program_arena );
         
     // parse
     if( !(yyparse( ) == 0) ) goto cleanup;
@@ -195,7 +146,13 @@ t_CKBOOL chuck_parse( c_constr fname, FILE * fd, c_constr code )
 
 cleanup:
 
+    // back to the heap
+    use_arena( NULL );
+    // no partial trees
+    if( !ret ) release_parse();
+
     // done
+    if( ybs ) yy_delete_buffer( ybs );
 	if( clo ) fclose( fd );
 
     return ret;
@@ -217,6 +174,21 @@ void reset_parse( )
 
 
 
+//------------------------------------------------------------------------------
+// name: release_parse()
+// desc: drop the parser's reference to the last parse tree; its arena is
+//       freed once nothing compiled from it (context, funcs, classes) is left
+//------------------------------------------------------------------------------
+void release_parse( )
+{
+    g_program = NULL;
+    arena_release( g_program_arena );
+    g_program_arena = NULL;
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: parseLine()
 // desc: ...
@@ -47,6 +47,9 @@
   extern a_Program g_program;
 #endif
 
+// arena holding g_program (see release_parse)
+extern a_Arena g_program_arena;
+
 // link with the parser
 extern "C" int yyparse( void );
 extern "C" void yyrestart( FILE * );
@@ -62,6 +65,8 @@ FILE * open_cat_ck( c_str filename );
 t_CKBOOL chuck_parse( c_constr fname, FILE * fd = NULL, c_constr code = NULL );
 // reset the parser
 void reset_parse( );
+// let go of the last parse tree
+void release_parse( );
 
 
 // syntax highlighting tools
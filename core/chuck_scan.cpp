@@ -271,6 +271,9 @@ t_CKBOOL type_engine_scan0_class_def( Chuck_Env * env, a_Class_Def class_def )
     // TODO: add ref to the parent?
     the_class->func = NULL;
     the_class->def = class_def;
+    // keep the tree around for as long as the class
+    the_class->def_arena = env->context->parse_arena;
+    arena_add_ref( the_class->def_arena );
     // add code
     the_class->info->pre_ctor = new Chuck_VM_Code;
     SAFE_ADD_REF( the_class->info->pre_ctor );
@@ -2501,6 +2504,9 @@ t_CKBOOL type_engine_scan2_func_def( Chuck_Env * env, a_Func_Def f )
     func->name = func_name;
     // reference the function definition
     func->def = f;
+    // keep the tree around for as long as the function
+    func->def_arena = env->context->parse_arena;
+    arena_add_ref( func->def_arena );
     // note whether the function is marked as member
     func->is_member = (f->static_decl != ae_key_static) && 
                       (env->class_def != NULL);
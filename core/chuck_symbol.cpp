@@ -35,22 +35,11 @@
 #include "chuck_utils.h"
 #include "chuck_symbol.h"
 #include "chuck_table.h"
+#include "util_thread.h"
 
 
-// S_Symbol
-struct S_Symbol_ { c_str name; S_Symbol next; };
-
-static S_Symbol mksymbol( c_constr name, S_Symbol next )
-{
-    S_Symbol s = (S_Symbol)checked_malloc(sizeof(*s));
-    s->name = (c_str)checked_malloc(strlen(name)+1);
-    strcpy(s->name, (c_str)name); s->next=next;
-    return s;
-}
-
-#define SIZE 65347  /* should be prime */
-
-static S_Symbol hashtable[SIZE];
+// S_Symbol (the name is stored right after the struct, in the same block)
+struct S_Symbol_ { c_str name; unsigned int hash; };
 
 static unsigned int hash(const char *s0)
 {
@@ -59,24 +48,73 @@ static unsigned int hash(const char *s0)
         h = h*65599 + *s;
     return h;
 }
- 
-static int streq(c_constr a, c_constr b)
+
+static S_Symbol mksymbol( c_constr name, unsigned int h )
 {
-    return !strcmp((char*)a,(char*)b);
+    size_t len = strlen(name);
+    S_Symbol s = (S_Symbol)checked_malloc(sizeof(*s) + len + 1);
+    s->name = (c_str)(s + 1);
+    memcpy(s->name, name, len + 1); s->hash = h;
+    return s;
 }
 
-S_Symbol insert_symbol(c_constr name)
+// the symbol table: open addressing with linear probing, doubled when half
+// full; one table for the process, since symbols are shared by every
+// compiler instance (hence the lock: instances may compile concurrently)
+#define SYMTAB_INIT_SIZE 4096  /* power of 2 */
+
+static S_Symbol * symtab = NULL;
+static unsigned int symtab_size = 0;
+static unsigned int symtab_count = 0;
+static XMutex symtab_lock;
+
+static void symtab_grow()
 {
-    S_Symbol syms = NULL, sym;
-    int index= hash(name) % SIZE;
+    unsigned int size = symtab_size ? symtab_size * 2 : SYMTAB_INIT_SIZE;
+    S_Symbol * table = (S_Symbol *)checked_malloc(sizeof(S_Symbol) * size);
+    memset(table, 0, sizeof(S_Symbol) * size);
+
+    // rehash
+    for(unsigned int i = 0; i < symtab_size; i++)
+    {
+        S_Symbol sym = symtab[i];
+        if( !sym ) continue;
+        unsigned int index = sym->hash & (size-1);
+        while( table[index] ) index = (index+1) & (size-1);
+        table[index] = sym;
+    }
+
+    free(symtab);
+    symtab = table;
+    symtab_size = size;
+}
 
+S_Symbol insert_symbol(c_constr name)
+{
     if( !name ) return NULL;
-    syms = hashtable[index];
-    for(sym=syms; sym; sym=sym->next)
-        if (streq(sym->name,name)) return sym;
-    sym = mksymbol(name,syms);
-    hashtable[index]=sym;
-    
+
+    unsigned int h = hash(name);
+    S_Symbol sym = NULL;
+
+    symtab_lock.acquire();
+
+    if( symtab_size == 0 ) symtab_grow();
+
+    unsigned int index = h & (symtab_size-1);
+    while( (sym = symtab[index]) )
+    {
+        if( sym->hash == h && !strcmp(sym->name, name) ) break;
+        index = (index+1) & (symtab_size-1);
+    }
+
+    if( !sym )
+    {
+        sym = symtab[index] = mksymbol(name, h);
+        if( ++symtab_count * 2 > symtab_size ) symtab_grow();
+    }
+
+    symtab_lock.release();
+
     return sym;
 }
 
@@ -161,7 +161,7 @@ Chuck_Env::Chuck_Env( )
     global_nspc = global_context.nspc; SAFE_ADD_REF(global_nspc);
     // deprecated stuff
     deprecated.clear(); deprecate_level = 1;
-    user_nspc = NULL;
+    user_nspc = NULL; user_changes_base = 0;
     // clear
     this->reset();
     
@@ -552,6 +552,9 @@ Chuck_Context * type_engine_make_context( a_Program prog, const string & filenam
     Chuck_Context * context = new Chuck_Context;
     // save a reference to the parse tree
     context->parse_tree = prog;
+    // ...and hold on to the memory it lives in
+    context->parse_arena = prog ? g_program_arena : NULL;
+    arena_add_ref( context->parse_arena );
     // set name
     context->filename = filename;
 
@@ -3154,6 +3157,10 @@ t_CKTYPE type_engine_check_exp_decl( Chuck_Env * env, a_Exp_Decl decl )
             // move the offset (TODO: check the size)
             env->curr->offset = type_engine_next_offset( env->curr->offset, type );
             // env->curr->offset += type->size;
+            // object members declared in chuck hold counted references
+            // (native mvars, imported through here too, are the class's own)
+            if( is_obj && env->class_def->def )
+                env->class_def->obj_mvar_offsets.push_back( value->offset );
         }
         else if( decl->is_static ) // static
         {
@@ -4477,7 +4484,8 @@ Chuck_Context::~Chuck_Context()
         new_types.clear();
     }
 
-    // TODO: delete abstract syntax tree * 
+    // let go of the abstract syntax tree (freed once unused)
+    arena_release( parse_arena );
 }
 
 
@@ -4547,21 +4555,21 @@ void Chuck_Context::rollback()
 t_CKBOOL type_engine_check_reserved( Chuck_Env * env, const string & xid, int pos )
 {
     // key word?
-    if( env->key_words[xid] )
+    if( env->key_words.count( xid ) && env->key_words[xid] )
     {
         EM_error2( pos, "illegal use of keyword '%s'.", xid.c_str() );
         return TRUE;
     }
 
     // key value?
-    if( env->key_values[xid] )
+    if( env->key_values.count( xid ) && env->key_values[xid] )
     {
         EM_error2( pos, "illegal re-declaration of reserved value '%s'.", xid.c_str() );
         return TRUE;
     }
 
     // key type?
-    if( env->key_types[xid] )
+    if( env->key_types.count( xid ) && env->key_types[xid] )
     {
         EM_error2( pos, "illegal use of reserved type id '%s'.", xid.c_str() );
         return TRUE;
@@ -5574,6 +5582,32 @@ t_CKBOOL type_engine_import_add_ex( Chuck_Env * env, const char * ex )
 
 
 
+//-----------------------------------------------------------------------------
+// name: type_engine_import_dtor_async()
+// desc: the class's dtor only frees the object's own memory, so it may run
+//       on the reaper thread instead of the thread that let the object go;
+//       unlink, if any, runs first on that thread (it may be the dtor itself,
+//       if the dtor only releases references and clears them)
+//-----------------------------------------------------------------------------
+t_CKBOOL type_engine_import_dtor_async( Chuck_Env * env, f_dtor unlink )
+{
+    // make sure we are in class
+    if( !env->class_def )
+    {
+        // error
+        EM_error2( 0,
+                   "import error: import_dtor_async invoked between begin/end" );
+        return FALSE;
+    }
+
+    env->class_def->dtor_async = TRUE;
+    env->class_def->dtor_unlink = unlink;
+
+    return TRUE;
+}
+
+
+
 //-----------------------------------------------------------------------------
 // name: type_engine_register_deprecate()
 // desc: ...
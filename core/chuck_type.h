@@ -81,6 +81,100 @@ typedef enum {
 
 
 
+//-----------------------------------------------------------------------------
+// name: struct Chuck_Scope_Frame
+// desc: one level of a scope: open-addressed hash map from interned symbol
+//       to object, probed linearly from the symbol's address; entries are
+//       never removed, only the whole frame cleared (keeping its storage)
+//-----------------------------------------------------------------------------
+struct Chuck_Scope_Frame
+{
+public:
+    Chuck_Scope_Frame() : m_keys( NULL ), m_vals( NULL ), m_size( 0 ), m_count( 0 ) { }
+    ~Chuck_Scope_Frame() { delete [] m_keys; delete [] m_vals; }
+
+    // value for key, NULL if none
+    Chuck_VM_Object * find( S_Symbol key ) const
+    {
+        if( !m_count ) return NULL;
+        for( t_CKUINT i = slot( key ); m_keys[i]; i = (i+1) & (m_size-1) )
+            if( m_keys[i] == key ) return m_vals[i];
+        return NULL;
+    }
+
+    // set value for key
+    void set( S_Symbol key, Chuck_VM_Object * val )
+    {
+        // grow when half full
+        if( (m_count+1) * 2 > m_size ) grow();
+        t_CKUINT i = slot( key );
+        while( m_keys[i] && m_keys[i] != key ) i = (i+1) & (m_size-1);
+        if( !m_keys[i] ) { m_keys[i] = key; m_count++; }
+        m_vals[i] = val;
+    }
+
+    // remove everything
+    void clear()
+    {
+        if( !m_count ) return;
+        memset( m_keys, 0, m_size * sizeof(S_Symbol) );
+        m_count = 0;
+    }
+
+    // number of entries
+    t_CKUINT size() const { return m_count; }
+    // the non-NULL values, in no particular order
+    void values( std::vector<Chuck_VM_Object *> & out ) const
+    {
+        for( t_CKUINT i = 0; i < m_size; i++ )
+            if( m_keys[i] && m_vals[i] ) out.push_back( m_vals[i] );
+    }
+
+    // iterate: slots 0 to capacity(), skipping those with a NULL key
+    t_CKUINT capacity() const { return m_size; }
+    S_Symbol key_at( t_CKUINT i ) const { return m_keys[i]; }
+    Chuck_VM_Object * value_at( t_CKUINT i ) const { return m_vals[i]; }
+
+protected:
+    t_CKUINT slot( S_Symbol key ) const
+    { return (((t_CKUINT)key >> 4) * 2654435761u) & (m_size-1); }
+
+    void grow()
+    {
+        S_Symbol * keys = m_keys;
+        Chuck_VM_Object ** vals = m_vals;
+        t_CKUINT size = m_size;
+
+        m_size = size ? size * 2 : 8;
+        m_keys = new S_Symbol[m_size];
+        m_vals = new Chuck_VM_Object *[m_size];
+        memset( m_keys, 0, m_size * sizeof(S_Symbol) );
+        m_count = 0;
+
+        // rehash
+        for( t_CKUINT i = 0; i < size; i++ )
+            if( keys[i] ) set( keys[i], vals[i] );
+
+        delete [] keys;
+        delete [] vals;
+    }
+
+protected:
+    S_Symbol * m_keys;
+    Chuck_VM_Object ** m_vals;
+    // capacity (power of 2) and number of keys
+    t_CKUINT m_size;
+    t_CKUINT m_count;
+
+private:
+    // not copyable
+    Chuck_Scope_Frame( const Chuck_Scope_Frame & );
+    Chuck_Scope_Frame & operator =( const Chuck_Scope_Frame & );
+};
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: struct Chuck_Scope
 // desc: scoping structure
@@ -90,36 +184,45 @@ struct Chuck_Scope
 {
 public:
     // constructor
-    Chuck_Scope() { this->push(); }
+    Chuck_Scope() : depth( 0 ), changes( 0 ) { this->push(); }
     // desctructor
-    ~Chuck_Scope() { this->pop(); }
+    ~Chuck_Scope()
+    {
+        for( t_CKUINT i = 0; i < scope.size(); i++ )
+            delete scope[i];
+    }
 
-    // push scope
-    void push() { scope.push_back( new std::map<S_Symbol, Chuck_VM_Object *> ); }
+    // push scope; frames popped earlier are reused rather than reallocated
+    void push()
+    {
+        if( depth == scope.size() ) scope.push_back( new Chuck_Scope_Frame );
+        else scope[depth]->clear();
+        depth++;
+    }
 
     // pop scope
     void pop()
     {
-        assert( scope.size() != 0 );
+        assert( depth != 0 );
         // TODO: release contents of scope.back()
-        delete scope.back(); scope.pop_back();
+        depth--;
     }
 
     // reset the scope
     void reset()
-    { scope.clear(); this->push(); }
+    { depth = 0; this->push(); changes++; }
     
     // atomic commit
     void commit()
     {
-        assert( scope.size() != 0 );        
-        std::map<S_Symbol, Chuck_VM_Object *>::iterator iter;
+        assert( depth != 0 );
 
         // go through buffer    
-        for( iter = commit_map.begin(); iter != commit_map.end(); iter++ )
+        for( t_CKUINT i = 0; i < commit_map.capacity(); i++ )
         {
             // add to front/where
-            (*scope.front())[(*iter).first] = (*iter).second;
+            if( commit_map.key_at(i) )
+                front()->set( commit_map.key_at(i), commit_map.value_at(i) );
         }
 
         // clear
@@ -129,14 +232,17 @@ public:
     // roll back since last commit or beginning
     void rollback()
     {
-        assert( scope.size() != 0 );
-        std::map<S_Symbol, Chuck_VM_Object *>::iterator iter;
+        assert( depth != 0 );
+
+        // anything to undo
+        if( commit_map.size() ) changes++;
 
         // go through buffer    
-        for( iter = commit_map.begin(); iter != commit_map.end(); iter++ )
+        for( t_CKUINT i = 0; i < commit_map.capacity(); i++ )
         {
             // release
-            (*iter).second->release();
+            if( commit_map.key_at(i) && commit_map.value_at(i) )
+                commit_map.value_at(i)->release();
         }
 
         // clear
@@ -148,12 +254,12 @@ public:
     { this->add( insert_symbol(xid.c_str()), value ); }
     void add( S_Symbol xid, Chuck_VM_Object * value )
     {
-        assert( scope.size() != 0 );
+        assert( depth != 0 );
         // add if back is NOT front
-        if( scope.back() != scope.front() )
-            (*scope.back())[xid] = value;
+        if( depth > 1 )
+            back()->set( xid, value );
         // add for commit
-        else commit_map[xid] = value;
+        else { commit_map.set( xid, value ); changes++; }
         // add reference
         SAFE_ADD_REF(value);
     }
@@ -166,31 +272,27 @@ public:
     // -1 base, 0 current, 1 climb
     T lookup( S_Symbol xid, t_CKINT climb = 1 )
     {
-        Chuck_VM_Object * val = NULL; assert( scope.size() != 0 );
+        Chuck_VM_Object * val = NULL; assert( depth != 0 );
 
         if( climb == 0 )
         {
-            val = (*scope.back())[xid];
+            val = back()->find( xid );
             // look in commit buffer if the back is the front
-            if( !val && scope.back() == scope.front() 
-                && (commit_map.find(xid) != commit_map.end()) ) 
-                val = commit_map[xid];
+            if( !val && depth == 1 ) val = commit_map.find( xid );
         }
         else if( climb > 0 )
         {
-            for( t_CKUINT i = scope.size(); i > 0; i-- )
-            { if( ( val = (*scope[i-1])[xid] ) ) break; }
+            for( t_CKUINT i = depth; i > 0; i-- )
+            { if( ( val = scope[i-1]->find( xid ) ) ) break; }
 
             // look in commit buffer
-            if( !val && (commit_map.find(xid) != commit_map.end()) )
-                val = commit_map[xid];
+            if( !val ) val = commit_map.find( xid );
         }
         else
         {
-            val = (*scope.front())[xid];
+            val = front()->find( xid );
             // look in commit buffer
-            if( !val && (commit_map.find(xid) != commit_map.end()) )
-                val = commit_map[xid];
+            if( !val ) val = commit_map.find( xid );
         }
 
         return (T)val;
@@ -199,45 +301,41 @@ public:
     // get list of top level
     void get_toplevel( std::vector<Chuck_VM_Object *> & out )
     {
-        assert( scope.size() != 0 );
-        std::map<S_Symbol, Chuck_VM_Object *>::iterator iter;
+        assert( depth != 0 );
 
         // clear the out
         out.clear();
-        // get the front of the array
-        std::map<S_Symbol, Chuck_VM_Object *> * m = scope.front();
-
-        // go through map
-        for( iter = m->begin(); iter != m->end(); iter++ )
-        {
-            // add
-            out.push_back( (*iter).second );
-        }
+        // go through the front
+        front()->values( out );
     }
+
+    // changes to the top level so far (only ever goes up)
+    t_CKUINT num_changes() const { return changes; }
     
     // get list of top level
     void get_level( int level, std::vector<Chuck_VM_Object *> & out )
     {
-        assert( scope.size() >= level );
-        std::map<S_Symbol, Chuck_VM_Object *>::iterator iter;
+        assert( (t_CKINT)depth >= level );
         
         // clear the out
         out.clear();
-        // get the front of the array
-        std::map<S_Symbol, Chuck_VM_Object *> * m = &commit_map;
-        
-        // go through map
-        for( iter = m->begin(); iter != m->end(); iter++ )
-        {
-            // add
-            out.push_back( (*iter).second );
-        }
+        // go through the commit buffer
+        commit_map.values( out );
     }
     
 
 protected:
-    std::vector<std::map<S_Symbol, Chuck_VM_Object *> *> scope;
-    std::map<S_Symbol, Chuck_VM_Object *> commit_map;
+    Chuck_Scope_Frame * front() { return scope[0]; }
+    Chuck_Scope_Frame * back() { return scope[depth-1]; }
+
+protected:
+    // frames; the first 'depth' are in use
+    std::vector<Chuck_Scope_Frame *> scope;
+    t_CKUINT depth;
+    // top-level additions not yet committed
+    Chuck_Scope_Frame commit_map;
+    // top-level additions, rollbacks, and resets
+    t_CKUINT changes;
 };
 
 
@@ -316,6 +414,10 @@ struct Chuck_Namespace : public Chuck_VM_Object
         type.rollback(); value.rollback(); func.rollback();
     }
 
+    // changes to the top level so far (only ever goes up)
+    t_CKUINT num_changes() const
+    { return type.num_changes() + value.num_changes() + func.num_changes(); }
+
     // get top level types
     void get_types( std::vector<Chuck_Type *> & out );
     // get top level values
@@ -339,6 +441,8 @@ struct Chuck_Context : public Chuck_VM_Object
     std::string full_path;
     // parse tree
     a_Program parse_tree;
+    // arena holding the parse tree
+    a_Arena parse_arena;
     // context namespace
     Chuck_Namespace * nspc;
     // public class def if any
@@ -367,7 +471,7 @@ struct Chuck_Context : public Chuck_VM_Object
     void rollback();
 
     // constructor
-    Chuck_Context() { parse_tree = NULL; nspc = new Chuck_Namespace; 
+    Chuck_Context() { parse_tree = NULL; parse_arena = NULL; nspc = new Chuck_Namespace; 
                       public_class_def = NULL; has_error = FALSE;
                       progress = P_NONE; }
     // destructor
@@ -410,6 +514,8 @@ protected:
     Chuck_Context global_context;
     // user-global namespace
     Chuck_Namespace * user_nspc;
+    // changes made to user namespaces cleared so far
+    t_CKUINT user_changes_base;
 
 public:
     // global namespace
@@ -492,12 +598,20 @@ public:
     
     void clear_user_namespace()
     {
+        // the new namespace starts counting after the old one
+        if(user_nspc) user_changes_base += user_nspc->num_changes() + 1;
         if(user_nspc) SAFE_RELEASE(user_nspc->parent);
         SAFE_RELEASE(user_nspc);
         load_user_namespace();
         this->reset();
     }
 
+    // version of what every compile can see (global and user namespaces);
+    // goes up whenever either changes or the user namespace is cleared
+    t_CKUINT version()
+    { return global_nspc->num_changes() + user_changes_base +
+             (user_nspc ? user_nspc->num_changes() : 0); }
+
     // top
     Chuck_Namespace * nspc_top( )
     { assert( nspc_stack.size() > 0 ); return nspc_stack.back(); }
@@ -597,12 +711,17 @@ struct Chuck_Type : public Chuck_VM_Object
     t_CKUINT array_depth;
     // object size (size in memory)
     t_CKUINT obj_size;
+    // offsets of object members declared by this class in chuck (traced by
+    // the cycle collector; parents' are in theirs)
+    std::vector<t_CKUINT> obj_mvar_offsets;
     // type info
     Chuck_Namespace * info;
     // func info
     Chuck_Func * func;
     // def
     a_Class_Def def;
+    // arena holding def (if parsed)
+    a_Arena def_arena;
     // ugen
     Chuck_UGen_Info * ugen_info;
     // copy
@@ -613,6 +732,10 @@ struct Chuck_Type : public Chuck_VM_Object
     t_CKBOOL has_constructor;
     // has destructor
     t_CKBOOL has_destructor;
+    // destructor only frees the object's own memory (may run on the reaper)
+    t_CKBOOL dtor_async;
+    // ...after this has run in place (e.g. releasing references)
+    f_dtor dtor_unlink;
     // custom allocator
     f_alloc allocator;
     
@@ -629,9 +752,9 @@ public:
         m_env = env;
         xid = _id; name = _n; parent = _p; size = _s; owner = NULL;
         array_type = NULL; array_depth = 0; obj_size = 0;
-        info = NULL; func = NULL; def = NULL; is_copy = FALSE; 
+        info = NULL; func = NULL; def = NULL; def_arena = NULL; is_copy = FALSE; 
         ugen_info = NULL; is_complete = TRUE; has_constructor = FALSE;
-        has_destructor = FALSE;
+        has_destructor = FALSE; dtor_async = FALSE; dtor_unlink = NULL;
         allocator = NULL;
     }
 
@@ -658,6 +781,10 @@ public:
             // SAFE_RELEASE(func);
             // SAFE_RELEASE(ugen_info);
         }
+
+        // let go of the parse tree
+        arena_release( def_arena );
+        def_arena = NULL;
     }   
     
     // assignment - this does not touch the Chuck_VM_Object
@@ -673,6 +800,8 @@ public:
         this->obj_size = rhs.obj_size;
         this->size = rhs.size;
         this->def = rhs.def;
+        this->def_arena = rhs.def_arena;
+        arena_add_ref( this->def_arena );
         this->is_copy = TRUE;
         this->array_depth = rhs.array_depth;
         this->array_type = rhs.array_type;
@@ -788,6 +917,8 @@ struct Chuck_Func : public Chuck_VM_Object
     std::string name;
     // func def from parser
     a_Func_Def def;
+    // arena holding def (if parsed)
+    a_Arena def_arena;
     // code (included imported)
     Chuck_VM_Code * code;
     // imported code
@@ -807,12 +938,12 @@ struct Chuck_Func : public Chuck_VM_Object
     std::string doc;
 
     // constructor
-    Chuck_Func() { def = NULL; code = NULL; is_member = FALSE; vt_index = 0xffffffff; 
+    Chuck_Func() { def = NULL; def_arena = NULL; code = NULL; is_member = FALSE; vt_index = 0xffffffff; 
                    value_ref = NULL; /*dl_code = NULL;*/ next = NULL; up = NULL; }
 
     // destructor
     virtual ~Chuck_Func()
-    { }
+    { arena_release( def_arena ); }
 };
 
 
@@ -899,6 +1030,7 @@ t_CKBOOL type_engine_import_svar( Chuck_Env * env, const char * type,
 t_CKBOOL type_engine_import_ugen_ctrl( Chuck_Env * env, const char * type, const char * name,
                                        f_ctrl ctrl, t_CKBOOL write, t_CKBOOL read );
 t_CKBOOL type_engine_import_add_ex( Chuck_Env * env, const char * ex );
+t_CKBOOL type_engine_import_dtor_async( Chuck_Env * env, f_dtor unlink = NULL );
 t_CKBOOL type_engine_import_class_end( Chuck_Env * env );
 t_CKBOOL type_engine_register_deprecate( Chuck_Env * env, 
                                          const std::string & former, const std::string & latter );
@@ -250,7 +250,10 @@ void Chuck_UGen::done()
     SAFE_DELETE_ARRAY( m_current_v );
 
     // more reclaim (added 1.3.0.0)
-    SAFE_DELETE_ARRAY( m_multi_chan );
+    // (mono allocates one, and sets the size to 0; none allocates one too)
+    if( m_multi_chan ) Chuck_VM_Alloc::instance()->free_block( m_multi_chan,
+        ( m_multi_chan_size ? m_multi_chan_size : 1 ) * sizeof(Chuck_UGen *) );
+    m_multi_chan = NULL;
     // TODO: m_multi_chan, break ref count loop
     
     // SPENCERTODO: is this okay??? (added 1.3.0.0)
@@ -265,6 +268,33 @@ void Chuck_UGen::done()
 
 
 
+//-----------------------------------------------------------------------------
+// name: unlink()
+// desc: leave the graph and the shred now; done() then has nothing shared
+//       left to touch, wherever the destructor runs
+//-----------------------------------------------------------------------------
+t_CKBOOL Chuck_UGen::unlink()
+{
+    // subgraphs take their inlet and outlet down with them, in place
+    if( m_is_subgraph || m_inlet || m_outlet )
+        return FALSE;
+    if( !Chuck_Object::unlink() )
+        return FALSE;
+
+    if( this->shred )
+        shred->remove( this );
+    this->shred = NULL;
+
+    // disconnect
+    this->disconnect( TRUE );
+    m_valid = FALSE;
+
+    return TRUE;
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: alloc_v()
 // desc: ...
@@ -303,7 +333,8 @@ void Chuck_UGen::alloc_multi_chan( t_CKUINT num_ins, t_CKUINT num_outs )
     m_multi_chan_size = ( num_ins > num_outs ? num_ins : num_outs );
 
     // allocate
-    m_multi_chan = new Chuck_UGen *[m_multi_chan_size];
+    m_multi_chan = (Chuck_UGen **)Chuck_VM_Alloc::instance()->alloc_block(
+        ( m_multi_chan_size ? m_multi_chan_size : 1 ) * sizeof(Chuck_UGen *) );
     // zero it out, whoever call this will fill in
     memset( m_multi_chan, 0, m_multi_chan_size * sizeof(Chuck_UGen *) );
 
@@ -963,6 +994,8 @@ t_CKBOOL Chuck_UGen::system_tick( t_CKTIME now )
         {
             // tick the ugen (Chuck_DL_Api::Api::instance() added 1.3.0.0)
             if( tick ) m_valid = tick( this, m_sum, &m_current, NULL, Chuck_DL_Api::Api::instance() );
+            // mono tickf: one frame at a time
+            else if( tickf ) m_valid = tickf( this, &m_sum, &m_current, 1, NULL, Chuck_DL_Api::Api::instance() );
             if( !m_valid ) m_current = 0.0f;
             // apply gain and pan
             m_current *= m_gain * m_pan;
@@ -1186,6 +1219,9 @@ t_CKBOOL Chuck_UGen::system_tick_v( t_CKTIME now, t_CKUINT numFrames )
             if( tick )
                 for( j = 0; j < numFrames; j++ )
                     m_valid = tick( this, m_sum_v[j], &(m_current_v[j]), NULL, Chuck_DL_Api::Api::instance() );
+            // mono tickf: the whole block in one call
+            else if( tickf )
+                m_valid = tickf( this, m_sum_v, m_current_v, numFrames, NULL, Chuck_DL_Api::Api::instance() );
             if( !m_valid )
                 for( j = 0; j < numFrames; j++ )
                     m_current_v[j] = 0.0f;
@@ -65,6 +65,7 @@ public:
     virtual ~Chuck_UGen( );
     virtual void init();
     virtual void done();
+    virtual t_CKBOOL unlink();
 
 public: // src
     t_CKBOOL add( Chuck_UGen * src, t_CKBOOL isUpChuck );
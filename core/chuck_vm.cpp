@@ -46,6 +46,10 @@ using namespace std;
 #else
   #include <unistd.h>
   #include <pthread.h>
+  #include <time.h>
+#endif
+#if defined(__PLATFORM_MACOSX__)
+  #include <mach/mach_time.h>
 #endif
 
 // uncomment to compile VM debug messages
@@ -148,6 +152,10 @@ Chuck_VM::Chuck_VM()
     m_init = FALSE;
     m_input_ref = NULL;
     m_output_ref = NULL;
+    m_anchor_index = 0;
+    m_anchor[0].host = m_anchor[1].host = 0;
+    m_anchor[0].now = m_anchor[1].now = 0;
+    m_anchor[0].frames = m_anchor[1].frames = 0;
     
     // REFACTOR-2017: TODO might want to dynamically grow queue?
     m_set_external_int_queue.init( 1024 );
@@ -202,6 +210,8 @@ t_CKBOOL Chuck_VM::initialize( t_CKUINT srate, t_CKUINT dac_chan,
 
     // lockdown
     Chuck_VM_Object::lock_all();
+    // objects let go from here on are destroyed off the audio thread
+    Chuck_VM_Alloc::instance()->start_reaper();
 
     // log
     EM_log( CK_LOG_SYSTEM, "allocating shreduler..." );
@@ -349,6 +359,12 @@ t_CKBOOL Chuck_VM::shutdown()
     SAFE_DELETE( m_reply_buffer );
     // free the event buffer
     SAFE_DELETE( m_event_buffer );
+    // free the timed callback buffers
+    for( list<CBufferSimple *>::iterator i = m_timed_buffers.begin();
+         i != m_timed_buffers.end(); i++ )
+        delete *i;
+    m_timed_buffers.clear();
+    m_timed.clear();
 
     // log
     EM_log( CK_LOG_SEVERE, "clearing shreds..." );
@@ -377,6 +393,11 @@ t_CKBOOL Chuck_VM::shutdown()
     SAFE_RELEASE( m_dac );
     SAFE_RELEASE( m_adc );
     SAFE_RELEASE( m_bunghole );
+
+    // log
+    EM_log( CK_LOG_SYSTEM, "reaping released objects..." );
+    // everything released above, before the types go away
+    Chuck_VM_Alloc::instance()->stop_reaper();
     
     // set state
     m_init = FALSE;
@@ -508,6 +529,10 @@ t_CKBOOL Chuck_VM::compute()
             { event->broadcast(); iterate = TRUE; }
         }
 
+        // callbacks due now
+        if( !m_timed_buffers.empty() && run_timed_callbacks() )
+            iterate = TRUE;
+
         // process messages
         while( m_msg_buffer->get( &msg, 1 ) )
         { process_msg( msg ); iterate = TRUE; }
@@ -517,6 +542,15 @@ t_CKBOOL Chuck_VM::compute()
             release_dump();
     }
 
+    // adaptive blocks must stop at the next timed callback
+    if( !m_timed.empty() )
+    {
+        t_CKDUR diff = m_timed.begin()->first - m_shreduler->now_system;
+        if( diff < 0 ) diff = 0;
+        if( m_shreduler->m_samps_until_next < 0 || diff < m_shreduler->m_samps_until_next )
+            m_shreduler->m_samps_until_next = diff;
+    }
+
     // continue executing if have shreds left or if don't-halt
     // or if have shreds to add
     return ( m_num_shreds || !m_halt || m_spork_external_shred_queue.more() );
@@ -536,6 +570,13 @@ t_CKBOOL Chuck_VM::run( t_CKINT N, const SAMPLE * input, SAMPLE * output )
     // frame count
     t_CKINT frame = 0;
 
+    // anchor host time to the start of this block
+    volatile Clock_Anchor & anchor = m_anchor[!m_anchor_index];
+    anchor.host = host_time();
+    anchor.now = m_shreduler->now_system;
+    anchor.frames = N;
+    m_anchor_index = !m_anchor_index;
+
     // for now, check for external variables once per sample (below)
     // TODO: once per buffer instead? (place here then)
 
@@ -557,6 +598,9 @@ t_CKBOOL Chuck_VM::run( t_CKINT N, const SAMPLE * input, SAMPLE * output )
     // clear
     m_input_ref = NULL; m_output_ref = NULL;
 
+    // collect some cycles, between blocks
+    gc( CVM_GC_SLICE );
+
     return FALSE;
 
 // vm stop here
@@ -575,10 +619,17 @@ vm_stop:
 
 //-----------------------------------------------------------------------------
 // name: gc
-// desc: ...
+// desc: one bounded slice of cycle collection (about amount objects
+//       visited); run between audio blocks
 //-----------------------------------------------------------------------------
 void Chuck_VM::gc( t_CKUINT amount )
 {
+    Chuck_VM_Alloc * alloc = Chuck_VM_Alloc::instance();
+    if( !alloc->num_candidates() ) return;
+
+    // the shreds' stacks are roots
+    m_shreduler->shreds( m_gc_shreds );
+    alloc->collect( amount, m_gc_shreds );
 }
 
 
@@ -586,10 +637,11 @@ void Chuck_VM::gc( t_CKUINT amount )
 
 //-----------------------------------------------------------------------------
 // name: gc
-// desc: ...
+// desc: collect all candidate cycles now
 //-----------------------------------------------------------------------------
 void Chuck_VM::gc( )
 {
+    gc( 0 );
 }
 
 
@@ -609,6 +661,23 @@ t_CKBOOL Chuck_VM::queue_msg( Chuck_Msg * msg, int count )
 
 
 
+//-----------------------------------------------------------------------------
+// name: queue_msgs()
+// desc: queue several messages at once; compute() sees all or none of them.
+//       fails, queueing nothing, if the ring hasn't room for all of them
+//       (splitting the batch would let compute() see part of it)
+//-----------------------------------------------------------------------------
+t_CKBOOL Chuck_VM::queue_msgs( Chuck_Msg ** msgs, t_CKUINT num_msg )
+{
+    // messages the vm hasn't taken yet still hold their slots
+    if( num_msg > m_msg_buffer->space() ) return FALSE;
+    m_msg_buffer->put( msgs, num_msg );
+    return TRUE;
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: queue_event()
 // desc: since 1.3.0.0 a buffer is passed in associated with each thread
@@ -650,6 +719,115 @@ CBufferSimple * Chuck_VM::create_event_buffer()
 
 
 
+//-----------------------------------------------------------------------------
+// name: host_time()
+// desc: monotonic host clock, in seconds
+//-----------------------------------------------------------------------------
+t_CKFLOAT Chuck_VM::host_time()
+{
+#if defined(__PLATFORM_WIN32__)
+    LARGE_INTEGER freq, count;
+    QueryPerformanceFrequency( &freq );
+    QueryPerformanceCounter( &count );
+    return (t_CKFLOAT)count.QuadPart / freq.QuadPart;
+#elif defined(__PLATFORM_MACOSX__)
+    static mach_timebase_info_data_t info;
+    if( info.denom == 0 ) mach_timebase_info( &info );
+    return (t_CKFLOAT)mach_absolute_time() * info.numer / info.denom * 1e-9;
+#else
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: host_to_vm_time()
+// desc: map a host_time() stamp to VM time (any thread)
+//-----------------------------------------------------------------------------
+t_CKTIME Chuck_VM::host_to_vm_time( t_CKFLOAT host )
+{
+    const volatile Clock_Anchor & anchor = m_anchor[m_anchor_index];
+    t_CKFLOAT anchor_host = anchor.host;
+    // before the first block: as soon as possible
+    if( anchor_host == 0 ) return 0;
+    // the block after the one the stamp falls in, at the same offset
+    return anchor.now + anchor.frames + ( host - anchor_host ) * m_srate;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: create_timed_buffer()
+// desc: buffer for one producer thread to queue timed callbacks
+//-----------------------------------------------------------------------------
+CBufferSimple * Chuck_VM::create_timed_buffer()
+{
+    CBufferSimple * buffer = new CBufferSimple;
+    buffer->initialize( 1024, sizeof(Chuck_VM_Timed_Callback) );
+    m_timed_buffers.push_back( buffer );
+
+    return buffer;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: queue_callback()
+// desc: queue a timed callback (producer thread)
+//-----------------------------------------------------------------------------
+t_CKBOOL Chuck_VM::queue_callback( void (* callback)( void * ), void * data,
+                                   t_CKTIME when, CBufferSimple * buffer )
+{
+    Chuck_VM_Timed_Callback cb;
+    cb.callback = callback;
+    cb.data = data;
+    cb.when = when;
+    buffer->put( &cb, 1 );
+
+    return TRUE;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: run_timed_callbacks()
+// desc: collect queued callbacks, run the ones due (VM thread)
+//-----------------------------------------------------------------------------
+t_CKBOOL Chuck_VM::run_timed_callbacks()
+{
+    Chuck_VM_Timed_Callback cb;
+    t_CKBOOL ran = FALSE;
+
+    for( list<CBufferSimple *>::const_iterator i = m_timed_buffers.begin();
+         i != m_timed_buffers.end(); i++ )
+    {
+        while( (*i)->get( &cb, 1 ) )
+            m_timed.insert( std::make_pair( cb.when, cb ) );
+    }
+
+    // same rounding as the shreduler
+    while( !m_timed.empty() &&
+           m_timed.begin()->first <= m_shreduler->now_system + .5 )
+    {
+        cb = m_timed.begin()->second;
+        m_timed.erase( m_timed.begin() );
+        cb.callback( cb.data );
+        ran = TRUE;
+    }
+
+    return ran;
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: destroy_event_buffer()
 // desc: added 1.3.0.0 to fix uber-crash
@@ -702,6 +880,8 @@ t_CKUINT Chuck_VM::process_msg( Chuck_Msg * msg )
         if( !shred )
         {
             shred = new Chuck_VM_Shred;
+            // set the vm (initialize() needs it)
+            shred->vm_ref = this;
             shred->initialize( msg->code );
             shred->name = msg->code->name;
             shred->base_ref = shred->mem;
@@ -1834,7 +2014,7 @@ t_CKBOOL Chuck_VM_Shred::shutdown()
     release_v.reserve(m_ugen_map.size());
     
     // get iterator to our map
-    map<Chuck_UGen *, Chuck_UGen *>::iterator iter = m_ugen_map.begin();
+    UGen_Map::iterator iter = m_ugen_map.begin();
     while( iter != m_ugen_map.end() )
     {
         // get the ugen
@@ -1896,8 +2076,8 @@ t_CKBOOL Chuck_VM_Shred::shutdown()
     {
         for(list<Chuck_IO_Serial *>::iterator i = m_serials->begin(); i != m_serials->end(); i++)
         {
-            (*i)->release();
             (*i)->close();
+            (*i)->release();
         }
         
         m_serials->clear();
@@ -2719,6 +2899,28 @@ void Chuck_VM_Shreduler::status( )
 
 
 
+//-----------------------------------------------------------------------------
+// name: shreds()
+// desc: every shred the shreduler holds: waiting, blocked, and current
+//-----------------------------------------------------------------------------
+void Chuck_VM_Shreduler::shreds( std::vector<Chuck_VM_Shred *> & out )
+{
+    out.clear();
+
+    for( Chuck_VM_Shred * shred = shred_list; shred; shred = shred->next )
+        out.push_back( shred );
+
+    std::map<Chuck_VM_Shred *, Chuck_VM_Shred *>::iterator iter;
+    for( iter = blocked.begin(); iter != blocked.end(); iter++ )
+        out.push_back( (*iter).second );
+
+    if( m_current_shred )
+        out.push_back( m_current_shred );
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: Chuck_VM_Status()
 // desc: ...
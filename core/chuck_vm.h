@@ -63,6 +63,8 @@
 //-----------------------------------------------------------------------------
 #define CVM_MEM_STACK_SIZE          (0x1 << 16)
 #define CVM_REG_STACK_SIZE          (0x1 << 14)
+// objects the cycle collector visits per audio block
+#define CVM_GC_SLICE                (0x1 << 10)
 
 
 // forward references
@@ -166,6 +168,8 @@ struct Chuck_VM_Shred : Chuck_Object
 public:
     Chuck_VM_Shred( );
     ~Chuck_VM_Shred( );
+    // destroyed in place: shutdown() lets go of the shred's ugens
+    virtual t_CKBOOL unlink() { return FALSE; }
 
     t_CKBOOL initialize( Chuck_VM_Code * c, 
                          t_CKUINT mem_st_size = CVM_MEM_STACK_SIZE, 
@@ -222,7 +226,9 @@ public:
     t_CKBOOL is_abort;
     t_CKBOOL is_dumped;
     Chuck_Event * event;  // event shred is waiting on
-    std::map<Chuck_UGen *, Chuck_UGen *> m_ugen_map;
+    typedef std::map<Chuck_UGen *, Chuck_UGen *, std::less<Chuck_UGen *>,
+        Chuck_Pool_Allocator<std::pair<Chuck_UGen * const, Chuck_UGen *> > > UGen_Map;
+    UGen_Map m_ugen_map;
     // references kept by the shred itself (e.g., when sporking member functions)
     // to be released when shred is done -- added 1.3.1.2
     std::vector<Chuck_Object *> m_parent_objects;
@@ -340,6 +346,8 @@ public: // high-level shred interface
     void status( );
     void status( Chuck_VM_Status * status );
     t_CKUINT highest();
+    // all shreds waiting to run or blocked, and the current one
+    void shreds( std::vector<Chuck_VM_Shred *> & out );
 
 public: // for event related shred queue
     t_CKBOOL add_blocked( Chuck_VM_Shred * shred );
@@ -496,6 +504,22 @@ struct Chuck_External_Event_Container {
 
 
 
+//-----------------------------------------------------------------------------
+// name: struct Chuck_VM_Timed_Callback
+// desc: work handed to the VM by another thread, to run at a given time
+//-----------------------------------------------------------------------------
+struct Chuck_VM_Timed_Callback
+{
+    // called on the VM thread
+    void (* callback)( void * data );
+    void * data;
+    // VM time to run at
+    t_CKTIME when;
+};
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: struct Chuck_VM
 // desc: ...
@@ -557,6 +581,8 @@ public: // garbage collection
 
 public: // msg
     t_CKBOOL queue_msg( Chuck_Msg * msg, int num_msg );
+    // queue msgs to be processed together, in the same compute()
+    t_CKBOOL queue_msgs( Chuck_Msg ** msgs, t_CKUINT num_msg );
     // CBufferSimple added 1.3.0.0 to fix uber-crash
     t_CKBOOL queue_event( Chuck_Event * event, int num_msg, CBufferSimple * buffer = NULL );
     t_CKUINT process_msg( Chuck_Msg * msg );
@@ -565,6 +591,19 @@ public: // msg
     // added 1.3.0.0 to fix uber-crash
     CBufferSimple * create_event_buffer();
     void destroy_event_buffer( CBufferSimple * buffer );
+
+public: // timed callbacks from other threads
+    // host monotonic clock, in seconds
+    static t_CKFLOAT host_time();
+    // VM time for a host_time() stamp, one block later, so that input
+    // stamped anywhere in a block lands at the same offset in the next
+    t_CKTIME host_to_vm_time( t_CKFLOAT host );
+    // single-producer buffer for queue_callback(), one per thread
+    CBufferSimple * create_timed_buffer();
+    // run callback( data ) on the VM thread at VM time when (or next, if
+    // already past); lock-free
+    t_CKBOOL queue_callback( void (* callback)( void * ), void * data,
+                             t_CKTIME when, CBufferSimple * buffer );
     
 public: // get error
     const char * last_error() const
@@ -659,6 +698,8 @@ protected:
     // place to put dumped shreds
     std::vector<Chuck_VM_Shred *> m_shred_dump;
     t_CKUINT m_num_dumped_shreds;
+    // shreds whose stacks the collector scans (reused)
+    std::vector<Chuck_VM_Shred *> m_gc_shreds;
 
     // message queue
     CBufferSimple * m_msg_buffer;
@@ -668,6 +709,18 @@ protected:
     // TODO: vector? (added 1.3.0.0 to fix uber-crash)
     std::list<CBufferSimple *> m_event_buffers;
 
+    // timed callbacks: per-thread buffers, and those pending, by time
+    std::list<CBufferSimple *> m_timed_buffers;
+    std::multimap<t_CKTIME, Chuck_VM_Timed_Callback> m_timed;
+    // run the callbacks that are due; true if any ran
+    t_CKBOOL run_timed_callbacks();
+
+    // host clock <-> VM time, taken at the top of each run(); double
+    // buffered so other threads always read a matching pair
+    struct Clock_Anchor { t_CKFLOAT host; t_CKTIME now; t_CKINT frames; };
+    volatile Clock_Anchor m_anchor[2];
+    volatile t_CKINT m_anchor_index;
+
 private:
     // external variables
     void cleanup_external_variables();
@@ -646,7 +646,8 @@ t_CKBOOL HidInManager::open( HidIn * hin, Chuck_VM * vm, t_CKINT device_type, t_
         return FALSE;
     }
     
-    // start thread
+#ifndef __PLATFORM_LINUX__
+    // start thread (on linux, devices are read on the shared XReactor)
     if( the_thread == NULL )
     {
         // allocate
@@ -656,6 +657,7 @@ t_CKBOOL HidInManager::open( HidIn * hin, Chuck_VM * vm, t_CKINT device_type, t_
         // start
         the_thread->start( cb_hid_input, NULL );
     }
+#endif
     
     // get the vector
     vector<PhyHidDevIn *> & v = the_matrix[device_type];
@@ -906,6 +908,25 @@ void HidInManager::push_message( HidMsg & msg )
     }
 }
 
+//-----------------------------------------------------------------------------
+// name: push_messages()
+// desc: push messages from one device with a single put
+//-----------------------------------------------------------------------------
+void HidInManager::push_messages( HidMsg * msgs, t_CKUINT num )
+{
+    if( num == 0 )
+        return;
+
+    // find the queue
+    if( the_matrix[msgs[0].device_type][msgs[0].device_num] != NULL )
+    {
+        CBufferAdvance * cbuf = the_matrix[msgs[0].device_type][msgs[0].device_num]->cbuf;
+        if( cbuf != NULL )
+            // queue the things
+            cbuf->put( msgs, num );
+    }
+}
+
 extern "C" void push_message( HidMsg msg )
 {
     HidInManager::push_message( msg );
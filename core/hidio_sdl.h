@@ -142,6 +142,8 @@ public:
 #endif
 
     static void push_message( HidMsg & msg );
+    // a batch from one device, woken once
+    static void push_messages( HidMsg * msgs, t_CKUINT num );
     
     static std::map< Chuck_VM *, CBufferSimple * > m_event_buffers;
     
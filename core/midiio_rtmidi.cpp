@@ -49,7 +49,7 @@
 #define BUFFER_SIZE 8192
 
 std::vector<RtMidiIn *> MidiInManager::the_mins;
-std::vector<CBufferAdvance *> MidiInManager::the_bufs;
+std::vector<MidiInPort *> MidiInManager::the_ports;
 std::vector<RtMidiOut *> MidiOutManager::the_mouts;
 std::map< Chuck_VM *, CBufferSimple * > MidiInManager::m_event_buffers;
 
@@ -308,6 +308,8 @@ MidiIn::MidiIn()
     m_buffer = NULL;
     m_suppress_output = FALSE;
     SELF = NULL;
+    m_vm = NULL;
+    m_has_next = FALSE;
 }
 
 
@@ -363,7 +365,7 @@ t_CKBOOL MidiIn::open( Chuck_VM * vm, const std::string & name )
 MidiInManager::MidiInManager()
 {
     the_mins.resize( 1024 );
-    the_bufs.resize( 1024 );
+    the_ports.resize( 1024 );
 }
 
 
@@ -386,7 +388,7 @@ t_CKBOOL MidiInManager::open( MidiIn * min, Chuck_VM * vm, t_CKINT device_num )
         
         // allocate the buffer
         CBufferAdvance * cbuf = new CBufferAdvance;
-        if( !cbuf->initialize( BUFFER_SIZE, sizeof(MidiMsg), m_event_buffers[vm] ) )
+        if( !cbuf->initialize( BUFFER_SIZE, sizeof(MidiInEntry), m_event_buffers[vm] ) )
         {
             if( !min->m_suppress_output )
                 EM_error2( 0, "MidiIn: couldn't allocate CBuffer for port %i...", device_num );
@@ -394,11 +396,17 @@ t_CKBOOL MidiInManager::open( MidiIn * min, Chuck_VM * vm, t_CKINT device_num )
             return FALSE;
         }
 
+        // what the callback thread needs
+        MidiInPort * port = new MidiInPort;
+        port->buffer = cbuf;
+        port->vm = vm;
+        port->timed = vm->create_timed_buffer();
+
         // allocate
         RtMidiIn * rtmin = new RtMidiIn;
         try {
             rtmin->openPort( device_num );
-            rtmin->setCallback( cb_midi_input, cbuf );
+            rtmin->setCallback( cb_midi_input, port );
         } catch( RtMidiError & err ) {
             if( !min->m_suppress_output )
             {
@@ -409,6 +417,7 @@ t_CKBOOL MidiInManager::open( MidiIn * min, Chuck_VM * vm, t_CKINT device_num )
                 // EM_error2( 0, "...(%s)", err.getMessage().c_str() );
             }
             delete cbuf;
+            delete port;
             return FALSE;
         }
 
@@ -418,18 +427,20 @@ t_CKBOOL MidiInManager::open( MidiIn * min, Chuck_VM * vm, t_CKINT device_num )
             t_CKINT size = the_mins.capacity() * 2;
             if( device_num >= size ) size = device_num + 1;
             the_mins.resize( size );
-            the_bufs.resize( size );
+            the_ports.resize( size );
         }
 
-        // put cbuf and rtmin in vector for future generations
+        // put port and rtmin in vector for future generations
         the_mins[device_num] = rtmin;
-        the_bufs[device_num] = cbuf;
+        the_ports[device_num] = port;
     }
 
     // set min
     min->min = the_mins[device_num];
     // found
-    min->m_buffer = the_bufs[device_num];
+    min->m_buffer = the_ports[device_num]->buffer;
+    min->m_vm = vm;
+    min->m_has_next = FALSE;
     // get an index into your (you are min here) own buffer, 
     // and a free ticket to your own workshop
     min->m_read_index = min->m_buffer->join( (Chuck_Event *)min->SELF );
@@ -508,6 +519,19 @@ t_CKBOOL MidiInManager::open( MidiIn * min, Chuck_VM * vm, const std::string & n
 //-----------------------------------------------------------------------------
 void MidiInManager::cleanup_buffer( Chuck_VM * vm )
 {
+    // stop ports queueing to this vm
+    for( t_CKUINT i = 0; i < the_ports.size(); i++ )
+    {
+        if( the_ports[i] && the_ports[i]->vm == vm )
+        {
+            // waits out a callback in progress; later ones see NULL
+            the_ports[i]->lock.acquire();
+            the_ports[i]->vm = NULL;
+            the_ports[i]->timed = NULL;
+            the_ports[i]->lock.release();
+        }
+    }
+
     if( m_event_buffers.count( vm ) > 0 )
     {
         vm->destroy_event_buffer( m_event_buffers[vm] );
@@ -545,7 +569,7 @@ t_CKBOOL MidiIn::close()
 t_CKBOOL MidiIn::empty()
 {
     if( !m_valid ) return TRUE;
-    return m_buffer->empty( m_read_index );
+    return !due();
 }
 
 
@@ -553,12 +577,36 @@ t_CKBOOL MidiIn::empty()
 
 //-----------------------------------------------------------------------------
 // name: get()
-// desc: get message
+// desc: get message, once its time has come
 //-----------------------------------------------------------------------------
 t_CKUINT MidiIn::recv( MidiMsg * msg )
 {
     if( !m_valid ) return FALSE;
-    return m_buffer->get( msg, 1, m_read_index );
+    if( !due() ) return FALSE;
+
+    *msg = m_next.msg;
+    m_has_next = FALSE;
+    return TRUE;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: due()
+// desc: peek the next message; is it due yet? (cb_wake signals when it is)
+//-----------------------------------------------------------------------------
+t_CKBOOL MidiIn::due()
+{
+    if( !m_has_next )
+    {
+        if( !m_buffer->get( &m_next, 1, m_read_index ) )
+            return FALSE;
+        m_has_next = TRUE;
+    }
+
+    // same rounding as the shreduler
+    return !m_vm || m_next.when <= m_vm->shreduler()->now_system + .5;
 }
 
 
@@ -572,17 +620,47 @@ void MidiInManager::cb_midi_input( double deltatime, std::vector<unsigned char>
                                    void * userData )
 {
     unsigned int nBytes = msg->size();
-    CBufferAdvance * cbuf = (CBufferAdvance *)userData;
-    MidiMsg m;
-    if( nBytes >= 1 ) m.data[0] = msg->at(0);
-    if( nBytes >= 2 ) m.data[1] = msg->at(1);
-    if( nBytes >= 3 ) m.data[2] = msg->at(2);
-
-    // put in the buffer, make sure not active sensing
-    if( m.data[2] != 0xfe )
+    MidiInPort * port = (MidiInPort *)userData;
+    MidiInEntry e;
+    // stamp first, before anything else can delay us
+    t_CKFLOAT stamp = Chuck_VM::host_time();
+
+    e.msg.data[0] = e.msg.data[1] = e.msg.data[2] = e.msg.data[3] = 0;
+    if( nBytes >= 1 ) e.msg.data[0] = msg->at(0);
+    if( nBytes >= 2 ) e.msg.data[1] = msg->at(1);
+    if( nBytes >= 3 ) e.msg.data[2] = msg->at(2);
+
+    // make sure not active sensing
+    if( e.msg.data[0] == 0xfe )
+        return;
+
+    // the vm can't go away while we hold this
+    port->lock.acquire();
+
+    // no vm (shut down): nothing will read it
+    if( port->vm && port->timed )
     {
-        cbuf->put( &m, 1 );
+        // the VM time it arrived, one block of latency later
+        e.when = port->vm->host_to_vm_time( stamp );
+
+        // put in the buffer, and have the VM wake readers at that time
+        port->buffer->write( &e, 1 );
+        port->vm->queue_callback( cb_wake, port->buffer, e.when, port->timed );
     }
+
+    port->lock.release();
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: cb_wake()
+// desc: a message is due: wake its readers (VM thread)
+//-----------------------------------------------------------------------------
+void MidiInManager::cb_wake( void * data )
+{
+    ((CBufferAdvance *)data)->wake();
 }
 
 
@@ -1006,4 +1084,8 @@ t_CKBOOL MidiIn::open( t_CKUINT device_num )
     return FALSE;
 }
 
+void MidiInManager::cleanup_buffer( Chuck_VM * vm )
+{
+}
+
 #endif // __DISABLE_MIDI__
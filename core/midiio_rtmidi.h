@@ -67,6 +67,17 @@ union MidiMsg
 };
 
 
+//-----------------------------------------------------------------------------
+// name: struct MidiInEntry
+// desc: a received message, stamped with the VM time it is due
+//-----------------------------------------------------------------------------
+struct MidiInEntry
+{
+    MidiMsg msg;
+    t_CKTIME when;
+};
+
+
 
 
 // forward reference
@@ -153,6 +164,10 @@ public:
     t_CKBOOL empty();
     t_CKUINT recv( MidiMsg * msg );
 
+protected:
+    // peek the next message; true if it is due by now
+    t_CKBOOL due();
+
 public:
     CBufferAdvance * m_buffer;
     t_CKUINT m_read_index;
@@ -161,6 +176,10 @@ public:
     t_CKUINT m_device_num;
     Chuck_Object * SELF;
     t_CKBOOL m_suppress_output;
+    Chuck_VM * m_vm;
+    // next message, read but not yet due
+    MidiInEntry m_next;
+    t_CKBOOL m_has_next;
 };
 
 
@@ -168,6 +187,22 @@ void probeMidiIn();
 void probeMidiOut();
 
 
+//-----------------------------------------------------------------------------
+// name: struct MidiInPort
+// desc: an open input port, as seen from its RtMidi callback thread
+//-----------------------------------------------------------------------------
+struct MidiInPort
+{
+    CBufferAdvance * buffer;
+    Chuck_VM * vm;
+    // this port's lane into vm->queue_callback()
+    CBufferSimple * timed;
+    // held by the callback while it uses vm/timed, and by
+    // cleanup_buffer() while it detaches them
+    XMutex lock;
+};
+
+
 class MidiInManager
 {
 public:
@@ -178,12 +213,13 @@ public:
 
     static void cb_midi_input( double deltatime, std::vector<unsigned char> * msg,
                                void *userData );
+    static void cb_wake( void * data );
 protected:
     MidiInManager();
     ~MidiInManager();
 
     static std::vector<RtMidiIn *> the_mins;
-    static std::vector<CBufferAdvance *> the_bufs;
+    static std::vector<MidiInPort *> the_ports;
 
 public:
     static std::map< Chuck_VM *, CBufferSimple * > m_event_buffers;
@@ -34,16 +34,30 @@
 #include "ugen_filter.h"
 #include "chuck_type.h"
 #include "chuck_compile.h"
+#include "chuck_instr.h"
+#include "chuck_ugen.h"
+#include "util_math.h"
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 
 static t_CKUINT g_srate = 0;
 static t_CKFLOAT g_radians_per_sample = 0;
 // filter member data offset
 static t_CKUINT FilterBasic_offset_data = 0;
+static t_CKUINT FilterBasic_offset_freqMod = 0;
 static t_CKUINT Teabox_offset_data = 0;
 static t_CKUINT biquad_offset_data = 0;
+static t_CKUINT SOSBank_offset_data = 0;
+// SOSBank modes
+static t_CKINT SOSBank_mode_PARALLEL = 0;
+static t_CKINT SOSBank_mode_SERIES = 1;
+// sections are processed in groups of this many
+#define SOSBANK_LANES 8
+// the per-section arrays never overlap; saying so lets the compiler
+// vectorize the section loop without a runtime check per pair of arrays
+#define SOSBANK_RESTRICT __restrict
 
 
 
@@ -58,6 +72,8 @@ DLL_QUERY filter_query( Chuck_DL_Query * QUERY )
     g_srate = QUERY->srate;
     // set radians per sample
     g_radians_per_sample = TWO_PI / (t_CKFLOAT)g_srate;
+    // coefficient design tables
+    fast_trig_init();
     
     std::string doc;
     
@@ -90,6 +106,11 @@ DLL_QUERY filter_query( Chuck_DL_Query * QUERY )
     FilterBasic_offset_data = type_engine_import_mvar( env, "int", "@FilterBasic_data", FALSE );
     if( FilterBasic_offset_data == CK_INVALID_OFFSET ) goto error;
 
+    // freqMod
+    FilterBasic_offset_freqMod = type_engine_import_mvar( env, "UGen", "freqMod", FALSE,
+        "Audio-rate frequency input: anything connected here is added to freq (in Hz), and the filter coefficients follow it once per block, ramped across the block." );
+    if( FilterBasic_offset_freqMod == CK_INVALID_OFFSET ) goto error;
+
     // freq
     func = make_new_mfun( "float", "freq", FilterBasic_ctrl_freq );
     func->add_arg( "float", "val" );
@@ -162,7 +183,7 @@ DLL_QUERY filter_query( Chuck_DL_Query * QUERY )
     //---------------------------------------------------------------------
     doc = "Bandpass filter (2nd order Butterworth).";
     if( !type_engine_import_ugen_begin( env, "BPF", "FilterBasic", env->global(),
-                                        BPF_ctor, NULL, BPF_tick, BPF_pmsg, doc.c_str() ) )
+                                        BPF_ctor, NULL, NULL, BPF_tickf, BPF_pmsg, 1, 1, doc.c_str() ) )
         return FALSE;
 
     type_engine_import_add_ex(env, "filter/bp.ck");
@@ -201,7 +222,7 @@ DLL_QUERY filter_query( Chuck_DL_Query * QUERY )
     //---------------------------------------------------------------------
     doc = "Band-reject filter (2nd order Butterworth).";
     if( !type_engine_import_ugen_begin( env, "BRF", "FilterBasic", env->global(),
-                                        BRF_ctor, NULL, BRF_tick, BRF_pmsg, doc.c_str() ) )
+                                        BRF_ctor, NULL, NULL, BRF_tickf, BRF_pmsg, 1, 1, doc.c_str() ) )
         return FALSE;
     
     type_engine_import_add_ex(env, "filter/br.ck");
@@ -240,7 +261,7 @@ DLL_QUERY filter_query( Chuck_DL_Query * QUERY )
     //---------------------------------------------------------------------
     doc = "Resonant low-pass filter (2nd order Butterworth).";
     if( !type_engine_import_ugen_begin( env, "LPF", "FilterBasic", env->global(),
-                                        RLPF_ctor, NULL, RLPF_tick, RLPF_pmsg, doc.c_str() ) )
+                                        RLPF_ctor, NULL, NULL, RLPF_tickf, RLPF_pmsg, 1, 1, doc.c_str() ) )
         return FALSE;
     
     type_engine_import_add_ex(env, "filter/lp.ck");
@@ -279,7 +300,7 @@ DLL_QUERY filter_query( Chuck_DL_Query * QUERY )
     //---------------------------------------------------------------------
     doc = "Resonant high-pass filter (2nd order Butterworth).";
     if( !type_engine_import_ugen_begin( env, "HPF", "FilterBasic", env->global(),
-                                        RHPF_ctor, NULL, RHPF_tick, RHPF_pmsg, doc.c_str() ) )
+                                        RHPF_ctor, NULL, NULL, RHPF_tickf, RHPF_pmsg, 1, 1, doc.c_str() ) )
         return FALSE;
     
     type_engine_import_add_ex(env, "filter/hp.ck");
@@ -318,7 +339,7 @@ DLL_QUERY filter_query( Chuck_DL_Query * QUERY )
     //---------------------------------------------------------------------
     doc = "Resonant filter. BiQuad with equal-gain zeros, keeps gain under control independent of frequency.";
     if( !type_engine_import_ugen_begin( env, "ResonZ", "FilterBasic", env->global(),
-                                        ResonZ_ctor, NULL, ResonZ_tick, ResonZ_pmsg, doc.c_str() ) )
+                                        ResonZ_ctor, NULL, NULL, ResonZ_tickf, ResonZ_pmsg, 1, 1, doc.c_str() ) )
         return FALSE;
 
     type_engine_import_add_ex(env, "filter/resonz.ck");
@@ -501,6 +522,133 @@ DLL_QUERY filter_query( Chuck_DL_Query * QUERY )
     // end the class import
     type_engine_import_class_end( env );
 	
+    //---------------------------------------------------------------------
+    // init class: SOSBank
+    //---------------------------------------------------------------------
+    doc = "A bank of second-order (biquad) sections in one unit generator. In PARALLEL mode every section filters the input and the output is their sum, weighted by mix(); in SERIES mode the sections are cascaded in order. Coefficient and mix changes are ramped over smooth().";
+    if( !type_engine_import_ugen_begin( env, "SOSBank", "UGen", env->global(),
+                                        SOSBank_ctor, SOSBank_dtor, NULL, SOSBank_tickf, NULL, 1, 1, doc.c_str() ) )
+        return FALSE;
+
+    // member variable
+    SOSBank_offset_data = type_engine_import_mvar( env, "int", "@SOSBank_data", FALSE );
+    if( SOSBank_offset_data == CK_INVALID_OFFSET ) goto error;
+
+    // modes
+    if( !type_engine_import_svar( env, "int", "PARALLEL", TRUE, (t_CKUINT)&SOSBank_mode_PARALLEL ) ) goto error;
+    if( !type_engine_import_svar( env, "int", "SERIES", TRUE, (t_CKUINT)&SOSBank_mode_SERIES ) ) goto error;
+
+    // size
+    func = make_new_mfun( "int", "size", SOSBank_ctrl_size );
+    func->add_arg( "int", "sections" );
+    func->doc = "Set number of sections; new sections pass their input through.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    func = make_new_mfun( "int", "size", SOSBank_cget_size );
+    func->doc = "Get number of sections.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // mode
+    func = make_new_mfun( "int", "mode", SOSBank_ctrl_mode );
+    func->add_arg( "int", "mode" );
+    func->doc = "Set SOSBank.PARALLEL (default) or SOSBank.SERIES.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    func = make_new_mfun( "int", "mode", SOSBank_cget_mode );
+    func->doc = "Get mode.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // coefs
+    func = make_new_mfun( "void", "coefs", SOSBank_ctrl_coefs );
+    func->add_arg( "int", "which" );
+    func->add_arg( "float", "b0" );
+    func->add_arg( "float", "b1" );
+    func->add_arg( "float", "b2" );
+    func->add_arg( "float", "a1" );
+    func->add_arg( "float", "a2" );
+    func->doc = "Set coefficients of a section (normalized so a0 is 1).";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // lpf
+    func = make_new_mfun( "void", "lpf", SOSBank_ctrl_lpf );
+    func->add_arg( "int", "which" );
+    func->add_arg( "float", "freq" );
+    func->add_arg( "float", "Q" );
+    func->doc = "Make a section a resonant lowpass.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // hpf
+    func = make_new_mfun( "void", "hpf", SOSBank_ctrl_hpf );
+    func->add_arg( "int", "which" );
+    func->add_arg( "float", "freq" );
+    func->add_arg( "float", "Q" );
+    func->doc = "Make a section a resonant highpass.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // bpf
+    func = make_new_mfun( "void", "bpf", SOSBank_ctrl_bpf );
+    func->add_arg( "int", "which" );
+    func->add_arg( "float", "freq" );
+    func->add_arg( "float", "Q" );
+    func->doc = "Make a section a bandpass with 0 dB peak gain.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // peak
+    func = make_new_mfun( "void", "peak", SOSBank_ctrl_peak );
+    func->add_arg( "int", "which" );
+    func->add_arg( "float", "freq" );
+    func->add_arg( "float", "Q" );
+    func->add_arg( "float", "db" );
+    func->doc = "Make a section a peaking EQ with the given gain in dB.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // mix
+    func = make_new_mfun( "float", "mix", SOSBank_ctrl_mix );
+    func->add_arg( "int", "which" );
+    func->add_arg( "float", "value" );
+    func->doc = "Set weight of a section in the PARALLEL sum.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    func = make_new_mfun( "float", "mix", SOSBank_cget_mix );
+    func->add_arg( "int", "which" );
+    func->doc = "Get weight of a section.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // smooth
+    func = make_new_mfun( "dur", "smooth", SOSBank_ctrl_smooth );
+    func->add_arg( "dur", "value" );
+    func->doc = "Set ramp time for coefficient and mix changes (default 0::samp).";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    func = make_new_mfun( "dur", "smooth", SOSBank_cget_smooth );
+    func->doc = "Get ramp time.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // follow
+    func = make_new_mfun( "dur", "follow", SOSBank_ctrl_follow );
+    func->add_arg( "dur", "value" );
+    func->doc = "Set time constant of the per-section envelope followers; 0::samp (default) turns them off.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    func = make_new_mfun( "dur", "follow", SOSBank_cget_follow );
+    func->doc = "Get envelope follower time constant.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // env
+    func = make_new_mfun( "float", "env", SOSBank_cget_env );
+    func->add_arg( "int", "which" );
+    func->doc = "Get envelope (smoothed absolute output) of a section.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // last
+    func = make_new_mfun( "float", "last", SOSBank_cget_last );
+    func->add_arg( "int", "which" );
+    func->doc = "Get most recent output of a section.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // clear
+    func = make_new_mfun( "void", "clear", SOSBank_ctrl_clear );
+    func->doc = "Clear filter state.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // end the class import
+    type_engine_import_class_end( env );
+
     /*
     //----------------------------------
     // begin onepole ugen
@@ -721,6 +869,84 @@ struct FilterBasic_data
     t_CKFLOAT m_Q;
     t_CKFLOAT m_db;
 
+    // coefficient design for this filter (one of the coef_* below)
+    void (FilterBasic_data::*m_design)( t_CKFLOAT freq, t_CKFLOAT Q );
+    // freq/Q set since the coefficients were last designed
+    t_CKBOOL m_dirty;
+    // coefficients have been designed at least once
+    t_CKBOOL m_designed;
+    // freq/Q the current coefficients were designed for
+    t_CKFLOAT m_coef_freq;
+    t_CKFLOAT m_coef_Q;
+
+    // set parameters; coefficients follow at the next block
+    inline void set( t_CKFLOAT freq, t_CKFLOAT Q )
+    {
+        m_freq = freq;
+        m_Q = Q;
+        m_dirty = TRUE;
+    }
+
+    // one block: if freq (which includes any freqMod) or Q moved, design
+    // the new coefficients (skipped when unchanged) and ramp to them across
+    // the block, so control-rate sweeps neither zipper nor pay for a
+    // redesign per set; with one-sample blocks this is the old behavior
+    template <SAMPLE (FilterBasic_data::*TICK)( SAMPLE )>
+    inline void tick_block( t_CKFLOAT freq, t_CKBOOL modulated,
+                            const SAMPLE * in, SAMPLE * out, t_CKUINT nframes )
+    {
+        t_CKUINT i;
+        t_CKBOOL ramp = FALSE;
+        SAMPLE a0 = m_a0, b1 = m_b1, b2 = m_b2;
+        SAMPLE da0 = 0, db1 = 0, db2 = 0;
+
+        if( m_dirty || ( modulated && freq != m_coef_freq ) )
+        {
+            if( !m_designed || freq != m_coef_freq || m_Q != m_coef_Q )
+            {
+                (this->*m_design)( freq, m_Q );
+                // first design snaps, later ones ramp from where we were
+                ramp = m_designed && nframes > 1;
+                m_designed = TRUE;
+                m_coef_freq = freq;
+                m_coef_Q = m_Q;
+            }
+            m_dirty = FALSE;
+        }
+
+        if( ramp )
+        {
+            SAMPLE ta0 = m_a0, tb1 = m_b1, tb2 = m_b2;
+            SAMPLE inv = (SAMPLE)1 / nframes;
+            da0 = ( ta0 - a0 ) * inv;
+            db1 = ( tb1 - b1 ) * inv;
+            db2 = ( tb2 - b2 ) * inv;
+            m_a0 = a0; m_b1 = b1; m_b2 = b2;
+            for( i = 0; i < nframes; i++ )
+            {
+                m_a0 += da0; m_b1 += db1; m_b2 += db2;
+                out[i] = (this->*TICK)( in[i] );
+            }
+            // land exactly on the target
+            m_a0 = ta0; m_b1 = tb1; m_b2 = tb2;
+        }
+        else
+        {
+            for( i = 0; i < nframes; i++ )
+                out[i] = (this->*TICK)( in[i] );
+        }
+
+        // be normal, once per block
+        CK_DDN(m_y1);
+        CK_DDN(m_y2);
+    }
+    
+    // clamp Q as the SC3 resonant filters do
+    static inline t_CKFLOAT rq_clamp( t_CKFLOAT Q )
+    {
+        return 1.0 / ck_max( .001, 1.0/Q );
+    }
+
     // tick_lpf
     inline SAMPLE tick_lpf( SAMPLE in )
     {
@@ -757,20 +983,18 @@ struct FilterBasic_data
         return result;
     }
 
-    // set_bpf
-    inline void set_bpf( t_CKFLOAT freq, t_CKFLOAT Q )
+    // coef_bpf
+    inline void coef_bpf( t_CKFLOAT freq, t_CKFLOAT Q )
     {
         t_CKFLOAT pfreq = freq * g_radians_per_sample;
         t_CKFLOAT pbw = 1.0 / Q * pfreq * .5;
 
-        t_CKFLOAT C = 1.0 / ::tan(pbw);
-        t_CKFLOAT D = 2.0 * ::cos(pfreq);
+        t_CKFLOAT C = 1.0 / fast_tan(pbw);
+        t_CKFLOAT D = 2.0 * fast_cos(pfreq);
         t_CKFLOAT next_a0 = 1.0 / (1.0 + C);
         t_CKFLOAT next_b1 = C * D * next_a0 ;
         t_CKFLOAT next_b2 = (1.0 - C) * next_a0;
 
-        m_freq = freq;
-        m_Q = Q;
         m_a0 = (SAMPLE)next_a0;
         m_b1 = (SAMPLE)next_b1;
         m_b2 = (SAMPLE)next_b2;
@@ -787,27 +1011,21 @@ struct FilterBasic_data
         m_y2 = m_y1;
         m_y1 = y0;
 
-        // be normal
-        CK_DDN(m_y1);
-        CK_DDN(m_y2);
-
         return result;
     }
 
-    // set_brf
-    inline void set_brf( t_CKFLOAT freq, t_CKFLOAT Q )
+    // coef_brf
+    inline void coef_brf( t_CKFLOAT freq, t_CKFLOAT Q )
     {
         t_CKFLOAT pfreq = freq * g_radians_per_sample;
         t_CKFLOAT pbw = 1.0 / Q * pfreq * .5;
 
-        t_CKFLOAT C = ::tan(pbw);
-        t_CKFLOAT D = 2.0 * ::cos(pfreq);
+        t_CKFLOAT C = fast_tan(pbw);
+        t_CKFLOAT D = 2.0 * fast_cos(pfreq);
         t_CKFLOAT next_a0 = 1.0 / (1.0 + C);
         t_CKFLOAT next_b1 = -D * next_a0 ;
         t_CKFLOAT next_b2 = (1.f - C) * next_a0;
 
-        m_freq = freq;
-        m_Q = Q;
         m_a0 = (SAMPLE)next_a0;
         m_b1 = (SAMPLE)next_b1;
         m_b2 = (SAMPLE)next_b2;
@@ -825,28 +1043,22 @@ struct FilterBasic_data
         m_y2 = m_y1;
         m_y1 = y0;
 
-        // be normal
-        CK_DDN(m_y1);
-        CK_DDN(m_y2);
-
         return result;
     }
 
-    // set_rlpf
-    inline void set_rlpf( t_CKFLOAT freq, t_CKFLOAT Q )
+    // coef_rlpf
+    inline void coef_rlpf( t_CKFLOAT freq, t_CKFLOAT Q )
     {
         t_CKFLOAT qres = ck_max( .001, 1.0/Q );
         t_CKFLOAT pfreq = freq * g_radians_per_sample;
 
-        t_CKFLOAT D = ::tan(pfreq * qres * 0.5);
+        t_CKFLOAT D = fast_tan(pfreq * qres * 0.5);
         t_CKFLOAT C = (1.0 - D) / (1.0 + D);
-        t_CKFLOAT cosf = ::cos(pfreq);
+        t_CKFLOAT cosf = fast_cos(pfreq);
         t_CKFLOAT next_b1 = (1.0 + C) * cosf;
         t_CKFLOAT next_b2 = -C;
         t_CKFLOAT next_a0 = (1.0 + C - next_b1) * 0.25;
 
-        m_freq = freq;
-        m_Q = 1.0 / qres;
         m_a0 = (SAMPLE)next_a0;
         m_b1 = (SAMPLE)next_b1;
         m_b2 = (SAMPLE)next_b2;
@@ -863,28 +1075,22 @@ struct FilterBasic_data
         m_y2 = m_y1;
         m_y1 = y0;
 
-        // be normal
-        CK_DDN(m_y1);
-        CK_DDN(m_y2);
-
         return result;
     }
 
-    // set_rhpf
-    inline void set_rhpf( t_CKFLOAT freq, t_CKFLOAT Q )
+    // coef_rhpf
+    inline void coef_rhpf( t_CKFLOAT freq, t_CKFLOAT Q )
     {
         t_CKFLOAT qres = ck_max( .001, 1.0/Q );
         t_CKFLOAT pfreq = freq * g_radians_per_sample;
 
-        t_CKFLOAT D = ::tan(pfreq * qres * 0.5);
+        t_CKFLOAT D = fast_tan(pfreq * qres * 0.5);
         t_CKFLOAT C = (1.0 - D) / (1.0 + D);
-        t_CKFLOAT cosf = ::cos(pfreq);
+        t_CKFLOAT cosf = fast_cos(pfreq);
         t_CKFLOAT next_b1 = (1.0 + C) * cosf;
         t_CKFLOAT next_b2 = -C;
         t_CKFLOAT next_a0 = (1.0 + C + next_b1) * 0.25;
 
-        m_freq = freq;
-        m_Q = 1.0 / qres;
         m_a0 = (SAMPLE)next_a0;
         m_b1 = (SAMPLE)next_b1;
         m_b2 = (SAMPLE)next_b2;
@@ -901,28 +1107,22 @@ struct FilterBasic_data
         m_y2 = m_y1;
         m_y1 = y0;
 
-        // be normal
-        CK_DDN(m_y1);
-        CK_DDN(m_y2);
-
         return result;
     }
 
-    // set_resonz
-    inline void set_resonz( t_CKFLOAT freq, t_CKFLOAT Q )
+    // coef_resonz
+    inline void coef_resonz( t_CKFLOAT freq, t_CKFLOAT Q )
     {
         t_CKFLOAT pfreq = freq * g_radians_per_sample;
         t_CKFLOAT B = pfreq / Q;
         t_CKFLOAT R = 1.0 - B * 0.5;
         t_CKFLOAT R2 = 2.0 * R;
         t_CKFLOAT R22 = R * R;
-        t_CKFLOAT cost = (R2 * ::cos(pfreq)) / (1.0 + R22);
+        t_CKFLOAT cost = (R2 * fast_cos(pfreq)) / (1.0 + R22);
         t_CKFLOAT next_b1 = R2 * cost;
         t_CKFLOAT next_b2 = -R22;
         t_CKFLOAT next_a0 = (1.0 - R22) * 0.5;
 
-        m_freq = freq;
-        m_Q = Q;
         m_a0 = (SAMPLE)next_a0;
         m_b1 = (SAMPLE)next_b1;
         m_b2 = (SAMPLE)next_b2;
@@ -939,10 +1139,6 @@ struct FilterBasic_data
         m_y2 = m_y1;
         m_y1 = y0;
 
-        // be normal
-        CK_DDN(m_y1);
-        CK_DDN(m_y2);
-
         return result;
     }
 
@@ -1000,6 +1196,10 @@ CK_DLL_CTOR( FilterBasic_ctor )
 {
     // set to zero
     OBJ_MEMBER_UINT(SELF, FilterBasic_offset_data) = 0;
+    // frequency modulation input
+    Chuck_Object * mod = instantiate_and_initialize_object( SHRED->vm_ref->env()->t_ugen, SHRED );
+    mod->add_ref();
+    OBJ_MEMBER_OBJECT(SELF, FilterBasic_offset_freqMod) = mod;
 }
 
 
@@ -1015,6 +1215,42 @@ CK_DLL_DTOR( FilterBasic_dtor )
     SAFE_DELETE(d);
     // set
     OBJ_MEMBER_UINT(SELF, FilterBasic_offset_data) = 0;
+    // release the modulation input
+    Chuck_Object * mod = OBJ_MEMBER_OBJECT(SELF, FilterBasic_offset_freqMod);
+    SAFE_RELEASE( mod );
+    OBJ_MEMBER_OBJECT(SELF, FilterBasic_offset_freqMod) = NULL;
+}
+
+
+//-----------------------------------------------------------------------------
+// name: FilterBasic_tickf()
+// desc: common block tick: pull freqMod (if anything feeds it) up to now,
+//       then run the filter's TICK over the block
+//-----------------------------------------------------------------------------
+template <SAMPLE (FilterBasic_data::*TICK)( SAMPLE )>
+static t_CKBOOL FilterBasic_tickf( Chuck_Object * SELF, SAMPLE * in, SAMPLE * out, t_CKUINT nframes )
+{
+    FilterBasic_data * d = (FilterBasic_data *)OBJ_MEMBER_UINT(SELF, FilterBasic_offset_data);
+    Chuck_UGen * mod = (Chuck_UGen *)OBJ_MEMBER_OBJECT(SELF, FilterBasic_offset_freqMod);
+    t_CKFLOAT freq = d->m_freq;
+    t_CKBOOL modulated = FALSE;
+
+    if( mod && mod->m_num_src )
+    {
+        t_CKTIME now = ((Chuck_UGen *)SELF)->m_time;
+        // same cadence as the graph we're being ticked from
+        if( mod->m_max_block_size > 0 ) mod->system_tick_v( now, nframes );
+        else mod->system_tick( now );
+        // block-rate sample of the modulator; coefficients ramp between
+        freq += mod->m_last;
+        // keep the designs stable
+        if( freq < 1 ) freq = 1;
+        else if( freq > g_srate * .49 ) freq = g_srate * .49;
+        modulated = TRUE;
+    }
+
+    d->tick_block<TICK>( freq, modulated, in, out, nframes );
+    return TRUE;
 }
 
 
@@ -1246,19 +1482,18 @@ CK_DLL_CTOR( BPF_ctor )
 {
     FilterBasic_data * f =  new FilterBasic_data;
     memset( f, 0, sizeof(FilterBasic_data) );
+    f->m_design = &FilterBasic_data::coef_bpf;
     OBJ_MEMBER_UINT(SELF, FilterBasic_offset_data) = (t_CKUINT)f;
 }
 
 
 //-----------------------------------------------------------------------------
-// name: BPF_tick()
-// desc: TICK function ...
+// name: BPF_tickf()
+// desc: TICKF function (mono, one block)
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( BPF_tick )
+CK_DLL_TICKF( BPF_tickf )
 {
-    FilterBasic_data * d = (FilterBasic_data *)OBJ_MEMBER_UINT(SELF, FilterBasic_offset_data);
-    *out = d->tick_bpf( in );
-    return TRUE;
+    return FilterBasic_tickf<&FilterBasic_data::tick_bpf>( SELF, in, out, nframes );
 }
 
 
@@ -1273,7 +1508,7 @@ CK_DLL_CTRL( BPF_ctrl_freq )
     t_CKFLOAT freq = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_bpf( freq, d->m_Q );
+    d->set( freq, d->m_Q );
 
     // return
     RETURN->v_float = d->m_freq;
@@ -1304,7 +1539,7 @@ CK_DLL_CTRL( BPF_ctrl_Q )
     t_CKFLOAT Q = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_bpf( d->m_freq, Q );
+    d->set( d->m_freq, Q );
 
 
     RETURN->v_float = d->m_Q;
@@ -1336,7 +1571,7 @@ CK_DLL_CTRL( BPF_ctrl_set )
     t_CKFLOAT Q = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_bpf( freq, Q );
+    d->set( freq, Q );
 }
 
 
@@ -1360,19 +1595,18 @@ CK_DLL_CTOR( BRF_ctor )
 {
     FilterBasic_data * f =  new FilterBasic_data;
     memset( f, 0, sizeof(FilterBasic_data) );
+    f->m_design = &FilterBasic_data::coef_brf;
     OBJ_MEMBER_UINT(SELF, FilterBasic_offset_data) = (t_CKUINT)f;
 }
 
 
 //-----------------------------------------------------------------------------
-// name: BRF_tick()
-// desc: TICK function ...
+// name: BRF_tickf()
+// desc: TICKF function (mono, one block)
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( BRF_tick )
+CK_DLL_TICKF( BRF_tickf )
 {
-    FilterBasic_data * d = (FilterBasic_data *)OBJ_MEMBER_UINT(SELF, FilterBasic_offset_data);
-    *out = d->tick_brf( in );
-    return TRUE;
+    return FilterBasic_tickf<&FilterBasic_data::tick_brf>( SELF, in, out, nframes );
 }
 
 
@@ -1387,7 +1621,7 @@ CK_DLL_CTRL( BRF_ctrl_freq )
     t_CKFLOAT freq = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_brf( freq, d->m_Q );
+    d->set( freq, d->m_Q );
 
     // return
     RETURN->v_float = d->m_freq;
@@ -1418,7 +1652,7 @@ CK_DLL_CTRL( BRF_ctrl_Q )
     t_CKFLOAT Q = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_brf( d->m_freq, Q );
+    d->set( d->m_freq, Q );
 
     // return
     RETURN->v_float = d->m_Q;
@@ -1450,7 +1684,7 @@ CK_DLL_CTRL( BRF_ctrl_set )
     t_CKFLOAT Q = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_brf( freq, Q );
+    d->set( freq, Q );
 }
 
 
@@ -1474,6 +1708,7 @@ CK_DLL_CTOR( RLPF_ctor )
 {
     FilterBasic_data * f =  new FilterBasic_data;
     memset( f, 0, sizeof(FilterBasic_data) );
+    f->m_design = &FilterBasic_data::coef_rlpf;
     // default
     f->m_Q = 1.0;
     OBJ_MEMBER_UINT(SELF, FilterBasic_offset_data) = (t_CKUINT)f;
@@ -1481,14 +1716,12 @@ CK_DLL_CTOR( RLPF_ctor )
 
 
 //-----------------------------------------------------------------------------
-// name: RLPF_tick()
-// desc: TICK function ...
+// name: RLPF_tickf()
+// desc: TICKF function (mono, one block)
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( RLPF_tick )
+CK_DLL_TICKF( RLPF_tickf )
 {
-    FilterBasic_data * d = (FilterBasic_data *)OBJ_MEMBER_UINT(SELF, FilterBasic_offset_data);
-    *out = d->tick_rlpf( in );
-    return TRUE;
+    return FilterBasic_tickf<&FilterBasic_data::tick_rlpf>( SELF, in, out, nframes );
 }
 
 
@@ -1502,7 +1735,7 @@ CK_DLL_CTRL( RLPF_ctrl_freq )
     t_CKFLOAT freq = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_rlpf( freq, d->m_Q );
+    d->set( freq, d->m_Q );
 
     // return
     RETURN->v_float = d->m_freq;
@@ -1532,7 +1765,7 @@ CK_DLL_CTRL( RLPF_ctrl_Q )
     t_CKFLOAT Q = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_rlpf( d->m_freq, Q );
+    d->set( d->m_freq, FilterBasic_data::rq_clamp( Q ) );
 
     // return
     RETURN->v_float = d->m_Q;
@@ -1564,7 +1797,7 @@ CK_DLL_CTRL( RLPF_ctrl_set )
     t_CKFLOAT Q = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_rlpf( freq, Q );
+    d->set( freq, FilterBasic_data::rq_clamp( Q ) );
 
     RETURN->v_float = freq;
 }
@@ -1590,21 +1823,20 @@ CK_DLL_CTOR( ResonZ_ctor )
 {
     FilterBasic_data * f =  new FilterBasic_data;
     memset( f, 0, sizeof(FilterBasic_data) );
+    f->m_design = &FilterBasic_data::coef_resonz;
     // default
-    f->set_resonz( 220, 1 );
+    f->set( 220, 1 );
     OBJ_MEMBER_UINT(SELF, FilterBasic_offset_data) = (t_CKUINT)f;
 }
 
 
 //-----------------------------------------------------------------------------
-// name: ResonZ_tick()
-// desc: TICK function ...
+// name: ResonZ_tickf()
+// desc: TICKF function (mono, one block)
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( ResonZ_tick )
+CK_DLL_TICKF( ResonZ_tickf )
 {
-    FilterBasic_data * d = (FilterBasic_data *)OBJ_MEMBER_UINT(SELF, FilterBasic_offset_data);
-    *out = d->tick_resonz( in );
-    return TRUE;
+    return FilterBasic_tickf<&FilterBasic_data::tick_resonz>( SELF, in, out, nframes );
 }
 
 
@@ -1618,7 +1850,7 @@ CK_DLL_CTRL( ResonZ_ctrl_freq )
     t_CKFLOAT freq = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_resonz( freq, d->m_Q );
+    d->set( freq, d->m_Q );
 
     // return
     RETURN->v_float = d->m_freq;
@@ -1648,7 +1880,7 @@ CK_DLL_CTRL( ResonZ_ctrl_Q )
     t_CKFLOAT Q = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_resonz( d->m_freq, Q );
+    d->set( d->m_freq, Q );
 
     // return
     RETURN->v_float = d->m_Q;
@@ -1680,7 +1912,7 @@ CK_DLL_CTRL( ResonZ_ctrl_set )
     t_CKFLOAT Q = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_resonz( freq, Q );
+    d->set( freq, Q );
 
     RETURN->v_float = freq;
 }
@@ -1706,6 +1938,7 @@ CK_DLL_CTOR( RHPF_ctor )
 {
     FilterBasic_data * f =  new FilterBasic_data;
     memset( f, 0, sizeof(FilterBasic_data) );
+    f->m_design = &FilterBasic_data::coef_rhpf;
     // default
     f->m_Q = 1.0;
     OBJ_MEMBER_UINT(SELF, FilterBasic_offset_data) = (t_CKUINT)f;
@@ -1713,14 +1946,12 @@ CK_DLL_CTOR( RHPF_ctor )
 
 
 //-----------------------------------------------------------------------------
-// name: RHPF_tick()
-// desc: TICK function ...
+// name: RHPF_tickf()
+// desc: TICKF function (mono, one block)
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( RHPF_tick )
+CK_DLL_TICKF( RHPF_tickf )
 {
-    FilterBasic_data * d = (FilterBasic_data *)OBJ_MEMBER_UINT(SELF, FilterBasic_offset_data);
-    *out = d->tick_rhpf( in );
-    return TRUE;
+    return FilterBasic_tickf<&FilterBasic_data::tick_rhpf>( SELF, in, out, nframes );
 }
 
 
@@ -1734,7 +1965,7 @@ CK_DLL_CTRL( RHPF_ctrl_freq )
     t_CKFLOAT freq = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_rhpf( freq, d->m_Q );
+    d->set( freq, d->m_Q );
 
     // return
     RETURN->v_float = d->m_freq;
@@ -1764,7 +1995,7 @@ CK_DLL_CTRL( RHPF_ctrl_Q )
     t_CKFLOAT Q = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_rhpf( d->m_freq, Q );
+    d->set( d->m_freq, FilterBasic_data::rq_clamp( Q ) );
 
     // return
     RETURN->v_float = d->m_Q;
@@ -1796,7 +2027,7 @@ CK_DLL_CTRL( RHPF_ctrl_set )
     t_CKFLOAT Q = GET_NEXT_FLOAT(ARGS);
 
     // set
-    d->set_rlpf( freq, Q );
+    d->set( freq, FilterBasic_data::rq_clamp( Q ) );
 }
 
 
@@ -2527,6 +2758,614 @@ CK_DLL_CTRL( gQ_ctrl_rad )
 
 
 
+//-----------------------------------------------------------------------------
+// name: SOSBank
+// desc: many second-order sections in one ugen, run in parallel or in series
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// name: SOSBank_data
+// desc: sections are stored by field (one array per coefficient), padded to
+//       a multiple of SOSBANK_LANES with silent sections, so the per-sample
+//       loops over sections carry no remainder and vectorize (at -O3; no
+//       -ffast-math needed, the lanes are summed in a fixed order); a parameter
+//       change ramps every coefficient linearly from where it is to its
+//       target over m_smooth samples (a straight line between two stable
+//       sections stays inside the stability triangle)
+//-----------------------------------------------------------------------------
+struct SOSBank_data
+{
+    // number of sections, and padded count
+    t_CKINT m_num;
+    t_CKINT m_pad;
+    // SOSBank.PARALLEL or SOSBank.SERIES
+    t_CKINT m_mode;
+    
+    // coefficients, targets, and per-sample steps toward them
+    enum { B0, B1, B2, A1, A2, MIX, NUM_PARAMS };
+    SAMPLE * m_c[NUM_PARAMS];
+    SAMPLE * m_target[NUM_PARAMS];
+    SAMPLE * m_step[NUM_PARAMS];
+    // state (transposed direct form II)
+    SAMPLE * m_z1;
+    SAMPLE * m_z2;
+    // per-section output of the current frame, and envelope
+    SAMPLE * m_y;
+    SAMPLE * m_env;
+    
+    // ramp length and samples left in the current ramp
+    t_CKINT m_smooth;
+    t_CKINT m_ramp;
+    // targets changed since the last block
+    t_CKBOOL m_dirty;
+    // envelope follower time (samples, 0 = off) and coefficient
+    t_CKDUR m_follow;
+    SAMPLE m_env_coef;
+    
+    SOSBank_data()
+    {
+        m_num = m_pad = 0;
+        m_mode = SOSBank_mode_PARALLEL;
+        for( t_CKINT p = 0; p < NUM_PARAMS; p++ )
+            m_c[p] = m_target[p] = m_step[p] = NULL;
+        m_z1 = m_z2 = m_y = m_env = NULL;
+        m_smooth = 0;
+        m_ramp = 0;
+        m_dirty = FALSE;
+        m_follow = 0;
+        m_env_coef = 0;
+    }
+    
+    ~SOSBank_data()
+    {
+        release();
+    }
+    
+    void release()
+    {
+        for( t_CKINT p = 0; p < NUM_PARAMS; p++ )
+        {
+            SAFE_DELETE_ARRAY( m_c[p] );
+            SAFE_DELETE_ARRAY( m_target[p] );
+            SAFE_DELETE_ARRAY( m_step[p] );
+        }
+        SAFE_DELETE_ARRAY( m_z1 );
+        SAFE_DELETE_ARRAY( m_z2 );
+        SAFE_DELETE_ARRAY( m_y );
+        SAFE_DELETE_ARRAY( m_env );
+    }
+    
+    // set the number of sections; existing sections are kept
+    void resize( t_CKINT num )
+    {
+        if( num < 0 ) num = 0;
+        t_CKINT pad = ( num + SOSBANK_LANES - 1 ) / SOSBANK_LANES * SOSBANK_LANES;
+        
+        SAMPLE * c[NUM_PARAMS], * target[NUM_PARAMS], * step[NUM_PARAMS];
+        for( t_CKINT p = 0; p < NUM_PARAMS; p++ )
+        {
+            c[p] = grow( m_c[p], pad );
+            target[p] = grow( m_target[p], pad );
+            step[p] = grow( m_step[p], pad );
+        }
+        SAMPLE * z1 = grow( m_z1, pad );
+        SAMPLE * z2 = grow( m_z2, pad );
+        SAMPLE * env = grow( m_env, pad );
+        SAMPLE * y = grow( m_y, pad );
+        
+        // new sections pass their input through, at unit mix
+        for( t_CKINT i = m_num; i < num; i++ )
+        {
+            c[B0][i] = target[B0][i] = 1;
+            c[MIX][i] = target[MIX][i] = 1;
+        }
+        // padding is silent
+        for( t_CKINT i = num; i < pad; i++ )
+        {
+            for( t_CKINT p = 0; p < NUM_PARAMS; p++ )
+                c[p][i] = target[p][i] = step[p][i] = 0;
+            z1[i] = z2[i] = env[i] = y[i] = 0;
+        }
+        
+        release();
+        for( t_CKINT p = 0; p < NUM_PARAMS; p++ )
+        { m_c[p] = c[p]; m_target[p] = target[p]; m_step[p] = step[p]; }
+        m_z1 = z1; m_z2 = z2; m_env = env; m_y = y;
+        m_num = num;
+        m_pad = pad;
+        
+        // restart any ramp against the new layout
+        if( m_ramp ) m_dirty = TRUE;
+    }
+    
+    // copy of src, resized to n (zero-filled)
+    SAMPLE * grow( SAMPLE * src, t_CKINT n )
+    {
+        SAMPLE * dest = new SAMPLE[n > 0 ? n : 1];
+        memset( dest, 0, sizeof(SAMPLE) * ( n > 0 ? n : 1 ) );
+        t_CKINT keep = m_pad < n ? m_pad : n;
+        if( src && keep > 0 ) memcpy( dest, src, sizeof(SAMPLE) * keep );
+        return dest;
+    }
+    
+    // set a target value for section i; the ramp starts at the next block
+    void set( t_CKINT i, t_CKINT p, SAMPLE value )
+    {
+        m_target[p][i] = value;
+        if( m_smooth <= 0 ) m_c[p][i] = value;
+        else m_dirty = TRUE;
+    }
+    
+    // (re)start the ramp from the current values toward the targets
+    void retarget()
+    {
+        if( m_smooth <= 0 )
+        {
+            for( t_CKINT p = 0; p < NUM_PARAMS; p++ )
+                memcpy( m_c[p], m_target[p], sizeof(SAMPLE) * m_pad );
+            m_ramp = 0;
+            m_dirty = FALSE;
+            return;
+        }
+        
+        SAMPLE inv = (SAMPLE)1.0 / m_smooth;
+        for( t_CKINT p = 0; p < NUM_PARAMS; p++ )
+            for( t_CKINT i = 0; i < m_pad; i++ )
+                m_step[p][i] = ( m_target[p][i] - m_c[p][i] ) * inv;
+        m_ramp = m_smooth;
+        m_dirty = FALSE;
+    }
+    
+    // advance the ramp by one sample
+    inline void ramp()
+    {
+        for( t_CKINT p = 0; p < NUM_PARAMS; p++ )
+        {
+            SAMPLE * c = m_c[p]; const SAMPLE * s = m_step[p];
+            for( t_CKINT i = 0; i < m_pad; i++ ) c[i] += s[i];
+        }
+        // land exactly on the targets
+        if( --m_ramp == 0 )
+            for( t_CKINT p = 0; p < NUM_PARAMS; p++ )
+                memcpy( m_c[p], m_target[p], sizeof(SAMPLE) * m_pad );
+    }
+    
+    // set the envelope follower time
+    void follow( t_CKDUR samples )
+    {
+        m_follow = samples > 0 ? samples : 0;
+        m_env_coef = m_follow > 0 ? (SAMPLE)( 1.0 - exp( -1.0 / m_follow ) ) : 0;
+        if( m_follow == 0 ) memset( m_env, 0, sizeof(SAMPLE) * m_pad );
+    }
+    
+    // one frame of input through n sections, side by side
+    static inline void sections( const SAMPLE * SOSBANK_RESTRICT b0,
+        const SAMPLE * SOSBANK_RESTRICT b1, const SAMPLE * SOSBANK_RESTRICT b2,
+        const SAMPLE * SOSBANK_RESTRICT a1, const SAMPLE * SOSBANK_RESTRICT a2,
+        SAMPLE * SOSBANK_RESTRICT z1, SAMPLE * SOSBANK_RESTRICT z2,
+        SAMPLE * SOSBANK_RESTRICT y, const SAMPLE x, const t_CKINT n )
+    {
+        for( t_CKINT i = 0; i < n; i++ )
+        {
+            SAMPLE v = b0[i] * x + z1[i];
+            z1[i] = b1[i] * x - a1[i] * v + z2[i];
+            z2[i] = b2[i] * x - a2[i] * v;
+            y[i] = v;
+        }
+    }
+    
+    // parallel: every section sees the input; output is the mixed sum
+    void tick_parallel( const SAMPLE * in, SAMPLE * out, t_CKUINT nframes )
+    {
+        const t_CKINT n = m_pad;
+        SAMPLE * z1 = m_z1, * z2 = m_z2, * y = m_y, * env = m_env;
+        const SAMPLE ec = m_env_coef;
+        
+        for( t_CKUINT f = 0; f < nframes; f++ )
+        {
+            if( m_ramp ) ramp();
+            const SAMPLE * mix = m_c[MIX];
+            
+            // across sections
+            sections( m_c[B0], m_c[B1], m_c[B2], m_c[A1], m_c[A2],
+                      z1, z2, y, in[f], n );
+            if( ec != 0 )
+                for( t_CKINT i = 0; i < n; i++ )
+                    env[i] += ec * ( fabs( y[i] ) - env[i] );
+            
+            // sum in lanes, then across lanes
+            SAMPLE acc[SOSBANK_LANES] = { 0 };
+            for( t_CKINT i = 0; i < n; i += SOSBANK_LANES )
+                for( t_CKINT l = 0; l < SOSBANK_LANES; l++ )
+                    acc[l] += mix[i+l] * y[i+l];
+            SAMPLE sum = 0;
+            for( t_CKINT l = 0; l < SOSBANK_LANES; l++ ) sum += acc[l];
+            out[f] = sum;
+        }
+    }
+    
+    // series: each section filters the whole block, in order
+    void tick_series( const SAMPLE * in, SAMPLE * out, t_CKUINT nframes )
+    {
+        if( in != out ) memcpy( out, in, sizeof(SAMPLE) * nframes );
+        
+        // frames (at the start of this block) still ramping
+        t_CKUINT ramped = m_ramp < (t_CKINT)nframes ? m_ramp : nframes;
+        const SAMPLE ec = m_env_coef;
+        
+        for( t_CKINT i = 0; i < m_num; i++ )
+        {
+            SAMPLE b0 = m_c[B0][i], b1 = m_c[B1][i], b2 = m_c[B2][i];
+            SAMPLE a1 = m_c[A1][i], a2 = m_c[A2][i];
+            SAMPLE z1 = m_z1[i], z2 = m_z2[i], env = m_env[i];
+            t_CKUINT f = 0;
+            
+            // ramping part
+            for( ; f < ramped; f++ )
+            {
+                b0 += m_step[B0][i]; b1 += m_step[B1][i]; b2 += m_step[B2][i];
+                a1 += m_step[A1][i]; a2 += m_step[A2][i];
+                SAMPLE x = out[f];
+                SAMPLE v = b0 * x + z1;
+                z1 = b1 * x - a1 * v + z2;
+                z2 = b2 * x - a2 * v;
+                out[f] = v;
+                env += ec * ( fabs( v ) - env );
+            }
+            // steady part
+            for( ; f < nframes; f++ )
+            {
+                SAMPLE x = out[f];
+                SAMPLE v = b0 * x + z1;
+                z1 = b1 * x - a1 * v + z2;
+                z2 = b2 * x - a2 * v;
+                out[f] = v;
+                env += ec * ( fabs( v ) - env );
+            }
+            
+            m_z1[i] = z1; m_z2[i] = z2; m_env[i] = env;
+            if( nframes ) m_y[i] = out[nframes-1];
+        }
+        
+        // move the shared ramp on by the same amount
+        if( ramped )
+        {
+            if( (t_CKINT)ramped == m_ramp )
+            {
+                for( t_CKINT p = 0; p < NUM_PARAMS; p++ )
+                    memcpy( m_c[p], m_target[p], sizeof(SAMPLE) * m_pad );
+                m_ramp = 0;
+            }
+            else
+            {
+                for( t_CKINT p = 0; p < NUM_PARAMS; p++ )
+                    for( t_CKINT i = 0; i < m_pad; i++ )
+                        m_c[p][i] += m_step[p][i] * ramped;
+                m_ramp -= ramped;
+            }
+        }
+        
+        // series output is not mixed per section
+    }
+    
+    void tick( const SAMPLE * in, SAMPLE * out, t_CKUINT nframes )
+    {
+        if( m_num == 0 )
+        {
+            if( in != out ) memcpy( out, in, sizeof(SAMPLE) * nframes );
+            return;
+        }
+        
+        // start ramping toward anything set since the last block
+        if( m_dirty ) retarget();
+        
+        if( m_mode == SOSBank_mode_SERIES ) tick_series( in, out, nframes );
+        else tick_parallel( in, out, nframes );
+        
+        // be normal, once per block
+        for( t_CKINT i = 0; i < m_num; i++ )
+        {
+            CK_DDN( m_z1[i] );
+            CK_DDN( m_z2[i] );
+            CK_DDN( m_env[i] );
+        }
+    }
+    
+    void clear()
+    {
+        memset( m_z1, 0, sizeof(SAMPLE) * m_pad );
+        memset( m_z2, 0, sizeof(SAMPLE) * m_pad );
+        memset( m_env, 0, sizeof(SAMPLE) * m_pad );
+        memset( m_y, 0, sizeof(SAMPLE) * m_pad );
+    }
+    
+    // RBJ cookbook designs, normalized by a0
+    enum { LPF, HPF, BPF, PEAK };
+    void design( t_CKINT i, t_CKINT type, t_CKFLOAT freq, t_CKFLOAT Q, t_CKFLOAT db )
+    {
+        if( Q <= 0 ) Q = .001;
+        t_CKFLOAT w = freq * g_radians_per_sample;
+        t_CKFLOAT cs = cos( w ), alpha = sin( w ) / ( 2 * Q );
+        t_CKFLOAT A = pow( 10.0, db / 40 );
+        t_CKFLOAT b0, b1, b2, a0, a1, a2;
+        
+        switch( type )
+        {
+            case LPF:
+                b0 = b2 = ( 1 - cs ) / 2; b1 = 1 - cs;
+                a0 = 1 + alpha; a1 = -2 * cs; a2 = 1 - alpha;
+                break;
+            case HPF:
+                b0 = b2 = ( 1 + cs ) / 2; b1 = -( 1 + cs );
+                a0 = 1 + alpha; a1 = -2 * cs; a2 = 1 - alpha;
+                break;
+            case BPF:
+                // constant 0 dB peak gain
+                b0 = alpha; b1 = 0; b2 = -alpha;
+                a0 = 1 + alpha; a1 = -2 * cs; a2 = 1 - alpha;
+                break;
+            default: // PEAK
+                b0 = 1 + alpha * A; b1 = -2 * cs; b2 = 1 - alpha * A;
+                a0 = 1 + alpha / A; a1 = -2 * cs; a2 = 1 - alpha / A;
+                break;
+        }
+        
+        set( i, B0, (SAMPLE)( b0 / a0 ) );
+        set( i, B1, (SAMPLE)( b1 / a0 ) );
+        set( i, B2, (SAMPLE)( b2 / a0 ) );
+        set( i, A1, (SAMPLE)( a1 / a0 ) );
+        set( i, A2, (SAMPLE)( a2 / a0 ) );
+    }
+};
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_ctor()
+// desc: CTOR function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CTOR( SOSBank_ctor )
+{
+    SOSBank_data * d = new SOSBank_data;
+    OBJ_MEMBER_UINT( SELF, SOSBank_offset_data ) = (t_CKUINT)d;
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_dtor()
+// desc: DTOR function ...
+//-----------------------------------------------------------------------------
+CK_DLL_DTOR( SOSBank_dtor )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    SAFE_DELETE( d );
+    OBJ_MEMBER_UINT(SELF, SOSBank_offset_data) = 0;
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_tickf()
+// desc: TICKF function ...
+//-----------------------------------------------------------------------------
+CK_DLL_TICKF( SOSBank_tickf )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    d->tick( in, out, nframes );
+    return TRUE;
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_ctrl_size()
+// desc: CTRL function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CTRL( SOSBank_ctrl_size )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    d->resize( GET_NEXT_INT(ARGS) );
+    RETURN->v_int = d->m_num;
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_cget_size()
+// desc: CGET function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CGET( SOSBank_cget_size )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    RETURN->v_int = d->m_num;
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_ctrl_mode()
+// desc: CTRL function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CTRL( SOSBank_ctrl_mode )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    t_CKINT mode = GET_NEXT_INT(ARGS);
+    d->m_mode = mode == SOSBank_mode_SERIES ? SOSBank_mode_SERIES : SOSBank_mode_PARALLEL;
+    RETURN->v_int = d->m_mode;
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_cget_mode()
+// desc: CGET function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CGET( SOSBank_cget_mode )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    RETURN->v_int = d->m_mode;
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_ctrl_coefs()
+// desc: CTRL function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CTRL( SOSBank_ctrl_coefs )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    t_CKINT which = GET_NEXT_INT(ARGS);
+    if( which < 0 || which >= d->m_num ) return;
+    d->set( which, SOSBank_data::B0, (SAMPLE)GET_NEXT_FLOAT(ARGS) );
+    d->set( which, SOSBank_data::B1, (SAMPLE)GET_NEXT_FLOAT(ARGS) );
+    d->set( which, SOSBank_data::B2, (SAMPLE)GET_NEXT_FLOAT(ARGS) );
+    d->set( which, SOSBank_data::A1, (SAMPLE)GET_NEXT_FLOAT(ARGS) );
+    d->set( which, SOSBank_data::A2, (SAMPLE)GET_NEXT_FLOAT(ARGS) );
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_design()
+// desc: shared by the lpf/hpf/bpf/peak setters
+//-----------------------------------------------------------------------------
+static void SOSBank_design( Chuck_Object * SELF, void * ARGS, t_CKINT type, t_CKBOOL has_db )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    t_CKINT which = GET_NEXT_INT(ARGS);
+    t_CKFLOAT freq = GET_NEXT_FLOAT(ARGS);
+    t_CKFLOAT Q = GET_NEXT_FLOAT(ARGS);
+    t_CKFLOAT db = has_db ? GET_NEXT_FLOAT(ARGS) : 0;
+    if( which < 0 || which >= d->m_num ) return;
+    d->design( which, type, freq, Q, db );
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_ctrl_lpf()
+// desc: CTRL function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CTRL( SOSBank_ctrl_lpf )
+{
+    SOSBank_design( SELF, ARGS, SOSBank_data::LPF, FALSE );
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_ctrl_hpf()
+// desc: CTRL function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CTRL( SOSBank_ctrl_hpf )
+{
+    SOSBank_design( SELF, ARGS, SOSBank_data::HPF, FALSE );
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_ctrl_bpf()
+// desc: CTRL function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CTRL( SOSBank_ctrl_bpf )
+{
+    SOSBank_design( SELF, ARGS, SOSBank_data::BPF, FALSE );
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_ctrl_peak()
+// desc: CTRL function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CTRL( SOSBank_ctrl_peak )
+{
+    SOSBank_design( SELF, ARGS, SOSBank_data::PEAK, TRUE );
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_ctrl_mix()
+// desc: CTRL function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CTRL( SOSBank_ctrl_mix )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    t_CKINT which = GET_NEXT_INT(ARGS);
+    t_CKFLOAT mix = GET_NEXT_FLOAT(ARGS);
+    RETURN->v_float = 0;
+    if( which < 0 || which >= d->m_num ) return;
+    d->set( which, SOSBank_data::MIX, (SAMPLE)mix );
+    RETURN->v_float = mix;
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_cget_mix()
+// desc: CGET function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CGET( SOSBank_cget_mix )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    t_CKINT which = GET_NEXT_INT(ARGS);
+    RETURN->v_float = which < 0 || which >= d->m_num ? 0 : d->m_target[SOSBank_data::MIX][which];
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_ctrl_smooth()
+// desc: CTRL function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CTRL( SOSBank_ctrl_smooth )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    t_CKDUR smooth = GET_NEXT_DUR(ARGS);
+    d->m_smooth = smooth > 0 ? (t_CKINT)( smooth + .5 ) : 0;
+    RETURN->v_dur = d->m_smooth;
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_cget_smooth()
+// desc: CGET function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CGET( SOSBank_cget_smooth )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    RETURN->v_dur = d->m_smooth;
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_ctrl_follow()
+// desc: CTRL function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CTRL( SOSBank_ctrl_follow )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    d->follow( GET_NEXT_DUR(ARGS) );
+    RETURN->v_dur = d->m_follow;
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_cget_follow()
+// desc: CGET function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CGET( SOSBank_cget_follow )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    RETURN->v_dur = d->m_follow;
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_cget_env()
+// desc: CGET function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CGET( SOSBank_cget_env )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    t_CKINT which = GET_NEXT_INT(ARGS);
+    RETURN->v_float = which < 0 || which >= d->m_num ? 0 : d->m_env[which];
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_cget_last()
+// desc: CGET function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CGET( SOSBank_cget_last )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    t_CKINT which = GET_NEXT_INT(ARGS);
+    RETURN->v_float = which < 0 || which >= d->m_num ? 0 : d->m_y[which];
+}
+
+//-----------------------------------------------------------------------------
+// name: SOSBank_ctrl_clear()
+// desc: CTRL function ...
+//-----------------------------------------------------------------------------
+CK_DLL_CTRL( SOSBank_ctrl_clear )
+{
+    SOSBank_data * d = (SOSBank_data *)OBJ_MEMBER_UINT(SELF, SOSBank_offset_data );
+    d->clear();
+}
+
+
+
+
 /*
 
 //-----------------------------------------------------------------------------
@@ -70,7 +70,7 @@ CK_DLL_CGET( HPF_cget_freq );
 // BPF
 CK_DLL_CTOR( BPF_ctor );
 CK_DLL_DTOR( BPF_dtor );
-CK_DLL_TICK( BPF_tick );
+CK_DLL_TICKF( BPF_tickf );
 CK_DLL_PMSG( BPF_pmsg );
 CK_DLL_CTRL( BPF_ctrl_freq );
 CK_DLL_CGET( BPF_cget_freq );
@@ -81,7 +81,7 @@ CK_DLL_CTRL( BPF_ctrl_set );
 // BRF
 CK_DLL_CTOR( BRF_ctor );
 CK_DLL_DTOR( BRF_dtor );
-CK_DLL_TICK( BRF_tick );
+CK_DLL_TICKF( BRF_tickf );
 CK_DLL_PMSG( BRF_pmsg );
 CK_DLL_CTRL( BRF_ctrl_freq );
 CK_DLL_CGET( BRF_cget_freq );
@@ -92,7 +92,7 @@ CK_DLL_CTRL( BRF_ctrl_set );
 // RLPF
 CK_DLL_CTOR( RLPF_ctor );
 CK_DLL_DTOR( RLPF_dtor );
-CK_DLL_TICK( RLPF_tick );
+CK_DLL_TICKF( RLPF_tickf );
 CK_DLL_PMSG( RLPF_pmsg );
 CK_DLL_CTRL( RLPF_ctrl_freq );
 CK_DLL_CGET( RLPF_cget_freq );
@@ -103,7 +103,7 @@ CK_DLL_CTRL( RLPF_ctrl_set );
 // RHPF
 CK_DLL_CTOR( RHPF_ctor );
 CK_DLL_DTOR( RHPF_dtor );
-CK_DLL_TICK( RHPF_tick );
+CK_DLL_TICKF( RHPF_tickf );
 CK_DLL_PMSG( RHPF_pmsg );
 CK_DLL_CTRL( RHPF_ctrl_freq );
 CK_DLL_CGET( RHPF_cget_freq );
@@ -114,7 +114,7 @@ CK_DLL_CTRL( RHPF_ctrl_set );
 // ResonZ
 CK_DLL_CTOR( ResonZ_ctor );
 CK_DLL_DTOR( ResonZ_dtor );
-CK_DLL_TICK( ResonZ_tick );
+CK_DLL_TICKF( ResonZ_tickf );
 CK_DLL_PMSG( ResonZ_pmsg );
 CK_DLL_CTRL( ResonZ_ctrl_freq );
 CK_DLL_CGET( ResonZ_cget_freq );
@@ -162,6 +162,29 @@ CK_DLL_CGET( biquad_cget_a1 );
 CK_DLL_CTRL( biquad_ctrl_a2 );
 CK_DLL_CGET( biquad_cget_a2 );
 
+// SOSBank
+CK_DLL_CTOR( SOSBank_ctor );
+CK_DLL_DTOR( SOSBank_dtor );
+CK_DLL_TICKF( SOSBank_tickf );
+CK_DLL_CTRL( SOSBank_ctrl_size );
+CK_DLL_CGET( SOSBank_cget_size );
+CK_DLL_CTRL( SOSBank_ctrl_mode );
+CK_DLL_CGET( SOSBank_cget_mode );
+CK_DLL_CTRL( SOSBank_ctrl_coefs );
+CK_DLL_CTRL( SOSBank_ctrl_lpf );
+CK_DLL_CTRL( SOSBank_ctrl_hpf );
+CK_DLL_CTRL( SOSBank_ctrl_bpf );
+CK_DLL_CTRL( SOSBank_ctrl_peak );
+CK_DLL_CTRL( SOSBank_ctrl_mix );
+CK_DLL_CGET( SOSBank_cget_mix );
+CK_DLL_CTRL( SOSBank_ctrl_smooth );
+CK_DLL_CGET( SOSBank_cget_smooth );
+CK_DLL_CTRL( SOSBank_ctrl_follow );
+CK_DLL_CGET( SOSBank_cget_follow );
+CK_DLL_CGET( SOSBank_cget_env );
+CK_DLL_CGET( SOSBank_cget_last );
+CK_DLL_CTRL( SOSBank_ctrl_clear );
+
 //Teabox
 CK_DLL_CTOR( teabox_ctor );
 CK_DLL_TICK( teabox_tick );
@@ -133,7 +133,7 @@ horn ok please -> written at the back of trucks, always, makes no sense.
 // ADSR
 CK_DLL_CTOR( ADSR_ctor );
 CK_DLL_DTOR( ADSR_dtor );
-CK_DLL_TICK( ADSR_tick );
+CK_DLL_TICKF( ADSR_tickf );
 CK_DLL_PMSG( ADSR_pmsg );
 CK_DLL_CTRL( ADSR_ctrl_attackTime );
 CK_DLL_CTRL( ADSR_ctrl_attackRate );
@@ -199,7 +199,7 @@ CK_DLL_CGET( Chorus_cget_mix );
 // Delay
 CK_DLL_CTOR( Delay_ctor );
 CK_DLL_DTOR( Delay_dtor );
-CK_DLL_TICK( Delay_tick );
+CK_DLL_TICKF( Delay_tickf );
 CK_DLL_PMSG( Delay_pmsg );
 CK_DLL_CTRL( Delay_ctrl_delay );
 CK_DLL_CTRL( Delay_ctrl_max );
@@ -210,7 +210,7 @@ CK_DLL_CGET( Delay_clear );
 // DelayA
 CK_DLL_CTOR( DelayA_ctor );
 CK_DLL_DTOR( DelayA_dtor );
-CK_DLL_TICK( DelayA_tick );
+CK_DLL_TICKF( DelayA_tickf );
 CK_DLL_PMSG( DelayA_pmsg );
 CK_DLL_CTRL( DelayA_ctrl_delay );
 CK_DLL_CTRL( DelayA_ctrl_max );
@@ -221,7 +221,7 @@ CK_DLL_CGET( DelayA_clear );
 // DelayL
 CK_DLL_CTOR( DelayL_ctor );
 CK_DLL_DTOR( DelayL_dtor );
-CK_DLL_TICK( DelayL_tick );
+CK_DLL_TICKF( DelayL_tickf );
 CK_DLL_PMSG( DelayL_pmsg );
 CK_DLL_CTRL( DelayL_ctrl_delay );
 CK_DLL_CTRL( DelayL_ctrl_max );
@@ -244,7 +244,7 @@ CK_DLL_CGET( Echo_cget_mix );
 // Envelope
 CK_DLL_CTOR( Envelope_ctor );
 CK_DLL_DTOR( Envelope_dtor );
-CK_DLL_TICK( Envelope_tick );
+CK_DLL_TICKF( Envelope_tickf );
 CK_DLL_PMSG( Envelope_pmsg );
 CK_DLL_CTRL( Envelope_ctrl_rate );
 CK_DLL_CTRL( Envelope_ctrl_target );
@@ -274,7 +274,7 @@ CK_DLL_CGET( FilterStk_cget_coefs );
 // OnePole
 CK_DLL_CTOR( OnePole_ctor );
 CK_DLL_DTOR( OnePole_dtor );
-CK_DLL_TICK( OnePole_tick );
+CK_DLL_TICKF( OnePole_tickf );
 CK_DLL_PMSG( OnePole_pmsg );
 CK_DLL_CTRL( OnePole_ctrl_a1 );
 CK_DLL_CTRL( OnePole_ctrl_b0 );
@@ -286,7 +286,7 @@ CK_DLL_CGET( OnePole_cget_pole );
 // TwoPole
 CK_DLL_CTOR( TwoPole_ctor );
 CK_DLL_DTOR( TwoPole_dtor );
-CK_DLL_TICK( TwoPole_tick );
+CK_DLL_TICKF( TwoPole_tickf );
 CK_DLL_PMSG( TwoPole_pmsg );
 CK_DLL_CTRL( TwoPole_ctrl_a1 );
 CK_DLL_CTRL( TwoPole_ctrl_a2 );
@@ -305,7 +305,7 @@ CK_DLL_CGET( TwoPole_cget_norm );
 // OneZero
 CK_DLL_CTOR( OneZero_ctor );
 CK_DLL_DTOR( OneZero_dtor );
-CK_DLL_TICK( OneZero_tick );
+CK_DLL_TICKF( OneZero_tickf );
 CK_DLL_PMSG( OneZero_pmsg );
 CK_DLL_CTRL( OneZero_ctrl_zero );
 CK_DLL_CTRL( OneZero_ctrl_b0 );
@@ -317,7 +317,7 @@ CK_DLL_CGET( OneZero_cget_b1 );
 // TwoZero
 CK_DLL_CTOR( TwoZero_ctor );
 CK_DLL_DTOR( TwoZero_dtor );
-CK_DLL_TICK( TwoZero_tick );
+CK_DLL_TICKF( TwoZero_tickf );
 CK_DLL_PMSG( TwoZero_pmsg );
 CK_DLL_CTRL( TwoZero_ctrl_b0 );
 CK_DLL_CTRL( TwoZero_ctrl_b1 );
@@ -333,7 +333,7 @@ CK_DLL_CGET( TwoZero_cget_radius );
 // PoleZero
 CK_DLL_CTOR( PoleZero_ctor );
 CK_DLL_DTOR( PoleZero_dtor );
-CK_DLL_TICK( PoleZero_tick );
+CK_DLL_TICKF( PoleZero_tickf );
 CK_DLL_PMSG( PoleZero_pmsg );
 CK_DLL_CTRL( PoleZero_ctrl_a1 );
 CK_DLL_CTRL( PoleZero_ctrl_b0 );
@@ -395,7 +395,7 @@ CK_DLL_PMSG( BlitSquare_pmsg );
 // JCRev
 CK_DLL_CTOR( JCRev_ctor );
 CK_DLL_DTOR( JCRev_dtor );
-CK_DLL_TICK( JCRev_tick );
+CK_DLL_TICKF( JCRev_tickf );
 CK_DLL_PMSG( JCRev_pmsg );
 CK_DLL_CTRL( JCRev_ctrl_mix );
 CK_DLL_CGET( JCRev_cget_mix );
@@ -403,7 +403,7 @@ CK_DLL_CGET( JCRev_cget_mix );
 // NRev
 CK_DLL_CTOR( NRev_ctor );
 CK_DLL_DTOR( NRev_dtor );
-CK_DLL_TICK( NRev_tick );
+CK_DLL_TICKF( NRev_tickf );
 CK_DLL_PMSG( NRev_pmsg );
 CK_DLL_CTRL( NRev_ctrl_mix );
 CK_DLL_CGET( NRev_cget_mix );
@@ -411,7 +411,7 @@ CK_DLL_CGET( NRev_cget_mix );
 // PRCRev
 CK_DLL_CTOR( PRCRev_ctor );
 CK_DLL_DTOR( PRCRev_dtor );
-CK_DLL_TICK( PRCRev_tick );
+CK_DLL_TICKF( PRCRev_tickf );
 CK_DLL_PMSG( PRCRev_pmsg );
 CK_DLL_CTRL( PRCRev_ctrl_mix );
 CK_DLL_CGET( PRCRev_cget_mix );
@@ -472,7 +472,7 @@ CK_DLL_CGET( WvOut_cget_fileGain );
 // FM
 CK_DLL_CTOR( FM_ctor );
 CK_DLL_DTOR( FM_dtor );
-CK_DLL_TICK( FM_tick );
+CK_DLL_TICKF( FM_tickf );
 CK_DLL_PMSG( FM_pmsg );
 CK_DLL_CTRL( FM_ctrl_freq );
 CK_DLL_CTRL( FM_ctrl_noteOn );
@@ -543,7 +543,7 @@ CK_DLL_PMSG( Drummer_pmsg );
 // Instrmnt
 CK_DLL_CTOR( Instrmnt_ctor );
 CK_DLL_DTOR( Instrmnt_dtor );
-CK_DLL_TICK( Instrmnt_tick );
+CK_DLL_TICKF( Instrmnt_tickf );
 CK_DLL_PMSG( Instrmnt_pmsg );
 CK_DLL_CTRL( Instrmnt_ctrl_freq );
 CK_DLL_CGET( Instrmnt_cget_freq );
@@ -554,7 +554,7 @@ CK_DLL_CTRL( Instrmnt_ctrl_controlChange );
 // BandedWG
 CK_DLL_CTOR( BandedWG_ctor );
 CK_DLL_DTOR( BandedWG_dtor );
-CK_DLL_TICK( BandedWG_tick );
+CK_DLL_TICKF( BandedWG_tickf );
 CK_DLL_PMSG( BandedWG_pmsg );
 CK_DLL_CTRL( BandedWG_ctrl_bowPressure );
 CK_DLL_CGET( BandedWG_cget_bowPressure );
@@ -589,14 +589,14 @@ CK_DLL_CTRL( BandedWG_ctrl_portamento );
 // BeeThree
 CK_DLL_CTOR( BeeThree_ctor );
 CK_DLL_DTOR( BeeThree_dtor );
-CK_DLL_TICK( BeeThree_tick );
+CK_DLL_TICKF( BeeThree_tickf );
 CK_DLL_PMSG( BeeThree_pmsg );
 CK_DLL_CTRL( BeeThree_ctrl_noteOn );
 
 // BlowBotl
 CK_DLL_CTOR( BlowBotl_ctor );
 CK_DLL_DTOR( BlowBotl_dtor );
-CK_DLL_TICK( BlowBotl_tick );
+CK_DLL_TICKF( BlowBotl_tickf );
 CK_DLL_PMSG( BlowBotl_pmsg );
 CK_DLL_CTRL( BlowBotl_ctrl_freq );
 CK_DLL_CGET( BlowBotl_cget_freq );
@@ -619,7 +619,7 @@ CK_DLL_CGET( BlowBotl_cget_rate );
 // BlowHole
 CK_DLL_CTOR( BlowHole_ctor );
 CK_DLL_DTOR( BlowHole_dtor );
-CK_DLL_TICK( BlowHole_tick );
+CK_DLL_TICKF( BlowHole_tickf );
 CK_DLL_PMSG( BlowHole_pmsg );
 CK_DLL_CTRL( BlowHole_ctrl_freq );
 CK_DLL_CGET( BlowHole_cget_freq );
@@ -644,7 +644,7 @@ CK_DLL_CGET( BlowHole_cget_rate );
 // Bowed
 CK_DLL_CTOR( Bowed_ctor );
 CK_DLL_DTOR( Bowed_dtor );
-CK_DLL_TICK( Bowed_tick );
+CK_DLL_TICKF( Bowed_tickf );
 CK_DLL_PMSG( Bowed_pmsg );
 CK_DLL_CTRL( Bowed_ctrl_freq );
 CK_DLL_CGET( Bowed_cget_freq );
@@ -677,7 +677,7 @@ CK_DLL_CTRL( BowTabl_ctrl_slope );
 // Brass
 CK_DLL_CTOR( Brass_ctor );
 CK_DLL_DTOR( Brass_dtor );
-CK_DLL_TICK( Brass_tick );
+CK_DLL_TICKF( Brass_tickf );
 CK_DLL_PMSG( Brass_pmsg );
 CK_DLL_CTRL( Brass_ctrl_freq );
 CK_DLL_CGET( Brass_cget_freq );
@@ -703,7 +703,7 @@ CK_DLL_CGET( Brass_cget_rate );
 // Clarinet
 CK_DLL_CTOR( Clarinet_ctor );
 CK_DLL_DTOR( Clarinet_dtor );
-CK_DLL_TICK( Clarinet_tick );
+CK_DLL_TICKF( Clarinet_tickf );
 CK_DLL_PMSG( Clarinet_pmsg );
 CK_DLL_CTRL( Clarinet_ctrl_freq );
 CK_DLL_CGET( Clarinet_cget_freq );
@@ -729,7 +729,7 @@ CK_DLL_CTRL( Clarinet_ctrl_controlChange );
 // Flute
 CK_DLL_CTOR( Flute_ctor );
 CK_DLL_DTOR( Flute_dtor );
-CK_DLL_TICK( Flute_tick );
+CK_DLL_TICKF( Flute_tickf );
 CK_DLL_PMSG( Flute_pmsg );
 CK_DLL_CTRL( Flute_ctrl_freq );
 CK_DLL_CGET( Flute_cget_freq );
@@ -759,7 +759,7 @@ CK_DLL_CGET( Flute_cget_rate );
 // FMVoices
 CK_DLL_CTOR( FMVoices_ctor );
 CK_DLL_DTOR( FMVoices_dtor );
-CK_DLL_TICK( FMVoices_tick );
+CK_DLL_TICKF( FMVoices_tickf );
 CK_DLL_PMSG( FMVoices_pmsg );
 CK_DLL_CTRL( FMVoices_ctrl_vowel );
 CK_DLL_CTRL( FMVoices_cget_vowel );
@@ -771,7 +771,7 @@ CK_DLL_CTRL( FMVoices_cget_adsrTarget );
 // HevyMetl
 CK_DLL_CTOR( HevyMetl_ctor );
 CK_DLL_DTOR( HevyMetl_dtor );
-CK_DLL_TICK( HevyMetl_tick );
+CK_DLL_TICKF( HevyMetl_tickf );
 CK_DLL_PMSG( HevyMetl_pmsg );
 
 // JetTabl
@@ -783,7 +783,7 @@ CK_DLL_PMSG( JetTabl_pmsg );
 // Mandolin
 CK_DLL_CTOR( Mandolin_ctor );
 CK_DLL_DTOR( Mandolin_dtor );
-CK_DLL_TICK( Mandolin_tick );
+CK_DLL_TICKF( Mandolin_tickf );
 CK_DLL_PMSG( Mandolin_pmsg );
 CK_DLL_CTRL( Mandolin_ctrl_freq );
 CK_DLL_CGET( Mandolin_cget_freq );
@@ -823,7 +823,7 @@ CK_DLL_CTRL( Modal_ctrl_noteOff );
 // ModalBar
 CK_DLL_CTOR( ModalBar_ctor );
 CK_DLL_DTOR( ModalBar_dtor );
-CK_DLL_TICK( ModalBar_tick );
+CK_DLL_TICKF( ModalBar_tickf );
 CK_DLL_PMSG( ModalBar_pmsg );
 CK_DLL_CTRL( ModalBar_ctrl_strike );
 CK_DLL_CTRL( ModalBar_ctrl_damp );
@@ -862,7 +862,7 @@ CK_DLL_CTRL( ModalBar_ctrl_controlChange );
 // Moog
 CK_DLL_CTOR( Moog_ctor );
 CK_DLL_DTOR( Moog_dtor );
-CK_DLL_TICK( Moog_tick );
+CK_DLL_TICKF( Moog_tickf );
 CK_DLL_PMSG( Moog_pmsg );
 CK_DLL_CTRL( Moog_ctrl_freq );
 CK_DLL_CTRL( Moog_ctrl_noteOn );
@@ -889,7 +889,7 @@ CK_DLL_CTRL( Moog_ctrl_controlChange );
 // PercFlut
 CK_DLL_CTOR( PercFlut_ctor );
 CK_DLL_DTOR( PercFlut_dtor );
-CK_DLL_TICK( PercFlut_tick );
+CK_DLL_TICKF( PercFlut_tickf );
 CK_DLL_PMSG( PercFlut_pmsg );
 CK_DLL_CTRL( PercFlut_ctrl_noteOn );
 CK_DLL_CTRL( PercFlut_ctrl_freq );
@@ -935,7 +935,7 @@ CK_DLL_PMSG( Resonate_pmsg );
 // Rhodey
 CK_DLL_CTOR( Rhodey_ctor );
 CK_DLL_DTOR( Rhodey_dtor );
-CK_DLL_TICK( Rhodey_tick );
+CK_DLL_TICKF( Rhodey_tickf );
 CK_DLL_PMSG( Rhodey_pmsg );
 CK_DLL_CTRL( Rhodey_ctrl_freq );
 CK_DLL_CTRL( Rhodey_ctrl_noteOn );
@@ -945,7 +945,7 @@ CK_DLL_CTRL( Rhodey_cget_freq );
 // Saxofony
 CK_DLL_CTOR( Saxofony_ctor );
 CK_DLL_DTOR( Saxofony_dtor );
-CK_DLL_TICK( Saxofony_tick );
+CK_DLL_TICKF( Saxofony_tickf );
 CK_DLL_PMSG( Saxofony_pmsg );
 CK_DLL_CTRL( Saxofony_ctrl_freq );
 CK_DLL_CGET( Saxofony_cget_freq );
@@ -975,7 +975,7 @@ CK_DLL_CTRL( Saxofony_ctrl_noteOff );
 // Shakers
 CK_DLL_CTOR( Shakers_ctor );
 CK_DLL_DTOR( Shakers_dtor );
-CK_DLL_TICK( Shakers_tick );
+CK_DLL_TICKF( Shakers_tickf );
 CK_DLL_PMSG( Shakers_pmsg );
 CK_DLL_CTRL( Shakers_ctrl_energy );
 CK_DLL_CGET( Shakers_cget_energy );
@@ -1016,7 +1016,7 @@ CK_DLL_CTRL( SingWave_ctrl_gainRate );
 // Sitar
 CK_DLL_CTOR( Sitar_ctor );
 CK_DLL_DTOR( Sitar_dtor );
-CK_DLL_TICK( Sitar_tick );
+CK_DLL_TICKF( Sitar_tickf );
 CK_DLL_PMSG( Sitar_pmsg );
 CK_DLL_CTRL( Sitar_ctrl_noteOn );
 CK_DLL_CTRL( Sitar_ctrl_noteOff );
@@ -1036,7 +1036,7 @@ CK_DLL_CTRL( Sphere_ctrl_mass );
 // StifKarp
 CK_DLL_CTOR( StifKarp_ctor );
 CK_DLL_DTOR( StifKarp_dtor );
-CK_DLL_TICK( StifKarp_tick );
+CK_DLL_TICKF( StifKarp_tickf );
 CK_DLL_PMSG( StifKarp_pmsg );
 CK_DLL_CTRL( StifKarp_ctrl_pluck );
 CK_DLL_CTRL( StifKarp_ctrl_clear );
@@ -1057,7 +1057,7 @@ CK_DLL_CGET( StifKarp_cget_baseLoopGain );
 // TubeBell
 CK_DLL_CTOR( TubeBell_ctor );
 CK_DLL_DTOR( TubeBell_dtor );
-CK_DLL_TICK( TubeBell_tick );
+CK_DLL_TICKF( TubeBell_tickf );
 CK_DLL_PMSG( TubeBell_pmsg );
 CK_DLL_CTRL( TubeBell_ctrl_noteOn );
 CK_DLL_CTRL( TubeBell_ctrl_freq );
@@ -1072,7 +1072,7 @@ CK_DLL_PMSG( Voicer_pmsg );
 // VoicForm
 CK_DLL_CTOR( VoicForm_ctor );
 CK_DLL_DTOR( VoicForm_dtor );
-CK_DLL_TICK( VoicForm_tick );
+CK_DLL_TICKF( VoicForm_tickf );
 CK_DLL_PMSG( VoicForm_pmsg );
 CK_DLL_CTRL( VoicForm_ctrl_voiceMix );
 CK_DLL_CGET( VoicForm_cget_voiceMix );
@@ -1113,7 +1113,7 @@ CK_DLL_CTRL( Whistle_ctrl_noteOff );
 // Wurley
 CK_DLL_CTOR( Wurley_ctor );
 CK_DLL_DTOR( Wurley_dtor );
-CK_DLL_TICK( Wurley_tick );
+CK_DLL_TICKF( Wurley_tickf );
 CK_DLL_PMSG( Wurley_pmsg );
 CK_DLL_CTRL( Wurley_ctrl_freq );
 CK_DLL_CTRL( Wurley_ctrl_noteOn );
@@ -1125,7 +1125,7 @@ CK_DLL_CGET( Wurley_cget_freq );
 // Instrmnt
 CK_DLL_CTOR( Instrmnt_ctor );
 CK_DLL_DTOR( Instrmnt_dtor );
-CK_DLL_TICK( Instrmnt_tick );
+CK_DLL_TICKF( Instrmnt_tickf );
 CK_DLL_PMSG( Instrmnt_pmsg );
 CK_DLL_CTRL( Instrmnt_ctrl_freq );
 
@@ -1258,7 +1258,7 @@ DLL_QUERY stk_query( Chuck_DL_Query * QUERY )
     doc = "Super-class for STK instruments.";
     
     if( !type_engine_import_ugen_begin( env, "StkInstrument", "UGen", env->global(),
-                                       Instrmnt_ctor, NULL, Instrmnt_tick, Instrmnt_pmsg,
+                                       Instrmnt_ctor, NULL, NULL, Instrmnt_tickf, Instrmnt_pmsg, 1, 1,
                                        doc.c_str()) ) return FALSE;
     // member variable
     Instrmnt_offset_data = type_engine_import_mvar ( env, "int", "@Instrmnt_data", FALSE );
@@ -1318,7 +1318,7 @@ Modified for Stk 4.0 by Gary Scavone.";
     
     if( !type_engine_import_ugen_begin( env, "BandedWG", "StkInstrument", env->global(),
                         BandedWG_ctor, BandedWG_dtor,
-                        BandedWG_tick, BandedWG_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, BandedWG_tickf, BandedWG_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/band-o-matic.ck");
     type_engine_import_add_ex(env, "stk/bandedwg.ck");
@@ -1427,7 +1427,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002";
 
     if( !type_engine_import_ugen_begin( env, "BlowBotl", "StkInstrument", env->global(), 
                         BlowBotl_ctor, BlowBotl_dtor,
-                        BlowBotl_tick, BlowBotl_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, BlowBotl_tickf, BlowBotl_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/blowbotl.ck");
     type_engine_import_add_ex(env, "stk/blowbotl2.ck");
@@ -1516,7 +1516,7 @@ Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "BlowHole", "StkInstrument", env->global(), 
                         BlowHole_ctor, BlowHole_dtor,
-                        BlowHole_tick, BlowHole_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, BlowHole_tickf, BlowHole_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/blowhole.ck");
     type_engine_import_add_ex(env, "stk/blowhole2.ck");
@@ -1613,7 +1613,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "Bowed", "StkInstrument", env->global(), 
                         Bowed_ctor, Bowed_dtor,
-                        Bowed_tick, Bowed_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, Bowed_tickf, Bowed_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/bowed.ck");
     type_engine_import_add_ex(env, "stk/bowed2.ck");
@@ -1701,7 +1701,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "Brass", "StkInstrument", env->global(), 
                         Brass_ctor, Brass_dtor,
-                        Brass_tick, Brass_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, Brass_tickf, Brass_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/brass.ck");
     type_engine_import_add_ex(env, "stk/brass2.ck");
@@ -1803,7 +1803,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "Clarinet", "StkInstrument", env->global(), 
                         Clarinet_ctor, Clarinet_dtor,
-                        Clarinet_tick, Clarinet_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, Clarinet_tickf, Clarinet_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/clarinet.ck");
     type_engine_import_add_ex(env, "stk/clarinet2.ck");
@@ -1905,7 +1905,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "Flute", "StkInstrument", env->global(), 
                         Flute_ctor, Flute_dtor,
-                        Flute_tick, Flute_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, Flute_tickf, Flute_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/flute.ck");
 
@@ -2025,7 +2025,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     //! see \example mand-o-matic.ck
     if( !type_engine_import_ugen_begin( env, "Mandolin", "StkInstrument", env->global(), 
                         Mandolin_ctor, Mandolin_dtor,
-                        Mandolin_tick, Mandolin_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, Mandolin_tickf, Mandolin_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/mandolin.ck");
     type_engine_import_add_ex(env, "stk/mand-o-matic.ck");
@@ -2124,7 +2124,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     //! see \example modalbot.ck
     if( !type_engine_import_ugen_begin( env, "ModalBar", "StkInstrument", env->global(),
                         ModalBar_ctor, ModalBar_dtor,
-                        ModalBar_tick, ModalBar_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, ModalBar_tickf, ModalBar_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/modalbar.ck");
     type_engine_import_add_ex(env, "stk/modalbar2.ck");
@@ -2279,7 +2279,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     //! see \example moogie.ck
     if( !type_engine_import_ugen_begin( env, "Moog", "StkInstrument", env->global(), 
                         Moog_ctor, Moog_dtor,
-                        Moog_tick, Moog_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, Moog_tickf, Moog_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/moog.ck");
     type_engine_import_add_ex(env, "stk/moog2.ck");
@@ -2401,7 +2401,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "Saxofony", "StkInstrument", env->global(), 
                         Saxofony_ctor, Saxofony_dtor,
-                        Saxofony_tick, Saxofony_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, Saxofony_tickf, Saxofony_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/saxofony.ck");
 
@@ -2545,7 +2545,7 @@ by Perry R. Cook, 1996 - 1999.";
     //! see \example shake-o-matic.ck
     if( !type_engine_import_ugen_begin( env, "Shakers", "StkInstrument", env->global(), 
                         Shakers_ctor, Shakers_dtor,
-                        Shakers_tick, Shakers_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, Shakers_tickf, Shakers_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/shake-cycle.ck");
     type_engine_import_add_ex(env, "stk/shake-o-matic.ck");
@@ -2634,7 +2634,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "Sitar", "StkInstrument", env->global(), 
                         Sitar_ctor, Sitar_dtor,
-                        Sitar_tick, Sitar_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, Sitar_tickf, Sitar_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/sitar.ck");
 
@@ -2675,7 +2675,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     //! see \example stifkarp.ck
     if( !type_engine_import_ugen_begin( env, "StifKarp", "StkInstrument", env->global(), 
                         StifKarp_ctor, StifKarp_dtor,
-                        StifKarp_tick, StifKarp_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, StifKarp_tickf, StifKarp_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/stifkarp.ck");
     type_engine_import_add_ex(env, "stk/stif-o-karp.ck");
@@ -2766,7 +2766,7 @@ Phoneme Names:\n\
     //! see \example voic-o-form.ck
     if( !type_engine_import_ugen_begin( env, "VoicForm", "StkInstrument", env->global(), 
                         VoicForm_ctor, VoicForm_dtor,
-                        VoicForm_tick, VoicForm_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, VoicForm_tickf, VoicForm_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/voic-o-form.ck");
 
@@ -2892,7 +2892,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "FM", "StkInstrument", env->global(), 
                                         FM_ctor, FM_dtor,
-                                        FM_tick, FM_pmsg, doc.c_str() ) ) return FALSE;
+                                        NULL, FM_tickf, FM_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
 
     // member variable
     // all subclasses of FM must use this offset, as this is where the inherited 
@@ -2980,7 +2980,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "BeeThree", "FM", env->global(), 
                         BeeThree_ctor, BeeThree_dtor,
-                        BeeThree_tick, BeeThree_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, BeeThree_tickf, BeeThree_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
 
     // end the class import
     type_engine_import_class_end( env );
@@ -3012,7 +3012,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "FMVoices", "FM", env->global(), 
                         FMVoices_ctor, FMVoices_dtor,
-                        FMVoices_tick, FMVoices_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, FMVoices_tickf, FMVoices_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
 
     func = make_new_mfun( "float", "vowel", FMVoices_ctrl_vowel ); //!select vowel
     func->add_arg( "float", "value" );
@@ -3070,7 +3070,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "HevyMetl", "FM", env->global(), 
                         HevyMetl_ctor, HevyMetl_dtor,
-                        HevyMetl_tick, HevyMetl_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, HevyMetl_tickf, HevyMetl_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
 
     // end the class import
     type_engine_import_class_end( env );
@@ -3101,7 +3101,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "PercFlut", "FM", env->global(), 
                         PercFlut_ctor, PercFlut_dtor,
-                        PercFlut_tick, PercFlut_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, PercFlut_tickf, PercFlut_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
 
     // end the class import
     type_engine_import_class_end( env );
@@ -3134,7 +3134,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     //! see \examples rhodey.ck
     if( !type_engine_import_ugen_begin( env, "Rhodey", "FM", env->global(), 
                         Rhodey_ctor, Rhodey_dtor,
-                        Rhodey_tick, Rhodey_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, Rhodey_tickf, Rhodey_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "stk/rhodey.ck");
 
@@ -3168,7 +3168,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "TubeBell", "FM", env->global(), 
                         TubeBell_ctor, TubeBell_dtor,
-                        TubeBell_tick, TubeBell_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, TubeBell_tickf, TubeBell_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
 
     // end the class import
     type_engine_import_class_end( env );
@@ -3201,7 +3201,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     //! see \examples wurley.ck
     if( !type_engine_import_ugen_begin( env, "Wurley", "FM", env->global(), 
                         Wurley_ctor, Wurley_dtor,
-                        Wurley_tick, Wurley_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, Wurley_tickf, Wurley_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
 
     type_engine_import_add_ex(env, "stk/wurley.ck");
     type_engine_import_add_ex(env, "stk/wurley2.ck");
@@ -3227,7 +3227,8 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     //! see \example net_relay.ck
     if( !type_engine_import_ugen_begin( env, "Delay", "UGen", env->global(), 
                         Delay_ctor, Delay_dtor,
-                        Delay_tick, Delay_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, Delay_tickf, Delay_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
+    if( !type_engine_import_dtor_async( env ) ) return FALSE; // dtor only frees
     
     //member variable
     Delay_offset_data = type_engine_import_mvar ( env, "int", "@Delay_data", FALSE );
@@ -3272,7 +3273,8 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "DelayA", "UGen", env->global(), 
                         DelayA_ctor, DelayA_dtor,
-                        DelayA_tick, DelayA_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, DelayA_tickf, DelayA_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
+    if( !type_engine_import_dtor_async( env ) ) return FALSE; // dtor only frees
     //member variable
     DelayA_offset_data = type_engine_import_mvar ( env, "int", "@DelayA_data", FALSE );
     if( DelayA_offset_data == CK_INVALID_OFFSET ) goto error;
@@ -3315,7 +3317,8 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     //! see \example i-robot.ck
     if( !type_engine_import_ugen_begin( env, "DelayL", "UGen", env->global(), 
                         DelayL_ctor, DelayL_dtor,
-                        DelayL_tick, DelayL_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, DelayL_tickf, DelayL_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
+    if( !type_engine_import_dtor_async( env ) ) return FALSE; // dtor only frees
     
     type_engine_import_add_ex(env, "basic/delay.ck");
     type_engine_import_add_ex(env, "basic/i-robot.ck");
@@ -3360,6 +3363,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     if( !type_engine_import_ugen_begin( env, "Echo", "UGen", env->global(), 
                         Echo_ctor, Echo_dtor,
                         Echo_tick, Echo_pmsg, doc.c_str() ) ) return FALSE;
+    if( !type_engine_import_dtor_async( env ) ) return FALSE; // dtor only frees
     
     type_engine_import_add_ex(env, "basic/echo.ck");
 
@@ -3410,7 +3414,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     //! see \example sixty.ck
     if( !type_engine_import_ugen_begin( env, "Envelope", "UGen", env->global(), 
                         Envelope_ctor, Envelope_dtor,
-                        Envelope_tick, Envelope_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, Envelope_tickf, Envelope_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "basic/envelope.ck");
     
@@ -3497,7 +3501,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     //! see \example adsr.ck
     if( !type_engine_import_ugen_begin( env, "ADSR", "Envelope", env->global(), 
                                         ADSR_ctor, ADSR_dtor,
-                                        ADSR_tick, ADSR_pmsg, doc.c_str() ) ) return FALSE;
+                                        NULL, ADSR_tickf, ADSR_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "basic/adsr.ck");
 
@@ -3720,7 +3724,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "OnePole", "UGen", env->global(),
                         OnePole_ctor, OnePole_dtor,
-                        OnePole_tick, OnePole_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, OnePole_tickf, OnePole_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     // member variable
     OnePole_offset_data = type_engine_import_mvar ( env, "int", "@OnePole_data", FALSE );
@@ -3767,7 +3771,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "TwoPole", "UGen", env->global(), 
                         TwoPole_ctor, TwoPole_dtor,
-                        TwoPole_tick, TwoPole_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, TwoPole_tickf, TwoPole_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     type_engine_import_add_ex(env, "shred/powerup.ck");
     
@@ -3842,7 +3846,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "OneZero", "UGen", env->global(), 
                         OneZero_ctor, OneZero_dtor,
-                        OneZero_tick, OneZero_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, OneZero_tickf, OneZero_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     //member variable
     OneZero_offset_data = type_engine_import_mvar ( env, "int", "@OneZero_data", FALSE );
@@ -3889,7 +3893,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "TwoZero", "UGen", env->global(), 
                         TwoZero_ctor, TwoZero_dtor,
-                        TwoZero_tick, TwoZero_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, TwoZero_tickf, TwoZero_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     //member variable
     TwoZero_offset_data = type_engine_import_mvar ( env, "int", "@TwoZero_data", FALSE );
@@ -3954,7 +3958,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "PoleZero", "UGen", env->global(), 
                         PoleZero_ctor, PoleZero_dtor,
-                        PoleZero_tick, PoleZero_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, PoleZero_tickf, PoleZero_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     //member variable
     PoleZero_offset_data = type_engine_import_mvar ( env, "int", "@PoleZero_data", FALSE );
@@ -4023,7 +4027,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "JCRev", "UGen", env->global(), 
                         JCRev_ctor, JCRev_dtor,
-                        JCRev_tick, JCRev_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, JCRev_tickf, JCRev_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     //member variable
     JCRev_offset_data = type_engine_import_mvar ( env, "int", "@JCRev_data", FALSE );
@@ -4052,7 +4056,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "NRev", "UGen", env->global(), 
                         NRev_ctor, NRev_dtor,
-                        NRev_tick, NRev_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, NRev_tickf, NRev_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     //member variable
     NRev_offset_data = type_engine_import_mvar ( env, "int", "@NRev_data", FALSE );
@@ -4080,7 +4084,7 @@ by Perry R. Cook and Gary P. Scavone, 1995 - 2002.";
     
     if( !type_engine_import_ugen_begin( env, "PRCRev", "UGen", env->global(), 
                         PRCRev_ctor, PRCRev_dtor,
-                        PRCRev_tick, PRCRev_pmsg, doc.c_str() ) ) return FALSE;
+                        NULL, PRCRev_tickf, PRCRev_pmsg, 1, 1, doc.c_str() ) ) return FALSE;
     
     //member variable
     PRCRev_offset_data = type_engine_import_mvar ( env, "int", "@PRCRev_data", FALSE );
@@ -5088,8 +5092,9 @@ MY_FLOAT ADSR :: tick()
 
 MY_FLOAT *ADSR :: tick(MY_FLOAT *vec, unsigned int vectorSize)
 {
+  // qualified: no virtual dispatch in the loop
   for (unsigned int i=0; i<vectorSize; i++)
-    vec[i] = tick();
+    vec[i] = ADSR::tick();
 
   return vec;
 }
@@ -5580,7 +5585,7 @@ MY_FLOAT BeeThree :: tick()
   register MY_FLOAT temp;
 
   if (modDepth > 0.0)   {
-    temp = 1.0 + (modDepth * vibrato->tick() * 0.1);
+    temp = 1.0 + (modDepth * vibrato->WaveLoop::tick() * 0.1);
     waves[0]->setFrequency(baseFrequency * temp * ratios[0]);
     waves[1]->setFrequency(baseFrequency * temp * ratios[1]);
     waves[2]->setFrequency(baseFrequency * temp * ratios[2]);
@@ -5588,12 +5593,12 @@ MY_FLOAT BeeThree :: tick()
   }
 
   waves[3]->addPhaseOffset(twozero->lastOut());
-  temp = control1 * 2.0 * gains[3] * adsr[3]->tick() * waves[3]->tick();
-  twozero->tick(temp);
+  temp = control1 * 2.0 * gains[3] * adsr[3]->ADSR::tick() * waves[3]->WaveLoop::tick();
+  twozero->TwoZero::tick(temp);
 
-  temp += control2 * 2.0 * gains[2] * adsr[2]->tick() * waves[2]->tick();
-  temp += gains[1] * adsr[1]->tick() * waves[1]->tick();
-  temp += gains[0] * adsr[0]->tick() * waves[0]->tick();
+  temp += control2 * 2.0 * gains[2] * adsr[2]->ADSR::tick() * waves[2]->WaveLoop::tick();
+  temp += gains[1] * adsr[1]->ADSR::tick() * waves[1]->WaveLoop::tick();
+  temp += gains[0] * adsr[0]->ADSR::tick() * waves[0]->WaveLoop::tick();
 
   lastOutput = temp * 0.125;
   return lastOutput;
@@ -5718,8 +5723,9 @@ MY_FLOAT BiQuad :: tick(MY_FLOAT sample)
 
 MY_FLOAT *BiQuad :: tick(MY_FLOAT *vec, unsigned int vectorSize)
 {
+  // qualified: no virtual dispatch in the loop
   for (unsigned int i=0; i<vectorSize; i++)
-    vec[i] = tick(vec[i]);
+    vec[i] = BiQuad::tick(vec[i]);
 
   return vec;
 }
@@ -6215,7 +6221,7 @@ MY_FLOAT BlowBotl :: tick()
 
   // Calculate the breath pressure (envelope + vibrato)
   breathPressure = maxPressure * adsr->tick();
-  breathPressure += vibratoGain * vibrato->tick();
+  breathPressure += vibratoGain * vibrato->WaveLoop::tick();
 
   pressureDiff = breathPressure - resonator->lastOut();
 
@@ -6486,7 +6492,7 @@ MY_FLOAT BlowHole :: tick()
   // Calculate the breath pressure (envelope + noise + vibrato)
   breathPressure = envelope->tick(); 
   breathPressure += breathPressure * noiseGain * noise->tick();
-  breathPressure += breathPressure * vibratoGain * vibrato->tick();
+  breathPressure += breathPressure * vibratoGain * vibrato->WaveLoop::tick();
 
   // Calculate the differential pressure = reflected - mouthpiece pressures
   pressureDiff = delays[0]->lastOut() - breathPressure;
@@ -6775,7 +6781,7 @@ MY_FLOAT Bowed :: tick()
     
   if (vibratoGain > 0.0)  {
     neckDelay->setDelay((baseDelay * ((MY_FLOAT) 1.0 - betaRatio)) + 
-                        (baseDelay * vibratoGain * vibrato->tick()));
+                        (baseDelay * vibratoGain * vibrato->WaveLoop::tick()));
   }
 
   lastOutput = bodyFilter->tick(bridgeDelay->lastOut());                 
@@ -6971,7 +6977,7 @@ void Brass :: noteOff(MY_FLOAT amplitude)
 MY_FLOAT Brass :: tick()
 {
   MY_FLOAT breathPressure = maxPressure * adsr->tick();
-  breathPressure += vibratoGain * vibrato->tick();
+  breathPressure += vibratoGain * vibrato->WaveLoop::tick();
 
   MY_FLOAT mouthPressure = 0.3 * breathPressure;
   MY_FLOAT borePressure = 0.85 * delayLine->lastOut();
@@ -7285,7 +7291,7 @@ MY_FLOAT Clarinet :: tick()
   // Calculate the breath pressure (envelope + noise + vibrato)
   breathPressure = envelope->tick(); 
   breathPressure += breathPressure * noiseGain * noise->tick();
-  breathPressure += breathPressure * vibratoGain * vibrato->tick();
+  breathPressure += breathPressure * vibratoGain * vibrato->WaveLoop::tick();
 
   // Perform commuted loss filtering.
   pressureDiff = -0.95 * filter->tick(delayLine->lastOut());
@@ -7498,8 +7504,9 @@ MY_FLOAT Delay :: tick(MY_FLOAT sample)
 
 MY_FLOAT *Delay :: tick(MY_FLOAT *vec, unsigned int vectorSize)
 {
+  // qualified: no virtual dispatch in the loop
   for (unsigned int i=0; i<vectorSize; i++)
-    vec[i] = tick(vec[i]);
+    vec[i] = Delay::tick(vec[i]);
 
   return vec;
 }
@@ -7651,6 +7658,15 @@ MY_FLOAT DelayA :: tick(MY_FLOAT sample)
     return outputs[0];
 }
 
+MY_FLOAT *DelayA :: tick(MY_FLOAT *vec, unsigned int vectorSize)
+{
+  // qualified: no virtual dispatch in the loop
+  for (unsigned int i=0; i<vectorSize; i++)
+    vec[i] = DelayA::tick(vec[i]);
+
+  return vec;
+}
+
 
 /***************************************************/
 /*! \class DelayL
@@ -7782,6 +7798,15 @@ MY_FLOAT DelayL :: tick(MY_FLOAT sample)
 
   return outputs[0];
 }
+
+MY_FLOAT *DelayL :: tick(MY_FLOAT *vec, unsigned int vectorSize)
+{
+  // qualified: no virtual dispatch in the loop
+  for (unsigned int i=0; i<vectorSize; i++)
+    vec[i] = DelayL::tick(vec[i]);
+
+  return vec;
+}
 /***************************************************/
 /*! \class Drummer
     \brief STK drum sample player class.
@@ -8173,8 +8198,13 @@ MY_FLOAT Envelope :: tick(void)
 
 MY_FLOAT *Envelope :: tick(MY_FLOAT *vec, unsigned int vectorSize)
 {
-  for (unsigned int i=0; i<vectorSize; i++)
-    vec[i] = tick();
+  unsigned int i = 0;
+  // ramp (qualified: no virtual dispatch in the loop)
+  for ( ; state && i<vectorSize; i++)
+    vec[i] = Envelope::tick();
+  // then hold
+  for ( ; i<vectorSize; i++)
+    vec[i] = value;
 
   return vec;
 }
@@ -8534,8 +8564,8 @@ MY_FLOAT FMVoices :: tick()
 {
   register MY_FLOAT temp, temp2;
 
-  temp = gains[3] * adsr[3]->tick() * waves[3]->tick();
-  temp2 = vibrato->tick() * modDepth * (MY_FLOAT) 0.1;
+  temp = gains[3] * adsr[3]->ADSR::tick() * waves[3]->WaveLoop::tick();
+  temp2 = vibrato->WaveLoop::tick() * modDepth * (MY_FLOAT) 0.1;
 
   waves[0]->setFrequency(baseFrequency * (1.0 + temp2) * ratios[0]);
   waves[1]->setFrequency(baseFrequency * (1.0 + temp2) * ratios[1]);
@@ -8546,10 +8576,10 @@ MY_FLOAT FMVoices :: tick()
   waves[1]->addPhaseOffset(temp * mods[1]);
   waves[2]->addPhaseOffset(temp * mods[2]);
   waves[3]->addPhaseOffset(twozero->lastOut());
-  twozero->tick(temp);
-  temp =  gains[0] * tilt[0] * adsr[0]->tick() * waves[0]->tick();
-  temp += gains[1] * tilt[1] * adsr[1]->tick() * waves[1]->tick();
-  temp += gains[2] * tilt[2] * adsr[2]->tick() * waves[2]->tick();
+  twozero->TwoZero::tick(temp);
+  temp =  gains[0] * tilt[0] * adsr[0]->ADSR::tick() * waves[0]->WaveLoop::tick();
+  temp += gains[1] * tilt[1] * adsr[1]->ADSR::tick() * waves[1]->WaveLoop::tick();
+  temp += gains[2] * tilt[2] * adsr[2]->ADSR::tick() * waves[2]->WaveLoop::tick();
     
   return temp * 0.33;
 }
@@ -9021,7 +9051,7 @@ MY_FLOAT Flute :: tick()
   // Calculate the breath pressure (envelope + noise + vibrato)
   breathPressure = maxPressure * adsr->tick();
   breathPressure += breathPressure * noiseGain * noise->tick();
-  breathPressure += breathPressure * vibratoGain * vibrato->tick();
+  breathPressure += breathPressure * vibratoGain * vibrato->WaveLoop::tick();
 
   MY_FLOAT temp = filter->tick( boreDelay->lastOut() );
   temp = dcBlock->tick(temp); // Block DC on reflection.
@@ -9268,24 +9298,24 @@ MY_FLOAT HevyMetl :: tick()
 {
   register MY_FLOAT temp;
 
-  temp = vibrato->tick() * modDepth * 0.2;    
+  temp = vibrato->WaveLoop::tick() * modDepth * 0.2;    
   waves[0]->setFrequency(baseFrequency * (1.0 + temp) * ratios[0]);
   waves[1]->setFrequency(baseFrequency * (1.0 + temp) * ratios[1]);
   waves[2]->setFrequency(baseFrequency * (1.0 + temp) * ratios[2]);
   waves[3]->setFrequency(baseFrequency * (1.0 + temp) * ratios[3]);
     
-  temp = gains[2] * adsr[2]->tick() * waves[2]->tick();
+  temp = gains[2] * adsr[2]->ADSR::tick() * waves[2]->WaveLoop::tick();
   waves[1]->addPhaseOffset(temp);
     
   waves[3]->addPhaseOffset(twozero->lastOut());
-  temp = (1.0 - (control2 * 0.5)) * gains[3] * adsr[3]->tick() * waves[3]->tick();
-  twozero->tick(temp);
+  temp = (1.0 - (control2 * 0.5)) * gains[3] * adsr[3]->ADSR::tick() * waves[3]->WaveLoop::tick();
+  twozero->TwoZero::tick(temp);
     
-  temp += control2 * (MY_FLOAT) 0.5 * gains[1] * adsr[1]->tick() * waves[1]->tick();
+  temp += control2 * (MY_FLOAT) 0.5 * gains[1] * adsr[1]->ADSR::tick() * waves[1]->WaveLoop::tick();
   temp = temp * control1;
     
   waves[0]->addPhaseOffset(temp);
-  temp = gains[0] * adsr[0]->tick() * waves[0]->tick();
+  temp = gains[0] * adsr[0]->ADSR::tick() * waves[0]->WaveLoop::tick();
     
   lastOutput = temp * 0.5;
   return lastOutput;
@@ -9441,34 +9471,34 @@ MY_FLOAT JCRev :: tick(MY_FLOAT input)
     // gewang: dedenormal
     CK_STK_DDN(input);
 
-    temp = allpassDelays[0]->lastOut();
+    temp = allpassDelays[0]->Delay::lastOut();
     temp0 = allpassCoefficient * temp;
     temp0 += input;
     // gewang: dedenormal
     CK_STK_DDN(temp0);
-    allpassDelays[0]->tick(temp0);
+    allpassDelays[0]->Delay::tick(temp0);
     temp0 = -(allpassCoefficient * temp0) + temp;
 
-    temp = allpassDelays[1]->lastOut();
+    temp = allpassDelays[1]->Delay::lastOut();
     temp1 = allpassCoefficient * temp;
     temp1 += temp0;
     // gewang: dedenormal
     CK_STK_DDN(temp1);
-    allpassDelays[1]->tick(temp1);
+    allpassDelays[1]->Delay::tick(temp1);
     temp1 = -(allpassCoefficient * temp1) + temp;
 
-    temp = allpassDelays[2]->lastOut();
+    temp = allpassDelays[2]->Delay::lastOut();
     temp2 = allpassCoefficient * temp;
     temp2 += temp1;
     // gewang: dedenormal
     CK_STK_DDN(temp2);
-    allpassDelays[2]->tick(temp2);
+    allpassDelays[2]->Delay::tick(temp2);
     temp2 = -(allpassCoefficient * temp2) + temp;
 
-    temp3 = temp2 + (combCoefficient[0] * combDelays[0]->lastOut());
-    temp4 = temp2 + (combCoefficient[1] * combDelays[1]->lastOut());
-    temp5 = temp2 + (combCoefficient[2] * combDelays[2]->lastOut());
-    temp6 = temp2 + (combCoefficient[3] * combDelays[3]->lastOut());
+    temp3 = temp2 + (combCoefficient[0] * combDelays[0]->Delay::lastOut());
+    temp4 = temp2 + (combCoefficient[1] * combDelays[1]->Delay::lastOut());
+    temp5 = temp2 + (combCoefficient[2] * combDelays[2]->Delay::lastOut());
+    temp6 = temp2 + (combCoefficient[3] * combDelays[3]->Delay::lastOut());
 
     // gewang: dedenormal
     CK_STK_DDN(temp3);
@@ -9476,18 +9506,18 @@ MY_FLOAT JCRev :: tick(MY_FLOAT input)
     CK_STK_DDN(temp5);
     CK_STK_DDN(temp6);
 
-    combDelays[0]->tick(temp3);
-    combDelays[1]->tick(temp4);
-    combDelays[2]->tick(temp5);
-    combDelays[3]->tick(temp6);
+    combDelays[0]->Delay::tick(temp3);
+    combDelays[1]->Delay::tick(temp4);
+    combDelays[2]->Delay::tick(temp5);
+    combDelays[3]->Delay::tick(temp6);
 
     filtout = temp3 + temp4 + temp5 + temp6;
 
     // gewang: dedenormal
     CK_STK_DDN(filtout);
 
-    lastOutput[0] = effectMix * (outLeftDelay->tick(filtout));
-    lastOutput[1] = effectMix * (outRightDelay->tick(filtout));
+    lastOutput[0] = effectMix * (outLeftDelay->Delay::tick(filtout));
+    lastOutput[1] = effectMix * (outRightDelay->Delay::tick(filtout));
     temp = (1.0 - effectMix) * input;
     lastOutput[0] += temp;
     lastOutput[1] += temp;
@@ -9495,6 +9525,15 @@ MY_FLOAT JCRev :: tick(MY_FLOAT input)
     return (lastOutput[0] + lastOutput[1]) * 0.5;
 }
 
+MY_FLOAT *JCRev :: tick(MY_FLOAT *vec, unsigned int vectorSize)
+{
+  // qualified: no virtual dispatch in the loop
+  for (unsigned int i=0; i<vectorSize; i++)
+    vec[i] = JCRev::tick(vec[i]);
+
+  return vec;
+}
+
 
 /***************************************************/
 /*! \class JetTabl
@@ -10344,18 +10383,19 @@ void Modal :: damp(MY_FLOAT amplitude)
 
 MY_FLOAT Modal :: tick()
 {
-  MY_FLOAT temp = masterGain * onepole->tick(wave->tick() * envelope->tick());
+  // qualified calls: these are always exactly these types (see ctor)
+  MY_FLOAT temp = masterGain * onepole->OnePole::tick(wave->tick() * envelope->Envelope::tick());
 
   MY_FLOAT temp2 = 0.0;
   for (int i=0; i<nModes; i++)
-    temp2 += filters[i]->tick(temp);
+    temp2 += filters[i]->BiQuad::tick(temp);
 
   temp2  -= temp2 * directGain;
   temp2 += directGain * temp;
 
   if (vibratoGain != 0.0)   {
     // Calculate AM and apply to master out
-    temp = 1.0 + (vibrato->tick() * vibratoGain);
+    temp = 1.0 + (vibrato->WaveLoop::tick() * vibratoGain);
     temp2 = temp * temp2;
   }
     
@@ -10622,7 +10662,7 @@ void Modulate :: setRandomGain(MY_FLOAT aGain)
 MY_FLOAT Modulate :: tick()
 {
   // Compute periodic and random modulations.
-  lastOutput = vibratoGain * vibrato->tick();
+  lastOutput = vibratoGain * vibrato->WaveLoop::tick();
   lastOutput += filter->tick( noise->tick() );
   return lastOutput;                        
 }
@@ -10901,28 +10941,28 @@ MY_FLOAT NRev :: tick(MY_FLOAT input)
     lowpassState = 0.7*lowpassState + 0.3*temp0;
     // gewang: dedenormal
     CK_STK_DDN(lowpassState);
-    temp = allpassDelays[3]->lastOut();
+    temp = allpassDelays[3]->Delay::lastOut();
     temp1 = allpassCoefficient * temp;
     temp1 += lowpassState;
     // gewang: dedenormal
     CK_STK_DDN(temp1);
-    allpassDelays[3]->tick(temp1);
+    allpassDelays[3]->Delay::tick(temp1);
     temp1 = -(allpassCoefficient * temp1) + temp;
 
-    temp = allpassDelays[4]->lastOut();
+    temp = allpassDelays[4]->Delay::lastOut();
     temp2 = allpassCoefficient * temp;
     temp2 += temp1;
     // gewang: dedenormal
     CK_STK_DDN(temp2);
-    allpassDelays[4]->tick(temp2);
+    allpassDelays[4]->Delay::tick(temp2);
     lastOutput[0] = effectMix*(-(allpassCoefficient * temp2) + temp);
 
-    temp = allpassDelays[5]->lastOut();
+    temp = allpassDelays[5]->Delay::lastOut();
     temp3 = allpassCoefficient * temp;
     temp3 += temp1;
     // gewang: dedenormal
     CK_STK_DDN(temp3);
-    allpassDelays[5]->tick(temp3);
+    allpassDelays[5]->Delay::tick(temp3);
     lastOutput[1] = effectMix*(-(allpassCoefficient * temp3) + temp);
 
     temp = (1.0 - effectMix) * input;
@@ -10932,6 +10972,15 @@ MY_FLOAT NRev :: tick(MY_FLOAT input)
     return (lastOutput[0] + lastOutput[1]) * 0.5;
 }
 
+MY_FLOAT *NRev :: tick(MY_FLOAT *vec, unsigned int vectorSize)
+{
+  // qualified: no virtual dispatch in the loop
+  for (unsigned int i=0; i<vectorSize; i++)
+    vec[i] = NRev::tick(vec[i]);
+
+  return vec;
+}
+
 
 /***************************************************/
 /*! \class Noise
@@ -11090,8 +11139,9 @@ MY_FLOAT OnePole :: tick(MY_FLOAT sample)
 
 MY_FLOAT *OnePole :: tick(MY_FLOAT *vec, unsigned int vectorSize)
 {
+  // qualified: no virtual dispatch in the loop
   for (unsigned int i=0; i<vectorSize; i++)
-    vec[i] = tick(vec[i]);
+    vec[i] = OnePole::tick(vec[i]);
 
   return vec;
 }
@@ -11188,8 +11238,9 @@ MY_FLOAT OneZero :: tick(MY_FLOAT sample)
 
 MY_FLOAT *OneZero :: tick(MY_FLOAT *vec, unsigned int vectorSize)
 {
+  // qualified: no virtual dispatch in the loop
   for (unsigned int i=0; i<vectorSize; i++)
-    vec[i] = tick(vec[i]);
+    vec[i] = OneZero::tick(vec[i]);
 
   return vec;
 }
@@ -11264,31 +11315,31 @@ MY_FLOAT PRCRev :: tick(MY_FLOAT input)
     // gewang: dedenormal
     CK_STK_DDN(input);
 
-    temp = allpassDelays[0]->lastOut();
+    temp = allpassDelays[0]->Delay::lastOut();
     temp0 = allpassCoefficient * temp;
     temp0 += input;
     // gewang: dedenormal
     CK_STK_DDN(temp0);
-    allpassDelays[0]->tick(temp0);
+    allpassDelays[0]->Delay::tick(temp0);
     temp0 = -(allpassCoefficient * temp0) + temp;
 
-    temp = allpassDelays[1]->lastOut();
+    temp = allpassDelays[1]->Delay::lastOut();
     temp1 = allpassCoefficient * temp;
     temp1 += temp0;
     // gewang: dedenormal
     CK_STK_DDN(temp1);
-    allpassDelays[1]->tick(temp1);
+    allpassDelays[1]->Delay::tick(temp1);
     temp1 = -(allpassCoefficient * temp1) + temp;
 
-    temp2 = temp1 + (combCoefficient[0] * combDelays[0]->lastOut());
-    temp3 = temp1 + (combCoefficient[1] * combDelays[1]->lastOut());
+    temp2 = temp1 + (combCoefficient[0] * combDelays[0]->Delay::lastOut());
+    temp3 = temp1 + (combCoefficient[1] * combDelays[1]->Delay::lastOut());
 
     // gewang: dedenormal
     CK_STK_DDN(temp2);
     CK_STK_DDN(temp3);
 
-    lastOutput[0] = effectMix * (combDelays[0]->tick(temp2));
-    lastOutput[1] = effectMix * (combDelays[1]->tick(temp3));
+    lastOutput[0] = effectMix * (combDelays[0]->Delay::tick(temp2));
+    lastOutput[1] = effectMix * (combDelays[1]->Delay::tick(temp3));
     temp = (MY_FLOAT) (1.0 - effectMix) * input;
     lastOutput[0] += temp;
     lastOutput[1] += temp;
@@ -11296,6 +11347,15 @@ MY_FLOAT PRCRev :: tick(MY_FLOAT input)
     return (lastOutput[0] + lastOutput[1]) * (MY_FLOAT) 0.5;
 }
 
+MY_FLOAT *PRCRev :: tick(MY_FLOAT *vec, unsigned int vectorSize)
+{
+  // qualified: no virtual dispatch in the loop
+  for (unsigned int i=0; i<vectorSize; i++)
+    vec[i] = PRCRev::tick(vec[i]);
+
+  return vec;
+}
+
 
 /***************************************************/
 /*! \class PercFlut
@@ -11382,24 +11442,24 @@ MY_FLOAT PercFlut :: tick()
 {
   register MY_FLOAT temp;
 
-  temp = vibrato->tick() * modDepth * (MY_FLOAT) 0.2;    
+  temp = vibrato->WaveLoop::tick() * modDepth * (MY_FLOAT) 0.2;    
   waves[0]->setFrequency(baseFrequency * ((MY_FLOAT) 1.0 + temp) * ratios[0]);
   waves[1]->setFrequency(baseFrequency * ((MY_FLOAT) 1.0 + temp) * ratios[1]);
   waves[2]->setFrequency(baseFrequency * ((MY_FLOAT) 1.0 + temp) * ratios[2]);
   waves[3]->setFrequency(baseFrequency * ((MY_FLOAT) 1.0 + temp) * ratios[3]);
     
   waves[3]->addPhaseOffset(twozero->lastOut());
-  temp = gains[3] * adsr[3]->tick() * waves[3]->tick();
+  temp = gains[3] * adsr[3]->ADSR::tick() * waves[3]->WaveLoop::tick();
 
-  twozero->tick(temp);
+  twozero->TwoZero::tick(temp);
   waves[2]->addPhaseOffset(temp);
-  temp = (1.0 - (control2 * 0.5)) * gains[2] * adsr[2]->tick() * waves[2]->tick();
+  temp = (1.0 - (control2 * 0.5)) * gains[2] * adsr[2]->ADSR::tick() * waves[2]->WaveLoop::tick();
 
-  temp += control2 * 0.5 * gains[1] * adsr[1]->tick() * waves[1]->tick();
+  temp += control2 * 0.5 * gains[1] * adsr[1]->ADSR::tick() * waves[1]->WaveLoop::tick();
   temp = temp * control1;
 
   waves[0]->addPhaseOffset(temp);
-  temp = gains[0] * adsr[0]->tick() * waves[0]->tick();
+  temp = gains[0] * adsr[0]->ADSR::tick() * waves[0]->WaveLoop::tick();
     
   lastOutput = temp * (MY_FLOAT) 0.5;
   return lastOutput;
@@ -12122,8 +12182,9 @@ MY_FLOAT PoleZero :: tick(MY_FLOAT sample)
 
 MY_FLOAT *PoleZero :: tick(MY_FLOAT *vec, unsigned int vectorSize)
 {
+  // qualified: no virtual dispatch in the loop
   for (unsigned int i=0; i<vectorSize; i++)
-    vec[i] = tick(vec[i]);
+    vec[i] = PoleZero::tick(vec[i]);
 
   return vec;
 }
@@ -12497,20 +12558,20 @@ MY_FLOAT Rhodey :: tick()
 {
   MY_FLOAT temp, temp2;
 
-  temp = gains[1] * adsr[1]->tick() * waves[1]->tick();
+  temp = gains[1] * adsr[1]->ADSR::tick() * waves[1]->WaveLoop::tick();
   temp = temp * control1;
 
   waves[0]->addPhaseOffset(temp);
   waves[3]->addPhaseOffset(twozero->lastOut());
-  temp = gains[3] * adsr[3]->tick() * waves[3]->tick();
-  twozero->tick(temp);
+  temp = gains[3] * adsr[3]->ADSR::tick() * waves[3]->WaveLoop::tick();
+  twozero->TwoZero::tick(temp);
 
   waves[2]->addPhaseOffset(temp);
-  temp = ( 1.0 - (control2 * 0.5)) * gains[0] * adsr[0]->tick() * waves[0]->tick();
-  temp += control2 * 0.5 * gains[2] * adsr[2]->tick() * waves[2]->tick();
+  temp = ( 1.0 - (control2 * 0.5)) * gains[0] * adsr[0]->ADSR::tick() * waves[0]->WaveLoop::tick();
+  temp += control2 * 0.5 * gains[2] * adsr[2]->ADSR::tick() * waves[2]->WaveLoop::tick();
 
   // Calculate amplitude modulation and apply it to output.
-  temp2 = vibrato->tick() * modDepth;
+  temp2 = vibrato->WaveLoop::tick() * modDepth;
   temp = temp * (1.0 + temp2);
     
   lastOutput = temp * 0.5;
@@ -13096,7 +13157,7 @@ MY_FLOAT Saxofony :: tick()
   // Calculate the breath pressure (envelope + noise + vibrato)
   breathPressure = envelope->tick(); 
   breathPressure += breathPressure * noiseGain * noise->tick();
-  breathPressure += breathPressure * vibratoGain * vibrato->tick();
+  breathPressure += breathPressure * vibratoGain * vibrato->WaveLoop::tick();
 
   temp = -0.95 * filter->tick( delays[0]->lastOut() );
   lastOutput = temp - delays[1]->lastOut();
@@ -15395,20 +15456,20 @@ MY_FLOAT TubeBell :: tick()
 {
   MY_FLOAT temp, temp2;
 
-  temp = gains[1] * adsr[1]->tick() * waves[1]->tick();
+  temp = gains[1] * adsr[1]->ADSR::tick() * waves[1]->WaveLoop::tick();
   temp = temp * control1;
 
   waves[0]->addPhaseOffset(temp);
   waves[3]->addPhaseOffset(twozero->lastOut());
-  temp = gains[3] * adsr[3]->tick() * waves[3]->tick();
-  twozero->tick(temp);
+  temp = gains[3] * adsr[3]->ADSR::tick() * waves[3]->WaveLoop::tick();
+  twozero->TwoZero::tick(temp);
 
   waves[2]->addPhaseOffset(temp);
-  temp = ( 1.0 - (control2 * 0.5)) * gains[0] * adsr[0]->tick() * waves[0]->tick();
-  temp += control2 * 0.5 * gains[2] * adsr[2]->tick() * waves[2]->tick();
+  temp = ( 1.0 - (control2 * 0.5)) * gains[0] * adsr[0]->ADSR::tick() * waves[0]->WaveLoop::tick();
+  temp += control2 * 0.5 * gains[2] * adsr[2]->ADSR::tick() * waves[2]->WaveLoop::tick();
 
   // Calculate amplitude modulation and apply it to output.
-  temp2 = vibrato->tick() * modDepth;
+  temp2 = vibrato->WaveLoop::tick() * modDepth;
   temp = temp * (1.0 + temp2);
     
   lastOutput = temp * 0.5;
@@ -15510,8 +15571,9 @@ MY_FLOAT TwoPole :: tick(MY_FLOAT sample)
 
 MY_FLOAT *TwoPole :: tick(MY_FLOAT *vec, unsigned int vectorSize)
 {
+  // qualified: no virtual dispatch in the loop
   for (unsigned int i=0; i<vectorSize; i++)
-    vec[i] = tick(vec[i]);
+    vec[i] = TwoPole::tick(vec[i]);
 
   return vec;
 }
@@ -15605,8 +15667,9 @@ MY_FLOAT TwoZero :: tick(MY_FLOAT sample)
 
 MY_FLOAT *TwoZero :: tick(MY_FLOAT *vec, unsigned int vectorSize)
 {
+  // qualified: no virtual dispatch in the loop
   for (unsigned int i=0; i<vectorSize; i++)
-    vec[i] = tick(vec[i]);
+    vec[i] = TwoZero::tick(vec[i]);
 
   return vec;
 }
@@ -16312,6 +16375,21 @@ void WaveLoop :: addPhaseOffset(MY_FLOAT anAngle)
   phaseOffset = fileSize * anAngle;
 }
 
+MY_FLOAT WaveLoop :: tick(void)
+{
+  // as WvIn::tick(), minus the virtual calls
+  WaveLoop::tickFrame();
+  return WvIn::lastOut();
+}
+
+MY_FLOAT *WaveLoop :: tick(MY_FLOAT *vec, unsigned int vectorSize)
+{
+  for ( unsigned int i=0; i<vectorSize; i++ )
+    vec[i] = WaveLoop::tick();
+
+  return vec;
+}
+
 const MY_FLOAT *WaveLoop :: tickFrame(void)
 {
   register MY_FLOAT tyme, alpha;
@@ -16713,20 +16791,20 @@ MY_FLOAT Wurley :: tick()
 {
   MY_FLOAT temp, temp2;
 
-  temp = gains[1] * adsr[1]->tick() * waves[1]->tick();
+  temp = gains[1] * adsr[1]->ADSR::tick() * waves[1]->WaveLoop::tick();
   temp = temp * control1;
 
   waves[0]->addPhaseOffset(temp);
   waves[3]->addPhaseOffset(twozero->lastOut());
-  temp = gains[3] * adsr[3]->tick() * waves[3]->tick();
-  twozero->tick(temp);
+  temp = gains[3] * adsr[3]->ADSR::tick() * waves[3]->WaveLoop::tick();
+  twozero->TwoZero::tick(temp);
 
   waves[2]->addPhaseOffset(temp);
-  temp = ( 1.0 - (control2 * 0.5)) * gains[0] * adsr[0]->tick() * waves[0]->tick();
-  temp += control2 * 0.5 * gains[2] * adsr[2]->tick() * waves[2]->tick();
+  temp = ( 1.0 - (control2 * 0.5)) * gains[0] * adsr[0]->ADSR::tick() * waves[0]->WaveLoop::tick();
+  temp += control2 * 0.5 * gains[2] * adsr[2]->ADSR::tick() * waves[2]->WaveLoop::tick();
 
   // Calculate amplitude modulation and apply it to output.
-  temp2 = vibrato->tick() * modDepth;
+  temp2 = vibrato->WaveLoop::tick() * modDepth;
   temp = temp * (1.0 + temp2);
     
   lastOutput = temp * 0.5;
@@ -19039,6 +19117,36 @@ ck_domidi ( Instrmnt * inst, unsigned char status, unsigned char data1, unsigned
 
 
 
+//-----------------------------------------------------------------------------
+// name: stk_tickf_gen() / stk_tickf_filter() / stk_tickf_env()
+// desc: block loops for the STK ugens; the qualified T::tick() call is bound
+//       at compile time, so the per-sample STK tick is a direct (usually
+//       inlined) call instead of a virtual one through the base class
+//-----------------------------------------------------------------------------
+template <class T>
+static inline void stk_tickf_gen( T & t, SAMPLE * out, t_CKUINT nframes )
+{
+    for( t_CKUINT i = 0; i < nframes; i++ )
+        out[i] = (SAMPLE)t.T::tick();
+}
+
+template <class T>
+static inline void stk_tickf_filter( T & t, const SAMPLE * in, SAMPLE * out, t_CKUINT nframes )
+{
+    for( t_CKUINT i = 0; i < nframes; i++ )
+        out[i] = (SAMPLE)t.T::tick( in[i] );
+}
+
+template <class T>
+static inline void stk_tickf_env( T & t, const SAMPLE * in, SAMPLE * out, t_CKUINT nframes )
+{
+    for( t_CKUINT i = 0; i < nframes; i++ )
+        out[i] = (SAMPLE)( in[i] * t.T::tick() );
+}
+
+
+
+
 // StkInstrument
 //-----------------------------------------------------------------------------
 // name: Instrmnt_ctor()
@@ -19063,14 +19171,16 @@ CK_DLL_DTOR( Instrmnt_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: Instrmnt_tick()
-// desc: TICK function ...
+// name: Instrmnt_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( Instrmnt_tick )
+CK_DLL_TICKF( Instrmnt_tickf )
 {
     Instrmnt * i = (Instrmnt *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
     if( !out ) CK_FPRINTF_STDERR( "[chuck](via STK): we warned you...\n");
-    *out = i->tick();
+    // concrete type unknown here: virtual per sample
+    for( t_CKUINT f = 0; f < nframes; f++ )
+        out[f] = i->tick();
     return TRUE;
 }
 
@@ -19170,12 +19280,13 @@ CK_DLL_DTOR( BandedWG_dtor )
 }
 
 //-----------------------------------------------------------------------------
-// name: BandedWG_tick()
-// desc: TICK function ...
+// name: BandedWG_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( BandedWG_tick )
+CK_DLL_TICKF( BandedWG_tickf )
 {
-    *out = ((BandedWG *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data))->tick();
+    BandedWG * d = (BandedWG *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -19721,13 +19832,13 @@ CK_DLL_DTOR( BlowBotl_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: BlowBotl_tick()
-// desc: TICK function ...
+// name: BlowBotl_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( BlowBotl_tick )
+CK_DLL_TICKF( BlowBotl_tickf )
 {
-    BlowBotl * p = (BlowBotl *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
-    *out = p->tick();
+    BlowBotl * d = (BlowBotl *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -19913,13 +20024,13 @@ CK_DLL_DTOR( BlowHole_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: BlowHole_tick()
-// desc: TICK function ...
+// name: BlowHole_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( BlowHole_tick )
+CK_DLL_TICKF( BlowHole_tickf )
 {
-    BlowHole * p = (BlowHole *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
-    *out = p->tick();
+    BlowHole * d = (BlowHole *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -20126,13 +20237,13 @@ CK_DLL_DTOR( Bowed_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: Bowed_tick()
-// desc: TICK function ...
+// name: Bowed_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( Bowed_tick )
+CK_DLL_TICKF( Bowed_tickf )
 {
-    Bowed * p = (Bowed *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
-    *out = p->tick();
+    Bowed * d = (Bowed *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -20516,13 +20627,13 @@ CK_DLL_DTOR( Brass_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: Brass_tick()
-// desc: TICK function ...
+// name: Brass_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( Brass_tick )
+CK_DLL_TICKF( Brass_tickf )
 {
-    Brass * b = (Brass *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
-    *out = b->tick();
+    Brass * d = (Brass *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -20755,13 +20866,13 @@ CK_DLL_DTOR( Clarinet_dtor )
 }
 
 //-----------------------------------------------------------------------------
-// name: Clarinet_tick()
-// desc: TICK function ...
+// name: Clarinet_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( Clarinet_tick )
+CK_DLL_TICKF( Clarinet_tickf )
 {
-    Clarinet * b = (Clarinet *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
-    *out = b->tick();
+    Clarinet * d = (Clarinet *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -20999,13 +21110,13 @@ CK_DLL_DTOR( Flute_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: Flute_tick()
-// desc: TICK function ...
+// name: Flute_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( Flute_tick )
+CK_DLL_TICKF( Flute_tickf )
 {
-    Flute * b = (Flute *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
-    *out = b->tick();
+    Flute * d = (Flute *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -21283,13 +21394,13 @@ CK_DLL_DTOR( ModalBar_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: ModalBar_tick()
-// desc: TICK function ...
+// name: ModalBar_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( ModalBar_tick )
+CK_DLL_TICKF( ModalBar_tickf )
 {
-    ModalBar_ * b = (ModalBar_ *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
-    *out = b->modalbar.tick();
+    ModalBar_ * d = (ModalBar_ *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( d->modalbar, out, nframes );
     return TRUE;
 }
 
@@ -21684,13 +21795,13 @@ CK_DLL_DTOR( Sitar_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: Sitar_tick()
-// desc: TICK function ...
+// name: Sitar_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( Sitar_tick )
+CK_DLL_TICKF( Sitar_tickf )
 {
-    Sitar * b = (Sitar *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
-    *out = b->tick();
+    Sitar * d = (Sitar *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -21756,13 +21867,13 @@ CK_DLL_DTOR( Saxofony_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: Saxofony_tick()
-// desc: TICK function ...
+// name: Saxofony_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( Saxofony_tick )
+CK_DLL_TICKF( Saxofony_tickf )
 {
-    Saxofony * b = (Saxofony *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
-    *out = b->tick();
+    Saxofony * d = (Saxofony *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -22034,13 +22145,13 @@ CK_DLL_DTOR( StifKarp_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: StifKarp_tick()
-// desc: TICK function ...
+// name: StifKarp_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( StifKarp_tick )
+CK_DLL_TICKF( StifKarp_tickf )
 {
-    StifKarp * b = (StifKarp *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
-    *out = b->tick();
+    StifKarp * d = (StifKarp *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -22198,12 +22309,13 @@ CK_DLL_DTOR( Delay_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: Delay_tick()
-// desc: TICK function ...
+// name: Delay_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( Delay_tick )
+CK_DLL_TICKF( Delay_tickf )
 {
-    *out = (SAMPLE)((Delay *)OBJ_MEMBER_UINT(SELF, Delay_offset_data))->tick( in );
+    Delay * d = (Delay *)OBJ_MEMBER_UINT(SELF, Delay_offset_data);
+    stk_tickf_filter( *d, in, out, nframes );
     return TRUE;
 }
 
@@ -22299,12 +22411,13 @@ CK_DLL_DTOR( DelayA_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: DelayA_tick()
-// desc: TICK function ...
+// name: DelayA_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( DelayA_tick )
+CK_DLL_TICKF( DelayA_tickf )
 {
-    *out = (SAMPLE)((DelayA *)OBJ_MEMBER_UINT(SELF, DelayA_offset_data))->tick( in );
+    DelayA * d = (DelayA *)OBJ_MEMBER_UINT(SELF, DelayA_offset_data);
+    stk_tickf_filter( *d, in, out, nframes );
     return TRUE;
 }
 
@@ -22400,12 +22513,13 @@ CK_DLL_DTOR( DelayL_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: DelayL_tick()
-// desc: TICK function ...
+// name: DelayL_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( DelayL_tick )
+CK_DLL_TICKF( DelayL_tickf )
 {
-    *out = (SAMPLE)((DelayL *)OBJ_MEMBER_UINT(SELF, DelayL_offset_data))->tick( in );
+    DelayL * d = (DelayL *)OBJ_MEMBER_UINT(SELF, DelayL_offset_data);
+    stk_tickf_filter( *d, in, out, nframes );
     return TRUE;
 }
 
@@ -22611,13 +22725,13 @@ CK_DLL_DTOR( Envelope_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: Envelope_tick()
-// desc: TICK function ...
+// name: Envelope_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( Envelope_tick )
+CK_DLL_TICKF( Envelope_tickf )
 {
     Envelope * d = (Envelope *)OBJ_MEMBER_UINT(SELF, Envelope_offset_data);
-    *out = in * d->tick();
+    stk_tickf_env( *d, in, out, nframes );
     return TRUE;
 }
 
@@ -22841,13 +22955,13 @@ CK_DLL_DTOR( ADSR_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: ADSR_tick()
-// desc: TICK function ...
+// name: ADSR_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( ADSR_tick )
+CK_DLL_TICKF( ADSR_tickf )
 {
     ADSR * d = (ADSR *)OBJ_MEMBER_UINT(SELF, Envelope_offset_data);
-    *out = in * d->tick();
+    stk_tickf_env( *d, in, out, nframes );
     return TRUE;
 }
 
@@ -23153,13 +23267,13 @@ CK_DLL_DTOR( OnePole_dtor  )
 
 
 //-----------------------------------------------------------------------------
-// name: OnePole_tick()
-// desc: TICK function ...
+// name: OnePole_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( OnePole_tick )
+CK_DLL_TICKF( OnePole_tickf )
 {
-    OnePole * m = (OnePole *)OBJ_MEMBER_UINT(SELF, OnePole_offset_data);
-    *out = m->tick( in );
+    OnePole * d = (OnePole *)OBJ_MEMBER_UINT(SELF, OnePole_offset_data);
+    stk_tickf_filter( *d, in, out, nframes );
     return TRUE;
 }
 
@@ -23272,13 +23386,13 @@ CK_DLL_DTOR( TwoPole_dtor  )
 
 
 //-----------------------------------------------------------------------------
-// name: TwoPole_tick()
-// desc: TICK function ...
+// name: TwoPole_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( TwoPole_tick )
+CK_DLL_TICKF( TwoPole_tickf )
 {
-    TwoPole * m = (TwoPole *)OBJ_MEMBER_UINT(SELF, TwoPole_offset_data);
-    *out = m->tick( in );
+    TwoPole * d = (TwoPole *)OBJ_MEMBER_UINT(SELF, TwoPole_offset_data);
+    stk_tickf_filter( *d, in, out, nframes );
     return TRUE;
 }
 
@@ -23464,13 +23578,13 @@ CK_DLL_DTOR( OneZero_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: OneZero_tick()
-// desc: TICK function ...
+// name: OneZero_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( OneZero_tick )
+CK_DLL_TICKF( OneZero_tickf )
 {
-    OneZero * m = (OneZero *)OBJ_MEMBER_UINT(SELF, OneZero_offset_data);
-    *out = m->tick( in );
+    OneZero * d = (OneZero *)OBJ_MEMBER_UINT(SELF, OneZero_offset_data);
+    stk_tickf_filter( *d, in, out, nframes );
     return TRUE;
 }
 
@@ -23585,13 +23699,13 @@ CK_DLL_DTOR( TwoZero_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: TwoZero_tick()
-// desc: TICK function ...
+// name: TwoZero_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( TwoZero_tick )
+CK_DLL_TICKF( TwoZero_tickf )
 {
-    TwoZero * m = (TwoZero *)OBJ_MEMBER_UINT(SELF, TwoZero_offset_data);
-    *out = m->tick( in );
+    TwoZero * d = (TwoZero *)OBJ_MEMBER_UINT(SELF, TwoZero_offset_data);
+    stk_tickf_filter( *d, in, out, nframes );
     return TRUE;
 }
 
@@ -23744,13 +23858,13 @@ CK_DLL_DTOR( PoleZero_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: PoleZero_tick()
-// desc: TICK function ...
+// name: PoleZero_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( PoleZero_tick )
+CK_DLL_TICKF( PoleZero_tickf )
 {
-    PoleZero * m = (PoleZero *)OBJ_MEMBER_UINT(SELF, PoleZero_offset_data);
-    *out = m->tick( in );
+    PoleZero * d = (PoleZero *)OBJ_MEMBER_UINT(SELF, PoleZero_offset_data);
+    stk_tickf_filter( *d, in, out, nframes );
     return TRUE;
 }
 
@@ -23913,14 +24027,15 @@ CK_DLL_DTOR( FM_dtor  )
 
 
 //-----------------------------------------------------------------------------
-// name: FM_tick()
-// desc: TICK function ...
+// name: FM_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( FM_tick )
+CK_DLL_TICKF( FM_tickf )
 {
     FM * m = (FM *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
     CK_FPRINTF_STDERR( "[chuck](via STK): error -- FM tick is virtual!\n" );
-    *out = m->tick();
+    for( t_CKUINT f = 0; f < nframes; f++ )
+        out[f] = m->tick();
     return TRUE;
 }
 
@@ -24080,13 +24195,13 @@ CK_DLL_DTOR( BeeThree_dtor  )
 
 
 //-----------------------------------------------------------------------------
-// name: BeeThree_tick()
-// desc: TICK function ...
+// name: BeeThree_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( BeeThree_tick )
+CK_DLL_TICKF( BeeThree_tickf )
 {
-    BeeThree * m = (BeeThree *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
-    *out = m->tick();
+    BeeThree * d = (BeeThree *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -24126,13 +24241,13 @@ CK_DLL_DTOR( FMVoices_dtor  )
 
 
 //-----------------------------------------------------------------------------
-// name: FMVoices_tick()
-// desc: TICK function ...
+// name: FMVoices_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( FMVoices_tick )
+CK_DLL_TICKF( FMVoices_tickf )
 {
-    FMVoices * m = (FMVoices *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
-    *out = m->tick();
+    FMVoices * d = (FMVoices *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -24238,13 +24353,13 @@ CK_DLL_DTOR( HevyMetl_dtor  )
 
 
 //-----------------------------------------------------------------------------
-// name: HevyMetl_tick()
-// desc: TICK function ...
+// name: HevyMetl_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( HevyMetl_tick )
+CK_DLL_TICKF( HevyMetl_tickf )
 {
-    HevyMetl * m = (HevyMetl *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
-    *out = m->tick();
+    HevyMetl * d = (HevyMetl *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -24287,13 +24402,13 @@ CK_DLL_DTOR( PercFlut_dtor  )
 
 
 //-----------------------------------------------------------------------------
-// name: PercFlut_tick()
-// desc: TICK function ...
+// name: PercFlut_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( PercFlut_tick )
+CK_DLL_TICKF( PercFlut_tickf )
 {
-    PercFlut * m = (PercFlut *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
-    *out = m->tick();
+    PercFlut * d = (PercFlut *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -24333,13 +24448,13 @@ CK_DLL_DTOR( Rhodey_dtor  )
 
 
 //-----------------------------------------------------------------------------
-// name: Rhodey_tick()
-// desc: TICK function ...
+// name: Rhodey_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( Rhodey_tick )
+CK_DLL_TICKF( Rhodey_tickf )
 {
-    Rhodey * m = (Rhodey *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
-    *out = m->tick();
+    Rhodey * d = (Rhodey *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -24382,13 +24497,13 @@ CK_DLL_DTOR( TubeBell_dtor  )
 
 
 //-----------------------------------------------------------------------------
-// name: TubeBell_tick()
-// desc: TICK function ...
+// name: TubeBell_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( TubeBell_tick )
+CK_DLL_TICKF( TubeBell_tickf )
 {
-    TubeBell * m = (TubeBell *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
-    *out = m->tick();
+    TubeBell * d = (TubeBell *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -24428,13 +24543,13 @@ CK_DLL_DTOR( Wurley_dtor  )
 
 
 //-----------------------------------------------------------------------------
-// name: Wurley_tick()
-// desc: TICK function ...
+// name: Wurley_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( Wurley_tick )
+CK_DLL_TICKF( Wurley_tickf )
 {
-    Wurley * m = (Wurley *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
-    *out = m->tick();
+    Wurley * d = (Wurley *)OBJ_MEMBER_UINT(SELF, FM_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -24522,13 +24637,13 @@ CK_DLL_DTOR( JCRev_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: JCRev_tick()
-// desc: TICK function ...
+// name: JCRev_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( JCRev_tick )
+CK_DLL_TICKF( JCRev_tickf )
 {
-    JCRev * j = (JCRev *)OBJ_MEMBER_UINT(SELF, JCRev_offset_data);
-    *out = j->tick( in );
+    JCRev * d = (JCRev *)OBJ_MEMBER_UINT(SELF, JCRev_offset_data);
+    stk_tickf_filter( *d, in, out, nframes );
     return TRUE;
 }
 
@@ -24593,13 +24708,13 @@ CK_DLL_DTOR( Mandolin_dtor  )
 
 
 //-----------------------------------------------------------------------------
-// name: Mandolin_tick()
-// desc: TICK function ...
+// name: Mandolin_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( Mandolin_tick )
+CK_DLL_TICKF( Mandolin_tickf )
 {
-    Mandolin * m = (Mandolin *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
-    *out = m->tick();
+    Mandolin * d = (Mandolin *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -24902,13 +25017,13 @@ CK_DLL_DTOR( Moog_dtor  )
 
 
 //-----------------------------------------------------------------------------
-// name: Moog_tick()
-// desc: TICK function ...
+// name: Moog_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( Moog_tick )
+CK_DLL_TICKF( Moog_tickf )
 {
-    Moog * m = (Moog *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
-    *out = m->tick();
+    Moog * d = (Moog *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -25129,13 +25244,13 @@ CK_DLL_DTOR( NRev_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: NRev_tick()
-// desc: TICK function ...
+// name: NRev_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( NRev_tick )
+CK_DLL_TICKF( NRev_tickf )
 {
-    NRev * j = (NRev *)OBJ_MEMBER_UINT(SELF, NRev_offset_data);
-    *out = j->tick( in );
+    NRev * d = (NRev *)OBJ_MEMBER_UINT(SELF, NRev_offset_data);
+    stk_tickf_filter( *d, in, out, nframes );
     return TRUE;
 }
 
@@ -25293,13 +25408,13 @@ CK_DLL_DTOR( PRCRev_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: PRCRev_tick()
-// desc: TICK function ...
+// name: PRCRev_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( PRCRev_tick )
+CK_DLL_TICKF( PRCRev_tickf )
 {
-    PRCRev * j = (PRCRev *)OBJ_MEMBER_UINT(SELF, PRCRev_offset_data);
-    *out = j->tick( in );
+    PRCRev * d = (PRCRev *)OBJ_MEMBER_UINT(SELF, PRCRev_offset_data);
+    stk_tickf_filter( *d, in, out, nframes );
     return TRUE;
 }
 
@@ -25360,13 +25475,13 @@ CK_DLL_DTOR( Shakers_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: Shakers_tick()
-// desc: TICK function ...
+// name: Shakers_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( Shakers_tick )
+CK_DLL_TICKF( Shakers_tickf )
 {
-    Shakers * s = (Shakers *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
-    *out = s->tick();
+    Shakers * d = (Shakers *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -25623,13 +25738,13 @@ CK_DLL_DTOR( VoicForm_dtor )
 
 
 //-----------------------------------------------------------------------------
-// name: VoicForm_tick()
-// desc: TICK function ...
+// name: VoicForm_tickf()
+// desc: TICKF function ...
 //-----------------------------------------------------------------------------
-CK_DLL_TICK( VoicForm_tick )
+CK_DLL_TICKF( VoicForm_tickf )
 {
-    VoicForm * m = (VoicForm *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
-    *out = m->tick();
+    VoicForm * d = (VoicForm *)OBJ_MEMBER_UINT(SELF, Instrmnt_offset_data);
+    stk_tickf_gen( *d, out, nframes );
     return TRUE;
 }
 
@@ -762,6 +762,9 @@ public:
   //! Input one sample to the delay-line and return one output.
   MY_FLOAT tick(MY_FLOAT sample);
 
+  //! Input \e vectorSize samples to the delay-line and return an equal number of outputs in \e vector.
+  MY_FLOAT *tick(MY_FLOAT *vector, unsigned int vectorSize);
+
  public: // SWAP formerly protected  
   MY_FLOAT alpha;
   MY_FLOAT omAlpha;
@@ -1342,6 +1345,12 @@ public:
   //! Return a pointer to the next sample frame of data.
   const MY_FLOAT *tickFrame(void);
 
+  //! Compute one sample and return it.
+  MY_FLOAT tick(void);
+
+  //! Compute \e vectorSize samples and return them in \e vector.
+  MY_FLOAT *tick(MY_FLOAT *vector, unsigned int vectorSize);
+
 public:
 
   // Read file data.
@@ -2379,6 +2388,9 @@ public:
   //! Input one sample to the delay-line and return one output.
   MY_FLOAT tick(MY_FLOAT sample);
 
+  //! Input \e vectorSize samples to the delay-line and return an equal number of outputs in \e vector.
+  MY_FLOAT *tick(MY_FLOAT *vector, unsigned int vectorSize);
+
 public: // SWAP formerly protected  
   MY_FLOAT alpha;
   MY_FLOAT coeff;
@@ -3202,6 +3214,9 @@ class JCRev : public Reverb
   //! Compute one output sample.
   MY_FLOAT tick(MY_FLOAT input);
 
+  //! Compute \e vectorSize outputs and return them in \e vector.
+  MY_FLOAT *tick(MY_FLOAT *vector, unsigned int vectorSize);
+
  public: // SWAP formerly protected
   Delay *allpassDelays[3];
   Delay *combDelays[4];
@@ -3916,6 +3931,9 @@ class NRev : public Reverb
   //! Compute one output sample.
   MY_FLOAT tick(MY_FLOAT input);
 
+  //! Compute \e vectorSize outputs and return them in \e vector.
+  MY_FLOAT *tick(MY_FLOAT *vector, unsigned int vectorSize);
+
  public: // SWAP formerly protected  
   Delay *allpassDelays[8];
   Delay *combDelays[6];
@@ -3966,6 +3984,9 @@ public:
   //! Compute one output sample.
   MY_FLOAT tick(MY_FLOAT input);
 
+  //! Compute \e vectorSize outputs and return them in \e vector.
+  MY_FLOAT *tick(MY_FLOAT *vector, unsigned int vectorSize);
+
 public: // SWAP formerly protected  
   Delay *allpassDelays[2];
   Delay *combDelays[2];
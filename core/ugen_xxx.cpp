@@ -40,6 +40,11 @@
 #include <string.h>
 #include <sys/stat.h>
 #include <limits.h>
+#ifndef __PLATFORM_WIN32__
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #if defined(__CK_SNDFILE_NATIVE__)
 #include <sndfile.h>
@@ -53,8 +58,13 @@
 #include "chuck_vm.h"
 #include "chuck_compile.h"
 #include "chuck_instr.h"
+#include "util_xforms.h"
+#include "util_buffers.h"
+#include "util_thread.h"
 
 #include <fstream>
+#include <map>
+#include <list>
 using namespace std;
 
 
@@ -65,6 +75,7 @@ CK_DLL_CTOR( subgraph_ctor );
 CK_DLL_CTOR( foogen_ctor );
 CK_DLL_DTOR( foogen_dtor );
 CK_DLL_TICK( foogen_tick );
+CK_DLL_TICKF( foogen_tickf );
 
 
 // LiSa query
@@ -85,6 +96,7 @@ static t_CKUINT impulse_offset_data = 0;
 static t_CKUINT step_offset_data = 0;
 static t_CKUINT delayp_offset_data = 0;
 static t_CKUINT sndbuf_offset_data = 0;
+static t_CKUINT convolver_offset_data = 0;
 static t_CKUINT dyno_offset_data = 0;
 // static t_CKUINT zerox_offset_data = 0;
 
@@ -148,7 +160,7 @@ DLL_QUERY xxx_query( Chuck_DL_Query * QUERY )
     //-------------------------------------------------------------------------
     // init as base class: FooGen
     //-------------------------------------------------------------------------
-    doc = "Base class for chugen-based user unit generators.";
+    doc = "Base class for chugen-based user unit generators. Define either tick(float in) returning float, called once per sample, or tickBlock(float in[], float out[]), called once per block with in.size() frames.";
     if( !type_engine_import_ugen_begin( env, "Chugen", "UGen", env->global(),
                                         foogen_ctor, foogen_dtor, foogen_tick, NULL, 1, 1, doc.c_str() ) )
         return FALSE;
@@ -567,6 +579,8 @@ DLL_QUERY xxx_query( Chuck_DL_Query * QUERY )
                                         delayp_ctor, delayp_dtor, 
                                         delayp_tick, delayp_pmsg ) )
         return FALSE;
+    // dtor only frees the buffers; off the audio thread
+    if( !type_engine_import_dtor_async( env ) ) return FALSE;
 
     // add member variable
     delayp_offset_data = type_engine_import_mvar( env, "int", "@delayp_data", FALSE );
@@ -635,6 +649,8 @@ DLL_QUERY xxx_query( Chuck_DL_Query * QUERY )
                                         sndbuf_ctor, sndbuf_dtor,
                                         sndbuf_tick, NULL, 1, 1, doc.c_str() ) )
         return FALSE;
+    // dtor only frees the buffers; off the audio thread
+    if( !type_engine_import_dtor_async( env ) ) return FALSE;
 
     if( !type_engine_import_add_ex( env, "basic/sndbuf.ck" ) ) goto error;
     
@@ -759,6 +775,81 @@ DLL_QUERY xxx_query( Chuck_DL_Query * QUERY )
     func->doc = "Chunk size, in frames, for loading the file from disk. 0 indicates that chunking is disabled.";
     if( !type_engine_import_mfun( env, func ) ) goto error;
 
+    // add ctrl: stream
+    func = make_new_mfun( "int", "stream", sndbuf_ctrl_stream );
+    func->add_arg( "int", "stream" );
+    func->doc = "Stream the file from disk on a background thread, keeping at most .streamCache chunks in memory. Set before .read().";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    // add cget: stream
+    func = make_new_mfun( "int", "stream", sndbuf_cget_stream );
+    func->doc = "Whether the file is streamed from disk on a background thread.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // add ctrl: streamCache
+    func = make_new_mfun( "int", "streamCache", sndbuf_ctrl_streamCache );
+    func->add_arg( "int", "chunks" );
+    func->doc = "Maximum number of chunks kept in memory when streaming.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    // add cget: streamCache
+    func = make_new_mfun( "int", "streamCache", sndbuf_cget_streamCache );
+    func->doc = "Maximum number of chunks kept in memory when streaming.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // add cget: streamUnderruns
+    func = make_new_mfun( "int", "streamUnderruns", sndbuf_cget_streamUnderruns );
+    func->doc = "Number of times playback reached a chunk before it was streamed in.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // add ctrl: cache
+    func = make_new_mfun( "int", "cache", sndbuf_ctrl_cache );
+    func->add_arg( "int", "cache" );
+    func->doc = "Share the decoded file with other SndBufs and LiSas reading it (default off). The whole file is decoded at .read(), on the audio thread, instead of in chunks as it plays; files larger than the cache budget load as usual. Set before .read().";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    // add cget: cache
+    func = make_new_mfun( "int", "cache", sndbuf_cget_cache );
+    func->doc = "Whether the decoded file is shared through the sample cache.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // add sfun: cacheHits
+    func = make_new_sfun( "int", "cacheHits", sndbuf_cache_hits );
+    func->doc = "Number of reads served from the shared sample cache.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
+    // add sfun: cacheMisses
+    func = make_new_sfun( "int", "cacheMisses", sndbuf_cache_misses );
+    func->doc = "Number of reads that had to decode a file for the shared sample cache.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
+    // add sfun: cacheEvictions
+    func = make_new_sfun( "int", "cacheEvictions", sndbuf_cache_evictions );
+    func->doc = "Number of unused files evicted from the shared sample cache.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
+    // add sfun: cacheBytes
+    func = make_new_sfun( "int", "cacheBytes", sndbuf_cache_bytes );
+    func->doc = "Bytes of decoded audio currently held by the shared sample cache.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
+    // add sfun: cacheBudget
+    func = make_new_sfun( "int", "cacheBudget", sndbuf_cache_set_budget );
+    func->add_arg( "int", "bytes" );
+    func->doc = "Set how many bytes of decoded audio the shared sample cache may hold before evicting unused files.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+    // add sfun: cacheBudget
+    func = make_new_sfun( "int", "cacheBudget", sndbuf_cache_get_budget );
+    func->doc = "How many bytes of decoded audio the shared sample cache may hold before evicting unused files.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
+    // add ctrl: mmap
+    func = make_new_mfun( "int", "mmap", sndbuf_ctrl_mmap );
+    func->add_arg( "int", "mmap" );
+    func->doc = "Memory-map 32-bit float WAV files instead of loading them; other formats load as usual. Set before .read().";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    // add cget: mmap
+    func = make_new_mfun( "int", "mmap", sndbuf_cget_mmap );
+    func->doc = "Whether float WAV files are memory-mapped.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
     // add cget: samples
     func = make_new_mfun( "int", "samples", sndbuf_cget_samples );
     func->doc = "Total number of sample frames in the file.";
@@ -797,6 +888,76 @@ DLL_QUERY xxx_query( Chuck_DL_Query * QUERY )
     // end import
     if( !type_engine_import_class_end( env ) )
         return FALSE;
+
+
+    //---------------------------------------------------------------------
+    // init as base class: Convolver
+    //---------------------------------------------------------------------
+    doc = "Partitioned FFT convolution with an impulse response, loaded from a sound file or a float array. Latency is one block (see .blockSize); for stereo impulse responses, use one Convolver per channel.";
+    if( !type_engine_import_ugen_begin( env, "Convolver", "UGen", env->global(),
+                                        convolver_ctor, convolver_dtor,
+                                        convolver_tick, NULL, 1, 1, doc.c_str() ) )
+        return FALSE;
+
+    // add member variable
+    convolver_offset_data = type_engine_import_mvar( env, "int", "@convolver_data", FALSE );
+    if( convolver_offset_data == CK_INVALID_OFFSET ) goto error;
+
+    // add ctrl: read
+    func = make_new_mfun( "string", "read", convolver_ctrl_read );
+    func->add_arg( "string", "read" );
+    func->doc = "Load impulse response from a sound file (channel selected by .channel).";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // add ctrl: ir
+    func = make_new_mfun( "float[]", "ir", convolver_ctrl_ir );
+    func->add_arg( "float[]", "ir" );
+    func->doc = "Set impulse response from an array of samples.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // add ctrl: channel
+    func = make_new_mfun( "int", "channel", convolver_ctrl_channel );
+    func->add_arg( "int", "channel" );
+    func->doc = "Channel of the sound file to use as impulse response; takes effect on the next .read().";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    // add cget: channel
+    func = make_new_mfun( "int", "channel", convolver_cget_channel );
+    func->doc = "Channel of the sound file to use as impulse response.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // add ctrl: blockSize
+    func = make_new_mfun( "int", "blockSize", convolver_ctrl_blockSize );
+    func->add_arg( "int", "frames" );
+    func->doc = "Partition size in samples, rounded up to a power of two (default 128). This is also the latency.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    // add cget: blockSize
+    func = make_new_mfun( "int", "blockSize", convolver_cget_blockSize );
+    func->doc = "Partition size in samples. This is also the latency.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // add cget: partitions
+    func = make_new_mfun( "int", "partitions", convolver_cget_partitions );
+    func->doc = "Number of partitions the impulse response is split into.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // add cget: samples
+    func = make_new_mfun( "int", "samples", convolver_cget_samples );
+    func->doc = "Length of the impulse response, in samples.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // add cget: length
+    func = make_new_mfun( "dur", "length", convolver_cget_length );
+    func->doc = "Length of the impulse response.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // add ctrl: clear
+    func = make_new_mfun( "void", "clear", convolver_ctrl_clear );
+    func->doc = "Clear internal state (silences the reverb tail).";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    // end import
+    if( !type_engine_import_class_end( env ) )
+        return FALSE;
     
 #endif // __DISABLE_SNDBUF__
 
@@ -982,6 +1143,12 @@ DLL_QUERY lisa_query( Chuck_DL_Query * QUERY )
                                         LiSaMulti_tick, NULL,
                                         LiSaMulti_pmsg, 1, 1 ))
         return FALSE;
+    // dtor only frees the buffers; off the audio thread
+    if( !type_engine_import_dtor_async( env ) ) return FALSE;
+
+    // add member variable (without it the data pointer lands in Object's slot)
+    LiSaMulti_offset_data = type_engine_import_mvar( env, "int", "@LiSa_data", FALSE );
+    if( LiSaMulti_offset_data == CK_INVALID_OFFSET ) goto error;
 	
     // set/get buffer size
     func = make_new_mfun( "dur", "duration", LiSaMulti_size );
@@ -990,6 +1157,17 @@ DLL_QUERY lisa_query( Chuck_DL_Query * QUERY )
 	func = make_new_mfun( "dur", "duration", LiSaMulti_cget_size );
     if( !type_engine_import_mfun( env, func ) ) goto error;
     
+    // load buffer from file (shared with other readers until written to)
+    func = make_new_mfun( "dur", "read", LiSaMulti_read );
+    func->add_arg( "string", "filename" );
+    func->doc = "Load a sound file (first channel) as the buffer, sharing the decoded samples with other SndBufs and LiSas until recorded into.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+    func = make_new_mfun( "dur", "read", LiSaMulti_read_chan );
+    func->add_arg( "string", "filename" );
+    func->add_arg( "int", "channel" );
+    func->doc = "Load one channel of a sound file as the buffer, sharing the decoded samples with other SndBufs and LiSas until recorded into.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
     // start/stop recording
     func = make_new_mfun( "int", "record", LiSaMulti_start_record );
     func->add_arg( "int", "toggle" );
@@ -1234,6 +1412,8 @@ DLL_QUERY lisa_query( Chuck_DL_Query * QUERY )
                                        NULL, LiSaMulti_tickf,
                                        LiSaMulti_pmsg, 1, LiSa_channels ))
         return FALSE;
+    // dtor only frees the buffers; off the audio thread
+    if( !type_engine_import_dtor_async( env ) ) return FALSE;
 	
     type_engine_import_class_end( env );
     
@@ -1282,9 +1462,47 @@ struct FooGen_Data
     
     t_CKFLOAT input;
     t_CKFLOAT output;
+    
+    // block views handed to tickBlock(float[],float[])
+    Chuck_Array8 * in_block;
+    Chuck_Array8 * out_block;
 };
 
 
+//-----------------------------------------------------------------------------
+// name: foogen_arg_type()
+// desc: type of a function's argument, or NULL past the end
+//-----------------------------------------------------------------------------
+static Chuck_Type * foogen_arg_type( Chuck_Func * func, t_CKUINT which )
+{
+    a_Arg_List args = func->def->arg_list;
+    for( t_CKUINT i = 0; args && i < which; i++ ) args = args->next;
+    return args ? args->type : NULL;
+}
+
+
+//-----------------------------------------------------------------------------
+// name: foogen_make_shred()
+// desc: wrap a call stub into a private shred
+//-----------------------------------------------------------------------------
+static Chuck_VM_Shred * foogen_make_shred( Chuck_VM * vm, vector<Chuck_Instr *> & instrs )
+{
+    Chuck_VM_Code * code = new Chuck_VM_Code;
+    
+    code->instr = new Chuck_Instr*[instrs.size()];
+    code->num_instr = instrs.size();
+    for(int i = 0; i < instrs.size(); i++) code->instr[i] = instrs[i];
+    code->stack_depth = 0;
+    code->need_this = 0;
+    
+    Chuck_VM_Shred * shred = new Chuck_VM_Shred;
+    shred->vm_ref = vm;
+    shred->initialize(code);
+    
+    return shred;
+}
+
+
 //-----------------------------------------------------------------------------
 // name: foogen_ctor()
 // desc: ...
@@ -1292,35 +1510,98 @@ struct FooGen_Data
 CK_DLL_CTOR( foogen_ctor )
 {
     FooGen_Data * data = new FooGen_Data;
+    Chuck_Env * env = SHRED->vm_ref->env();
     
     data->shred = NULL;
     data->vm = SHRED->vm_ref;
+    data->in_block = NULL;
+    data->out_block = NULL;
     
     // 1.3.1.0: changed from unsigned int to t_CKUINT
     OBJ_MEMBER_UINT(SELF, foogen_offset_data) = (t_CKUINT)data;
 
     Chuck_UGen * ugen = (Chuck_UGen *)SELF;
     int tick_fun_index = -1;
+    int block_fun_index = -1;
     
-    for(int i = 0; i < ugen->vtable->funcs.size(); i++)
+    // look for tickBlock(float[],float[]) first
+    for( int i = 0; i < ugen->vtable->funcs.size(); i++ )
     {
         Chuck_Func * func = ugen->vtable->funcs[i];
-        if(func->name.find("tick") == 0 && 
-           // ensure has one argument
-           func->def->arg_list != NULL &&
-           // ensure first argument is float
-           func->def->arg_list->type == SHRED->vm_ref->env()->t_float &&
-           // ensure has only one argument
-           func->def->arg_list->next == NULL &&
-           // ensure returns float
-           func->def->ret_type == SHRED->vm_ref->env()->t_float )
+        Chuck_Type * a = foogen_arg_type( func, 0 );
+        Chuck_Type * b = foogen_arg_type( func, 1 );
+        if( func->name.find("tickBlock") == 0 &&
+           // ensure two arguments, both float[]
+           a && a->array_depth == 1 && a->array_type == env->t_float &&
+           b && b->array_depth == 1 && b->array_type == env->t_float &&
+           foogen_arg_type( func, 2 ) == NULL &&
+           // ensure returns void
+           func->def->ret_type == env->t_void )
         {
-            tick_fun_index = i;
+            block_fun_index = i;
             break;
         }
     }
     
-    if( tick_fun_index != -1 )
+    if( block_fun_index == -1 )
+    {
+        for(int i = 0; i < ugen->vtable->funcs.size(); i++)
+        {
+            Chuck_Func * func = ugen->vtable->funcs[i];
+            if(func->name.find("tick") == 0 && 
+               // ensure has one argument
+               func->def->arg_list != NULL &&
+               // ensure first argument is float
+               func->def->arg_list->type == env->t_float &&
+               // ensure has only one argument
+               func->def->arg_list->next == NULL &&
+               // ensure returns float
+               func->def->ret_type == env->t_float )
+            {
+                tick_fun_index = i;
+                break;
+            }
+        }
+    }
+    
+    if( block_fun_index != -1 )
+    {
+        // block arrays, reused for the life of the ugen
+        data->in_block = new Chuck_Array8( 0 );
+        initialize_object( data->in_block, env->t_array );
+        data->in_block->add_ref();
+        data->out_block = new Chuck_Array8( 0 );
+        initialize_object( data->out_block, env->t_array );
+        data->out_block->add_ref();
+        
+        vector<Chuck_Instr *> instrs;
+        // push args (float[] in, float[] out); the callee releases them
+        instrs.push_back(new Chuck_Instr_Reg_Push_Imm((t_CKUINT)data->in_block) );
+        instrs.push_back(new Chuck_Instr_Reg_AddRef_Object3);
+        instrs.push_back(new Chuck_Instr_Reg_Push_Imm((t_CKUINT)data->out_block) );
+        instrs.push_back(new Chuck_Instr_Reg_AddRef_Object3);
+        // push this (as func arg)
+        instrs.push_back(new Chuck_Instr_Reg_Push_Imm((t_CKUINT)SELF) );
+        // reg dup last (push this again) (for member func resolution)
+        instrs.push_back(new Chuck_Instr_Reg_Dup_Last);
+        // dot member func
+        instrs.push_back(new Chuck_Instr_Dot_Member_Func(block_fun_index) );
+        // func to code
+        instrs.push_back(new Chuck_Instr_Func_To_Code);
+        // push stack depth
+        instrs.push_back(new Chuck_Instr_Reg_Push_Imm(12));
+        // func call (void: nothing to pop)
+        instrs.push_back(new Chuck_Instr_Func_Call());
+        // EOC
+        instrs.push_back(new Chuck_Instr_EOC);
+        
+        data->shred = foogen_make_shred( SHRED->vm_ref, instrs );
+        
+        // tick by the block from here on
+        ugen->tick = NULL;
+        ugen->tickf = foogen_tickf;
+    }
+    else if( tick_fun_index != -1 )
     {
         vector<Chuck_Instr *> instrs;
         // push arg (float input)
@@ -1346,17 +1627,7 @@ CK_DLL_CTOR( foogen_ctor )
         // EOC
         instrs.push_back(new Chuck_Instr_EOC);
         
-        Chuck_VM_Code * code = new Chuck_VM_Code;
-        
-        code->instr = new Chuck_Instr*[instrs.size()];
-        code->num_instr = instrs.size();
-        for(int i = 0; i < instrs.size(); i++) code->instr[i] = instrs[i];
-        code->stack_depth = 0;
-        code->need_this = 0;
-        
-        data->shred = new Chuck_VM_Shred;
-        data->shred->vm_ref = SHRED->vm_ref;
-        data->shred->initialize(code);
+        data->shred = foogen_make_shred( SHRED->vm_ref, instrs );
     }
     else
     {
@@ -1375,9 +1646,41 @@ CK_DLL_DTOR( foogen_dtor )
 {
     FooGen_Data * data = (FooGen_Data *) OBJ_MEMBER_UINT(SELF, foogen_offset_data);
     OBJ_MEMBER_UINT(SELF, foogen_offset_data) = 0;
+    if( data ) SAFE_RELEASE( data->in_block );
+    if( data ) SAFE_RELEASE( data->out_block );
     SAFE_DELETE(data);
 }
 
+
+//-----------------------------------------------------------------------------
+// name: foogen_run()
+// desc: rewind the private shred and run the call stub once
+//-----------------------------------------------------------------------------
+static void foogen_run( FooGen_Data * data )
+{
+    // program counter
+    data->shred->pc = 0;
+    data->shred->next_pc = 1;
+    // shred in dump (all done)
+    data->shred->is_dumped = FALSE;
+    // shred done
+    data->shred->is_done = FALSE;
+    // shred running
+    data->shred->is_running = FALSE;
+    // shred abort
+    data->shred->is_abort = FALSE;
+    // set the instr
+    data->shred->instr = data->shred->code->instr;
+    // zero out the id
+    data->shred->xid = 0;
+    // set vmRef
+    data->shred->vm_ref = data->vm;
+    
+    // run shred
+    data->shred->run( data->vm );
+}
+
+
 //-----------------------------------------------------------------------------
 // name: foogen_tick()
 // desc: ...
@@ -1391,31 +1694,10 @@ CK_DLL_TICK( foogen_tick )
     
     if(data->shred)
     {
-        // reset shred
-        
-        // program counter
-        data->shred->pc = 0;
-        data->shred->next_pc = 1;
-        // shred in dump (all done)
-        data->shred->is_dumped = FALSE;
-        // shred done
-        data->shred->is_done = FALSE;
-        // shred running
-        data->shred->is_running = FALSE;
-        // shred abort
-        data->shred->is_abort = FALSE;
-        // set the instr
-        data->shred->instr = data->shred->code->instr;
-        // zero out the id
-        data->shred->xid = 0;
-        // set vmRef
-        data->shred->vm_ref = data->vm;
-        
         // set input
         data->input = in;
-        
         // run shred
-        data->shred->run( data->vm );
+        foogen_run( data );
     }
     
     *out = data->output;
@@ -1424,6 +1706,35 @@ CK_DLL_TICK( foogen_tick )
 }
 
 
+//-----------------------------------------------------------------------------
+// name: foogen_tickf()
+// desc: one call into tickBlock() per block
+//-----------------------------------------------------------------------------
+CK_DLL_TICKF( foogen_tickf )
+{
+    FooGen_Data * data = (FooGen_Data *) OBJ_MEMBER_UINT(SELF, foogen_offset_data);
+    vector<t_CKFLOAT> & vin = data->in_block->m_vector;
+    vector<t_CKFLOAT> & vout = data->out_block->m_vector;
+    t_CKUINT i;
+    
+    // (re)size the views; only allocates when the block grows
+    vin.resize( nframes );
+    vout.resize( nframes );
+    for( i = 0; i < nframes; i++ ) vin[i] = in[i];
+    // default: passthru
+    for( i = 0; i < nframes; i++ ) vout[i] = in[i];
+    
+    foogen_run( data );
+    
+    // tickBlock may have resized out[]
+    t_CKUINT n = vout.size() < nframes ? vout.size() : nframes;
+    for( i = 0; i < n; i++ ) out[i] = (SAMPLE)vout[i];
+    for( ; i < nframes; i++ ) out[i] = 0;
+    
+    return TRUE;
+}
+
+
 
 //-----------------------------------------------------------------------------
 // name: multi_ctor()
@@ -2455,119 +2766,684 @@ protected:
 };
 #endif /* CK_SNDBUF_MEMORY_BUFFER */
 
-// data for each sndbuf
-struct sndbuf_data
+// streaming defaults
+#define CK_SNDBUF_STREAM_DEFAULT_CACHE (8) // chunks kept in memory per SndBuf
+#define CK_SNDBUF_STREAM_AHEAD (2)         // chunks requested ahead of the play head
+
+// chunk states (streaming)
+enum { SNDBUF_CHUNK_ABSENT = 0, SNDBUF_CHUNK_REQUESTED, SNDBUF_CHUNK_RESIDENT };
+
+// flags shared with the streamer thread ('closed', exit)
+#if defined(__PLATFORM_WIN32__) && !defined(__GNUC__)
+  #define CK_STREAM_SET(p,v) InterlockedExchange( (p), (v) )
+  #define CK_STREAM_GET(p) InterlockedCompareExchange( (p), 0, 0 )
+#else
+  #define CK_STREAM_SET(p,v) __sync_lock_test_and_set( (p), (v) )
+  #define CK_STREAM_GET(p) __sync_fetch_and_add( (p), 0 )
+#endif
+
+//-----------------------------------------------------------------------------
+// name: struct SndBufChunk
+// desc: a chunk handed from the streamer thread to the audio thread
+//-----------------------------------------------------------------------------
+struct SndBufChunk
 {
-    SAMPLE * buffer;
-    t_CKUINT num_samples;
-    t_CKUINT num_channels;
-    t_CKUINT num_frames;
-    t_CKUINT samplerate;
-    t_CKUINT chan;
-    
-    t_CKUINT chunks;
-    t_CKUINT chunks_read;
+    t_CKUINT bin;
+    SAMPLE * data;
+};
+
+//-----------------------------------------------------------------------------
+// name: struct SndBufStream
+// desc: state shared between a streaming SndBuf and the streamer thread.
+//       the audio thread owns chunk_map, state and resident; the streamer
+//       owns fd.  they talk only through the three queues.  once 'closed'
+//       is set (CK_STREAM_SET), the audio side lets go and the streamer
+//       frees everything.
+//-----------------------------------------------------------------------------
+struct SndBufStream
+{
+    SNDFILE * fd;
+    t_CKUINT chunks;       // samples per chunk (multiple of num_channels)
     t_CKUINT chunk_num;
+    t_CKUINT num_channels;
     SAMPLE ** chunk_map;
+    t_CKBYTE * state;
+    std::vector<t_CKUINT> resident;
+    t_CKUINT cache;
+    t_CKUINT last_bin;
+    t_CKUINT underruns;
+    // audio -> streamer: bins to load
+    CircularBuffer<t_CKUINT> * requests;
+    // streamer -> audio: loaded bins
+    CircularBuffer<SndBufChunk> * loaded;
+    // audio -> streamer: evicted chunk data to free
+    CircularBuffer<SAMPLE *> * dead;
+    volatile long closed;
+
+    SndBufStream( SNDFILE * _fd, t_CKUINT _chunks, t_CKUINT _chunk_num,
+                  t_CKUINT _num_channels, t_CKUINT _cache )
+    {
+        fd = _fd;
+        chunks = _chunks;
+        chunk_num = _chunk_num;
+        num_channels = _num_channels;
+        cache = _cache;
+        chunk_map = new SAMPLE*[chunk_num];
+        memset( chunk_map, 0, chunk_num * sizeof(SAMPLE *) );
+        state = new t_CKBYTE[chunk_num];
+        memset( state, SNDBUF_CHUNK_ABSENT, chunk_num );
+        resident.reserve( chunk_num );
+        last_bin = chunk_num;
+        underruns = 0;
+        // each bin is in at most one queue at a time
+        requests = new CircularBuffer<t_CKUINT>( chunk_num );
+        loaded = new CircularBuffer<SndBufChunk>( chunk_num );
+        dead = new CircularBuffer<SAMPLE *>( chunk_num );
+        closed = 0;
+    }
 
-    SAMPLE * eob;
-    //SAMPLE * curr;
-    SAMPLE current_val;
-    t_CKFLOAT sampleratio;
-    t_CKFLOAT curf;
-    t_CKFLOAT rate_factor;
-    t_CKFLOAT rate;
-    t_CKINT interp;
-    t_CKBOOL loop;
-    
-    bool sinc_table_built;
-    bool sinc_use_table;
-    bool sinc_use_interp;
-    t_CKINT sinc_samples_per_zero_crossing;
-    t_CKINT sinc_width;
-    double * sinc_table;
+    ~SndBufStream()
+    {
+        SndBufChunk c;
+        SAMPLE * data;
+        while( loaded->get( c ) ) delete [] c.data;
+        while( dead->get( data ) ) delete [] data;
+        for( t_CKUINT i = 0; i < chunk_num; i++ )
+            SAFE_DELETE_ARRAY( chunk_map[i] );
+        SAFE_DELETE_ARRAY( chunk_map );
+        SAFE_DELETE_ARRAY( state );
+        SAFE_DELETE( requests );
+        SAFE_DELETE( loaded );
+        SAFE_DELETE( dead );
+        if( fd ) sf_close( fd );
+    }
 
-#ifdef CK_SNDBUF_MEMORY_BUFFER
-    MultiBuffer< SAMPLE > mb_buffer;
-    t_CKUINT mb_max_samples;
-    MultiBuffer< SAMPLE >::Pointer mb_record_position;
-    MultiBuffer< SAMPLE >::Pointer mb_playback_position;
-#endif /* CK_SNDBUF_MEMORY_BUFFER */
+    // read one chunk from disk (streamer thread, or before registering)
+    SAMPLE * read_chunk( t_CKUINT bin )
+    {
+        SAMPLE * data = new SAMPLE[chunks];
+        t_CKUINT frames = chunks / num_channels;
+        sf_seek( fd, bin * frames, SEEK_SET );
+#if defined(__CHUCK_USE_64_BIT_SAMPLE__)
+        t_CKUINT n = sf_readf_double( fd, data, frames );
+#else
+        t_CKUINT n = sf_readf_float( fd, data, frames );
+#endif
+        // zero the tail of the last chunk
+        if( n < frames )
+            memset( data + n * num_channels, 0, (frames - n) * num_channels * sizeof(SAMPLE) );
+        return data;
+    }
+};
 
-    SNDFILE * fd;
+//-----------------------------------------------------------------------------
+// name: class SndBufStreamer
+// desc: background thread that services all streaming SndBufs; it sleeps
+//       until a SndBuf wakes it, and reads from disk without holding the
+//       lock the audio thread takes
+//-----------------------------------------------------------------------------
+class SndBufStreamer
+{
+public:
+    // get the shared instance (starts the thread)
+    static SndBufStreamer * shared()
+    {
+        if( o_streamer == NULL )
+            o_streamer = new SndBufStreamer();
+        return o_streamer;
+    }
 
-    // constructor
-    sndbuf_data()
+    // wake the shared instance, if there is one (audio thread)
+    static void notify()
     {
-        buffer = NULL;
-        interp = SNDBUF_INTERP;
-        num_channels = 0;
-        num_frames = 0;
-        num_samples = 0;
-        chunks = CK_SNDBUF_DEFAULT_CHUNK_SIZE;
-        chunks_read = 0;
-        samplerate = 0;
-        sampleratio = 1.0;
-        chan = 0;
-        curf = 0.0;
-        rate_factor = 1.0;
-        rate = 1.0;
-        eob = NULL;
-        current_val = 0.0;
-        chunk_map = NULL;
-        chunk_num = 0;
-        
-        sinc_table_built = false;
-        sinc_use_table = USE_TABLE;
-        sinc_use_interp = USE_INTERP;
-        sinc_width = WIDTH;
-        sinc_samples_per_zero_crossing = SAMPLES_PER_ZERO_CROSSING;
-        sinc_table = NULL;
-        
-#ifdef CK_SNDBUF_MEMORY_BUFFER
-        mb_buffer = MultiBuffer< SAMPLE >();
-#endif /* CK_SNDBUF_MEMORY_BUFFER */
-        
-        loop = FALSE;
-        fd = NULL;
+        if( o_streamer ) o_streamer->m_wake.post();
     }
 
-    ~sndbuf_data()
+    // stop and join the thread; it keeps running if a SndBuf still streams
+    static void shutdown()
     {
-        SAFE_DELETE_ARRAY( buffer );
-        
-        if( chunk_map )
+        if( o_streamer == NULL ) return;
+        SndBufStreamer * s = o_streamer;
+
+        CK_STREAM_SET( &s->m_thread_exit, 1 );
+        s->m_wake.post();
+        s->m_thread.wait( -1, false );
+        s->m_thread.clear();
+
+        // thread is stopped: free closed streams here
+        s->service();
+        s->m_mutex.acquire();
+        t_CKBOOL busy = !s->m_streams.empty();
+        s->m_mutex.release();
+        if( busy )
         {
-            for(int i = 0; i < chunk_num; i++)
-                SAFE_DELETE_ARRAY(chunk_map[i]);
-            SAFE_DELETE_ARRAY(chunk_map);
+            CK_STREAM_SET( &s->m_thread_exit, 0 );
+            s->m_thread.start( stream_cb, s );
+            return;
         }
+
+        o_streamer = NULL;
+        delete s;
     }
-    
-    inline void sampleIndex2FrameIndexAndChannel(t_CKINT sample, t_CKINT *frame, t_CKINT *channel)
+
+    // hand a stream to the streamer thread
+    void add( SndBufStream * stream )
     {
-        *frame = (t_CKINT) floorf(sample/this->num_channels);
-        *channel = sample%this->num_channels;
+        m_mutex.acquire();
+        m_streams.push_back( stream );
+        m_mutex.release();
+        m_wake.post();
     }
-};
 
+protected:
+    SndBufStreamer()
+    {
+        m_thread_exit = 0;
+        m_thread.start( stream_cb, this );
+    }
 
-double sndbuf_sinc( sndbuf_data * d, double x );
-double sndbuf_t_sinc( sndbuf_data * d, double x );
-void   sndbuf_make_sinc( sndbuf_data * d );
-void   sndbuf_sinc_interpolate( sndbuf_data * d, SAMPLE * out );
+    // service requests once (streamer thread, or shutdown() once it stopped)
+    void service()
+    {
+        // take a snapshot; only this thread ever removes or frees streams,
+        // so they stay valid after the lock is let go
+        std::vector<SndBufStream *> closed;
+        m_mutex.acquire();
+        for( size_t i = 0; i < m_streams.size(); )
+        {
+            // released by its SndBuf
+            if( CK_STREAM_GET( &m_streams[i]->closed ) )
+            {
+                closed.push_back( m_streams[i] );
+                m_streams[i] = m_streams.back();
+                m_streams.pop_back();
+                continue;
+            }
+            i++;
+        }
+        m_work = m_streams;
+        m_mutex.release();
 
-CK_DLL_CTOR( sndbuf_ctor )
-{
-    OBJ_MEMBER_UINT(SELF, sndbuf_offset_data) = (t_CKUINT)new sndbuf_data;
+        for( size_t i = 0; i < closed.size(); i++ )
+            delete closed[i];
 
-}
+        for( size_t i = 0; i < m_work.size(); i++ )
+        {
+            SndBufStream * s = m_work[i];
+
+            SAMPLE * data;
+            while( s->dead->get( data ) )
+                delete [] data;
+
+            t_CKUINT bin;
+            while( s->requests->get( bin ) )
+            {
+                SndBufChunk c;
+                c.bin = bin;
+                c.data = s->read_chunk( bin );
+                s->loaded->put( c );
+            }
+        }
+    }
+
+#if ( defined(__PLATFORM_MACOSX__) || defined(__PLATFORM_LINUX__) || defined(__WINDOWS_PTHREAD__) )
+    static void * stream_cb( void * _thiss )
+#elif defined(__PLATFORM_WIN32__)
+    static unsigned THREAD_TYPE stream_cb( void * _thiss )
+#endif
+    {
+        SndBufStreamer * _this = (SndBufStreamer *)_thiss;
+        while( !CK_STREAM_GET( &_this->m_thread_exit ) )
+        {
+            // sleep until there is something to do
+            _this->m_wake.wait();
+            _this->service();
+        }
+        return 0;
+    }
+
+protected:
+    XThread m_thread;
+    XMutex m_mutex;
+    XSemaphore m_wake;
+    volatile long m_thread_exit;
+    // guarded by m_mutex
+    std::vector<SndBufStream *> m_streams;
+    // streamer thread only
+    std::vector<SndBufStream *> m_work;
+
+    static SndBufStreamer * o_streamer;
+};
+
+SndBufStreamer * SndBufStreamer::o_streamer = NULL;
+
+//-----------------------------------------------------------------------------
+// name: sndbuf_streamer_shutdown()
+// desc: stop and join the streamer thread, once no SndBuf streams
+//-----------------------------------------------------------------------------
+void sndbuf_streamer_shutdown()
+{
+    SndBufStreamer::shutdown();
+}
+
+
+
+
+// default cache budget, in bytes of decoded audio
+#define CK_SAMPLE_CACHE_DEFAULT_BUDGET (256*1024*1024)
+
+//-----------------------------------------------------------------------------
+// name: struct SampleCacheEntry
+// desc: one decoded file (or one channel of it), shared read-only
+//-----------------------------------------------------------------------------
+struct SampleCacheEntry
+{
+    // key
+    std::string path;
+    time_t mtime;
+    t_CKINT chan; // -1: all channels, interleaved
+
+    // decoded samples; one extra frame of zeros at the end
+    SAMPLE * data;
+    t_CKUINT frames;
+    t_CKUINT channels;
+    t_CKUINT samplerate;
+    size_t bytes;
+
+    // users; at 0 the entry sits in the LRU list until evicted
+    t_CKUINT refs;
+    std::list<SampleCacheEntry *>::iterator lru;
+};
+
+//-----------------------------------------------------------------------------
+// name: class SampleCache
+// desc: process-wide cache of decoded sound files, keyed by path, mtime and
+//       channel, so SndBuf and LiSa instances on the same file share one
+//       immutable copy.  unreferenced entries are kept for reuse and evicted
+//       least-recently-released first once the budget is exceeded.
+//-----------------------------------------------------------------------------
+class SampleCache
+{
+public:
+    // get a decoded file, loading it on a miss; NULL on error or if the
+    // file is too large to cache.  pair each success with release()
+    static SampleCacheEntry * acquire( const char * filename, t_CKINT chan )
+    {
+        struct stat st;
+        if( stat( filename, &st ) ) return NULL;
+        std::string path = filename;
+#ifndef __PLATFORM_WIN32__
+        // one entry regardless of how the path was spelled
+        char resolved[PATH_MAX];
+        if( realpath( filename, resolved ) ) path = resolved;
+#endif
+        Key key( path, st.st_mtime, chan );
+
+        o_mutex.acquire();
+        SampleCacheEntry * e = find( key );
+        if( e )
+        {
+            o_hits++;
+            o_mutex.release();
+            return e;
+        }
+        o_misses++;
+        o_mutex.release();
+
+        // decode outside the lock
+        e = load( filename, chan );
+        if( !e ) return NULL;
+        e->path = path;
+        e->mtime = st.st_mtime;
+        e->refs = 1;
+        // mono files are kept under -1 only (load() sets e->chan)
+        key.chan = e->chan;
+
+        o_mutex.acquire();
+        // lost a race with another loader: use theirs
+        SampleCacheEntry * theirs = find( key );
+        if( theirs )
+        {
+            SAFE_DELETE_ARRAY( e->data );
+            SAFE_DELETE( e );
+            e = theirs;
+        }
+        else
+        {
+            o_entries[key] = e;
+            o_bytes += e->bytes;
+            trim();
+        }
+        o_mutex.release();
+        return e;
+    }
+
+    // done with an entry
+    static void release( SampleCacheEntry * e )
+    {
+        o_mutex.acquire();
+        if( --e->refs == 0 )
+        {
+            o_lru.push_front( e );
+            e->lru = o_lru.begin();
+            trim();
+        }
+        o_mutex.release();
+    }
+
+    // stats
+    static t_CKINT hits() { return o_hits; }
+    static t_CKINT misses() { return o_misses; }
+    static t_CKINT evictions() { return o_evictions; }
+    static t_CKINT bytes() { return o_bytes; }
+    static t_CKINT budget() { return o_budget; }
+    static void setBudget( t_CKINT budget )
+    {
+        o_mutex.acquire();
+        o_budget = budget > 0 ? budget : 0;
+        trim();
+        o_mutex.release();
+    }
+
+protected:
+    struct Key
+    {
+        std::string path;
+        time_t mtime;
+        t_CKINT chan;
+
+        Key( const std::string & p, time_t m, t_CKINT c ) : path(p), mtime(m), chan(c) { }
+        bool operator<( const Key & rhs ) const
+        {
+            if( mtime != rhs.mtime ) return mtime < rhs.mtime;
+            if( chan != rhs.chan ) return chan < rhs.chan;
+            return path < rhs.path;
+        }
+    };
+
+    // look up and reference an entry (lock held); channel 0 of a mono
+    // file is the whole file, so it is found under -1
+    static SampleCacheEntry * find( const Key & key )
+    {
+        std::map<Key, SampleCacheEntry *>::iterator it = o_entries.find( key );
+        if( it == o_entries.end() && key.chan == 0 )
+        {
+            it = o_entries.find( Key( key.path, key.mtime, -1 ) );
+            if( it != o_entries.end() && it->second->channels != 1 )
+                it = o_entries.end();
+        }
+        if( it == o_entries.end() ) return NULL;
+
+        SampleCacheEntry * e = it->second;
+        if( e->refs++ == 0 ) o_lru.erase( e->lru );
+        return e;
+    }
+
+    // decode a file; chan < 0 keeps all channels
+    static SampleCacheEntry * load( const char * filename, t_CKINT chan )
+    {
+        SF_INFO info;
+        info.format = 0;
+        SNDFILE * fd = sf_open( filename, SFM_READ, &info );
+        if( sf_error( fd ) )
+        {
+            if( fd ) sf_close( fd );
+            return NULL;
+        }
+
+        t_CKUINT out_chans = chan < 0 ? info.channels : 1;
+        size_t bytes = ( info.frames + 1 ) * out_chans * sizeof(SAMPLE);
+        // would not fit even in an empty cache
+        if( chan >= info.channels || bytes > (size_t)o_budget )
+        {
+            sf_close( fd );
+            return NULL;
+        }
+
+        SAMPLE * data = new SAMPLE[( info.frames + 1 ) * info.channels];
+        memset( data, 0, ( info.frames + 1 ) * info.channels * sizeof(SAMPLE) );
+#if defined(__CHUCK_USE_64_BIT_SAMPLE__)
+        t_CKUINT n = sf_readf_double( fd, data, info.frames );
+#else
+        t_CKUINT n = sf_readf_float( fd, data, info.frames );
+#endif
+        sf_close( fd );
+
+        // pick out one channel, in place
+        if( chan >= 0 && info.channels > 1 )
+        {
+            for( t_CKUINT i = 0; i < n; i++ )
+                data[i] = data[i*info.channels + chan];
+            memset( data + n, 0, sizeof(SAMPLE) );
+        }
+
+        SampleCacheEntry * e = new SampleCacheEntry;
+        // one key for a mono file, whichever way it was asked for
+        e->chan = info.channels == 1 ? -1 : chan;
+        e->data = data;
+        e->frames = n;
+        e->channels = out_chans;
+        e->samplerate = info.samplerate;
+        e->bytes = bytes;
+        return e;
+    }
+
+    // evict unreferenced entries until within budget (lock held)
+    static void trim()
+    {
+        while( o_bytes > o_budget && o_lru.size() )
+        {
+            SampleCacheEntry * e = o_lru.back();
+            o_lru.pop_back();
+            o_entries.erase( Key( e->path, e->mtime, e->chan ) );
+            o_bytes -= e->bytes;
+            o_evictions++;
+            SAFE_DELETE_ARRAY( e->data );
+            SAFE_DELETE( e );
+        }
+    }
+
+protected:
+    static XMutex o_mutex;
+    static std::map<Key, SampleCacheEntry *> o_entries;
+    static std::list<SampleCacheEntry *> o_lru;
+    static t_CKINT o_bytes;
+    static t_CKINT o_budget;
+    static t_CKINT o_hits;
+    static t_CKINT o_misses;
+    static t_CKINT o_evictions;
+};
+
+XMutex SampleCache::o_mutex;
+std::map<SampleCache::Key, SampleCacheEntry *> SampleCache::o_entries;
+std::list<SampleCacheEntry *> SampleCache::o_lru;
+t_CKINT SampleCache::o_bytes = 0;
+t_CKINT SampleCache::o_budget = CK_SAMPLE_CACHE_DEFAULT_BUDGET;
+t_CKINT SampleCache::o_hits = 0;
+t_CKINT SampleCache::o_misses = 0;
+t_CKINT SampleCache::o_evictions = 0;
+
+
+
+
+// data for each sndbuf
+struct sndbuf_data
+{
+    SAMPLE * buffer;
+    t_CKUINT num_samples;
+    t_CKUINT num_channels;
+    t_CKUINT num_frames;
+    t_CKUINT samplerate;
+    t_CKUINT chan;
+    
+    t_CKUINT chunks;
+    t_CKUINT chunks_read;
+    t_CKUINT chunk_num;
+    SAMPLE ** chunk_map;
+
+    SAMPLE * eob;
+    //SAMPLE * curr;
+    SAMPLE current_val;
+    t_CKFLOAT sampleratio;
+    t_CKFLOAT curf;
+    t_CKFLOAT rate_factor;
+    t_CKFLOAT rate;
+    t_CKINT interp;
+    t_CKBOOL loop;
+    
+    bool sinc_table_built;
+    bool sinc_use_table;
+    bool sinc_use_interp;
+    t_CKINT sinc_samples_per_zero_crossing;
+    t_CKINT sinc_width;
+    double * sinc_table;
+
+    // stream from disk in the background (set before read)
+    t_CKBOOL stream_mode;
+    t_CKUINT stream_cache;
+    SndBufStream * stream;
+
+    // memory-map float wav files (set before read)
+    t_CKBOOL mmap_mode;
+    void * mmap_base;
+    size_t mmap_size;
+
+    // share decoded files through SampleCache (set before read)
+    t_CKBOOL cache_mode;
+    SampleCacheEntry * cached;
+
+#ifdef CK_SNDBUF_MEMORY_BUFFER
+    MultiBuffer< SAMPLE > mb_buffer;
+    t_CKUINT mb_max_samples;
+    MultiBuffer< SAMPLE >::Pointer mb_record_position;
+    MultiBuffer< SAMPLE >::Pointer mb_playback_position;
+#endif /* CK_SNDBUF_MEMORY_BUFFER */
+
+    SNDFILE * fd;
+
+    // constructor
+    sndbuf_data()
+    {
+        buffer = NULL;
+        interp = SNDBUF_INTERP;
+        num_channels = 0;
+        num_frames = 0;
+        num_samples = 0;
+        chunks = CK_SNDBUF_DEFAULT_CHUNK_SIZE;
+        chunks_read = 0;
+        samplerate = 0;
+        sampleratio = 1.0;
+        chan = 0;
+        curf = 0.0;
+        rate_factor = 1.0;
+        rate = 1.0;
+        eob = NULL;
+        current_val = 0.0;
+        chunk_map = NULL;
+        chunk_num = 0;
+        
+        sinc_table_built = false;
+        sinc_use_table = USE_TABLE;
+        sinc_use_interp = USE_INTERP;
+        sinc_width = WIDTH;
+        sinc_samples_per_zero_crossing = SAMPLES_PER_ZERO_CROSSING;
+        sinc_table = NULL;
+
+        stream_mode = FALSE;
+        stream_cache = CK_SNDBUF_STREAM_DEFAULT_CACHE;
+        stream = NULL;
+        mmap_mode = FALSE;
+        mmap_base = NULL;
+        mmap_size = 0;
+        cache_mode = FALSE;
+        cached = NULL;
+        
+#ifdef CK_SNDBUF_MEMORY_BUFFER
+        mb_buffer = MultiBuffer< SAMPLE >();
+#endif /* CK_SNDBUF_MEMORY_BUFFER */
+        
+        loop = FALSE;
+        fd = NULL;
+    }
+
+    ~sndbuf_data()
+    {
+        close();
+    }
+
+    // release whatever is loaded
+    void close()
+    {
+        // streamer frees chunk_map along with the rest of the stream
+        if( stream )
+        {
+            CK_STREAM_SET( &stream->closed, 1 );
+            SndBufStreamer::notify();
+            stream = NULL;
+            chunk_map = NULL;
+            chunk_num = 0;
+        }
+
+#ifndef __PLATFORM_WIN32__
+        // buffer points into the mapping
+        if( mmap_base )
+        {
+            munmap( mmap_base, mmap_size );
+            mmap_base = NULL;
+            mmap_size = 0;
+            buffer = NULL;
+        }
+#endif
+
+        // buffer belongs to the cache
+        if( cached )
+        {
+            SampleCache::release( cached );
+            cached = NULL;
+            buffer = NULL;
+        }
+
+        SAFE_DELETE_ARRAY( buffer );
+        
+        if( chunk_map )
+        {
+            for(int i = 0; i < chunk_num; i++)
+                SAFE_DELETE_ARRAY(chunk_map[i]);
+            SAFE_DELETE_ARRAY(chunk_map);
+            chunk_num = 0;
+        }
+
+        if( fd )
+        {
+            sf_close( fd );
+            fd = NULL;
+        }
+    }
+    
+    inline void sampleIndex2FrameIndexAndChannel(t_CKINT sample, t_CKINT *frame, t_CKINT *channel)
+    {
+        *frame = (t_CKINT) floorf(sample/this->num_channels);
+        *channel = sample%this->num_channels;
+    }
+};
+
+
+double sndbuf_sinc( sndbuf_data * d, double x );
+double sndbuf_t_sinc( sndbuf_data * d, double x );
+void   sndbuf_make_sinc( sndbuf_data * d );
+void   sndbuf_sinc_interpolate( sndbuf_data * d, SAMPLE * out );
+
+CK_DLL_CTOR( sndbuf_ctor )
+{
+    OBJ_MEMBER_UINT(SELF, sndbuf_offset_data) = (t_CKUINT)new sndbuf_data;
 
-CK_DLL_DTOR( sndbuf_dtor )
-{
-    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
-    SAFE_DELETE(d);
-    OBJ_MEMBER_UINT(SELF, sndbuf_offset_data) = 0;
+}
+
+CK_DLL_DTOR( sndbuf_dtor )
+{
+    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
+    SAFE_DELETE(d);
+    OBJ_MEMBER_UINT(SELF, sndbuf_offset_data) = 0;
 }
 
 inline t_CKUINT sndbuf_read( sndbuf_data * d, t_CKUINT frame, t_CKUINT num_frames )
@@ -2634,6 +3510,92 @@ inline t_CKINT sndbuf_load( sndbuf_data * d, t_CKUINT sample )
     return ret;
 }
 
+//-----------------------------------------------------------------------------
+// name: sndbuf_fetch()
+// desc: sample at interleaved index; 0 if a streamed chunk isn't in yet
+//-----------------------------------------------------------------------------
+inline SAMPLE sndbuf_fetch( sndbuf_data * d, t_CKUINT index )
+{
+    if( d->buffer ) return d->buffer[index];
+    SAMPLE * chunk = d->chunk_map[index/d->chunks];
+    return chunk ? chunk[index%d->chunks] : 0;
+}
+
+//-----------------------------------------------------------------------------
+// name: sndbuf_stream_request()
+// desc: ask the streamer for a bin, if it isn't already in or on its way
+//-----------------------------------------------------------------------------
+inline t_CKBOOL sndbuf_stream_request( SndBufStream * s, t_CKUINT bin )
+{
+    if( s->state[bin] != SNDBUF_CHUNK_ABSENT || !s->requests->put( bin ) )
+        return FALSE;
+    s->state[bin] = SNDBUF_CHUNK_REQUESTED;
+    return TRUE;
+}
+
+//-----------------------------------------------------------------------------
+// name: sndbuf_stream_update()
+// desc: (audio thread) take in loaded chunks, prefetch ahead of the play
+//       head in the direction of playback, and evict down to the budget
+//-----------------------------------------------------------------------------
+void sndbuf_stream_update( sndbuf_data * d, t_CKUINT index )
+{
+    SndBufStream * s = d->stream;
+    t_CKINT num = (t_CKINT)s->chunk_num;
+    // anything new for the streamer?
+    t_CKBOOL wake = FALSE;
+
+    // take in loaded chunks
+    SndBufChunk c;
+    while( s->loaded->get( c ) )
+    {
+        s->chunk_map[c.bin] = c.data;
+        s->state[c.bin] = SNDBUF_CHUNK_RESIDENT;
+        s->resident.push_back( c.bin );
+    }
+
+    t_CKINT bin = index / s->chunks;
+    t_CKINT dir = d->rate < 0 ? -1 : 1;
+    if( bin != (t_CKINT)s->last_bin )
+    {
+        s->last_bin = bin;
+        if( s->state[bin] != SNDBUF_CHUNK_RESIDENT ) s->underruns++;
+
+        // current and next few, wrapping if looping
+        for( t_CKINT i = 0; i <= CK_SNDBUF_STREAM_AHEAD; i++ )
+        {
+            t_CKINT b = bin + dir * i;
+            if( d->loop ) b = ( b % num + num ) % num;
+            else if( b < 0 || b >= num ) break;
+            if( sndbuf_stream_request( s, b ) ) wake = TRUE;
+        }
+    }
+
+    // evict the chunk we'll need latest
+    while( s->resident.size() > s->cache )
+    {
+        size_t victim = 0;
+        t_CKINT farthest = -1;
+        for( size_t i = 0; i < s->resident.size(); i++ )
+        {
+            t_CKINT dist = ( (t_CKINT)s->resident[i] - bin ) * dir;
+            // behind the play head: last in line (looping) or never (not)
+            if( dist < 0 ) dist = d->loop ? dist + num : num - dist;
+            if( dist > farthest ) { farthest = dist; victim = i; }
+        }
+        t_CKUINT b = s->resident[victim];
+        // can't free from here; streamer thread will
+        if( !s->dead->put( s->chunk_map[b] ) ) break;
+        s->chunk_map[b] = NULL;
+        s->state[b] = SNDBUF_CHUNK_ABSENT;
+        s->resident[victim] = s->resident.back();
+        s->resident.pop_back();
+        wake = TRUE;
+    }
+
+    if( wake ) SndBufStreamer::notify();
+}
+
 inline void sndbuf_setpos( sndbuf_data *d, double frame_pos )
 {
     if( !(d->buffer || d->chunk_map) ) return;
@@ -2660,13 +3622,12 @@ inline void sndbuf_setpos( sndbuf_data *d, double frame_pos )
     t_CKUINT index = d->chan + ((t_CKINT)d->curf) * d->num_channels;
     // ensure load
     if( d->fd != NULL ) sndbuf_load( d, index );
+    // keep the streamer ahead of us
+    if( d->stream ) sndbuf_stream_update( d, index );
     
     // sets curr to correct position ( account for channels )
 //    t_CKUINT index = d->chan + i * d->num_channels;
-    if(d->buffer)
-        d->current_val = d->buffer[index];
-    else
-        d->current_val = d->chunk_map[index/d->chunks][index%d->chunks];
+    d->current_val = sndbuf_fetch( d, index );
 }
 
 inline SAMPLE sndbuf_sampleAt( sndbuf_data * d, t_CKINT frame_pos, t_CKINT arg_chan = -1 )
@@ -2695,10 +3656,7 @@ inline SAMPLE sndbuf_sampleAt( sndbuf_data * d, t_CKINT frame_pos, t_CKINT arg_c
     if( d->fd != NULL ) sndbuf_load( d, index );
     
     // return sample
-    if(d->buffer != NULL)
-        return d->buffer[index];
-    else
-        return d->chunk_map[index/d->chunks][index%d->chunks];
+    return sndbuf_fetch( d, index );
 }
 
 inline double sndbuf_getpos( sndbuf_data * d )
@@ -2984,6 +3942,70 @@ CK_DLL_TICKF( sndbuf_tickf )
 #include "util_raw.h"
 
 
+//-----------------------------------------------------------------------------
+// name: sndbuf_mmap()
+// desc: map a 32-bit float wav file and point buffer at its sample data;
+//       returns FALSE (and leaves d alone) for anything else
+//-----------------------------------------------------------------------------
+static t_CKBOOL sndbuf_mmap( sndbuf_data * d, const char * filename, SF_INFO * info )
+{
+#if defined(__PLATFORM_WIN32__) || defined(__CHUCK_USE_64_BIT_SAMPLE__)
+    return FALSE;
+#else
+    // samples must be usable in place: float, little endian
+    t_CKINT major = info->format & SF_FORMAT_TYPEMASK;
+    short one = 1;
+    if( ( major != SF_FORMAT_WAV && major != SF_FORMAT_WAVEX ) ||
+        ( info->format & SF_FORMAT_SUBMASK ) != SF_FORMAT_FLOAT ||
+        *(char *)&one != 1 )
+    {
+        EM_log( CK_LOG_INFO, "(sndbuf): not a float wav file, loading instead of mapping" );
+        return FALSE;
+    }
+
+    int fdes = open( filename, O_RDONLY );
+    if( fdes < 0 ) return FALSE;
+    struct stat st;
+    if( fstat( fdes, &st ) || st.st_size < 12 ) { ::close( fdes ); return FALSE; }
+    size_t len = st.st_size;
+    void * base = mmap( NULL, len, PROT_READ, MAP_PRIVATE, fdes, 0 );
+    ::close( fdes );
+    if( base == MAP_FAILED ) return FALSE;
+
+    // walk the RIFF chunks for 'data'
+    const t_CKBYTE * bytes = (const t_CKBYTE *)base;
+    size_t offset = 12, data_offset = 0, data_size = 0;
+    while( offset + 8 <= len )
+    {
+        size_t chunk_size = bytes[offset+4] | (bytes[offset+5] << 8) |
+                            (bytes[offset+6] << 16) | ((size_t)bytes[offset+7] << 24);
+        if( memcmp( bytes + offset, "data", 4 ) == 0 )
+        {
+            data_offset = offset + 8;
+            data_size = ck_min( chunk_size, len - data_offset );
+            break;
+        }
+        // chunks are padded to even length
+        offset += 8 + chunk_size + ( chunk_size & 1 );
+    }
+
+    // need aligned floats
+    if( memcmp( bytes, "RIFF", 4 ) || !data_offset || data_offset % sizeof(SAMPLE) )
+    {
+        munmap( base, len );
+        return FALSE;
+    }
+
+    d->mmap_base = base;
+    d->mmap_size = len;
+    d->buffer = (SAMPLE *)( bytes + data_offset );
+    info->frames = ck_min( (size_t)info->frames, data_size / ( sizeof(SAMPLE) * info->channels ) );
+
+    EM_log( CK_LOG_INFO, "(sndbuf): mapped %d bytes", len );
+    return TRUE;
+#endif
+}
+
 CK_DLL_CTRL( sndbuf_ctrl_read )
 {
     sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
@@ -2993,21 +4015,8 @@ CK_DLL_CTRL( sndbuf_ctrl_read )
     // return filename
     RETURN->v_string = ckfilename;
     
-    SAFE_DELETE_ARRAY(d->buffer);
-    
-    if( d->chunk_map )
-    {
-        for(int i = 0; i < d->chunk_num; i++)
-            SAFE_DELETE_ARRAY(d->chunk_map[i]);
-        SAFE_DELETE_ARRAY(d->chunk_map);
-        d->chunk_num = 0;
-    }
-    
-    if( d->fd )
-    {
-        sf_close( d->fd );
-        d->fd = NULL;
-    }
+    // release previous file
+    d->close();
 
     // log
     EM_log( CK_LOG_INFO, "(sndbuf): reading '%s'...", filename );
@@ -3123,6 +4132,19 @@ CK_DLL_CTRL( sndbuf_ctrl_read )
 
         d->buffer[rawsize] = d->buffer[0];
     }
+    else if( d->cache_mode && !d->stream_mode && !d->mmap_mode &&
+             ( d->cached = SampleCache::acquire( filename, -1 ) ) )
+    {
+        // shared, already decoded
+        d->buffer = d->cached->data;
+        d->chunk_map = NULL;
+        d->chunks_read = d->cached->frames * d->cached->channels;
+        d->chan = 0;
+        d->num_frames = d->cached->frames;
+        d->num_channels = d->cached->channels;
+        d->samplerate = d->cached->samplerate;
+        d->num_samples = d->num_frames * d->num_channels;
+    }
     else // read file
     {
         // stat the file first
@@ -3153,13 +4175,40 @@ CK_DLL_CTRL( sndbuf_ctrl_read )
             CK_FPRINTF_STDERR( "[chuck](via SndBuf): sndfile error '%li' opening '%s'...\n", er, filename );
             CK_FPRINTF_STDERR( "[chuck](via SndBuf): (reason: %s)\n", sf_strerror( d->fd ) );
             if( d->fd ) sf_close( d->fd );
+            d->fd = NULL;
             // escape
             return;
         }
 
         // allocate
         t_CKINT size = info.channels * info.frames;
-        if(d->chunks)
+        if( d->mmap_mode && sndbuf_mmap( d, filename, &info ) )
+        {
+            // buffer points into the mapped file; nothing to read
+            sf_close( d->fd );
+            d->fd = NULL;
+            d->chunk_map = NULL;
+        }
+        else if( d->stream_mode )
+        {
+            // chunks must hold whole frames
+            t_CKUINT chunks = d->chunks ? d->chunks : CK_SNDBUF_DEFAULT_CHUNK_SIZE;
+            chunks = ck_max( chunks - chunks % info.channels, (t_CKUINT)info.channels );
+            d->chunks = chunks;
+            d->chunk_num = ( size + chunks - 1 ) / chunks;
+            d->stream = new SndBufStream( d->fd, chunks, d->chunk_num, info.channels,
+                                          ck_max( d->stream_cache, (t_CKUINT)CK_SNDBUF_STREAM_AHEAD + 1 ) );
+            // the stream owns the file from here on
+            d->fd = NULL;
+            d->buffer = NULL;
+            d->chunk_map = d->stream->chunk_map;
+            // first chunk now, so playback starts clean
+            d->stream->chunk_map[0] = d->stream->read_chunk( 0 );
+            d->stream->state[0] = SNDBUF_CHUNK_RESIDENT;
+            d->stream->resident.push_back( 0 );
+            SndBufStreamer::shared()->add( d->stream );
+        }
+        else if(d->chunks)
         {
             // split into small allocations
             d->chunk_num = ceilf(((t_CKFLOAT) size) / ((t_CKFLOAT) d->chunks));
@@ -3191,10 +4240,10 @@ CK_DLL_CTRL( sndbuf_ctrl_read )
         EM_poplog();
 
         // read
-        sf_seek( d->fd, 0, SEEK_SET );
+        if( d->fd ) sf_seek( d->fd, 0, SEEK_SET );
 
         // no chunk
-        if( !d->chunks )
+        if( d->fd && !d->chunks )
         {
             // read all
             t_CKUINT f = sndbuf_read( d, 0, d->num_frames );
@@ -3218,6 +4267,8 @@ CK_DLL_CTRL( sndbuf_ctrl_read )
     d->current_val = 0;
     d->curf = 0;
     d->eob = d->buffer + d->num_samples;
+    // start prefetching
+    if( d->stream ) sndbuf_setpos( d, 0 );
 }
 
 CK_DLL_CTRL( sndbuf_ctrl_write )
@@ -3321,38 +4372,130 @@ CK_DLL_CTRL( sndbuf_ctrl_pos )
     RETURN->v_int = (t_CKINT)sndbuf_getpos(d); // TODO TODO TODOOO
 }
 
-CK_DLL_CGET( sndbuf_cget_pos )
+CK_DLL_CGET( sndbuf_cget_pos )
+{
+    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
+    RETURN->v_int = (t_CKINT)sndbuf_getpos(d); 
+}
+
+CK_DLL_CTRL( sndbuf_ctrl_interp )
+{ 
+    sndbuf_data * d = ( sndbuf_data * ) OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
+    t_CKINT interp = GET_CK_INT(ARGS);
+    d->interp = interp;
+    RETURN->v_int = d->interp;
+}
+
+CK_DLL_CGET( sndbuf_cget_interp )
+{
+    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
+    RETURN->v_int = d->interp;
+}
+
+CK_DLL_CTRL( sndbuf_ctrl_chunks )
+{
+    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
+    t_CKINT frames = GET_NEXT_INT(ARGS);
+    d->chunks = frames >= 0 ? frames : 0;
+    RETURN->v_int = d->chunks;
+}
+
+CK_DLL_CGET( sndbuf_cget_chunks )
+{
+    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
+    RETURN->v_int = d->chunks;
+}
+
+CK_DLL_CTRL( sndbuf_ctrl_stream )
+{
+    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
+    d->stream_mode = GET_NEXT_INT(ARGS) != 0;
+    RETURN->v_int = d->stream_mode;
+}
+
+CK_DLL_CGET( sndbuf_cget_stream )
+{
+    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
+    RETURN->v_int = d->stream_mode;
+}
+
+CK_DLL_CTRL( sndbuf_ctrl_streamCache )
+{
+    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
+    t_CKINT chunks = GET_NEXT_INT(ARGS);
+    // room for the current chunk plus what's prefetched
+    d->stream_cache = ck_max( chunks, CK_SNDBUF_STREAM_AHEAD + 1 );
+    if( d->stream ) d->stream->cache = d->stream_cache;
+    RETURN->v_int = d->stream_cache;
+}
+
+CK_DLL_CGET( sndbuf_cget_streamCache )
+{
+    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
+    RETURN->v_int = d->stream_cache;
+}
+
+CK_DLL_CGET( sndbuf_cget_streamUnderruns )
+{
+    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
+    RETURN->v_int = d->stream ? d->stream->underruns : 0;
+}
+
+CK_DLL_CTRL( sndbuf_ctrl_cache )
+{
+    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
+    d->cache_mode = GET_NEXT_INT(ARGS) != 0;
+    RETURN->v_int = d->cache_mode;
+}
+
+CK_DLL_CGET( sndbuf_cget_cache )
+{
+    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
+    RETURN->v_int = d->cache_mode;
+}
+
+CK_DLL_SFUN( sndbuf_cache_hits )
+{
+    RETURN->v_int = SampleCache::hits();
+}
+
+CK_DLL_SFUN( sndbuf_cache_misses )
 {
-    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
-    RETURN->v_int = (t_CKINT)sndbuf_getpos(d); 
+    RETURN->v_int = SampleCache::misses();
 }
 
-CK_DLL_CTRL( sndbuf_ctrl_interp )
-{ 
-    sndbuf_data * d = ( sndbuf_data * ) OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
-    t_CKINT interp = GET_CK_INT(ARGS);
-    d->interp = interp;
-    RETURN->v_int = d->interp;
+CK_DLL_SFUN( sndbuf_cache_evictions )
+{
+    RETURN->v_int = SampleCache::evictions();
 }
 
-CK_DLL_CGET( sndbuf_cget_interp )
+CK_DLL_SFUN( sndbuf_cache_bytes )
 {
-    sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
-    RETURN->v_int = d->interp;
+    RETURN->v_int = SampleCache::bytes();
 }
 
-CK_DLL_CTRL( sndbuf_ctrl_chunks )
+CK_DLL_SFUN( sndbuf_cache_set_budget )
+{
+    SampleCache::setBudget( GET_NEXT_INT(ARGS) );
+    RETURN->v_int = SampleCache::budget();
+}
+
+CK_DLL_SFUN( sndbuf_cache_get_budget )
+{
+    RETURN->v_int = SampleCache::budget();
+}
+
+CK_DLL_CTRL( sndbuf_ctrl_mmap )
 {
     sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
-    t_CKINT frames = GET_NEXT_INT(ARGS);
-    d->chunks = frames >= 0 ? frames : 0;
-    RETURN->v_int = d->chunks;
+    d->mmap_mode = GET_NEXT_INT(ARGS) != 0;
+    RETURN->v_int = d->mmap_mode;
 }
 
-CK_DLL_CGET( sndbuf_cget_chunks )
+CK_DLL_CGET( sndbuf_cget_mmap )
 {
     sndbuf_data * d = (sndbuf_data *)OBJ_MEMBER_UINT(SELF, sndbuf_offset_data);
-    RETURN->v_int = d->chunks;
+    RETURN->v_int = d->mmap_mode;
 }
 
 CK_DLL_CTRL( sndbuf_ctrl_phase_offset )
@@ -3393,6 +4536,366 @@ CK_DLL_CGET( sndbuf_cget_valueAt )
     RETURN->v_float = ( frame > d->num_frames || frame < 0 ) ? 0 : sndbuf_sampleAt(d, frame, channel);
 }
 
+
+
+
+//-----------------------------------------------------------------------------
+// name: Convolver
+// desc: uniformly partitioned overlap-save FFT convolution
+//
+// the impulse response is cut into partitions of 'block' samples, each
+// transformed (zero-padded to 2*block) once up front.  input spectra go into
+// a frequency-domain delay line (fdl); every block the output spectrum is the
+// sum over k of ir[k] * fdl[n-k].  only the k = 0 term depends on the block
+// that just finished, so the k >= 1 terms are accumulated a few at a time
+// while the current block is being ticked, to avoid a CPU spike every
+// 'block' samples.  latency is exactly one block.
+//-----------------------------------------------------------------------------
+#define CK_CONVOLVER_DEFAULT_BLOCK_SIZE (128)
+#define CK_CONVOLVER_MAX_BLOCK_SIZE (16384)
+
+struct Convolver_Data
+{
+    // impulse response (time domain, kept so block size can change)
+    std::vector<SAMPLE> ir;
+    // channel to take from multichannel files
+    t_CKUINT chan;
+
+    // partition size (and latency)
+    t_CKUINT block;
+    // number of partitions
+    t_CKUINT num_parts;
+    // partition spectra, num_parts * 2*block (rfft packing)
+    SAMPLE * ir_spec;
+    // input spectra, num_parts * 2*block
+    SAMPLE * fdl;
+    // slot in fdl of the most recent input spectrum
+    t_CKUINT fdl_pos;
+    // output spectrum accumulator for the next block
+    SAMPLE * accum;
+    // next partition to accumulate into accum
+    t_CKUINT accum_next;
+    // last two blocks of input
+    SAMPLE * in_buf;
+    // output block being played
+    SAMPLE * out_buf;
+    // fft work buffer
+    SAMPLE * scratch;
+    // position within current block
+    t_CKUINT pos;
+
+    Convolver_Data()
+    {
+        chan = 0;
+        block = CK_CONVOLVER_DEFAULT_BLOCK_SIZE;
+        num_parts = 0;
+        ir_spec = NULL;
+        fdl = NULL;
+        fdl_pos = 0;
+        accum = NULL;
+        accum_next = 1;
+        in_buf = NULL;
+        out_buf = NULL;
+        scratch = NULL;
+        pos = 0;
+    }
+
+    ~Convolver_Data()
+    {
+        cleanup();
+    }
+
+    void cleanup()
+    {
+        SAFE_DELETE_ARRAY( ir_spec );
+        SAFE_DELETE_ARRAY( fdl );
+        SAFE_DELETE_ARRAY( accum );
+        SAFE_DELETE_ARRAY( in_buf );
+        SAFE_DELETE_ARRAY( out_buf );
+        SAFE_DELETE_ARRAY( scratch );
+        num_parts = 0;
+    }
+
+    // (re)build partition spectra and state from ir
+    void prepare()
+    {
+        cleanup();
+        pos = 0;
+        fdl_pos = 0;
+        accum_next = 1;
+        if( ir.size() == 0 ) return;
+
+        t_CKUINT N = 2 * block;
+        num_parts = ( ir.size() + block - 1 ) / block;
+        ir_spec = new SAMPLE[num_parts * N];
+        fdl = new SAMPLE[num_parts * N];
+        accum = new SAMPLE[N];
+        in_buf = new SAMPLE[N];
+        out_buf = new SAMPLE[block];
+        scratch = new SAMPLE[N];
+        memset( fdl, 0, num_parts * N * sizeof(SAMPLE) );
+        memset( accum, 0, N * sizeof(SAMPLE) );
+        memset( in_buf, 0, N * sizeof(SAMPLE) );
+        memset( out_buf, 0, block * sizeof(SAMPLE) );
+
+        // rfft scales forward by 1/N and inverse not at all; a product of
+        // two forward spectra is thus N too small, fold that into the ir
+        for( t_CKUINT p = 0; p < num_parts; p++ )
+        {
+            SAMPLE * spec = ir_spec + p * N;
+            t_CKUINT offset = p * block;
+            t_CKUINT len = ck_min( block, ir.size() - offset );
+            memset( spec, 0, N * sizeof(SAMPLE) );
+            for( t_CKUINT i = 0; i < len; i++ )
+                spec[i] = ir[offset + i] * (SAMPLE)N;
+            rfft( spec, block, FFT_FORWARD );
+        }
+    }
+
+    void clear()
+    {
+        if( !num_parts ) return;
+        t_CKUINT N = 2 * block;
+        memset( fdl, 0, num_parts * N * sizeof(SAMPLE) );
+        memset( accum, 0, N * sizeof(SAMPLE) );
+        memset( in_buf, 0, N * sizeof(SAMPLE) );
+        memset( out_buf, 0, block * sizeof(SAMPLE) );
+        accum_next = 1;
+    }
+
+    // complex multiply-accumulate of packed rfft spectra
+    inline void mac( SAMPLE * acc, const SAMPLE * a, const SAMPLE * b )
+    {
+        // DC and nyquist are both real, packed in the first bin
+        acc[0] += a[0] * b[0];
+        acc[1] += a[1] * b[1];
+        for( t_CKUINT i = 2; i < 2 * block; i += 2 )
+        {
+            acc[i]   += a[i] * b[i]   - a[i+1] * b[i+1];
+            acc[i+1] += a[i] * b[i+1] + a[i+1] * b[i];
+        }
+    }
+
+    // accumulate older partitions up to (not including) 'target'
+    inline void accumulate( t_CKUINT target )
+    {
+        t_CKUINT N = 2 * block;
+        while( accum_next < target )
+        {
+            // fdl_pos holds the previous block; partition k pairs with k-1 blocks before that
+            t_CKUINT slot = ( fdl_pos + accum_next - 1 ) % num_parts;
+            mac( accum, ir_spec + accum_next * N, fdl + slot * N );
+            accum_next++;
+        }
+    }
+
+    // end of block: transform input, add partition 0, produce next output
+    void process()
+    {
+        t_CKUINT N = 2 * block;
+        // make sure all older partitions are in
+        accumulate( num_parts );
+
+        // newest input spectrum replaces the oldest
+        fdl_pos = ( fdl_pos + num_parts - 1 ) % num_parts;
+        SAMPLE * X = fdl + fdl_pos * N;
+        memcpy( X, in_buf, N * sizeof(SAMPLE) );
+        rfft( X, block, FFT_FORWARD );
+        mac( accum, ir_spec, X );
+
+        // back to time domain; second half is the valid (non-aliased) part
+        memcpy( scratch, accum, N * sizeof(SAMPLE) );
+        rfft( scratch, block, FFT_INVERSE );
+        memcpy( out_buf, scratch + block, block * sizeof(SAMPLE) );
+
+        // slide input, reset accumulator
+        memcpy( in_buf, in_buf + block, block * sizeof(SAMPLE) );
+        memset( accum, 0, N * sizeof(SAMPLE) );
+        accum_next = 1;
+        pos = 0;
+    }
+
+    inline SAMPLE tick( SAMPLE in )
+    {
+        if( !num_parts ) return 0;
+
+        in_buf[block + pos] = in;
+        SAMPLE out = out_buf[pos];
+        pos++;
+
+        // spread the older partitions evenly over the block
+        if( num_parts > 1 )
+            accumulate( 1 + ( num_parts - 1 ) * pos / block );
+
+        if( pos == block ) process();
+
+        return out;
+    }
+};
+
+
+CK_DLL_CTOR( convolver_ctor )
+{
+    OBJ_MEMBER_UINT(SELF, convolver_offset_data) = (t_CKUINT)new Convolver_Data;
+}
+
+CK_DLL_DTOR( convolver_dtor )
+{
+    Convolver_Data * d = (Convolver_Data *)OBJ_MEMBER_UINT(SELF, convolver_offset_data);
+    SAFE_DELETE(d);
+    OBJ_MEMBER_UINT(SELF, convolver_offset_data) = 0;
+}
+
+CK_DLL_TICK( convolver_tick )
+{
+    Convolver_Data * d = (Convolver_Data *)OBJ_MEMBER_UINT(SELF, convolver_offset_data);
+    *out = d->tick( in );
+    return TRUE;
+}
+
+CK_DLL_CTRL( convolver_ctrl_read )
+{
+    Convolver_Data * d = (Convolver_Data *)OBJ_MEMBER_UINT(SELF, convolver_offset_data);
+    Chuck_String * ckfilename = GET_CK_STRING(ARGS);
+    const char * filename = ckfilename->str().c_str();
+
+    // return filename
+    RETURN->v_string = ckfilename;
+
+    // log
+    EM_log( CK_LOG_INFO, "(Convolver): reading '%s'...", filename );
+
+    // open it
+    SF_INFO info;
+    info.format = 0;
+    SNDFILE * fd = sf_open( filename, SFM_READ, &info );
+    t_CKINT er = sf_error( fd );
+    if( er )
+    {
+        CK_FPRINTF_STDERR( "[chuck](via Convolver): sndfile error '%li' opening '%s'...\n", er, filename );
+        CK_FPRINTF_STDERR( "[chuck](via Convolver): (reason: %s)\n", sf_strerror( fd ) );
+        if( fd ) sf_close( fd );
+        return;
+    }
+
+    // read all frames (none: an empty impulse response)
+    t_CKUINT chans = info.channels;
+    std::vector<SAMPLE> frames( info.frames > 0 ? info.frames * chans : 0 );
+    t_CKUINT n = 0;
+    if( frames.size() )
+    {
+#if defined(__CHUCK_USE_64_BIT_SAMPLE__)
+        n = sf_readf_double( fd, &frames[0], info.frames );
+#else
+        n = sf_readf_float( fd, &frames[0], info.frames );
+#endif
+    }
+    sf_close( fd );
+
+    // pick channel
+    t_CKUINT chan = d->chan < chans ? d->chan : 0;
+    d->ir.resize( n );
+    for( t_CKUINT i = 0; i < n; i++ )
+        d->ir[i] = frames[i*chans + chan];
+
+    // log
+    EM_pushlog();
+    EM_log( CK_LOG_INFO, "channels: %d (using %d)", chans, chan );
+    EM_log( CK_LOG_INFO, "frames: %d", n );
+    EM_log( CK_LOG_INFO, "srate: %d", info.samplerate );
+    EM_poplog();
+
+    d->prepare();
+}
+
+CK_DLL_CTRL( convolver_ctrl_ir )
+{
+    Convolver_Data * d = (Convolver_Data *)OBJ_MEMBER_UINT(SELF, convolver_offset_data);
+    Chuck_Array8 * arr = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+
+    // return it through
+    RETURN->v_object = arr;
+
+    d->ir.clear();
+    if( arr )
+    {
+        t_CKFLOAT v = 0;
+        d->ir.resize( arr->size() );
+        for( t_CKINT i = 0; i < arr->size(); i++ )
+        {
+            arr->get( i, &v );
+            d->ir[i] = (SAMPLE)v;
+        }
+    }
+
+    d->prepare();
+}
+
+CK_DLL_CTRL( convolver_ctrl_channel )
+{
+    Convolver_Data * d = (Convolver_Data *)OBJ_MEMBER_UINT(SELF, convolver_offset_data);
+    t_CKINT chan = GET_CK_INT(ARGS);
+    if( chan >= 0 ) d->chan = chan;
+    RETURN->v_int = (t_CKINT)d->chan;
+}
+
+CK_DLL_CGET( convolver_cget_channel )
+{
+    Convolver_Data * d = (Convolver_Data *)OBJ_MEMBER_UINT(SELF, convolver_offset_data);
+    RETURN->v_int = (t_CKINT)d->chan;
+}
+
+CK_DLL_CTRL( convolver_ctrl_blockSize )
+{
+    Convolver_Data * d = (Convolver_Data *)OBJ_MEMBER_UINT(SELF, convolver_offset_data);
+    t_CKINT frames = GET_CK_INT(ARGS);
+    // ignore non-positive sizes
+    if( frames <= 0 )
+    {
+        RETURN->v_int = (t_CKINT)d->block;
+        return;
+    }
+    // power of two, at least 2 (rfft needs an even number of complex points)
+    t_CKUINT block = 2;
+    while( block < (t_CKUINT)frames && block < CK_CONVOLVER_MAX_BLOCK_SIZE ) block <<= 1;
+    if( block != d->block )
+    {
+        d->block = block;
+        d->prepare();
+    }
+    RETURN->v_int = (t_CKINT)d->block;
+}
+
+CK_DLL_CGET( convolver_cget_blockSize )
+{
+    Convolver_Data * d = (Convolver_Data *)OBJ_MEMBER_UINT(SELF, convolver_offset_data);
+    RETURN->v_int = (t_CKINT)d->block;
+}
+
+CK_DLL_CGET( convolver_cget_partitions )
+{
+    Convolver_Data * d = (Convolver_Data *)OBJ_MEMBER_UINT(SELF, convolver_offset_data);
+    RETURN->v_int = (t_CKINT)d->num_parts;
+}
+
+CK_DLL_CGET( convolver_cget_samples )
+{
+    Convolver_Data * d = (Convolver_Data *)OBJ_MEMBER_UINT(SELF, convolver_offset_data);
+    RETURN->v_int = (t_CKINT)d->ir.size();
+}
+
+CK_DLL_CGET( convolver_cget_length )
+{
+    Convolver_Data * d = (Convolver_Data *)OBJ_MEMBER_UINT(SELF, convolver_offset_data);
+    RETURN->v_dur = (t_CKDUR)d->ir.size();
+}
+
+CK_DLL_CTRL( convolver_ctrl_clear )
+{
+    Convolver_Data * d = (Convolver_Data *)OBJ_MEMBER_UINT(SELF, convolver_offset_data);
+    d->clear();
+}
+
 #endif // __DISABLE_SNDBUF__
 
 
@@ -3698,7 +5201,8 @@ LiSa updates/fixes:
 4. corrected loopEnd so it is the same as duration, not 1 less than duration, when set...
 */
 
-#define LiSa_MAXVOICES 200
+#define LiSa_MAXVOICES 4096
+#define LiSa_DEFAULTVOICES 200 // voice storage allocated up front; grows with maxVoices
 #define LiSa_MAXBUFSIZE 44100000
 //-----------------------------------------------------------------------------
 // name: LiSaMulti_data
@@ -3710,28 +5214,177 @@ struct LiSaMulti_data
 	SAMPLE * outsamples; //samples by channel to send out
     t_CKINT mdata_len;
     t_CKINT maxvoices;
-    t_CKINT loop_start[LiSa_MAXVOICES], loop_end[LiSa_MAXVOICES], loop_end_rec;
+    t_CKINT voice_capacity; // size of the per-voice arrays below
+    t_CKINT * loop_start, * loop_end, loop_end_rec;
     t_CKINT rindex; // record and play indices
-    t_CKBOOL record, looprec, loopplay[LiSa_MAXVOICES], reset, append, play[LiSa_MAXVOICES], bi[LiSa_MAXVOICES];
+    t_CKBOOL record, looprec, * loopplay, reset, append, * play, * bi;
     t_CKFLOAT coeff; // feedback coeff
-	t_CKFLOAT voiceGain[LiSa_MAXVOICES]; //gain control for each voice
-	t_CKFLOAT voicePan[LiSa_MAXVOICES];  //pan control for each voice; places voice between any pair of channels.
-	t_CKFLOAT channelGain[LiSa_MAXVOICES][LiSa_channels]; 
-    t_CKDOUBLE p_inc[LiSa_MAXVOICES], pindex[LiSa_MAXVOICES]; // playback increment
+	t_CKFLOAT * voiceGain; //gain control for each voice
+	t_CKFLOAT * voicePan;  //pan control for each voice; places voice between any pair of channels.
+	t_CKFLOAT (* channelGain)[LiSa_channels];
+    t_CKDOUBLE * p_inc, * pindex; // playback increment
     
     // ramp stuff
-    t_CKDOUBLE rampup_len[LiSa_MAXVOICES], rampdown_len[LiSa_MAXVOICES], rec_ramplen, rec_ramplen_inv;
-    t_CKDOUBLE rampup_len_inv[LiSa_MAXVOICES], rampdown_len_inv[LiSa_MAXVOICES];
-    t_CKDOUBLE rampctr[LiSa_MAXVOICES];
-    t_CKBOOL rampup[LiSa_MAXVOICES], rampdown[LiSa_MAXVOICES];
+    t_CKDOUBLE * rampup_len, * rampdown_len, rec_ramplen, rec_ramplen_inv;
+    t_CKDOUBLE * rampup_len_inv, * rampdown_len_inv;
+    t_CKDOUBLE * rampctr;
+    t_CKBOOL * rampup, * rampdown;
+
+    // compact list of playing voices, so silent voices cost nothing per sample
+    t_CKINT * active;      // voice numbers
+    t_CKINT * active_slot; // position of each voice in active[], -1 if not playing
+    t_CKINT num_active;
     
     t_CKINT track;
 	
 	t_CKINT num_chans;
 
+    // mdata is shared through SampleCache until written to
+    SampleCacheEntry * cached;
+
+    LiSaMulti_data()
+    {
+        mdata = NULL;
+        outsamples = NULL;
+        mdata_len = 0;
+        maxvoices = 0;
+        voice_capacity = 0;
+        loop_start = loop_end = NULL;
+        loop_end_rec = 0;
+        rindex = 0;
+        record = looprec = reset = append = FALSE;
+        loopplay = play = bi = NULL;
+        coeff = 0;
+        voiceGain = voicePan = NULL;
+        channelGain = NULL;
+        p_inc = pindex = NULL;
+        rampup_len = rampdown_len = NULL;
+        rec_ramplen = rec_ramplen_inv = 0;
+        rampup_len_inv = rampdown_len_inv = NULL;
+        rampctr = NULL;
+        rampup = rampdown = NULL;
+        active = active_slot = NULL;
+        num_active = 0;
+        track = 0;
+        num_chans = 0;
+        cached = NULL;
+    }
+
+    ~LiSaMulti_data()
+    {
+        buffer_free();
+        voices_free();
+    }
+
+    // resize one per-voice array from voice_capacity to n entries, zero-filled
+    template <typename T>
+    inline bool grow(T * & arr, t_CKINT n)
+    {
+        T * p = (T *)realloc(arr, n * sizeof(T));
+        if(!p) return false;
+        memset(p + voice_capacity, 0, (n - voice_capacity) * sizeof(T));
+        arr = p;
+        return true;
+    }
+
+    // grow per-voice storage to hold at least n voices
+    inline int voices_grow(t_CKINT n)
+    {
+        if(n <= voice_capacity) return true;
+
+        if( !grow(loop_start, n) || !grow(loop_end, n) ||
+            !grow(loopplay, n) || !grow(play, n) || !grow(bi, n) ||
+            !grow(voiceGain, n) || !grow(voicePan, n) || !grow(channelGain, n) ||
+            !grow(p_inc, n) || !grow(pindex, n) ||
+            !grow(rampup_len, n) || !grow(rampdown_len, n) ||
+            !grow(rampup_len_inv, n) || !grow(rampdown_len_inv, n) ||
+            !grow(rampctr, n) || !grow(rampup, n) || !grow(rampdown, n) ||
+            !grow(active, n) || !grow(active_slot, n) )
+        {
+            CK_FPRINTF_STDERR( "LiSa: unable to allocate memory for %ld voices!\n", n );
+            return false;
+        }
+
+        t_CKINT old = voice_capacity;
+        voice_capacity = n;
+        for(t_CKINT i = old; i < n; i++) {
+            active_slot[i] = -1;
+            voice_init(i);
+        }
+
+        return true;
+    }
+
+    inline void voices_free()
+    {
+        free(loop_start); free(loop_end);
+        free(loopplay); free(play); free(bi);
+        free(voiceGain); free(voicePan); free(channelGain);
+        free(p_inc); free(pindex);
+        free(rampup_len); free(rampdown_len);
+        free(rampup_len_inv); free(rampdown_len_inv);
+        free(rampctr); free(rampup); free(rampdown);
+        free(active); free(active_slot);
+        voice_capacity = num_active = 0;
+    }
+
+    // reset one voice to its defaults
+    inline void voice_init(t_CKINT i)
+    {
+        loop_start[i] = 0;
+        //loop_end[i] = length - 1; //no idea why i had this
+        loop_end[i] = mdata_len;
+
+        pindex[i] = 0;
+        set_play(i, false);
+        bi[i] = false;
+        loopplay[i] = true;
+        p_inc[i] = 1.;
+        voiceGain[i] = 1.;
+        voicePan[i] = 0.5;
+
+        // ramp stuff
+        rampup[i] = rampdown[i] = false;
+        rampup_len[i] = rampdown_len[i] = 0.;
+        rampup_len_inv[i] = rampdown_len_inv[i] = 1.;
+        rampctr[i] = 0.;
+
+        for(t_CKINT j=2; j<num_chans; j++) {
+            channelGain[i][j] = 1.;
+        }
+        channelGain[i][0] = 1.0;
+//      channelGain[i][0] = 0.707;
+//      channelGain[i][1] = 0.707;
+    }
+
+    // start/stop a voice, keeping the active list in step with play[]
+    inline void set_play(t_CKINT which, t_CKBOOL on)
+    {
+        play[which] = on;
+        if(on && active_slot[which] < 0) {
+            active_slot[which] = num_active;
+            active[num_active++] = which;
+        } else if(!on && active_slot[which] >= 0) {
+            t_CKINT last = active[--num_active];
+            active[active_slot[which]] = last;
+            active_slot[last] = active_slot[which];
+            active_slot[which] = -1;
+        }
+    }
+
+    // let go of mdata
+    inline void buffer_free()
+    {
+        if( cached ) SampleCache::release( cached );
+        else if( mdata ) free( mdata );
+        cached = NULL;
+        mdata = NULL;
+    }
+
     // allocate memory, length in samples
     inline int buffer_alloc(t_CKINT length)
     {
+        buffer_free();
         mdata = (SAMPLE *)malloc((length + 1) * sizeof(SAMPLE)); //extra sample for safety....
         if(!mdata)  {
             CK_FPRINTF_STDERR( "LiSaBasic: unable to allocate memory!\n" );
@@ -3739,7 +5392,41 @@ struct LiSaMulti_data
         }
         
         memset(mdata, 0, (length + 1) * sizeof(SAMPLE));
-            
+
+        return buffer_init(length);
+    }
+
+    // share one channel of a sound file as the buffer
+    inline int buffer_attach(const char * filename, t_CKINT chan)
+    {
+        SampleCacheEntry * e = SampleCache::acquire(filename, chan);
+        if(!e) {
+            CK_FPRINTF_STDERR( "LiSa: cannot read channel %ld of '%s'\n", chan, filename );
+            return false;
+        }
+
+        buffer_free();
+        cached = e;
+        mdata = e->data;
+
+        return buffer_init(e->frames);
+    }
+
+    // copy-on-write: take a private copy before changing a shared buffer
+    inline void buffer_own()
+    {
+        if(!cached) return;
+        SAMPLE * copy = (SAMPLE *)malloc((mdata_len + 1) * sizeof(SAMPLE));
+        if(!copy) return;
+        memcpy(copy, mdata, (mdata_len + 1) * sizeof(SAMPLE));
+        SampleCache::release(cached);
+        cached = NULL;
+        mdata = copy;
+    }
+
+    // reset state for a buffer of length samples
+    inline int buffer_init(t_CKINT length)
+    {
         mdata_len = length;
         maxvoices = 10; // default; user can set
         rec_ramplen = 0.;
@@ -3747,32 +5434,14 @@ struct LiSaMulti_data
         
         track = 0;
         
-        for (t_CKINT i=0; i < LiSa_MAXVOICES; i++) {
-            loop_start[i] = 0;
-            //loop_end[i] = length - 1; //no idea why i had this
-			loop_end[i] = length;
-			loop_end_rec = length;
-            
-            pindex[i] = rindex = 0;
-            play[i] = record = bi[i] = false;
-            looprec = loopplay[i] = true;
-            coeff = 0.;
-            p_inc[i] = 1.;
-			voiceGain[i] = 1.;
-			voicePan[i] = 0.5;
-            
-            // ramp stuff
-            rampup[i] = rampdown[i] = false;
-            rampup_len[i] = rampdown_len[i] = 0.;
-            rampup_len_inv[i] = rampdown_len_inv[i] = 1.;
-            rampctr[i] = 0.;
-			
-			for(t_CKINT j=2; j<num_chans; j++) {
-				channelGain[i][j] = 1.;
-			}
-			channelGain[i][0] = 1.0;
-//			channelGain[i][0] = 0.707;
-//			channelGain[i][1] = 0.707;
+        loop_end_rec = length;
+        rindex = 0;
+        record = false;
+        looprec = true;
+        coeff = 0.;
+
+        for (t_CKINT i=0; i < voice_capacity; i++) {
+            voice_init(i);
         }
         
         return true;
@@ -3833,7 +5502,7 @@ struct LiSaMulti_data
 			}
 
         } else if(pindex[which] >= mdata_len || pindex[which] < 0) { //should be >=, no?
-            play[which] = 0;
+            set_play(which, false);
             //CK_FPRINTF_STDERR( "turning voice %d off!\n", which );
             return (SAMPLE) 0.;
         }
@@ -3874,7 +5543,7 @@ struct LiSaMulti_data
             outsample *= (rampdown_len[which] - rampctr[which]++) * rampdown_len_inv[which];
             if(rampctr[which] >= rampdown_len[which]) {
                 rampdown[which] = false;
-                play[which] = false; 
+                set_play(which, false);
             }
         }
 		
@@ -3912,7 +5581,7 @@ struct LiSaMulti_data
         // CK_FPRINTF_STDERR( "ramping up voice %d", voicenum );
 
         rampup[voicenum] = true;
-        play[voicenum] = true;
+        set_play(voicenum, true);
         rampup_len[voicenum] = (t_CKDOUBLE)uptime;
         if(rampup_len[voicenum] > 0.) rampup_len_inv[voicenum] = 1./rampup_len[voicenum];
         else rampup_len[voicenum] = 1.;
@@ -3962,19 +5631,12 @@ struct LiSaMulti_data
         recordSamp(in);
 
         if(track==0) {
-            for (t_CKINT i=0; i<maxvoices; i++) {
-                if(play[i]) {
-					tempsample = getNextSamp(i);
-					for(t_CKINT j=0;j<num_chans;j++) {
-						//outsamples[j] += tempsample; //mono for now, testing...
-						outsamples[j] += tempsample * channelGain[i][j]; //channelGain should return gain for voice i in channel j
-					}
-				}
-            }
+            tick_block(outsamples, 1, num_chans);
         } else if(track==1) {
             if(in<0.) in = -in; 
-			for (t_CKINT i=0; i<maxvoices; i++) {
-				if(play[i]) {
+			for (t_CKINT k=num_active-1; k>=0; k--) {
+                t_CKINT i = active[k];
+				if(i < maxvoices) {
                     t_CKDOUBLE location = loop_start[i] + (t_CKDOUBLE)in * (loop_end[i] - loop_start[i]);
                     tempsample = getSamp(location, i);
                     
@@ -3998,8 +5660,110 @@ struct LiSaMulti_data
         return outsamples;
     }
     
+    // play a block of nframes with no recording or tracking: each active voice
+    // runs over the whole block in turn, mixing into interleaved out
+    inline void tick_block( SAMPLE * out, t_CKUINT nframes, t_CKUINT nchans )
+    {
+        memset( out, 0, nframes * nchans * sizeof(SAMPLE) );
+
+        for (t_CKINT k=num_active-1; k>=0; k--) {
+            t_CKINT i = active[k];
+            if(i >= maxvoices) continue;
+
+            if(bi[i]) {
+                // direction changes are rare; take the per-sample path
+                for(t_CKUINT f=0; f<nframes && play[i]; f++) {
+                    SAMPLE tempsample = getNextSamp(i);
+                    for(t_CKUINT j=0; j<nchans; j++)
+                        out[f*nchans+j] += tempsample * channelGain[i][j];
+                }
+            }
+            else render_voice(i, out, nframes, nchans);
+        }
+    }
+
+    // getNextSamp() over a block for one voice (not bidirectional), with the
+    // voice state kept in locals for the duration
+    inline void render_voice( t_CKINT which, SAMPLE * out, t_CKUINT nframes, t_CKUINT nchans )
+    {
+        const SAMPLE * buf = mdata;
+        const t_CKINT len = mdata_len;
+        const t_CKINT start = loop_start[which], end = loop_end[which];
+        const t_CKBOOL loop = loopplay[which];
+        const t_CKDOUBLE inc = p_inc[which], gain = voiceGain[which];
+        // only mix into channels this voice is panned to
+        t_CKFLOAT gains[LiSa_channels];
+        t_CKUINT chans[LiSa_channels], nmix = 0;
+        for(t_CKUINT j=0; j<nchans; j++) {
+            if(channelGain[which][j] != 0.) {
+                gains[nmix] = channelGain[which][j];
+                chans[nmix++] = j;
+            }
+        }
+        t_CKDOUBLE pos = pindex[which], ctr = rampctr[which];
+        t_CKBOOL up = rampup[which], down = rampdown[which];
+        const t_CKDOUBLE up_len = rampup_len[which], up_inv = rampup_len_inv[which];
+        const t_CKDOUBLE down_len = rampdown_len[which], down_inv = rampdown_len_inv[which];
+        t_CKBOOL stopped = false;
+
+        for(t_CKUINT f=0; f<nframes; f++)
+        {
+            // constrain
+            if(loop) {
+                if(start == end) pos = start;
+                else {
+                    while(pos >= end) pos = start + (pos - end);
+                    while(pos < start) pos = end - (start - pos);
+                }
+            } else if(pos >= len || pos < 0) {
+                stopped = true;
+                break;
+            }
+
+            // interp
+            t_CKINT whereTrunc = (t_CKINT)pos;
+            t_CKDOUBLE whereFrac = pos - (t_CKDOUBLE)whereTrunc;
+            t_CKINT whereNext = whereTrunc + 1;
+            if(loop) {
+                if(whereNext >= end) whereNext = start;
+                if(whereTrunc >= end) whereTrunc = start;
+            } else {
+                if(whereTrunc >= len) { whereTrunc = len - 1; whereNext = 0; }
+                if(whereNext >= len) whereNext = 0;
+            }
+
+            pos += inc;
+
+            t_CKDOUBLE outsample = (t_CKDOUBLE)buf[whereTrunc] + (t_CKDOUBLE)(buf[whereNext] - buf[whereTrunc]) * whereFrac;
+
+            // ramp stuff
+            if(up) {
+                outsample *= ctr++ * up_inv;
+                if(ctr >= up_len) up = false;
+            }
+            else if(down) {
+                outsample *= (down_len - ctr++) * down_inv;
+                if(ctr >= down_len) { down = false; stopped = true; }
+            }
+
+            SAMPLE tempsample = (SAMPLE)(outsample * gain);
+            SAMPLE * o = out + f*nchans;
+            for(t_CKUINT j=0; j<nmix; j++)
+                o[chans[j]] += tempsample * gains[j];
+
+            if(stopped) break;
+        }
+
+        pindex[which] = pos;
+        rampctr[which] = ctr;
+        rampup[which] = up;
+        rampdown[which] = down;
+        if(stopped) set_play(which, false);
+    }
+    
     inline void clear_buf()
     {
+        buffer_own();
         for (t_CKINT i = 0; i < mdata_len; i++)
             mdata[i] = 0.;
     }
@@ -4007,7 +5771,7 @@ struct LiSaMulti_data
     inline t_CKINT get_free_voice()
     {
         t_CKINT voicenumber = 0;
-        while(play[voicenumber] && voicenumber < maxvoices) {
+        while(voicenumber < maxvoices && play[voicenumber]) {
             voicenumber++;
         }
         if(voicenumber == maxvoices) voicenumber = -1;
@@ -4020,7 +5784,10 @@ struct LiSaMulti_data
 		if ( index >= mdata_len || index < 0 ) {
 			index = 0;
 			CK_FPRINTF_STDERR( "LiSa: trying to put sample out of buffer range; ignoring" );
-		} else mdata[index] = insample;
+		} else {
+			buffer_own();
+			mdata[index] = insample;
+		}
 	
 	}
 	
@@ -4073,10 +5840,10 @@ CK_DLL_CTOR( LiSaMulti_ctor )
 {
 
     LiSaMulti_data * f =  new LiSaMulti_data;
-    memset( f, 0, sizeof(LiSaMulti_data) );
 			
 	Chuck_UGen * ugen = (Chuck_UGen *)SELF;
 	f->num_chans = ugen->m_multi_chan_size > 0 ? ugen->m_multi_chan_size : 1;
+    f->voices_grow( LiSa_DEFAULTVOICES );
     //CK_FPRINTF_STDERR( "LiSa: number of channels = %d\n", f->num_chans );
 	f->outsamples = new SAMPLE[f->num_chans];
 	memset( f->outsamples, 0, (f->num_chans)*sizeof(SAMPLE) );
@@ -4133,6 +5900,14 @@ CK_DLL_TICKF( LiSaMulti_tickf )
     LiSaMulti_data * d = (LiSaMulti_data *)OBJ_MEMBER_UINT(SELF, LiSaMulti_offset_data);
 	
     unsigned int nchans = ugen->m_num_outs;
+
+    // voices are independent unless recording or tracking the input
+    if( d->mdata && !d->record && d->track == 0 && nchans <= (unsigned int)d->num_chans )
+    {
+        d->tick_block( out, nframes, nchans );
+        return TRUE;
+    }
+
     for(unsigned int frame_idx = 0; frame_idx < nframes; frame_idx++)
     {
         SAMPLE * temp_out_samples = d->tick_multi( in[frame_idx*nchans+1] );
@@ -4165,6 +5940,29 @@ CK_DLL_CTRL( LiSaMulti_size )
     RETURN->v_dur = (t_CKDUR)buflen;
 }
 
+//-----------------------------------------------------------------------------
+// name: LiSaMulti_read()
+// desc: load a sound file (one channel) as the buffer
+//-----------------------------------------------------------------------------
+CK_DLL_MFUN( LiSaMulti_read )
+{
+    LiSaMulti_data * d = (LiSaMulti_data *)OBJ_MEMBER_UINT(SELF, LiSaMulti_offset_data);
+    Chuck_String * filename = GET_NEXT_STRING(ARGS);
+    d->buffer_attach( filename->str().c_str(), 0 );
+
+    RETURN->v_dur = (t_CKDUR)d->mdata_len;
+}
+
+CK_DLL_MFUN( LiSaMulti_read_chan )
+{
+    LiSaMulti_data * d = (LiSaMulti_data *)OBJ_MEMBER_UINT(SELF, LiSaMulti_offset_data);
+    Chuck_String * filename = GET_NEXT_STRING(ARGS);
+    t_CKINT chan = GET_NEXT_INT(ARGS);
+    d->buffer_attach( filename->str().c_str(), chan );
+
+    RETURN->v_dur = (t_CKDUR)d->mdata_len;
+}
+
 CK_DLL_CGET( LiSaMulti_cget_size )
 {
     LiSaMulti_data * d = (LiSaMulti_data *)OBJ_MEMBER_UINT(SELF, LiSaMulti_offset_data);
@@ -4181,6 +5979,8 @@ CK_DLL_CTRL( LiSaMulti_start_record )
 {
     LiSaMulti_data * d = (LiSaMulti_data *)OBJ_MEMBER_UINT(SELF, LiSaMulti_offset_data);
     d->record = GET_NEXT_INT(ARGS);
+    // recording writes into the buffer
+    if( d->record ) d->buffer_own();
     
     RETURN->v_int = (t_CKINT)d->record;    
 }
@@ -4194,7 +5994,7 @@ CK_DLL_CTRL( LiSaMulti_start_play )
 {
     LiSaMulti_data * d = (LiSaMulti_data *)OBJ_MEMBER_UINT(SELF, LiSaMulti_offset_data);
     t_CKINT which = GET_NEXT_INT(ARGS);
-    d->play[which] = GET_NEXT_INT(ARGS);
+    d->set_play(which, GET_NEXT_INT(ARGS) != 0);
     //CK_FPRINTF_STDERR( "voice %d playing = %d\n", which, d->play[which] );
 	
 	//turn off ramping toggles
@@ -4213,7 +6013,7 @@ CK_DLL_CTRL( LiSaMulti_start_play0 )
 {
 
     LiSaMulti_data * d = (LiSaMulti_data *)OBJ_MEMBER_UINT(SELF, LiSaMulti_offset_data);
-    d->play[0] = GET_NEXT_INT(ARGS);
+    d->set_play(0, GET_NEXT_INT(ARGS) != 0);
     //CK_FPRINTF_STDERR( "voice %d playing = %d\n", which, d->play[which] );
 
 	//turn off ramping toggles
@@ -4869,6 +6669,8 @@ CK_DLL_CTRL( LiSaMulti_ctrl_maxvoices )
 		d->maxvoices = LiSa_MAXVOICES;
 		CK_FPRINTF_STDERR( "LiSa: MAXVOICES limited to  %d.\n", LiSa_MAXVOICES );
 	}
+    if( !d->voices_grow( d->maxvoices ) )
+        d->maxvoices = d->voice_capacity;
     RETURN->v_int = d->maxvoices;
 }
 
@@ -42,6 +42,8 @@
 
 // query
 DLL_QUERY xxx_query( Chuck_DL_Query * query );
+// stop the SndBuf streaming thread, once no SndBuf streams (shutdown)
+void sndbuf_streamer_shutdown();
 
 // stereo
 CK_DLL_CTOR( stereo_ctor );
@@ -177,12 +179,42 @@ CK_DLL_CTRL( sndbuf_ctrl_channel );
 CK_DLL_CGET( sndbuf_cget_channel );
 CK_DLL_CTRL( sndbuf_ctrl_chunks );
 CK_DLL_CGET( sndbuf_cget_chunks );
+CK_DLL_CTRL( sndbuf_ctrl_stream );
+CK_DLL_CGET( sndbuf_cget_stream );
+CK_DLL_CTRL( sndbuf_ctrl_streamCache );
+CK_DLL_CGET( sndbuf_cget_streamCache );
+CK_DLL_CGET( sndbuf_cget_streamUnderruns );
+CK_DLL_CTRL( sndbuf_ctrl_cache );
+CK_DLL_CGET( sndbuf_cget_cache );
+CK_DLL_SFUN( sndbuf_cache_hits );
+CK_DLL_SFUN( sndbuf_cache_misses );
+CK_DLL_SFUN( sndbuf_cache_evictions );
+CK_DLL_SFUN( sndbuf_cache_bytes );
+CK_DLL_SFUN( sndbuf_cache_set_budget );
+CK_DLL_SFUN( sndbuf_cache_get_budget );
+CK_DLL_CTRL( sndbuf_ctrl_mmap );
+CK_DLL_CGET( sndbuf_cget_mmap );
 CK_DLL_CTRL( sndbuf_ctrl_phase_offset );
 CK_DLL_CGET( sndbuf_cget_samples );
 CK_DLL_CGET( sndbuf_cget_length );
 CK_DLL_CGET( sndbuf_cget_channels );
 CK_DLL_CGET( sndbuf_cget_valueAt );
 
+// convolver
+CK_DLL_CTOR( convolver_ctor );
+CK_DLL_DTOR( convolver_dtor );
+CK_DLL_TICK( convolver_tick );
+CK_DLL_CTRL( convolver_ctrl_read );
+CK_DLL_CTRL( convolver_ctrl_ir );
+CK_DLL_CTRL( convolver_ctrl_channel );
+CK_DLL_CGET( convolver_cget_channel );
+CK_DLL_CTRL( convolver_ctrl_blockSize );
+CK_DLL_CGET( convolver_cget_blockSize );
+CK_DLL_CGET( convolver_cget_partitions );
+CK_DLL_CGET( convolver_cget_samples );
+CK_DLL_CGET( convolver_cget_length );
+CK_DLL_CTRL( convolver_ctrl_clear );
+
 // LiSa (Dan Trueman)
 CK_DLL_CTOR( LiSaMulti_ctor );
 CK_DLL_DTOR( LiSaMulti_dtor );
@@ -190,6 +222,8 @@ CK_DLL_TICK( LiSaMulti_tick );
 CK_DLL_TICKF( LiSaMulti_tickf );
 CK_DLL_PMSG( LiSaMulti_pmsg );
 CK_DLL_CTRL( LiSaMulti_size );
+CK_DLL_MFUN( LiSaMulti_read );
+CK_DLL_MFUN( LiSaMulti_read_chan );
 CK_DLL_CTRL( LiSaMulti_cget_size );
 CK_DLL_CTRL( LiSaMulti_start_record );
 CK_DLL_CTRL( LiSaMulti_start_play );
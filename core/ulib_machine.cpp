@@ -107,6 +107,19 @@ DLL_QUERY machine_query( Chuck_DL_Query * QUERY )
     //! get list of active shreds by id
     QUERY->add_sfun( QUERY, machine_shreds_impl, "int[]", "shreds" );
 
+    // add allocs
+    //! number of times object memory came from the system allocator
+    //! (flat during playback once pools are warm)
+    QUERY->add_sfun( QUERY, machine_allocs_impl, "int", "allocs" );
+
+    // add recycled
+    //! number of times object memory was reused from a pool
+    QUERY->add_sfun( QUERY, machine_recycled_impl, "int", "recycled" );
+
+    // add collected
+    //! number of objects freed by the cycle collector
+    QUERY->add_sfun( QUERY, machine_collected_impl, "int", "collected" );
+
     // end class
     QUERY->end_class( QUERY );
 
@@ -218,3 +231,18 @@ CK_DLL_SFUN( machine_shreds_impl )
     
     RETURN->v_object = array;
 }
+
+CK_DLL_SFUN( machine_allocs_impl )
+{
+    RETURN->v_int = Chuck_VM_Alloc::instance()->num_system_allocs();
+}
+
+CK_DLL_SFUN( machine_recycled_impl )
+{
+    RETURN->v_int = Chuck_VM_Alloc::instance()->num_recycled();
+}
+
+CK_DLL_SFUN( machine_collected_impl )
+{
+    RETURN->v_int = Chuck_VM_Alloc::instance()->num_collected();
+}
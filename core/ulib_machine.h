@@ -57,6 +57,9 @@ CK_DLL_SFUN( machine_replace_impl );
 CK_DLL_SFUN( machine_status_impl );
 CK_DLL_SFUN( machine_intsize_impl );
 CK_DLL_SFUN( machine_shreds_impl );
+CK_DLL_SFUN( machine_allocs_impl );
+CK_DLL_SFUN( machine_recycled_impl );
+CK_DLL_SFUN( machine_collected_impl );
 
 
 #endif
@@ -34,11 +34,15 @@
 #include "ulib_math.h"
 #include "util_math.h"
 #include "ulib_std.h"
+#include "chuck_instr.h"
+#include "chuck_vm.h"
 
 #include <limits.h>
 #include <float.h>
 #include <stdlib.h>
 #include <time.h>
+#include <string.h>
+#include <algorithm>
 
 
 static double g_pi = ONE_PI;
@@ -367,6 +371,168 @@ DLL_QUERY libmath_query( Chuck_DL_Query * QUERY )
     return TRUE;
 }
 
+
+
+//-----------------------------------------------------------------------------
+// name: libvec_query()
+// desc: query entry point for 'Vec', whole-array math over float[] and
+//       complex[]; every function that produces an array also has a form
+//       taking a destination array, which is resized and reused instead of
+//       allocating a new one (the destination may alias an input).  the
+//       complex[] forms are c-prefixed (cadd, cmul, ...) since overloads
+//       cannot differ in return type
+//-----------------------------------------------------------------------------
+DLL_QUERY libvec_query( Chuck_DL_Query * QUERY )
+{
+    // name
+    QUERY->setname( QUERY, "Vec" );
+
+    /*! \example
+    Vec.mul( fft.fvals(), window, tmp ) @=> tmp;
+    Vec.argmax( tmp ) => int peak;
+    */
+
+    // add class
+    QUERY->begin_class( QUERY, "Vec", "Object" );
+
+    // add add
+    QUERY->add_sfun( QUERY, vec_add_impl, "float[]", "add" ); //! a + b
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_arg( QUERY, "float[]", "b" );
+    QUERY->add_sfun( QUERY, vec_add_dest_impl, "float[]", "add" ); //! a + b => dest
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_arg( QUERY, "float[]", "b" );
+    QUERY->add_arg( QUERY, "float[]", "dest" );
+    QUERY->add_sfun( QUERY, vec_cadd_impl, "complex[]", "cadd" ); //! a + b
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_arg( QUERY, "complex[]", "b" );
+    QUERY->add_sfun( QUERY, vec_cadd_dest_impl, "complex[]", "cadd" ); //! a + b => dest
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_arg( QUERY, "complex[]", "b" );
+    QUERY->add_arg( QUERY, "complex[]", "dest" );
+
+    // add mul
+    QUERY->add_sfun( QUERY, vec_mul_impl, "float[]", "mul" ); //! a * b
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_arg( QUERY, "float[]", "b" );
+    QUERY->add_sfun( QUERY, vec_mul_dest_impl, "float[]", "mul" ); //! a * b => dest
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_arg( QUERY, "float[]", "b" );
+    QUERY->add_arg( QUERY, "float[]", "dest" );
+    QUERY->add_sfun( QUERY, vec_cmul_impl, "complex[]", "cmul" ); //! a * b (complex product)
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_arg( QUERY, "complex[]", "b" );
+    QUERY->add_sfun( QUERY, vec_cmul_dest_impl, "complex[]", "cmul" ); //! a * b => dest
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_arg( QUERY, "complex[]", "b" );
+    QUERY->add_arg( QUERY, "complex[]", "dest" );
+
+    // add scale
+    QUERY->add_sfun( QUERY, vec_scale_impl, "float[]", "scale" ); //! a * s
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_arg( QUERY, "float", "s" );
+    QUERY->add_sfun( QUERY, vec_scale_dest_impl, "float[]", "scale" ); //! a * s => dest
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_arg( QUERY, "float", "s" );
+    QUERY->add_arg( QUERY, "float[]", "dest" );
+    QUERY->add_sfun( QUERY, vec_cscale_impl, "complex[]", "cscale" ); //! a * s
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_arg( QUERY, "float", "s" );
+    QUERY->add_sfun( QUERY, vec_cscale_dest_impl, "complex[]", "cscale" ); //! a * s => dest
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_arg( QUERY, "float", "s" );
+    QUERY->add_arg( QUERY, "complex[]", "dest" );
+
+    // add interp
+    QUERY->add_sfun( QUERY, vec_interp_impl, "float[]", "interp" ); //! a + (b-a)*t
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_arg( QUERY, "float[]", "b" );
+    QUERY->add_arg( QUERY, "float", "t" );
+    QUERY->add_sfun( QUERY, vec_interp_dest_impl, "float[]", "interp" ); //! a + (b-a)*t => dest
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_arg( QUERY, "float[]", "b" );
+    QUERY->add_arg( QUERY, "float", "t" );
+    QUERY->add_arg( QUERY, "float[]", "dest" );
+    QUERY->add_sfun( QUERY, vec_cinterp_impl, "complex[]", "cinterp" ); //! a + (b-a)*t
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_arg( QUERY, "complex[]", "b" );
+    QUERY->add_arg( QUERY, "float", "t" );
+    QUERY->add_sfun( QUERY, vec_cinterp_dest_impl, "complex[]", "cinterp" ); //! a + (b-a)*t => dest
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_arg( QUERY, "complex[]", "b" );
+    QUERY->add_arg( QUERY, "float", "t" );
+    QUERY->add_arg( QUERY, "complex[]", "dest" );
+
+    // add clamp
+    QUERY->add_sfun( QUERY, vec_clamp_impl, "float[]", "clamp" ); //! each of a into [lo,hi]
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_arg( QUERY, "float", "lo" );
+    QUERY->add_arg( QUERY, "float", "hi" );
+    QUERY->add_sfun( QUERY, vec_clamp_dest_impl, "float[]", "clamp" ); //! each of a into [lo,hi] => dest
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_arg( QUERY, "float", "lo" );
+    QUERY->add_arg( QUERY, "float", "hi" );
+    QUERY->add_arg( QUERY, "float[]", "dest" );
+
+    // add copy
+    QUERY->add_sfun( QUERY, vec_copy_impl, "float[]", "copy" ); //! new copy of a
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_sfun( QUERY, vec_copy_dest_impl, "float[]", "copy" ); //! a => dest
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_arg( QUERY, "float[]", "dest" );
+    QUERY->add_sfun( QUERY, vec_ccopy_impl, "complex[]", "ccopy" ); //! new copy of a
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_sfun( QUERY, vec_ccopy_dest_impl, "complex[]", "ccopy" ); //! a => dest
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_arg( QUERY, "complex[]", "dest" );
+
+    // add fill
+    QUERY->add_sfun( QUERY, vec_fill_impl, "float[]", "fill" ); //! set every element of a to v
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_arg( QUERY, "float", "v" );
+    QUERY->add_sfun( QUERY, vec_cfill_impl, "complex[]", "cfill" ); //! set every element of a to v
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_arg( QUERY, "complex", "v" );
+
+    // add magnitude
+    QUERY->add_sfun( QUERY, vec_magnitude_impl, "float[]", "magnitude" ); //! |a|
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_sfun( QUERY, vec_magnitude_dest_impl, "float[]", "magnitude" ); //! |a| => dest
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_arg( QUERY, "float[]", "dest" );
+
+    // add phase
+    QUERY->add_sfun( QUERY, vec_phase_impl, "float[]", "phase" ); //! arg(a)
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_sfun( QUERY, vec_phase_dest_impl, "float[]", "phase" ); //! arg(a) => dest
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+    QUERY->add_arg( QUERY, "float[]", "dest" );
+
+    // add dot
+    QUERY->add_sfun( QUERY, vec_dot_impl, "float", "dot" ); //! sum of a * b
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_arg( QUERY, "float[]", "b" );
+
+    // add sum
+    QUERY->add_sfun( QUERY, vec_sum_impl, "float", "sum" ); //! sum of a
+    QUERY->add_arg( QUERY, "float[]", "a" );
+    QUERY->add_sfun( QUERY, vec_csum_impl, "complex", "csum" ); //! sum of a
+    QUERY->add_arg( QUERY, "complex[]", "a" );
+
+    // add max
+    QUERY->add_sfun( QUERY, vec_max_impl, "float", "max" ); //! largest element of a
+    QUERY->add_arg( QUERY, "float[]", "a" );
+
+    // add argmax
+    QUERY->add_sfun( QUERY, vec_argmax_impl, "int", "argmax" ); //! index of largest element of a, -1 if empty
+    QUERY->add_arg( QUERY, "float[]", "a" );
+
+    // done
+    QUERY->end_class( QUERY );
+
+    return TRUE;
+}
+
 // sin
 CK_DLL_SFUN( sin_impl )
 {
@@ -775,3 +941,487 @@ CK_DLL_SFUN( gauss_impl )
     // compute gaussian
     RETURN->v_float = (1.0 / (sd*::sqrt(TWO_PI))) * ::exp( -(x-mu)*(x-mu) / (2*sd*sd) );
 }
+
+
+
+//-----------------------------------------------------------------------------
+// Vec
+//
+// the kernels work on the raw element storage of the arrays: plain indexed
+// loops with no per-element calls, so the compiler can vectorize them.
+// complex[] is laid out as interleaved (re,im) doubles, so the elementwise
+// linear ops (add, scale, interp, copy) reuse the float kernels over 2n
+// values.  the reductions keep four partial sums to break the dependency
+// chain (floating point addition order is otherwise fixed by the language).
+// every kernel tolerates out aliasing an input element for element.
+//-----------------------------------------------------------------------------
+static inline t_CKFLOAT * vec_data( Chuck_Array8 * a )
+{ return a->m_vector.empty() ? NULL : &a->m_vector[0]; }
+static inline t_CKFLOAT * vec_data( Chuck_Array16 * a )
+{ return a->m_vector.empty() ? NULL : (t_CKFLOAT *)&a->m_vector[0]; }
+
+static void vec_add( const t_CKFLOAT * a, const t_CKFLOAT * b, t_CKFLOAT * out, t_CKUINT n )
+{ for( t_CKUINT i = 0; i < n; i++ ) out[i] = a[i] + b[i]; }
+
+static void vec_mul( const t_CKFLOAT * a, const t_CKFLOAT * b, t_CKFLOAT * out, t_CKUINT n )
+{ for( t_CKUINT i = 0; i < n; i++ ) out[i] = a[i] * b[i]; }
+
+static void vec_scale( const t_CKFLOAT * a, t_CKFLOAT s, t_CKFLOAT * out, t_CKUINT n )
+{ for( t_CKUINT i = 0; i < n; i++ ) out[i] = a[i] * s; }
+
+static void vec_interp( const t_CKFLOAT * a, const t_CKFLOAT * b, t_CKFLOAT t, t_CKFLOAT * out, t_CKUINT n )
+{ for( t_CKUINT i = 0; i < n; i++ ) out[i] = a[i] + (b[i] - a[i]) * t; }
+
+static void vec_clamp( const t_CKFLOAT * a, t_CKFLOAT lo, t_CKFLOAT hi, t_CKFLOAT * out, t_CKUINT n )
+{
+    for( t_CKUINT i = 0; i < n; i++ )
+    {
+        t_CKFLOAT v = a[i] < lo ? lo : a[i];
+        out[i] = v > hi ? hi : v;
+    }
+}
+
+static void vec_copy( const t_CKFLOAT * a, t_CKFLOAT * out, t_CKUINT n )
+{ if( n && out != a ) memmove( out, a, n * sizeof(t_CKFLOAT) ); }
+
+// complex product, n complex elements
+static void vec_cmul( const t_CKFLOAT * a, const t_CKFLOAT * b, t_CKFLOAT * out, t_CKUINT n )
+{
+    for( t_CKUINT i = 0; i < 2*n; i += 2 )
+    {
+        t_CKFLOAT re = a[i] * b[i] - a[i+1] * b[i+1];
+        t_CKFLOAT im = a[i] * b[i+1] + a[i+1] * b[i];
+        out[i] = re; out[i+1] = im;
+    }
+}
+
+// modulus of n complex elements
+static void vec_magnitude( const t_CKFLOAT * a, t_CKFLOAT * out, t_CKUINT n )
+{ for( t_CKUINT i = 0; i < n; i++ ) out[i] = ::sqrt( a[2*i] * a[2*i] + a[2*i+1] * a[2*i+1] ); }
+
+// phase of n complex elements
+static void vec_phase( const t_CKFLOAT * a, t_CKFLOAT * out, t_CKUINT n )
+{ for( t_CKUINT i = 0; i < n; i++ ) out[i] = ::atan2( a[2*i+1], a[2*i] ); }
+
+static t_CKFLOAT vec_dot( const t_CKFLOAT * a, const t_CKFLOAT * b, t_CKUINT n )
+{
+    t_CKFLOAT s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    t_CKUINT i = 0;
+    for( ; i + 4 <= n; i += 4 )
+    {
+        s0 += a[i] * b[i]; s1 += a[i+1] * b[i+1];
+        s2 += a[i+2] * b[i+2]; s3 += a[i+3] * b[i+3];
+    }
+    for( ; i < n; i++ ) s0 += a[i] * b[i];
+    return (s0 + s1) + (s2 + s3);
+}
+
+// sum of n values spaced stride apart
+static t_CKFLOAT vec_sum( const t_CKFLOAT * a, t_CKUINT n, t_CKUINT stride )
+{
+    t_CKFLOAT s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    t_CKUINT i = 0;
+    for( ; i + 4 <= n; i += 4 )
+    {
+        s0 += a[i*stride]; s1 += a[(i+1)*stride];
+        s2 += a[(i+2)*stride]; s3 += a[(i+3)*stride];
+    }
+    for( ; i < n; i++ ) s0 += a[i*stride];
+    return (s0 + s1) + (s2 + s3);
+}
+
+// get the array to write n elements into: dest resized, or a new array
+static Chuck_Array8 * vec_out8( Chuck_VM_Shred * shred, Chuck_Array8 * dest, t_CKUINT n )
+{
+    if( dest ) { dest->set_size( n ); return dest; }
+    Chuck_Array8 * array = new Chuck_Array8( n );
+    initialize_object( array, shred->vm_ref->env()->t_array );
+    return array;
+}
+
+static Chuck_Array16 * vec_out16( Chuck_VM_Shred * shred, Chuck_Array16 * dest, t_CKUINT n )
+{
+    if( dest ) { dest->set_size( n ); return dest; }
+    Chuck_Array16 * array = new Chuck_Array16( n );
+    initialize_object( array, shred->vm_ref->env()->t_array );
+    return array;
+}
+
+// binary float[] op; the shorter input sets the length
+static Chuck_Array8 * vec_binary8( Chuck_VM_Shred * shred, const char * name,
+    void (* op)( const t_CKFLOAT *, const t_CKFLOAT *, t_CKFLOAT *, t_CKUINT ),
+    Chuck_Array8 * a, Chuck_Array8 * b, Chuck_Array8 * dest )
+{
+    // make sure not null
+    if( !a || !b )
+    {
+        EM_log( CK_LOG_WARNING, "Vec.%s( ... ) was given one or more NULL arrays...", name );
+        return NULL;
+    }
+
+    t_CKUINT n = ck_min( a->size(), b->size() );
+    Chuck_Array8 * out = vec_out8( shred, dest, n );
+    op( vec_data( a ), vec_data( b ), vec_data( out ), n );
+    return out;
+}
+
+// binary complex[] op, counted in complex elements
+static Chuck_Array16 * vec_binary16( Chuck_VM_Shred * shred, const char * name,
+    void (* op)( const t_CKFLOAT *, const t_CKFLOAT *, t_CKFLOAT *, t_CKUINT ), t_CKUINT width,
+    Chuck_Array16 * a, Chuck_Array16 * b, Chuck_Array16 * dest )
+{
+    // make sure not null
+    if( !a || !b )
+    {
+        EM_log( CK_LOG_WARNING, "Vec.%s( ... ) was given one or more NULL arrays...", name );
+        return NULL;
+    }
+
+    t_CKUINT n = ck_min( a->size(), b->size() );
+    Chuck_Array16 * out = vec_out16( shred, dest, n );
+    op( vec_data( a ), vec_data( b ), vec_data( out ), n * width );
+    return out;
+}
+
+static Chuck_Array8 * vec_scale8( Chuck_VM_Shred * shred, Chuck_Array8 * a, t_CKFLOAT s, Chuck_Array8 * dest )
+{
+    if( !a ) { EM_log( CK_LOG_WARNING, "Vec.scale( ... ) was given a NULL array..." ); return NULL; }
+    Chuck_Array8 * out = vec_out8( shred, dest, a->size() );
+    vec_scale( vec_data( a ), s, vec_data( out ), a->size() );
+    return out;
+}
+
+static Chuck_Array16 * vec_scale16( Chuck_VM_Shred * shred, Chuck_Array16 * a, t_CKFLOAT s, Chuck_Array16 * dest )
+{
+    if( !a ) { EM_log( CK_LOG_WARNING, "Vec.scale( ... ) was given a NULL array..." ); return NULL; }
+    Chuck_Array16 * out = vec_out16( shred, dest, a->size() );
+    vec_scale( vec_data( a ), s, vec_data( out ), 2 * a->size() );
+    return out;
+}
+
+static Chuck_Array8 * vec_interp8( Chuck_VM_Shred * shred, Chuck_Array8 * a, Chuck_Array8 * b,
+                                   t_CKFLOAT t, Chuck_Array8 * dest )
+{
+    if( !a || !b ) { EM_log( CK_LOG_WARNING, "Vec.interp( ... ) was given one or more NULL arrays..." ); return NULL; }
+    t_CKUINT n = ck_min( a->size(), b->size() );
+    Chuck_Array8 * out = vec_out8( shred, dest, n );
+    vec_interp( vec_data( a ), vec_data( b ), t, vec_data( out ), n );
+    return out;
+}
+
+static Chuck_Array16 * vec_interp16( Chuck_VM_Shred * shred, Chuck_Array16 * a, Chuck_Array16 * b,
+                                     t_CKFLOAT t, Chuck_Array16 * dest )
+{
+    if( !a || !b ) { EM_log( CK_LOG_WARNING, "Vec.interp( ... ) was given one or more NULL arrays..." ); return NULL; }
+    t_CKUINT n = ck_min( a->size(), b->size() );
+    Chuck_Array16 * out = vec_out16( shred, dest, n );
+    vec_interp( vec_data( a ), vec_data( b ), t, vec_data( out ), 2 * n );
+    return out;
+}
+
+static Chuck_Array8 * vec_clamp8( Chuck_VM_Shred * shred, Chuck_Array8 * a, t_CKFLOAT lo,
+                                  t_CKFLOAT hi, Chuck_Array8 * dest )
+{
+    if( !a ) { EM_log( CK_LOG_WARNING, "Vec.clamp( ... ) was given a NULL array..." ); return NULL; }
+    Chuck_Array8 * out = vec_out8( shred, dest, a->size() );
+    vec_clamp( vec_data( a ), lo, hi, vec_data( out ), a->size() );
+    return out;
+}
+
+static Chuck_Array8 * vec_copy8( Chuck_VM_Shred * shred, Chuck_Array8 * a, Chuck_Array8 * dest )
+{
+    if( !a ) { EM_log( CK_LOG_WARNING, "Vec.copy( ... ) was given a NULL array..." ); return NULL; }
+    Chuck_Array8 * out = vec_out8( shred, dest, a->size() );
+    vec_copy( vec_data( a ), vec_data( out ), a->size() );
+    return out;
+}
+
+static Chuck_Array16 * vec_copy16( Chuck_VM_Shred * shred, Chuck_Array16 * a, Chuck_Array16 * dest )
+{
+    if( !a ) { EM_log( CK_LOG_WARNING, "Vec.copy( ... ) was given a NULL array..." ); return NULL; }
+    Chuck_Array16 * out = vec_out16( shred, dest, a->size() );
+    vec_copy( vec_data( a ), vec_data( out ), 2 * a->size() );
+    return out;
+}
+
+// complex[] to float[] op
+static Chuck_Array8 * vec_polar8( Chuck_VM_Shred * shred, const char * name,
+    void (* op)( const t_CKFLOAT *, t_CKFLOAT *, t_CKUINT ), Chuck_Array16 * a, Chuck_Array8 * dest )
+{
+    if( !a ) { EM_log( CK_LOG_WARNING, "Vec.%s( ... ) was given a NULL array...", name ); return NULL; }
+    Chuck_Array8 * out = vec_out8( shred, dest, a->size() );
+    op( vec_data( a ), vec_data( out ), a->size() );
+    return out;
+}
+
+// add
+CK_DLL_SFUN( vec_add_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array8 * b = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_binary8( SHRED, "add", vec_add, a, b, NULL );
+}
+
+CK_DLL_SFUN( vec_add_dest_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array8 * b = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array8 * dest = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_binary8( SHRED, "add", vec_add, a, b, dest );
+}
+
+CK_DLL_SFUN( vec_cadd_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array16 * b = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_binary16( SHRED, "add", vec_add, 2, a, b, NULL );
+}
+
+CK_DLL_SFUN( vec_cadd_dest_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array16 * b = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array16 * dest = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_binary16( SHRED, "add", vec_add, 2, a, b, dest );
+}
+
+// mul
+CK_DLL_SFUN( vec_mul_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array8 * b = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_binary8( SHRED, "mul", vec_mul, a, b, NULL );
+}
+
+CK_DLL_SFUN( vec_mul_dest_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array8 * b = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array8 * dest = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_binary8( SHRED, "mul", vec_mul, a, b, dest );
+}
+
+CK_DLL_SFUN( vec_cmul_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array16 * b = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_binary16( SHRED, "mul", vec_cmul, 1, a, b, NULL );
+}
+
+CK_DLL_SFUN( vec_cmul_dest_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array16 * b = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array16 * dest = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_binary16( SHRED, "mul", vec_cmul, 1, a, b, dest );
+}
+
+// scale
+CK_DLL_SFUN( vec_scale_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    t_CKFLOAT s = GET_NEXT_FLOAT(ARGS);
+    RETURN->v_object = vec_scale8( SHRED, a, s, NULL );
+}
+
+CK_DLL_SFUN( vec_scale_dest_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    t_CKFLOAT s = GET_NEXT_FLOAT(ARGS);
+    Chuck_Array8 * dest = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_scale8( SHRED, a, s, dest );
+}
+
+CK_DLL_SFUN( vec_cscale_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    t_CKFLOAT s = GET_NEXT_FLOAT(ARGS);
+    RETURN->v_object = vec_scale16( SHRED, a, s, NULL );
+}
+
+CK_DLL_SFUN( vec_cscale_dest_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    t_CKFLOAT s = GET_NEXT_FLOAT(ARGS);
+    Chuck_Array16 * dest = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_scale16( SHRED, a, s, dest );
+}
+
+// interp
+CK_DLL_SFUN( vec_interp_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array8 * b = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    t_CKFLOAT t = GET_NEXT_FLOAT(ARGS);
+    RETURN->v_object = vec_interp8( SHRED, a, b, t, NULL );
+}
+
+CK_DLL_SFUN( vec_interp_dest_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array8 * b = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    t_CKFLOAT t = GET_NEXT_FLOAT(ARGS);
+    Chuck_Array8 * dest = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_interp8( SHRED, a, b, t, dest );
+}
+
+CK_DLL_SFUN( vec_cinterp_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array16 * b = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    t_CKFLOAT t = GET_NEXT_FLOAT(ARGS);
+    RETURN->v_object = vec_interp16( SHRED, a, b, t, NULL );
+}
+
+CK_DLL_SFUN( vec_cinterp_dest_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array16 * b = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    t_CKFLOAT t = GET_NEXT_FLOAT(ARGS);
+    Chuck_Array16 * dest = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_interp16( SHRED, a, b, t, dest );
+}
+
+// clamp
+CK_DLL_SFUN( vec_clamp_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    t_CKFLOAT lo = GET_NEXT_FLOAT(ARGS);
+    t_CKFLOAT hi = GET_NEXT_FLOAT(ARGS);
+    RETURN->v_object = vec_clamp8( SHRED, a, lo, hi, NULL );
+}
+
+CK_DLL_SFUN( vec_clamp_dest_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    t_CKFLOAT lo = GET_NEXT_FLOAT(ARGS);
+    t_CKFLOAT hi = GET_NEXT_FLOAT(ARGS);
+    Chuck_Array8 * dest = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_clamp8( SHRED, a, lo, hi, dest );
+}
+
+// copy
+CK_DLL_SFUN( vec_copy_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_copy8( SHRED, a, NULL );
+}
+
+CK_DLL_SFUN( vec_copy_dest_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array8 * dest = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_copy8( SHRED, a, dest );
+}
+
+CK_DLL_SFUN( vec_ccopy_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_copy16( SHRED, a, NULL );
+}
+
+CK_DLL_SFUN( vec_ccopy_dest_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array16 * dest = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_copy16( SHRED, a, dest );
+}
+
+// fill
+CK_DLL_SFUN( vec_fill_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    t_CKFLOAT v = GET_NEXT_FLOAT(ARGS);
+    if( a ) std::fill( a->m_vector.begin(), a->m_vector.end(), v );
+    else EM_log( CK_LOG_WARNING, "Vec.fill( ... ) was given a NULL array..." );
+    RETURN->v_object = a;
+}
+
+CK_DLL_SFUN( vec_cfill_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    t_CKCOMPLEX v = GET_NEXT_COMPLEX(ARGS);
+    if( a ) std::fill( a->m_vector.begin(), a->m_vector.end(), v );
+    else EM_log( CK_LOG_WARNING, "Vec.fill( ... ) was given a NULL array..." );
+    RETURN->v_object = a;
+}
+
+// magnitude
+CK_DLL_SFUN( vec_magnitude_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_polar8( SHRED, "magnitude", vec_magnitude, a, NULL );
+}
+
+CK_DLL_SFUN( vec_magnitude_dest_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array8 * dest = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_polar8( SHRED, "magnitude", vec_magnitude, a, dest );
+}
+
+// phase
+CK_DLL_SFUN( vec_phase_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_polar8( SHRED, "phase", vec_phase, a, NULL );
+}
+
+CK_DLL_SFUN( vec_phase_dest_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array8 * dest = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_object = vec_polar8( SHRED, "phase", vec_phase, a, dest );
+}
+
+// dot
+CK_DLL_SFUN( vec_dot_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    Chuck_Array8 * b = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    if( !a || !b )
+    {
+        EM_log( CK_LOG_WARNING, "Vec.dot( ... ) was given one or more NULL arrays..." );
+        RETURN->v_float = 0;
+        return;
+    }
+    RETURN->v_float = vec_dot( vec_data( a ), vec_data( b ), ck_min( a->size(), b->size() ) );
+}
+
+// sum
+CK_DLL_SFUN( vec_sum_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_float = a ? vec_sum( vec_data( a ), a->size(), 1 ) : 0;
+}
+
+CK_DLL_SFUN( vec_csum_impl )
+{
+    Chuck_Array16 * a = (Chuck_Array16 *)GET_NEXT_OBJECT(ARGS);
+    RETURN->v_complex.re = a ? vec_sum( vec_data( a ), a->size(), 2 ) : 0;
+    RETURN->v_complex.im = a && a->size() ? vec_sum( vec_data( a ) + 1, a->size(), 2 ) : 0;
+}
+
+// max
+CK_DLL_SFUN( vec_max_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    t_CKUINT n = a ? a->size() : 0;
+    if( !n ) { RETURN->v_float = 0; return; }
+    const t_CKFLOAT * v = vec_data( a );
+    t_CKFLOAT m = v[0];
+    for( t_CKUINT i = 1; i < n; i++ ) m = v[i] > m ? v[i] : m;
+    RETURN->v_float = m;
+}
+
+// argmax
+CK_DLL_SFUN( vec_argmax_impl )
+{
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    t_CKUINT n = a ? a->size() : 0;
+    if( !n ) { RETURN->v_int = -1; return; }
+    const t_CKFLOAT * v = vec_data( a );
+    t_CKUINT k = 0;
+    for( t_CKUINT i = 1; i < n; i++ ) if( v[i] > v[k] ) k = i;
+    RETURN->v_int = k;
+}
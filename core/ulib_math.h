@@ -36,6 +36,7 @@
 
 // query
 DLL_QUERY libmath_query( Chuck_DL_Query * QUERY );
+DLL_QUERY libvec_query( Chuck_DL_Query * QUERY );
 
 // impl
 CK_DLL_SFUN( sin_impl );
@@ -88,6 +89,40 @@ CK_DLL_SFUN( srandom_impl );
 
 CK_DLL_SFUN( gauss_impl );
 
+CK_DLL_SFUN( vec_add_impl );
+CK_DLL_SFUN( vec_add_dest_impl );
+CK_DLL_SFUN( vec_cadd_impl );
+CK_DLL_SFUN( vec_cadd_dest_impl );
+CK_DLL_SFUN( vec_mul_impl );
+CK_DLL_SFUN( vec_mul_dest_impl );
+CK_DLL_SFUN( vec_cmul_impl );
+CK_DLL_SFUN( vec_cmul_dest_impl );
+CK_DLL_SFUN( vec_scale_impl );
+CK_DLL_SFUN( vec_scale_dest_impl );
+CK_DLL_SFUN( vec_cscale_impl );
+CK_DLL_SFUN( vec_cscale_dest_impl );
+CK_DLL_SFUN( vec_interp_impl );
+CK_DLL_SFUN( vec_interp_dest_impl );
+CK_DLL_SFUN( vec_cinterp_impl );
+CK_DLL_SFUN( vec_cinterp_dest_impl );
+CK_DLL_SFUN( vec_clamp_impl );
+CK_DLL_SFUN( vec_clamp_dest_impl );
+CK_DLL_SFUN( vec_copy_impl );
+CK_DLL_SFUN( vec_copy_dest_impl );
+CK_DLL_SFUN( vec_ccopy_impl );
+CK_DLL_SFUN( vec_ccopy_dest_impl );
+CK_DLL_SFUN( vec_fill_impl );
+CK_DLL_SFUN( vec_cfill_impl );
+CK_DLL_SFUN( vec_magnitude_impl );
+CK_DLL_SFUN( vec_magnitude_dest_impl );
+CK_DLL_SFUN( vec_phase_impl );
+CK_DLL_SFUN( vec_phase_dest_impl );
+CK_DLL_SFUN( vec_dot_impl );
+CK_DLL_SFUN( vec_sum_impl );
+CK_DLL_SFUN( vec_csum_impl );
+CK_DLL_SFUN( vec_max_impl );
+CK_DLL_SFUN( vec_argmax_impl );
+
 // max for random functions
 #ifdef __WINDOWS_DS__
 #define CK_RANDOM_MAX RAND_MAX
@@ -1208,6 +1208,57 @@ DLL_QUERY opensoundcontrol_query ( Chuck_DL_Query * query ) {
     func = make_new_mfun( "int", "kick", osc_send_kickMesg );
     if( !type_engine_import_mfun( env, func ) ) goto error;
 
+    func = make_new_mfun( "int", "async", osc_send_setAsync );
+    func->add_arg( "int", "on" );
+    func->doc = "Queue messages for the network thread (on by default) instead of sending from the VM.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    func = make_new_mfun( "int", "async", osc_send_getAsync );
+    func->doc = "Whether messages are queued for the network thread.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    func = make_new_sfun( "int", "coalesce", osc_send_setCoalesce );
+    func->add_arg( "int", "on" );
+    func->doc = "Send queued messages from one OscSend at the same logical time as one bundle (on by default).";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
+    func = make_new_sfun( "int", "coalesce", osc_send_getCoalesce );
+    func->doc = "Whether same-time messages are coalesced into bundles.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
+    func = make_new_sfun( "int", "capacity", osc_send_setCapacity );
+    func->add_arg( "int", "packets" );
+    func->doc = "Set how many packets the send queue holds; when full, new packets are dropped.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
+    func = make_new_sfun( "int", "capacity", osc_send_getCapacity );
+    func->doc = "How many packets the send queue holds.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
+    func = make_new_sfun( "int", "pending", osc_send_pending );
+    func->doc = "Packets queued but not yet sent.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
+    func = make_new_sfun( "int", "queued", osc_send_queued );
+    func->doc = "Total packets queued so far.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
+    func = make_new_sfun( "int", "dropped", osc_send_dropped );
+    func->doc = "Total packets dropped because the send queue was full.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
+    func = make_new_sfun( "int", "highWater", osc_send_highWater );
+    func->doc = "Most packets ever waiting in the send queue at once.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
+    func = make_new_sfun( "int", "datagrams", osc_send_datagrams );
+    func->doc = "Total UDP datagrams sent by the network thread.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
+    func = make_new_sfun( "int", "bundles", osc_send_bundles );
+    func->doc = "How many of those datagrams were coalesced bundles.";
+    if( !type_engine_import_sfun( env, func ) ) goto error;
+
     type_engine_import_class_end( env );
 
     // init base class
@@ -1244,6 +1295,21 @@ DLL_QUERY opensoundcontrol_query ( Chuck_DL_Query * query ) {
     func = make_new_mfun( "string", "getString", osc_address_next_string );
     if( !type_engine_import_mfun( env, func ) ) goto error;
 
+    func = make_new_mfun( "int", "getFloats", osc_address_next_floats );
+    func->add_arg( "float[]", "values" );
+    func->doc = "Read the numeric arguments left in the current message into values (resized to fit); stops at the first non-numeric argument. Returns the count.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    func = make_new_mfun( "int", "getInts", osc_address_next_ints );
+    func->add_arg( "int[]", "values" );
+    func->doc = "Read the numeric arguments left in the current message into values (resized to fit; floats are truncated). Returns the count.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
+    func = make_new_mfun( "int", "getBlob", osc_address_next_blob );
+    func->add_arg( "int[]", "bytes" );
+    func->doc = "Read the next argument, a blob, into bytes (one 0-255 value per byte, resized to fit). Returns the size.";
+    if( !type_engine_import_mfun( env, func ) ) goto error;
+
     func = make_new_mfun( "int", "can_wait", osc_address_can_wait );
     if( !type_engine_import_mfun( env, func ) ) goto error;
 
@@ -1346,6 +1412,7 @@ CK_DLL_MFUN( osc_send_setHost ) {
 //-----------------------------------------------
 CK_DLL_MFUN( osc_send_startMesg ) { 
     OSC_Transmitter* xmit = (OSC_Transmitter *)OBJ_MEMBER_INT(SELF, osc_send_offset_data);
+    xmit->setNow( SHRED->now );
     Chuck_String* address = GET_NEXT_STRING(ARGS);
     Chuck_String* args = GET_NEXT_STRING(ARGS);
     xmit->startMessage( (char*) address->str().c_str(), (char*) args->str().c_str() );
@@ -1357,6 +1424,7 @@ CK_DLL_MFUN( osc_send_startMesg ) {
 //-----------------------------------------------
 CK_DLL_MFUN( osc_send_startMesg_spec ) { 
     OSC_Transmitter* xmit = (OSC_Transmitter *)OBJ_MEMBER_INT(SELF, osc_send_offset_data);
+    xmit->setNow( SHRED->now );
     Chuck_String* spec = GET_NEXT_STRING(ARGS);
     xmit->startMessage( (char*) spec->str().c_str() );
 }
@@ -1367,6 +1435,7 @@ CK_DLL_MFUN( osc_send_startMesg_spec ) {
 //-----------------------------------------------
 CK_DLL_MFUN( osc_send_addInt ) { 
     OSC_Transmitter* xmit = (OSC_Transmitter *)OBJ_MEMBER_INT(SELF, osc_send_offset_data);
+    xmit->setNow( SHRED->now );
     xmit->addInt( GET_NEXT_INT(ARGS) );
 }
 
@@ -1376,6 +1445,7 @@ CK_DLL_MFUN( osc_send_addInt ) {
 //-----------------------------------------------
 CK_DLL_MFUN( osc_send_addFloat ) { 
     OSC_Transmitter* xmit = (OSC_Transmitter *)OBJ_MEMBER_INT(SELF, osc_send_offset_data);
+    xmit->setNow( SHRED->now );
     xmit->addFloat( (float)(GET_NEXT_FLOAT(ARGS)) );
 }
 
@@ -1385,6 +1455,7 @@ CK_DLL_MFUN( osc_send_addFloat ) {
 //-----------------------------------------------
 CK_DLL_MFUN( osc_send_addString ) { 
     OSC_Transmitter* xmit = (OSC_Transmitter *)OBJ_MEMBER_INT(SELF, osc_send_offset_data);
+    xmit->setNow( SHRED->now );
     xmit->addString( (char*)(GET_NEXT_STRING(ARGS))->str().c_str() );
 }
 
@@ -1405,6 +1476,7 @@ CK_DLL_MFUN( osc_send_openBundle ) {
 //-----------------------------------------------
 CK_DLL_MFUN( osc_send_closeBundle ) { 
     OSC_Transmitter* xmit = (OSC_Transmitter *)OBJ_MEMBER_INT(SELF, osc_send_offset_data);
+    xmit->setNow( SHRED->now );
     xmit->closeBundle();
 }
 
@@ -1423,9 +1495,84 @@ CK_DLL_MFUN( osc_send_holdMesg ) {
 //-----------------------------------------------
 CK_DLL_MFUN( osc_send_kickMesg ) { 
     OSC_Transmitter* xmit = (OSC_Transmitter *)OBJ_MEMBER_INT(SELF, osc_send_offset_data);
+    xmit->setNow( SHRED->now );
     xmit->kickMessage();
 }
 
+//----------------------------------------------
+// name :  osc_send_setAsync 
+// desc : MFUN function 
+//-----------------------------------------------
+CK_DLL_MFUN( osc_send_setAsync ) { 
+    OSC_Transmitter* xmit = (OSC_Transmitter *)OBJ_MEMBER_INT(SELF, osc_send_offset_data);
+    xmit->setAsync( GET_NEXT_INT(ARGS) != 0 );
+    RETURN->v_int = xmit->async();
+}
+
+//----------------------------------------------
+// name :  osc_send_getAsync 
+// desc : MFUN function 
+//-----------------------------------------------
+CK_DLL_MFUN( osc_send_getAsync ) { 
+    OSC_Transmitter* xmit = (OSC_Transmitter *)OBJ_MEMBER_INT(SELF, osc_send_offset_data);
+    RETURN->v_int = xmit->async();
+}
+
+//----------------------------------------------
+// name :  osc_send_setCoalesce 
+// desc : SFUN function 
+//-----------------------------------------------
+CK_DLL_SFUN( osc_send_setCoalesce ) { 
+    OSC_Send_Queue::shared()->set_coalesce( GET_NEXT_INT(ARGS) != 0 );
+    RETURN->v_int = OSC_Send_Queue::shared()->coalesce();
+}
+
+CK_DLL_SFUN( osc_send_getCoalesce ) { 
+    RETURN->v_int = OSC_Send_Queue::shared()->coalesce();
+}
+
+//----------------------------------------------
+// name :  osc_send_setCapacity 
+// desc : SFUN function 
+//-----------------------------------------------
+CK_DLL_SFUN( osc_send_setCapacity ) { 
+    t_CKINT n = GET_NEXT_INT(ARGS);
+    OSC_Send_Queue::shared()->set_capacity( n > 0 ? n : 1 );
+    RETURN->v_int = OSC_Send_Queue::shared()->capacity();
+}
+
+CK_DLL_SFUN( osc_send_getCapacity ) { 
+    RETURN->v_int = OSC_Send_Queue::shared()->capacity();
+}
+
+//----------------------------------------------
+// name :  osc_send_pending, ... 
+// desc : SFUN functions - send queue statistics 
+//-----------------------------------------------
+CK_DLL_SFUN( osc_send_pending ) { 
+    RETURN->v_int = OSC_Send_Queue::shared()->pending();
+}
+
+CK_DLL_SFUN( osc_send_queued ) { 
+    RETURN->v_int = OSC_Send_Queue::shared()->queued();
+}
+
+CK_DLL_SFUN( osc_send_dropped ) { 
+    RETURN->v_int = OSC_Send_Queue::shared()->dropped();
+}
+
+CK_DLL_SFUN( osc_send_highWater ) { 
+    RETURN->v_int = OSC_Send_Queue::shared()->high_water();
+}
+
+CK_DLL_SFUN( osc_send_datagrams ) { 
+    RETURN->v_int = OSC_Send_Queue::shared()->datagrams();
+}
+
+CK_DLL_SFUN( osc_send_bundles ) { 
+    RETURN->v_int = OSC_Send_Queue::shared()->bundles();
+}
+
 //----------------------------------------------
 // name :  osc_address_ctor  
 // desc : CTOR function 
@@ -1506,6 +1653,58 @@ CK_DLL_MFUN( osc_address_next_string  ) {
     RETURN->v_string = ckstr;
 }
 
+//----------------------------------------------
+// name : osc_address_next_floats   
+// desc : MFUN function 
+//-----------------------------------------------
+CK_DLL_MFUN( osc_address_next_floats  ) { 
+    OSC_Address_Space * addr = (OSC_Address_Space *)OBJ_MEMBER_INT( SELF, osc_address_offset_data );
+    Chuck_Array8 * a = (Chuck_Array8 *)GET_NEXT_OBJECT(ARGS);
+    if( !a ) { throw_exception( SHRED, "NullPointerException", "OscEvent.getFloats: array is null" ); return; }
+
+    // sized for everything left, then shrunk to what was numeric
+    t_CKINT n = addr->remaining();
+    a->set_size( n );
+    n = n ? addr->next_floats( &a->m_vector[0], n ) : 0;
+    a->set_size( n );
+    RETURN->v_int = n;
+}
+
+//----------------------------------------------
+// name : osc_address_next_ints   
+// desc : MFUN function 
+//-----------------------------------------------
+CK_DLL_MFUN( osc_address_next_ints  ) { 
+    OSC_Address_Space * addr = (OSC_Address_Space *)OBJ_MEMBER_INT( SELF, osc_address_offset_data );
+    Chuck_Array4 * a = (Chuck_Array4 *)GET_NEXT_OBJECT(ARGS);
+    if( !a ) { throw_exception( SHRED, "NullPointerException", "OscEvent.getInts: array is null" ); return; }
+
+    t_CKINT n = addr->remaining();
+    a->set_size( n );
+    n = n ? addr->next_ints( (t_CKINT *)&a->m_vector[0], n ) : 0;
+    a->set_size( n );
+    RETURN->v_int = n;
+}
+
+//----------------------------------------------
+// name : osc_address_next_blob   
+// desc : MFUN function 
+//-----------------------------------------------
+CK_DLL_MFUN( osc_address_next_blob  ) { 
+    OSC_Address_Space * addr = (OSC_Address_Space *)OBJ_MEMBER_INT( SELF, osc_address_offset_data );
+    Chuck_Array4 * a = (Chuck_Array4 *)GET_NEXT_OBJECT(ARGS);
+    if( !a ) { throw_exception( SHRED, "NullPointerException", "OscEvent.getBlob: array is null" ); return; }
+
+    t_CKINT n = addr->blob_size();
+    // not a blob: next_blob() reports the type mismatch
+    unsigned char * b = (unsigned char *)addr->next_blob();
+    if( !b || n < 0 ) n = 0;
+    a->set_size( n );
+    for( t_CKINT i = 0; i < n; i++ )
+        a->m_vector[i] = b[i];
+    RETURN->v_int = n;
+}
+
 
 // OscRecv functions 
 
@@ -53,6 +53,18 @@ CK_DLL_MFUN ( osc_send_openBundle );
 CK_DLL_MFUN ( osc_send_closeBundle );
 CK_DLL_MFUN ( osc_send_holdMesg );
 CK_DLL_MFUN ( osc_send_kickMesg );
+CK_DLL_MFUN ( osc_send_setAsync );
+CK_DLL_MFUN ( osc_send_getAsync );
+CK_DLL_SFUN ( osc_send_setCoalesce );
+CK_DLL_SFUN ( osc_send_getCoalesce );
+CK_DLL_SFUN ( osc_send_setCapacity );
+CK_DLL_SFUN ( osc_send_getCapacity );
+CK_DLL_SFUN ( osc_send_pending );
+CK_DLL_SFUN ( osc_send_queued );
+CK_DLL_SFUN ( osc_send_dropped );
+CK_DLL_SFUN ( osc_send_highWater );
+CK_DLL_SFUN ( osc_send_datagrams );
+CK_DLL_SFUN ( osc_send_bundles );
 
 CK_DLL_CTOR ( osc_address_ctor );
 CK_DLL_DTOR ( osc_address_dtor );
@@ -63,6 +75,9 @@ CK_DLL_MFUN ( osc_address_next_mesg );
 CK_DLL_MFUN ( osc_address_next_int );
 CK_DLL_MFUN ( osc_address_next_float );
 CK_DLL_MFUN ( osc_address_next_string );
+CK_DLL_MFUN ( osc_address_next_floats );
+CK_DLL_MFUN ( osc_address_next_ints );
+CK_DLL_MFUN ( osc_address_next_blob );
 
 CK_DLL_CTOR ( osc_recv_ctor );
 CK_DLL_DTOR ( osc_recv_dtor );
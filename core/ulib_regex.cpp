@@ -35,6 +35,7 @@
 #include "chuck_instr.h"
 #include "chuck_type.h"
 #include "chuck_vm.h"
+#include "util_thread.h"
 
 #ifdef WIN32
 #include "regex/regex.h"
@@ -42,13 +43,31 @@
 #include <regex.h>
 #endif
 
+#include <list>
+#include <map>
+#include <string>
+
 #define CK_REGEX_MAX_MATCHES (10)
+// number of compiled patterns kept for the static functions
+#define CK_REGEX_CACHE_SIZE (32)
 
 CK_DLL_SFUN( regex_match );
 CK_DLL_SFUN( regex_match2 );
 CK_DLL_SFUN( regex_replace );
 CK_DLL_SFUN( regex_replaceAll );
 
+CK_DLL_CTOR( regex_ctor );
+CK_DLL_DTOR( regex_dtor );
+CK_DLL_MFUN( regex_compile );
+CK_DLL_MFUN( regex_pattern );
+CK_DLL_MFUN( regex_obj_match );
+CK_DLL_MFUN( regex_obj_match2 );
+CK_DLL_MFUN( regex_obj_replace );
+CK_DLL_MFUN( regex_obj_replaceAll );
+
+static t_CKUINT regex_offset_data = 0;
+
+
 DLL_QUERY regex_query( Chuck_DL_Query * QUERY )
 {
     // set name
@@ -57,6 +76,12 @@ DLL_QUERY regex_query( Chuck_DL_Query * QUERY )
     // begin class
     QUERY->begin_class( QUERY, "RegEx", "Object" );
     
+    // compiled pattern of a RegEx object
+    regex_offset_data = QUERY->add_mvar( QUERY, "int", "@RegEx_data", FALSE );
+    
+    QUERY->add_ctor( QUERY, regex_ctor );
+    QUERY->add_dtor( QUERY, regex_dtor );
+    
     // add match
     QUERY->add_sfun( QUERY, regex_match, "int", "match" );
     QUERY->add_arg( QUERY, "string", "pattern");
@@ -80,6 +105,33 @@ DLL_QUERY regex_query( Chuck_DL_Query * QUERY )
     QUERY->add_arg( QUERY, "string", "replacement");
     QUERY->add_arg( QUERY, "string", "str");
     
+    // add compile (object form: compile once, match many times)
+    QUERY->add_mfun( QUERY, regex_compile, "int", "compile" );
+    QUERY->add_arg( QUERY, "string", "pattern");
+    
+    // add pattern
+    QUERY->add_mfun( QUERY, regex_pattern, "string", "pattern" );
+    
+    // add test (object form of match; member functions cannot
+    // share a name with the static ones)
+    QUERY->add_mfun( QUERY, regex_obj_match, "int", "test" );
+    QUERY->add_arg( QUERY, "string", "str");
+    
+    // add test2 (object form of match2)
+    QUERY->add_mfun( QUERY, regex_obj_match2, "int", "test" );
+    QUERY->add_arg( QUERY, "string", "str");
+    QUERY->add_arg( QUERY, "string[]", "matches");
+    
+    // add sub (object form of replace)
+    QUERY->add_mfun( QUERY, regex_obj_replace, "string", "sub" );
+    QUERY->add_arg( QUERY, "string", "replacement");
+    QUERY->add_arg( QUERY, "string", "str");
+    
+    // add subAll (object form of replaceAll)
+    QUERY->add_mfun( QUERY, regex_obj_replaceAll, "string", "subAll" );
+    QUERY->add_arg( QUERY, "string", "replacement");
+    QUERY->add_arg( QUERY, "string", "str");
+    
     QUERY->end_class( QUERY );
     
     return TRUE;
@@ -90,315 +142,486 @@ error:
 }
 
 
-CK_DLL_SFUN( regex_match )
+
+
+//-----------------------------------------------------------------------------
+// name: struct RegEx_Compiled
+// desc: a compiled pattern, shared between the static-function cache and
+//       RegEx objects; freed when the last holder lets go
+//-----------------------------------------------------------------------------
+struct RegEx_Compiled
 {
-    Chuck_String * pattern = GET_NEXT_STRING(ARGS);
-    Chuck_String * str = GET_NEXT_STRING(ARGS);
-    
     regex_t regex;
-    t_CKBOOL r_free = FALSE;
-    int result = 0;
+    std::string pattern;
+    int flags;
+    // holders: the cache and any RegEx objects (under g_regex_lock)
+    t_CKUINT refs;
+};
+
+typedef std::pair<std::string, int> RegEx_Key;
+typedef std::list<RegEx_Compiled *> RegEx_LRU;
+
+// most recently used first
+static RegEx_LRU g_regex_lru;
+static std::map<RegEx_Key, RegEx_LRU::iterator> g_regex_index;
+// static functions can be called from several VMs at once
+static XMutex g_regex_lock;
+
+
+//-----------------------------------------------------------------------------
+// name: regex_release_compiled()
+// desc: drop a hold on a compiled pattern (lock held)
+//-----------------------------------------------------------------------------
+static void regex_release_compiled( RegEx_Compiled * c )
+{
+    if( --c->refs == 0 )
+    {
+        regfree( &c->regex );
+        delete c;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// name: regex_acquire()
+// desc: get the compiled form of pattern, from the cache or by compiling it
+//       and caching the result, with a hold for the caller; on a compile
+//       error, reports it on behalf of 'who' and returns NULL
+//-----------------------------------------------------------------------------
+static RegEx_Compiled * regex_acquire( const std::string & pattern, int flags, const char * who )
+{
+    RegEx_Compiled * c = NULL;
     
-    if(pattern == NULL)
+    g_regex_lock.acquire();
+    
+    std::map<RegEx_Key, RegEx_LRU::iterator>::iterator it =
+        g_regex_index.find( RegEx_Key( pattern, flags ) );
+    if( it != g_regex_index.end() )
     {
-        throw_exception(SHRED, "NullPointerException", "RegEx.match: argument 'pattern' is null");
-        goto error;
+        // move to front
+        g_regex_lru.splice( g_regex_lru.begin(), g_regex_lru, it->second );
+        c = *it->second;
+        c->refs++;
+        g_regex_lock.release();
+        return c;
     }
-    if(str == NULL)
+    
+    c = new RegEx_Compiled;
+    int result = regcomp( &c->regex, pattern.c_str(), flags );
+    if( result != 0 )
     {
-        throw_exception(SHRED, "NullPointerException", "RegEx.match: argument 'str' is null");
-        goto error;
+        g_regex_lock.release();
+        
+        char errbuf[256];
+        regerror( result, &c->regex, errbuf, 256 );
+        EM_error2( 0, "(%s): regex reported error: %s", who, errbuf );
+        
+        delete c;
+        return NULL;
     }
     
-    result = regcomp(&regex, pattern->str().c_str(), REG_EXTENDED | REG_NOSUB);
-    if(result != 0)
-        goto error;
+    c->pattern = pattern;
+    c->flags = flags;
+    // one for the cache, one for the caller
+    c->refs = 2;
+    g_regex_lru.push_front( c );
+    g_regex_index[RegEx_Key( pattern, flags )] = g_regex_lru.begin();
     
-    r_free = TRUE;
+    // evict least recently used
+    if( g_regex_lru.size() > CK_REGEX_CACHE_SIZE )
+    {
+        RegEx_Compiled * old = g_regex_lru.back();
+        g_regex_index.erase( RegEx_Key( old->pattern, old->flags ) );
+        g_regex_lru.pop_back();
+        regex_release_compiled( old );
+    }
     
-    result = regexec(&regex, str->str().c_str(), 0, NULL, 0);
+    g_regex_lock.release();
     
-    RETURN->v_int = (result == 0 ? 1 : 0);
+    return c;
+}
+
+
+//-----------------------------------------------------------------------------
+// name: regex_release()
+// desc: give back a hold from regex_acquire()
+//-----------------------------------------------------------------------------
+static void regex_release( RegEx_Compiled * c )
+{
+    g_regex_lock.acquire();
+    regex_release_compiled( c );
+    g_regex_lock.release();
+}
+
+
+//-----------------------------------------------------------------------------
+// name: regex_do_match()
+// desc: match str against a compiled pattern; if matches is not NULL, fill it
+//       with the whole match and each subexpression.  strings already in
+//       matches that nothing else refers to are overwritten in place rather
+//       than reallocated
+//-----------------------------------------------------------------------------
+static t_CKINT regex_do_match( Chuck_VM_Shred * SHRED, RegEx_Compiled * c,
+                               const std::string & str, Chuck_Array4 * matches )
+{
+    if( matches == NULL )
+        return regexec( &c->regex, str.c_str(), 0, NULL, 0 ) == 0 ? 1 : 0;
     
-    regfree(&regex);
-    r_free = FALSE;
+    // signed, like the array's size()
+    t_CKINT n = (t_CKINT)c->regex.re_nsub + 1;
+    regmatch_t buf[CK_REGEX_MAX_MATCHES];
+    regmatch_t * matcharray = n <= CK_REGEX_MAX_MATCHES ? buf : new regmatch_t[n];
     
-    return;
+    int result = regexec( &c->regex, str.c_str(), n, matcharray, 0 );
     
-error:
-    if(result != 0)
+    if( result != 0 )
     {
-        char buf[256];
+        matches->set_size( 0 );
+    }
+    else
+    {
+        // drop what is past the new end, keep the rest for reuse
+        if( matches->size() > n ) matches->set_size( n );
         
-        regerror(result, &regex, buf, 256);
-        EM_error2( 0, "(RegEx.match): regex reported error: %s", buf);
+        for( t_CKINT i = 0; i < n; i++ )
+        {
+            Chuck_String * match = NULL;
+            if( i < matches->size() )
+                match = (Chuck_String *)matches->m_vector[i];
+            
+            if( match == NULL || match->m_ref_count > 1 )
+            {
+                match = (Chuck_String *) instantiate_and_initialize_object(SHRED->vm_ref->env()->t_string, SHRED);
+                if( i < matches->size() ) matches->set( i, (t_CKUINT) match );
+                else matches->push_back( (t_CKUINT) match );
+            }
+            
+            if(matcharray[i].rm_so >= 0 && matcharray[i].rm_eo > 0)
+                match->set( std::string(str, matcharray[i].rm_so,
+                                         matcharray[i].rm_eo-matcharray[i].rm_so) );
+            else
+                match->set( "" );
+        }
     }
     
-    if(r_free)
+    if( matcharray != buf ) delete [] matcharray;
+    
+    return result == 0 ? 1 : 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// name: regex_do_replace()
+// desc: replace the first (or every) match of a compiled pattern in s
+//-----------------------------------------------------------------------------
+static void regex_do_replace( RegEx_Compiled * c, const std::string & replace,
+                              std::string & s, t_CKBOOL all )
+{
+    size_t n = c->regex.re_nsub + 1;
+    regmatch_t buf[CK_REGEX_MAX_MATCHES];
+    regmatch_t * matcharray = n <= CK_REGEX_MAX_MATCHES ? buf : new regmatch_t[n];
+    size_t pos = 0;
+    
+    do
     {
-        regfree(&regex);
-        r_free = FALSE;
-    }
+        // past the start of the string, '^' must not match again
+        int result = regexec( &c->regex, s.c_str()+pos, n, matcharray,
+                              pos > 0 ? REG_NOTBOL : 0 );
         
-    RETURN->v_int = 0;
+        // perform substitution
+        if( result != 0 || matcharray[0].rm_so < 0 || matcharray[0].rm_eo < 0 )
+            break;
+        
+        s.replace( pos+matcharray[0].rm_so,
+                   matcharray[0].rm_eo-matcharray[0].rm_so, replace );
+        
+        pos = pos + matcharray[0].rm_so + replace.size();
+        // step over an empty match so it is not found again
+        if( matcharray[0].rm_eo == matcharray[0].rm_so ) pos++;
+    } while( all && pos < s.size() );
+    
+    if( matcharray != buf ) delete [] matcharray;
 }
 
 
-CK_DLL_SFUN( regex_match2 )
+CK_DLL_SFUN( regex_match )
 {
     Chuck_String * pattern = GET_NEXT_STRING(ARGS);
     Chuck_String * str = GET_NEXT_STRING(ARGS);
-    Chuck_Array4 * matches = (Chuck_Array4 *) GET_NEXT_OBJECT(ARGS);
     
-    regex_t regex;
-    t_CKBOOL r_free = FALSE;
-    size_t i;
-    regmatch_t *matcharray = NULL;
-    int result = 0;
+    RETURN->v_int = 0;
     
     if(pattern == NULL)
     {
         throw_exception(SHRED, "NullPointerException", "RegEx.match: argument 'pattern' is null");
-        goto error;
+        return;
     }
     if(str == NULL)
     {
         throw_exception(SHRED, "NullPointerException", "RegEx.match: argument 'str' is null");
-        goto error;
-    }
-    if(matches == NULL)
-    {
-        throw_exception(SHRED, "NullPointerException", "RegEx.match: argument 'matches' is null");
-        goto error;
+        return;
     }
     
+    RegEx_Compiled * c = regex_acquire( pattern->str(), REG_EXTENDED | REG_NOSUB, "RegEx.match" );
+    if( c == NULL )
+        return;
     
-    //matches->clear();
-    // bugfix: array.clear() doesnt seem to work? 
-    matches->set_size(0);
-    
-    result = regcomp(&regex, pattern->str().c_str(), REG_EXTENDED);
-    if(result != 0)
-        goto error;
-    
-    r_free = TRUE;
-    
-    matcharray = new regmatch_t[regex.re_nsub+1];
+    RETURN->v_int = regex_do_match( SHRED, c, str->str(), NULL );
     
-    result = regexec(&regex, str->str().c_str(), regex.re_nsub+1, matcharray, 0);
+    regex_release( c );
+}
+
+
+CK_DLL_SFUN( regex_match2 )
+{
+    Chuck_String * pattern = GET_NEXT_STRING(ARGS);
+    Chuck_String * str = GET_NEXT_STRING(ARGS);
+    Chuck_Array4 * matches = (Chuck_Array4 *) GET_NEXT_OBJECT(ARGS);
     
-    RETURN->v_int = (result == 0 ? 1 : 0);
+    RETURN->v_int = 0;
     
-    regfree(&regex);
-    r_free = FALSE;
-
-    if(result == 0)
+    if(pattern == NULL)
     {
-        for(i = 0; i < regex.re_nsub+1; i++)
-        {
-            Chuck_String * match = (Chuck_String *) instantiate_and_initialize_object(SHRED->vm_ref->env()->t_string, SHRED);
-            
-            if(matcharray[i].rm_so >= 0 && matcharray[i].rm_eo > 0)
-                match->set( std::string(str->str(), matcharray[i].rm_so,
-                                         matcharray[i].rm_eo-matcharray[i].rm_so) );
-                                         
-            matches->push_back((t_CKUINT) match);
-        }
+        throw_exception(SHRED, "NullPointerException", "RegEx.match: argument 'pattern' is null");
+        return;
     }
-    
-    SAFE_DELETE(matcharray);
-    
-    return;
-    
-error:
-    if(result != 0)
+    if(str == NULL)
     {
-        char errbuf[256];
-        
-        regerror(result, &regex, errbuf, 256);
-        EM_error2( 0, "(RegEx.match): regex reported error: %s", errbuf);
+        throw_exception(SHRED, "NullPointerException", "RegEx.match: argument 'str' is null");
+        return;
+    }
+    if(matches == NULL)
+    {
+        throw_exception(SHRED, "NullPointerException", "RegEx.match: argument 'matches' is null");
+        return;
     }
     
-    if(r_free)
+    RegEx_Compiled * c = regex_acquire( pattern->str(), REG_EXTENDED, "RegEx.match" );
+    if( c == NULL )
     {
-        regfree(&regex);
-        r_free = FALSE;
+        matches->set_size( 0 );
+        return;
     }
     
-    SAFE_DELETE(matcharray);
+    RETURN->v_int = regex_do_match( SHRED, c, str->str(), matches );
     
-    RETURN->v_int = 0;
+    regex_release( c );
 }
 
 
-CK_DLL_SFUN( regex_replace )
+//-----------------------------------------------------------------------------
+// name: regex_static_replace()
+// desc: shared body of the static replace/replaceAll
+//-----------------------------------------------------------------------------
+static void regex_static_replace( void * ARGS, Chuck_DL_Return * RETURN,
+                                  Chuck_VM_Shred * SHRED, t_CKBOOL all )
 {
     Chuck_String * pattern = GET_NEXT_STRING(ARGS);
     Chuck_String * replace = GET_NEXT_STRING(ARGS);
     Chuck_String * str = GET_NEXT_STRING(ARGS);
     
-    Chuck_String * ret = (Chuck_String *) instantiate_and_initialize_object(SHRED->vm_ref->env()->t_string, SHRED);
-    ret->set( str->str() );
-    
-    regex_t regex;
-    t_CKBOOL r_free = FALSE;
-    regmatch_t *matcharray = NULL;
-    int result = 0;
+    RETURN->v_string = NULL;
     
     if(pattern == NULL)
     {
         throw_exception(SHRED, "NullPointerException",
                         "RegEx.match: argument 'pattern' is null");
-        goto error;
+        return;
     }
     if(str == NULL)
     {
         throw_exception(SHRED, "NullPointerException",
                         "RegEx.match: argument 'str' is null");
-        goto error;
+        return;
     }
     if(replace == NULL)
     {
         throw_exception(SHRED, "NullPointerException",
                         "RegEx.match: argument 'replace' is null");
-        goto error;
+        return;
     }
     
-    // compile regex
-    result = regcomp(&regex, pattern->str().c_str(), REG_EXTENDED);
-    if(result != 0)
-        goto error;
+    RegEx_Compiled * c = regex_acquire( pattern->str(), REG_EXTENDED,
+                                        all ? "RegEx.replaceAll" : "RegEx.replace" );
+    if( c == NULL )
+        return;
     
-    r_free = TRUE;
+    std::string s = str->str();
+    regex_do_replace( c, replace->str(), s, all );
     
-    // perform match
-    matcharray = new regmatch_t[regex.re_nsub+1];
-    result = regexec(&regex, str->str().c_str(), regex.re_nsub+1, matcharray, 0);
+    regex_release( c );
     
-    regfree(&regex);
-    r_free = FALSE;
+    Chuck_String * ret = (Chuck_String *) instantiate_and_initialize_object(SHRED->vm_ref->env()->t_string, SHRED);
+    ret->set( s );
+    RETURN->v_string = ret;
+}
+
+
+CK_DLL_SFUN( regex_replace )
+{
+    regex_static_replace( ARGS, RETURN, SHRED, FALSE );
+}
+
+
+CK_DLL_SFUN( regex_replaceAll )
+{
+    regex_static_replace( ARGS, RETURN, SHRED, TRUE );
+}
+
+
+CK_DLL_CTOR( regex_ctor )
+{
+    OBJ_MEMBER_UINT(SELF, regex_offset_data) = 0;
+}
+
+
+CK_DLL_DTOR( regex_dtor )
+{
+    RegEx_Compiled * c = (RegEx_Compiled *) OBJ_MEMBER_UINT(SELF, regex_offset_data);
+    if( c ) regex_release( c );
+    OBJ_MEMBER_UINT(SELF, regex_offset_data) = 0;
+}
+
+
+CK_DLL_MFUN( regex_compile )
+{
+    Chuck_String * pattern = GET_NEXT_STRING(ARGS);
+    
+    RETURN->v_int = 0;
     
-    // perform substitution
-    if(result == 0 && matcharray[0].rm_so >= 0 && matcharray[0].rm_eo >= 0)
+    if(pattern == NULL)
     {
-        std::string s = ret->str();
-        s.replace(matcharray[0].rm_so,
-                  matcharray[0].rm_eo-matcharray[0].rm_so, replace->str());
-        ret->set( s );
+        throw_exception(SHRED, "NullPointerException", "RegEx.compile: argument 'pattern' is null");
+        return;
     }
     
-    SAFE_DELETE(matcharray);
+    // a pattern that fails to compile leaves the object without one
+    RegEx_Compiled * old = (RegEx_Compiled *) OBJ_MEMBER_UINT(SELF, regex_offset_data);
+    RegEx_Compiled * c = regex_acquire( pattern->str(), REG_EXTENDED, "RegEx.compile" );
+    if( old ) regex_release( old );
+    OBJ_MEMBER_UINT(SELF, regex_offset_data) = (t_CKUINT) c;
+    
+    RETURN->v_int = c != NULL;
+}
+
+
+CK_DLL_MFUN( regex_pattern )
+{
+    RegEx_Compiled * c = (RegEx_Compiled *) OBJ_MEMBER_UINT(SELF, regex_offset_data);
     
+    Chuck_String * ret = (Chuck_String *) instantiate_and_initialize_object(SHRED->vm_ref->env()->t_string, SHRED);
+    if( c ) ret->set( c->pattern );
     RETURN->v_string = ret;
+}
+
+
+//-----------------------------------------------------------------------------
+// name: regex_get_compiled()
+// desc: the compiled pattern of a RegEx object; reports it missing otherwise
+//-----------------------------------------------------------------------------
+static RegEx_Compiled * regex_get_compiled( Chuck_Object * SELF, const char * who )
+{
+    RegEx_Compiled * c = (RegEx_Compiled *) OBJ_MEMBER_UINT(SELF, regex_offset_data);
+    if( c == NULL )
+        EM_error2( 0, "(%s): no pattern compiled", who );
+    return c;
+}
+
+
+CK_DLL_MFUN( regex_obj_match )
+{
+    Chuck_String * str = GET_NEXT_STRING(ARGS);
     
-    return;
+    RETURN->v_int = 0;
     
-error:
-    if(result != 0)
+    if(str == NULL)
     {
-        char errbuf[256];
-        
-        regerror(result, &regex, errbuf, 256);
-        EM_error2( 0, "(RegEx.match): regex reported error: %s", errbuf);
+        throw_exception(SHRED, "NullPointerException", "RegEx.test: argument 'str' is null");
+        return;
     }
     
-    if(r_free)
-    {
-        regfree(&regex);
-        r_free = FALSE;
-    }
+    RegEx_Compiled * c = regex_get_compiled( SELF, "RegEx.test" );
+    if( c == NULL )
+        return;
     
-    RETURN->v_int = 0;
+    RETURN->v_int = regex_do_match( SHRED, c, str->str(), NULL );
 }
 
 
-CK_DLL_SFUN( regex_replaceAll )
+CK_DLL_MFUN( regex_obj_match2 )
 {
-    Chuck_String * pattern = GET_NEXT_STRING(ARGS);
-    Chuck_String * replace = GET_NEXT_STRING(ARGS);
     Chuck_String * str = GET_NEXT_STRING(ARGS);
+    Chuck_Array4 * matches = (Chuck_Array4 *) GET_NEXT_OBJECT(ARGS);
     
-    Chuck_String * ret = (Chuck_String *) instantiate_and_initialize_object(SHRED->vm_ref->env()->t_string, SHRED);
-    ret->set( str->str() );
-    
-    regex_t regex;
-    t_CKBOOL r_free = FALSE;
-    regmatch_t *matcharray = NULL;
-    int result = 0;
-    size_t pos = 0;
+    RETURN->v_int = 0;
     
-    if(pattern == NULL)
-    {
-        throw_exception(SHRED, "NullPointerException",
-                        "RegEx.match: argument 'pattern' is null");
-        goto error;
-    }
     if(str == NULL)
     {
-        throw_exception(SHRED, "NullPointerException",
-                        "RegEx.match: argument 'str' is null");
-        goto error;
+        throw_exception(SHRED, "NullPointerException", "RegEx.test: argument 'str' is null");
+        return;
     }
-    if(replace == NULL)
+    if(matches == NULL)
     {
-        throw_exception(SHRED, "NullPointerException",
-                        "RegEx.match: argument 'replace' is null");
-        goto error;
+        throw_exception(SHRED, "NullPointerException", "RegEx.test: argument 'matches' is null");
+        return;
     }
     
-    // compile regex
-    result = regcomp(&regex, pattern->str().c_str(), REG_EXTENDED);
-    if(result != 0)
-        goto error;
-    
-    r_free = TRUE;
-    
-    // perform match
-    matcharray = new regmatch_t[regex.re_nsub+1];
-    
-    while(pos < str->str().size())
+    RegEx_Compiled * c = regex_get_compiled( SELF, "RegEx.test" );
+    if( c == NULL )
     {
-        result = regexec(&regex, ret->str().c_str()+pos, regex.re_nsub+1, matcharray, 0);
-        
-        // perform substitution
-        if(result != 0)
-            break;
-        else if(matcharray[0].rm_so >= 0 && matcharray[0].rm_eo >= 0)
-        {
-            std::string s = ret->str();
-            s.replace(pos+matcharray[0].rm_so,
-                      matcharray[0].rm_eo-matcharray[0].rm_so,
-                      replace->str());
-            ret->set( s );
-            
-            pos = pos + matcharray[0].rm_so + replace->str().size();
-        }
+        matches->set_size( 0 );
+        return;
     }
     
-    SAFE_DELETE(matcharray);
-    
-    regfree(&regex);
-    r_free = FALSE;
-    
-    RETURN->v_string = ret;
+    RETURN->v_int = regex_do_match( SHRED, c, str->str(), matches );
+}
+
+
+//-----------------------------------------------------------------------------
+// name: regex_obj_do_replace()
+// desc: shared body of the object replace/replaceAll
+//-----------------------------------------------------------------------------
+static void regex_obj_do_replace( Chuck_Object * SELF, void * ARGS, Chuck_DL_Return * RETURN,
+                                  Chuck_VM_Shred * SHRED, t_CKBOOL all )
+{
+    Chuck_String * replace = GET_NEXT_STRING(ARGS);
+    Chuck_String * str = GET_NEXT_STRING(ARGS);
     
-    return;
+    RETURN->v_string = NULL;
     
-error:
-    if(result != 0)
+    if(str == NULL)
     {
-        char errbuf[256];
-        
-        regerror(result, &regex, errbuf, 256);
-        EM_error2( 0, "(RegEx.match): regex reported error: %s", errbuf);
+        throw_exception(SHRED, "NullPointerException",
+                        "RegEx.sub: argument 'str' is null");
+        return;
     }
-    
-    if(r_free)
+    if(replace == NULL)
     {
-        regfree(&regex);
-        r_free = FALSE;
+        throw_exception(SHRED, "NullPointerException",
+                        "RegEx.sub: argument 'replace' is null");
+        return;
     }
     
-    RETURN->v_int = 0;
+    RegEx_Compiled * c = regex_get_compiled( SELF, all ? "RegEx.subAll" : "RegEx.sub" );
+    if( c == NULL )
+        return;
+    
+    std::string s = str->str();
+    regex_do_replace( c, replace->str(), s, all );
+    
+    Chuck_String * ret = (Chuck_String *) instantiate_and_initialize_object(SHRED->vm_ref->env()->t_string, SHRED);
+    ret->set( s );
+    RETURN->v_string = ret;
 }
 
+
+CK_DLL_MFUN( regex_obj_replace )
+{
+    regex_obj_do_replace( SELF, ARGS, RETURN, SHRED, FALSE );
+}
+
+
+CK_DLL_MFUN( regex_obj_replaceAll )
+{
+    regex_obj_do_replace( SELF, ARGS, RETURN, SHRED, TRUE );
+}
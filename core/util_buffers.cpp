@@ -35,6 +35,14 @@
 #include <stdlib.h>
 #include "util_buffers.h"
 #include "chuck_errmsg.h"
+#include <string.h>
+
+#if defined(__PLATFORM_WIN32__)
+  #include <windows.h>
+  #define CK_BUFFER_FENCE() MemoryBarrier()
+#else
+  #define CK_BUFFER_FENCE() __sync_synchronize()
+#endif
 
 
 #ifndef CALLBACK
@@ -233,12 +241,16 @@ void CBufferAdvance::put( void * data, UINT__ num_elem )
                 // invalidate its read_offset
                 // m_read_offsets[j].read_offset = -1;
             }
-
-            if( m_read_offsets[j].event )
-                m_read_offsets[j].event->queue_broadcast( m_event_buffer );
         }
     }
 
+    // one wakeup per put, however many elements
+    for( j = 0; num_elem && j < m_read_offsets.size(); j++ )
+    {
+        if( m_read_offsets[j].event )
+            m_read_offsets[j].event->queue_broadcast( m_event_buffer );
+    }
+
     // TODO: necessary?
     m_mutex.release();
 }
@@ -246,6 +258,69 @@ void CBufferAdvance::put( void * data, UINT__ num_elem )
 
 
 
+//-----------------------------------------------------------------------------
+// name: write()
+// desc: put without waking readers (they are woken separately, see wake());
+//       a reader the write laps loses its oldest element instead of its
+//       whole backlog
+//-----------------------------------------------------------------------------
+void CBufferAdvance::write( void * data, UINT__ num_elem )
+{
+    UINT__ i, j;
+    BYTE__ * d = (BYTE__ *)data;
+    SINT__ w = m_write_offset;
+
+    // readers move their offsets under this
+    m_mutex.acquire();
+
+    for( i = 0; i < num_elem; i++ )
+    {
+        memcpy( m_data + w * m_data_width, d + i * m_data_width, m_data_width );
+        // wrap
+        if( ++w >= m_max_elem )
+            w = 0;
+
+        // caught up with a reader: it would look empty, so push it ahead
+        for( j = 0; j < m_read_offsets.size(); j++ )
+        {
+            if( m_read_offsets[j].read_offset == w )
+            {
+                if( ++m_read_offsets[j].read_offset >= m_max_elem )
+                    m_read_offsets[j].read_offset = 0;
+            }
+        }
+    }
+
+    // publish the data before the offset
+    CK_BUFFER_FENCE();
+    m_write_offset = w;
+
+    m_mutex.release();
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: wake()
+// desc: broadcast to every reader's event
+//-----------------------------------------------------------------------------
+void CBufferAdvance::wake()
+{
+    m_mutex.acquire();
+
+    for( UINT__ j = 0; j < m_read_offsets.size(); j++ )
+    {
+        if( m_read_offsets[j].event )
+            m_read_offsets[j].event->broadcast();
+    }
+
+    m_mutex.release();
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: get()
 // desc: get
@@ -442,20 +517,38 @@ void CBufferSimple::put( void * data, UINT__ num_elem )
 {
     UINT__ i, j;
     BYTE__ * d = (BYTE__ *)data;
+    UINT__ write_offset = m_write_offset;
 
     // copy
     for( i = 0; i < num_elem; i++ )
     {
         for( j = 0; j < m_data_width; j++ )
         {
-            m_data[m_write_offset*m_data_width+j] = d[i*m_data_width+j];
+            m_data[write_offset*m_data_width+j] = d[i*m_data_width+j];
         }
 
-        // move the write
-        // Aug 2014 - spencer
-        // change to fully "atomic" increment+wrap
-        m_write_offset = (m_write_offset + 1) % m_max_elem;
+        write_offset = (write_offset + 1) % m_max_elem;
     }
+
+    // move the write, once: the reader sees all num_elem or none
+    // Aug 2014 - spencer
+    // change to fully "atomic" increment+wrap
+    CK_BUFFER_FENCE();
+    m_write_offset = write_offset;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: space()
+// desc: free slots; one always stays empty, so that full and empty differ.
+//       the reader only ever frees more, so the answer is safe to act on
+//-----------------------------------------------------------------------------
+UINT__ CBufferSimple::space()
+{
+    UINT__ read_offset = m_read_offset;
+    return ( read_offset + m_max_elem - m_write_offset - 1 ) % m_max_elem;
 }
 
 
@@ -502,6 +595,18 @@ UINT__ CBufferSimple::get( void * data, UINT__ num_elem )
 
 
 
+//-----------------------------------------------------------------------------
+// name: empty()
+// desc: nothing to get
+//-----------------------------------------------------------------------------
+BOOL__ CBufferSimple::empty()
+{
+    return m_read_offset == m_write_offset;
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: AccumBuffer()
 // desc: constructor
@@ -73,6 +73,10 @@ public:
 public:
     UINT__ get( void * data, UINT__ num_elem, UINT__ read_offset_index );
     void put( void * data, UINT__ num_elem );
+    // put, without waking readers; one writer thread only
+    void write( void * data, UINT__ num_elem );
+    // wake all readers (VM thread)
+    void wake();
     BOOL__ empty( UINT__ read_offset_index );
     UINT__ join( Chuck_Event * event = NULL );
     void resign( UINT__ read_offset_index );
@@ -94,7 +98,7 @@ protected:
     std::vector<ReadOffset> m_read_offsets;
     std::queue<UINT__> m_free;
 
-    SINT__   m_write_offset;
+    volatile SINT__ m_write_offset;
     SINT__   m_max_elem;
 
     // TODO: necessary?
@@ -123,12 +127,15 @@ public:
 public:
     UINT__ get( void * data, UINT__ num_elem );
     void put( void * data, UINT__ num_elem );
+    BOOL__ empty();
+    // how many elements put() can take now (writer side)
+    UINT__ space();
 
 protected:
     BYTE__ * m_data;
     UINT__   m_data_width;
     UINT__   m_read_offset;
-    UINT__   m_write_offset;
+    volatile UINT__ m_write_offset;
     UINT__   m_max_elem;
 };
 
@@ -190,9 +197,21 @@ protected:
 
 
 
+// CircularBuffer indices: one thread puts, one thread gets; the element is
+// written before the index that hands it over
+#if defined(__GNUC__)
+  #define CK_RING_LOAD(p) __atomic_load_n( (p), __ATOMIC_ACQUIRE )
+  #define CK_RING_STORE(p,v) __atomic_store_n( (p), (v), __ATOMIC_RELEASE )
+#else
+  // msvc: volatile accesses are acquire / release
+  #define CK_RING_LOAD(p) ( *(volatile size_t *)(p) )
+  #define CK_RING_STORE(p,v) ( *(volatile size_t *)(p) = (v) )
+#endif
+
 //-----------------------------------------------------------------------------
 // name: class CircularBuffer
-// desc: templated circular buffer
+// desc: templated circular buffer; safe for one producer and one consumer
+//       thread
 //-----------------------------------------------------------------------------
 template<typename T>
 class CircularBuffer
@@ -220,7 +239,7 @@ public:
     // returns number of elements successfully put
     size_t put(T element)
     {
-        if((m_write + 1)%m_numElements == m_read)
+        if((m_write + 1)%m_numElements == CK_RING_LOAD(&m_read))
         {
             // no space
             return 0;
@@ -228,7 +247,7 @@ public:
         
         m_elements[m_write] = element;
         
-        m_write = (m_write+1)%m_numElements;
+        CK_RING_STORE(&m_write, (m_write+1)%m_numElements);
         
         return 1;
     }
@@ -237,7 +256,7 @@ public:
     // returns number of elements successfully got
     size_t get(T &element)
     {
-        if(m_read == m_write)
+        if(m_read == CK_RING_LOAD(&m_write))
         {
             // nothing to get
             return 0;
@@ -245,7 +264,7 @@ public:
         
         element = m_elements[m_read];
         
-        m_read = (m_read+1)%m_numElements;
+        CK_RING_STORE(&m_read, (m_read+1)%m_numElements);
         
         return 1;
     }
@@ -268,23 +287,24 @@ public:
         return 0;
     }
     
-    void clear() { m_write = m_read; }
+    void clear() { CK_RING_STORE(&m_write, CK_RING_LOAD(&m_read)); }
     
     // return maximum number of elements that can be held
     size_t maxElements() { return m_numElements-1; }
     
     // return if buffer is full
-    bool atMaximum() { return (m_write + 1)%m_numElements == m_read; }
+    bool atMaximum() { return (CK_RING_LOAD(&m_write) + 1)%m_numElements == CK_RING_LOAD(&m_read); }
     
     // return number of valid elements in the buffer
     size_t numElements()
     {
-        if(m_read == m_write)
+        size_t read = CK_RING_LOAD(&m_read), write = CK_RING_LOAD(&m_write);
+        if(read == write)
             return 0;
-        else if(m_read < m_write)
-            return m_write - m_read;
+        else if(read < write)
+            return write - read;
         else
-            return m_numElements - m_read + m_write;
+            return m_numElements - read + write;
     }
     
 private:
@@ -6321,7 +6321,6 @@ Linux general HID support
 #include <linux/unistd.h>
 #include <string.h>
 #include <fcntl.h>
-#include <sys/poll.h>
 #include <sys/ioctl.h>
 #include <errno.h>
 #include <linux/joystick.h>
@@ -6333,6 +6332,8 @@ Linux general HID support
 #define CK_HID_EVDEVFILE ("event%d")
 #define CK_HID_STRBUFSIZE (1024)
 #define CK_HID_NAMESIZE (128)
+// events taken per read()
+#define CK_HID_READ_BATCH (64)
 
 class linux_device
 {
@@ -6342,9 +6343,7 @@ public:
         fd = -1;
         num = -1;
         refcount = 0;
-        pollfds_i = 0;
         filename[0] = '\0';
-        needs_open = needs_close = FALSE;
         strncpy( name, "(name unknown)", CK_HID_NAMESIZE );
     }
     
@@ -6355,11 +6354,6 @@ public:
     
     t_CKUINT refcount;
     
-    size_t pollfds_i;
-    
-    t_CKBOOL needs_open;
-    t_CKBOOL needs_close;
-    
     char filename[CK_HID_STRBUFSIZE];
     char name[CK_HID_NAMESIZE];
 };
@@ -6374,42 +6368,49 @@ public:
     
     virtual void callback()
     {        
-        js_event event;
+        js_event events[CK_HID_READ_BATCH];
+        HidMsg msgs[CK_HID_READ_BATCH];
         HidMsg msg;
         ssize_t len;
-                
-        while( ( len = read( fd, &event, sizeof( event ) ) ) > 0 )
+        
+        // everything pending, a batch per read()
+        while( ( len = read( fd, events, sizeof( events ) ) ) > 0 )
         {
-            if( len < sizeof( event ) )
-            {
+            if( len % sizeof( js_event ) )
                 EM_log( CK_LOG_WARNING, "joystick: read event from %s smaller than expected, ignoring", name );
-                continue;
-            }
-            
-            if( event.type == JS_EVENT_INIT )
-                continue;
-            
-            msg.device_type = CK_HID_DEV_JOYSTICK;
-            msg.device_num = num;
-            msg.eid = event.number;
             
-            switch( event.type )
+            size_t n = 0;
+            for( size_t i = 0; i < len / sizeof( js_event ); i++ )
             {
-                case JS_EVENT_BUTTON:
-                    msg.type = event.value ? CK_HID_BUTTON_DOWN : 
-                                             CK_HID_BUTTON_UP;
-                    msg.idata[0] = event.value;
-                    break;
-                case JS_EVENT_AXIS:
-                    msg.type = CK_HID_JOYSTICK_AXIS;
-                    msg.fdata[0] = ((t_CKFLOAT)event.value) / ((t_CKFLOAT) SHRT_MAX);
-                    break;
-                default:
-                    EM_log( CK_LOG_WARNING, "joystick: unknown event type from %s, ignoring", name );
+                js_event & event = events[i];
+            
+                if( event.type == JS_EVENT_INIT )
                     continue;
+            
+                msg.device_type = CK_HID_DEV_JOYSTICK;
+                msg.device_num = num;
+                msg.eid = event.number;
+            
+                switch( event.type )
+                {
+                    case JS_EVENT_BUTTON:
+                        msg.type = event.value ? CK_HID_BUTTON_DOWN : 
+                                                 CK_HID_BUTTON_UP;
+                        msg.idata[0] = event.value;
+                        break;
+                    case JS_EVENT_AXIS:
+                        msg.type = CK_HID_JOYSTICK_AXIS;
+                        msg.fdata[0] = ((t_CKFLOAT)event.value) / ((t_CKFLOAT) SHRT_MAX);
+                        break;
+                    default:
+                        EM_log( CK_LOG_WARNING, "joystick: unknown event type from %s, ignoring", name );
+                        continue;
+                }
+            
+                msgs[n++] = msg;
             }
             
-            HidInManager::push_message( msg );
+            HidInManager::push_messages( msgs, n );
         }
     }
     
@@ -6456,116 +6457,123 @@ public:
     virtual void callback()
     {        
         //ps2_mouse_event event;
-        input_event event;
+        input_event events[CK_HID_READ_BATCH];
+        HidMsg msgs[CK_HID_READ_BATCH];
         HidMsg msg;
         ssize_t len;
-                
-        while( ( len = read( fd, &event, sizeof( event ) ) ) > 0 )
+        
+        // everything pending, a batch per read()
+        while( ( len = read( fd, events, sizeof( events ) ) ) > 0 )
         {
-            if( len < sizeof( event ) )
-            {
+            if( len % sizeof( input_event ) )
                 EM_log( CK_LOG_WARNING, "mouse: read event from mouse %i smaller than expected (%i), ignoring", num, len );
-                continue;
-            }
             
-            switch( event.type )
+            size_t n = 0;
+            for( size_t i = 0; i < len / sizeof( input_event ); i++ )
             {
-                case EV_KEY:
-                    if( event.code & BTN_MOUSE )
-                    {
+                input_event & event = events[i];
+            
+                switch( event.type )
+                {
+                    case EV_KEY:
+                        if( event.code & BTN_MOUSE )
+                        {
+                            msg.clear();
+                            msg.device_type = CK_HID_DEV_MOUSE;
+                            msg.device_num = num;
+                            msg.eid = event.code - BTN_MOUSE;
+                            msg.type = event.value ? CK_HID_BUTTON_DOWN : CK_HID_BUTTON_UP;
+                            msg.idata[0] = event.value;
+                            msgs[n++] = msg;
+                        }
+                    
+                        break;
+                
+                    case EV_REL:
                         msg.clear();
                         msg.device_type = CK_HID_DEV_MOUSE;
                         msg.device_num = num;
-                        msg.eid = event.code - BTN_MOUSE;
-                        msg.type = event.value ? CK_HID_BUTTON_DOWN : CK_HID_BUTTON_UP;
-                        msg.idata[0] = event.value;
-                        HidInManager::push_message( msg ); 
-                    }
                     
-                    break;
-                
-                case EV_REL:
-                    msg.clear();
-                    msg.device_type = CK_HID_DEV_MOUSE;
-                    msg.device_num = num;
-                    
-                    switch( event.code )
-                    {
-                        case REL_X:
-                            msg.type = CK_HID_MOUSE_MOTION;
-                            msg.idata[0] = event.value;
-                            msg.idata[1] = 0;
-                            break;
+                        switch( event.code )
+                        {
+                            case REL_X:
+                                msg.type = CK_HID_MOUSE_MOTION;
+                                msg.idata[0] = event.value;
+                                msg.idata[1] = 0;
+                                break;
                     
-                        case REL_Y:
-                            msg.type = CK_HID_MOUSE_MOTION;
-                            msg.idata[0] = 0;
-                            msg.idata[1] = event.value;
-                            break;
+                            case REL_Y:
+                                msg.type = CK_HID_MOUSE_MOTION;
+                                msg.idata[0] = 0;
+                                msg.idata[1] = event.value;
+                                break;
                     
-                        case REL_HWHEEL:
-                            msg.type = CK_HID_MOUSE_WHEEL;
-                            msg.idata[0] = event.value;
-                            msg.idata[1] = 0;
-                            break;
+                            case REL_HWHEEL:
+                                msg.type = CK_HID_MOUSE_WHEEL;
+                                msg.idata[0] = event.value;
+                                msg.idata[1] = 0;
+                                break;
                     
-                        case REL_Z:
-                        case REL_WHEEL:
-                            msg.type = CK_HID_MOUSE_WHEEL;
-                            msg.idata[0] = 0;
-                            msg.idata[1] = event.value;
-                            break;
-                    }
+                            case REL_Z:
+                            case REL_WHEEL:
+                                msg.type = CK_HID_MOUSE_WHEEL;
+                                msg.idata[0] = 0;
+                                msg.idata[1] = event.value;
+                                break;
+                        }
                     
-                    HidInManager::push_message( msg );
+                        msgs[n++] = msg;
                     
-                    break;
+                        break;
                     
-            }
+                }
             
-/*            
-            if( event.dx || event.dy )
-            {
-                msg.device_type = CK_HID_DEV_MOUSE;
-                msg.device_num = num;
-                msg.eid = 0;
-                msg.type = CK_HID_MOUSE_MOTION;
-                msg.idata[0] = event.dx;
-                msg.idata[1] = event.dy;
-                HidInManager::push_message( msg );
-            }
+    /*            
+                if( event.dx || event.dy )
+                {
+                    msg.device_type = CK_HID_DEV_MOUSE;
+                    msg.device_num = num;
+                    msg.eid = 0;
+                    msg.type = CK_HID_MOUSE_MOTION;
+                    msg.idata[0] = event.dx;
+                    msg.idata[1] = event.dy;
+                    HidInManager::push_message( msg );
+                }
             
-            if( event.button1 ^ last_event.button1 )
-            {
-                msg.device_type = CK_HID_DEV_MOUSE;
-                msg.device_num = num;
-                msg.eid = 0;
-                msg.type = event.button1 ? CK_HID_BUTTON_DOWN : CK_HID_BUTTON_UP;
-                msg.idata[0] = event.button1;
-                HidInManager::push_message( msg );
-            }
+                if( event.button1 ^ last_event.button1 )
+                {
+                    msg.device_type = CK_HID_DEV_MOUSE;
+                    msg.device_num = num;
+                    msg.eid = 0;
+                    msg.type = event.button1 ? CK_HID_BUTTON_DOWN : CK_HID_BUTTON_UP;
+                    msg.idata[0] = event.button1;
+                    HidInManager::push_message( msg );
+                }
             
-            if( event.button2 ^ last_event.button2 )
-            {
-                msg.device_type = CK_HID_DEV_MOUSE;
-                msg.device_num = num;
-                msg.eid = 2;
-                msg.type = event.button2 ? CK_HID_BUTTON_DOWN : CK_HID_BUTTON_UP;
-                msg.idata[0] = event.button2;
-                HidInManager::push_message( msg );
-            }
+                if( event.button2 ^ last_event.button2 )
+                {
+                    msg.device_type = CK_HID_DEV_MOUSE;
+                    msg.device_num = num;
+                    msg.eid = 2;
+                    msg.type = event.button2 ? CK_HID_BUTTON_DOWN : CK_HID_BUTTON_UP;
+                    msg.idata[0] = event.button2;
+                    HidInManager::push_message( msg );
+                }
             
-            if( event.button3 ^ last_event.button3 )
-            {
-                msg.device_type = CK_HID_DEV_MOUSE;
-                msg.device_num = num;
-                msg.eid = 3;
-                msg.type = event.button3 ? CK_HID_BUTTON_DOWN : CK_HID_BUTTON_UP;
-                msg.idata[0] = event.button3;
-                HidInManager::push_message( msg );
+                if( event.button3 ^ last_event.button3 )
+                {
+                    msg.device_type = CK_HID_DEV_MOUSE;
+                    msg.device_num = num;
+                    msg.eid = 3;
+                    msg.type = event.button3 ? CK_HID_BUTTON_DOWN : CK_HID_BUTTON_UP;
+                    msg.idata[0] = event.button3;
+                    HidInManager::push_message( msg );
+                }
+                */
+                memcpy( &last_event, &event, sizeof( last_event ) );
             }
-            */
-            memcpy( &last_event, &event, sizeof( last_event ) );
+            
+            HidInManager::push_messages( msgs, n );
         }
     }
     
@@ -6991,33 +6999,40 @@ public:
     
     virtual void callback()
     {
-        input_event event;
+        input_event events[CK_HID_READ_BATCH];
+        HidMsg msgs[CK_HID_READ_BATCH];
         HidMsg msg;
         ssize_t len;
-                
-        while( ( len = read( fd, &event, sizeof( event ) ) ) > 0 )
+        
+        // everything pending, a batch per read()
+        while( ( len = read( fd, events, sizeof( events ) ) ) > 0 )
         {
-            if( len < sizeof( event ) )
-            {
+            if( len % sizeof( input_event ) )
                 EM_log( CK_LOG_WARNING, "keyboard: read event from keyboard %i smaller than expected (%i), ignoring", num, len );
-                continue;
-            }
             
-            if( event.type != EV_KEY )
-                continue;
+            size_t n = 0;
+            for( size_t i = 0; i < len / sizeof( input_event ); i++ )
+            {
+                input_event & event = events[i];
             
-            if( event.value == 2 )
-                continue;
+                if( event.type != EV_KEY )
+                    continue;
             
-            msg.clear();
-            msg.device_type = CK_HID_DEV_KEYBOARD;
-            msg.device_num = num;
-            msg.type = event.value ? CK_HID_BUTTON_DOWN : CK_HID_BUTTON_UP;
-            msg.eid = event.code;
-            msg.idata[0] = event.value;
-            Keyboard_translate_key( event.code, msg.idata[2], msg.idata[1] );
+                if( event.value == 2 )
+                    continue;
             
-            HidInManager::push_message( msg );
+                msg.clear();
+                msg.device_type = CK_HID_DEV_KEYBOARD;
+                msg.device_num = num;
+                msg.type = event.value ? CK_HID_BUTTON_DOWN : CK_HID_BUTTON_UP;
+                msg.eid = event.code;
+                msg.idata[0] = event.value;
+                Keyboard_translate_key( event.code, msg.idata[2], msg.idata[1] );
+            
+                msgs[n++] = msg;
+            }
+            
+            HidInManager::push_messages( msgs, n );
         }
     }
 };
@@ -7026,59 +7041,42 @@ static vector< linux_joystick * > * joysticks = NULL;
 static vector< linux_mouse * > * mice = NULL;
 static vector< linux_keyboard * > * keyboards = NULL;
 
-static map< int, linux_device * > * device_map = NULL;
+static t_CKBOOL g_hid_init = FALSE;
 
-static pollfd * pollfds = NULL;
-#define DEFAULT_POLLFDS_SIZE (1)
-static size_t pollfds_size = 0;
-static size_t pollfds_end = 0;
-static int hid_channel_r = -1; // HID communications channel, read fd
-static int hid_channel_w = -1; // HID communications channel, write fd
+//-----------------------------------------------------------------------------
+// name: Hid_device_cb()
+// desc: the reactor says an open device has input
+//-----------------------------------------------------------------------------
+static void Hid_device_cb( int fd, t_CKUINT events, void * data )
+{
+    ( (linux_device *)data )->callback();
+}
 
-struct hid_channel_msg
+//-----------------------------------------------------------------------------
+// name: Hid_watch()
+// desc: start delivering input from an opened device
+//-----------------------------------------------------------------------------
+static t_CKBOOL Hid_watch( linux_device * device )
 {
-    int action;
-#define HID_CHANNEL_OPEN 1
-#define HID_CHANNEL_CLOSE 0
-#define HID_CHANNEL_QUIT -1
-    linux_device * device;
-};
+    return XReactor::shared()->add( device->fd, XReactor::READ, Hid_device_cb, device );
+}
 
-static t_CKBOOL g_hid_init = FALSE;
+//-----------------------------------------------------------------------------
+// name: Hid_unwatch()
+// desc: stop delivering input, and close
+//-----------------------------------------------------------------------------
+static void Hid_unwatch( linux_device * device )
+{
+    XReactor::shared()->remove( device->fd );
+    close( device->fd );
+    device->fd = -1;
+}
 
 void Hid_init()
 {
     if( g_hid_init )
         return;
     
-    pollfds = new pollfd[DEFAULT_POLLFDS_SIZE];
-    pollfds_size = DEFAULT_POLLFDS_SIZE;
-    pollfds_end = 0;
-    
-    int filedes[2];
-    if( pipe( filedes ) )
-    {
-        EM_log( CK_LOG_SEVERE, "hid: unable to create pipe, initialization failed" );
-        return;
-    }
-    
-    hid_channel_r = filedes[0];
-    hid_channel_w = filedes[1];
-    
-    int fd_flags = fcntl( hid_channel_r, F_GETFL );
-    fcntl( hid_channel_r, F_SETFL, fd_flags | O_NONBLOCK );
-    
-    /* right now, the hid_channel is just used as a dummy file descriptor
-       passed to poll, such that poll will work/block even when there are
-       no open devices.  In the future hid_channel could also be used to 
-       communicate between the VM thread and the HID thread */
-    pollfds[0].fd = hid_channel_r;
-    pollfds[0].events = POLLIN;
-    pollfds[0].revents = 0;
-    pollfds_end = 1;
-    
-    device_map = new map< int, linux_device * >;
-    
     Keyboard_init_translation_table();
     
     g_hid_init = TRUE;
@@ -7086,67 +7084,7 @@ void Hid_init()
 
 void Hid_poll()
 {
-    if( !g_hid_init )
-        return;
-
-    hid_channel_msg hcm;
-    while( poll( pollfds, pollfds_end, -1 ) > 0 )
-    {
-        for( int i = 1; i < pollfds_end; i++ )
-        {
-            if( pollfds[i].revents & POLLIN )
-            {
-                ( *device_map )[pollfds[i].fd]->callback();
-                pollfds[i].revents = 0;
-            }
-        }
-        
-        if( pollfds[0].revents & POLLIN )
-        {
-            while( read( hid_channel_r, &hcm, sizeof( hcm ) ) > 0 )
-            {
-                if( hcm.action == HID_CHANNEL_OPEN )
-                {
-                    if( pollfds_end >= pollfds_size )
-                    {
-                        pollfds_size = pollfds_end * 2;
-                        pollfd * t_pollfds = new pollfd[pollfds_size];
-                        memcpy( t_pollfds, pollfds, pollfds_end * sizeof( pollfd ) );
-                        delete[] pollfds;
-                        pollfds = t_pollfds;
-                    }
-
-                    pollfds[pollfds_end].fd = hcm.device->fd;
-                    pollfds[pollfds_end].events = POLLIN;
-                    pollfds[pollfds_end].revents = 0;
-                    hcm.device->pollfds_i = pollfds_end;
-                    ( *device_map )[hcm.device->fd] = hcm.device;
-                    pollfds_end++;
-                }
-                
-                else if( hcm.action == HID_CHANNEL_CLOSE )
-                {
-                    // erase the closing entry by copying the last entry into it
-                    // this is okay even when joystick->pollfds_i == pollfds_end
-                    // because we decrement pollfds_end
-                    ( *device_map )[pollfds[pollfds_end - 1].fd]->pollfds_i = hcm.device->pollfds_i;  
-                    pollfds[hcm.device->pollfds_i] = pollfds[pollfds_end - 1];
-                    pollfds_end--;
-                    close( hcm.device->fd );
-                    device_map->erase( hcm.device->fd );
-                }
-                
-                else if( hcm.action == HID_CHANNEL_QUIT )
-                {
-                    close( hid_channel_r );
-                    return;
-                }
-
-            }
-            
-            break;
-        }
-    }
+    // devices are read on the shared XReactor thread
 }
 
 void Hid_quit()
@@ -7154,15 +7092,6 @@ void Hid_quit()
     if( !g_hid_init )
         return;
     
-    hid_channel_msg hcm = { HID_CHANNEL_QUIT, NULL };
-    if (write( hid_channel_w, &hcm, sizeof( hcm ) ) == -1)
-      EM_log( CK_LOG_WARNING, "HID_CHANNEL_QUIT message failed: %s" , strerror( errno ) );
-
-    close( hid_channel_w );
-        
-    delete[] pollfds;
-    delete device_map;
-        
     g_hid_init = FALSE;
 }
 
@@ -7293,11 +7222,10 @@ int Joystick_open( int js )
             return -1;
         }
         
-        hid_channel_msg hcm = { HID_CHANNEL_OPEN, joystick };
-        if(write( hid_channel_w, &hcm, sizeof( hcm ) ) == -1) 
+        if( !Hid_watch( joystick ) )
         {
-            EM_log( CK_LOG_SEVERE, "joystick: unable to write channel message %s: %s", 
-                joystick->filename, strerror( errno ) );
+            EM_log( CK_LOG_SEVERE, "joystick: unable to watch %s", joystick->filename );
+            close( joystick->fd );
             return -1;
         }
     }
@@ -7318,10 +7246,7 @@ int Joystick_close( int js )
     
     if( joystick->refcount == 0 )
     {
-        hid_channel_msg hcm = { HID_CHANNEL_CLOSE, joystick };
-        if(write( hid_channel_w, &hcm, sizeof( hcm ) ) == -1) return -1;
-            EM_log( CK_LOG_SEVERE, "joystick: unable complete close message: %s", 
-                 strerror( errno ) );
+        Hid_unwatch( joystick );
     }
     
     
@@ -7497,11 +7422,10 @@ int Mouse_open( int m )
             return -1;
         }
         
-        mouse->needs_open = TRUE;
-        hid_channel_msg hcm = { HID_CHANNEL_OPEN, mouse };
-        if(write( hid_channel_w, &hcm, sizeof( hcm ) ) == -1) 
+        if( !Hid_watch( mouse ) )
         {
-            EM_log( CK_LOG_SEVERE, "mouse: unable to complete open message %: %s", strerror( errno ) );
+            EM_log( CK_LOG_SEVERE, "mouse: unable to watch %s", mouse->filename );
+            close( mouse->fd );
             return -1;
         }
     }
@@ -7522,10 +7446,7 @@ int Mouse_close( int m )
     
     if( mouse->refcount == 0 )
     {
-        mouse->needs_close = TRUE;
-        hid_channel_msg hcm = { HID_CHANNEL_CLOSE, mouse };
-        if(write( hid_channel_w, &hcm, sizeof( hcm ) ) == -1)
-          EM_log( CK_LOG_WARNING, "mouse: HID_CHANNEL_CLOSE message failed: %s" , strerror( errno ) );
+        Hid_unwatch( mouse );
     }
     
     return 0;
@@ -7675,10 +7596,10 @@ int Keyboard_open( int k )
             return -1;
         }
         
-        hid_channel_msg hcm = { HID_CHANNEL_OPEN, keyboard };
-        if(write( hid_channel_w, &hcm, sizeof( hcm ) ) == -1) 
+        if( !Hid_watch( keyboard ) )
         {
-            EM_log( CK_LOG_SEVERE, "keyboard: unable to write open message: %s", strerror( errno ) );
+            EM_log( CK_LOG_SEVERE, "keyboard: unable to watch %s", keyboard->filename );
+            close( keyboard->fd );
             return -1;
         }
     }
@@ -7699,9 +7620,7 @@ int Keyboard_close( int k )
     
     if( keyboard->refcount == 0 )
     {
-        hid_channel_msg hcm = { HID_CHANNEL_CLOSE, keyboard };
-        if(write( hid_channel_w, &hcm, sizeof( hcm ) ) == -1)
-          EM_log( CK_LOG_WARNING, "keyboard: HID_CHANNEL_CLOSE message failed: %s" , strerror( errno ) );
+        Hid_unwatch( keyboard );
     }
     
     return 0;
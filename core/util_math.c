@@ -198,3 +198,70 @@ unsigned long ensurepow2( unsigned long n )
 {
     return nextpow2( n-1 );
 }
+
+
+
+
+//-----------------------------------------------------------------------------
+// fast_tan() / fast_cos(): table lookup with linear interpolation, for
+// recomputing filter coefficients at control/block rate; tan is tabulated
+// on [0, 1.5] (beyond that the curve is too steep to interpolate well and
+// ::tan is used), cos on [0, pi]
+//-----------------------------------------------------------------------------
+#define FAST_TRIG_SIZE 4096
+#define FAST_TAN_MAX 1.5
+#define FAST_TRIG_PI 3.14159265358979323846
+static double g_fast_tan[FAST_TRIG_SIZE+2];
+static double g_fast_cos[FAST_TRIG_SIZE+2];
+static int g_fast_trig_ready = 0;
+
+
+//-----------------------------------------------------------------------------
+// name: fast_trig_init()
+// desc: fill the tables (called on first use; call early to keep it off the
+//       audio thread)
+//-----------------------------------------------------------------------------
+void fast_trig_init()
+{
+    int i;
+    if( g_fast_trig_ready ) return;
+    for( i = 0; i < FAST_TRIG_SIZE+2; i++ )
+    {
+        g_fast_tan[i] = tan( i * FAST_TAN_MAX / FAST_TRIG_SIZE );
+        g_fast_cos[i] = cos( i * FAST_TRIG_PI / FAST_TRIG_SIZE );
+    }
+    g_fast_trig_ready = 1;
+}
+
+
+//-----------------------------------------------------------------------------
+// name: fast_tan()
+// desc: tan(x), interpolated from a table for |x| <= 1.5
+//-----------------------------------------------------------------------------
+double fast_tan( double x )
+{
+    double a = x < 0 ? -x : x, pos, y;
+    int i;
+    if( a >= FAST_TAN_MAX ) return tan( x );
+    if( !g_fast_trig_ready ) fast_trig_init();
+    pos = a * ( FAST_TRIG_SIZE / FAST_TAN_MAX );
+    i = (int)pos;
+    y = g_fast_tan[i] + ( pos - i ) * ( g_fast_tan[i+1] - g_fast_tan[i] );
+    return x < 0 ? -y : y;
+}
+
+
+//-----------------------------------------------------------------------------
+// name: fast_cos()
+// desc: cos(x), interpolated from a table for |x| <= pi
+//-----------------------------------------------------------------------------
+double fast_cos( double x )
+{
+    double a = x < 0 ? -x : x, pos;
+    int i;
+    if( a > FAST_TRIG_PI ) return cos( x );
+    if( !g_fast_trig_ready ) fast_trig_init();
+    pos = a * ( FAST_TRIG_SIZE / FAST_TRIG_PI );
+    i = (int)pos;
+    return g_fast_cos[i] + ( pos - i ) * ( g_fast_cos[i+1] - g_fast_cos[i] );
+}
@@ -65,6 +65,12 @@ double dbtorms( double f );
 unsigned long nextpow2( unsigned long i );
 // ensurepow2
 unsigned long ensurepow2( unsigned long i );
+// fast_trig_init
+void fast_trig_init();
+// fast_tan (table; for filter coefficients)
+double fast_tan( double x );
+// fast_cos (table; for filter coefficients)
+double fast_cos( double x );
 
 #if defined (__cplusplus) || defined(_cplusplus)  
 }
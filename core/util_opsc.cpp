@@ -1071,6 +1071,8 @@ public:
     
     void set_host(char * hostaddress, int port);
     int send(char *buffer, int size);
+    int send(char *buffer, int size, const SOCKADDR_IN & addr);
+    const SOCKADDR_IN & host() const { return _host_addr; }
     udp_stat status(void) { return _status; } 
     void close_sock();
 };
@@ -1416,6 +1418,17 @@ int UDP_Transmitter::send( char * buffer, int bsize )
     return ( ret <= 0 ) ? 0 : ret ;
 }
 
+int UDP_Transmitter::send( char * buffer, int bsize, const SOCKADDR_IN & addr )
+{
+    if( _status != UDP_READY )
+    {
+        EM_log( CK_LOG_SYSTEM, "(via OSC): send -> socket not bound!");
+        return 0;
+    }
+    int ret = ck_sendto(_sock, buffer, bsize, (struct sockaddr *) &addr, sizeof(addr) );
+    return ( ret <= 0 ) ? 0 : ret ;
+}
+
 
 void UDP_Transmitter::close_sock()
 {
@@ -1428,12 +1441,16 @@ void UDP_Transmitter::close_sock()
 OSC_Transmitter::OSC_Transmitter()  { 
     _out = new UDP_Transmitter();
     _holdMessage = false;
+    _async = true;
+    _now = 0;
     init();
 }
 
 OSC_Transmitter::OSC_Transmitter( UDP_Transmitter * out ) { 
     _out = out;
     _holdMessage = false;
+    _async = false;
+    _now = 0;
 }
 
 OSC_Transmitter::~OSC_Transmitter() { delete _out; } 
@@ -1454,6 +1471,17 @@ OSC_Transmitter::presend( char * buf, int sz ) {
    _out->send(buf,sz);
 }
 
+void
+OSC_Transmitter::send( char * buf, int sz ) { 
+   if( !_async ) { _out->send(buf,sz); return; }
+   if( _out->status() != UDP_READY ) { 
+       EM_log( CK_LOG_SYSTEM, "(via OSC): send -> socket not bound!");
+       return;
+   }
+   // full queue: the packet is dropped and counted; never wait here
+   OSC_Send_Queue::shared()->push( this, _out, _now, buf, sz );
+}
+
 void
 OSC_Transmitter::openBundle( OSCTimeTag t) { 
    OSC_openBundle( &_osc, t);
@@ -1594,7 +1622,7 @@ void
 OSC_Transmitter::tryMessage() { 
     if( !packetReady() ) return;
 
-    _out->send( OSC_getPacket(&_osc), OSC_packetSize(&_osc) );
+    send( OSC_getPacket(&_osc), OSC_packetSize(&_osc) );
     OSC_resetBuffer(&_osc);
 }
 
@@ -1608,11 +1636,360 @@ OSC_Transmitter::kickMessage() {
     if( !OSC_isBufferDone(&_osc) ) { 
         CK_FPRINTF_STDERR( "[chuck](via OSC): error -> sending incomplete packet!\n" );
     }
-    _out->send( OSC_getPacket(&_osc), OSC_packetSize(&_osc) );
+    send( OSC_getPacket(&_osc), OSC_packetSize(&_osc) );
     OSC_resetBuffer(&_osc);
 }
 
 
+
+
+//-----------------------------------------------------------------------------
+// OSC_Send_Queue
+//-----------------------------------------------------------------------------
+const t_CKUINT OSC_Send_Queue::DEFAULT_CAPACITY = 1024;
+// largest UDP payload that fits an ethernet frame unfragmented
+const t_CKUINT OSC_Send_Queue::MAX_DATAGRAM = 1472;
+OSC_Send_Queue * OSC_Send_Queue::o_instance = NULL;
+
+// one queued packet
+struct OSC_Send_Queue::Packet
+{
+    const void * sender;
+    SOCKADDR_IN addr;
+    t_CKTIME now;
+    int size;
+    char data[2048];
+};
+
+
+//-----------------------------------------------------------------------------
+// name: shared()
+// desc: get the shared instance; starts the network thread
+//-----------------------------------------------------------------------------
+OSC_Send_Queue * OSC_Send_Queue::shared()
+{
+    if( o_instance == NULL )
+    {
+        o_instance = new OSC_Send_Queue;
+        o_instance->m_thread->start( send_cb, o_instance );
+    }
+
+    return o_instance;
+}
+
+
+//-----------------------------------------------------------------------------
+// name: drain()
+// desc: give the network thread up to ms to empty the queue
+//-----------------------------------------------------------------------------
+void OSC_Send_Queue::drain( long ms )
+{
+    if( o_instance == NULL ) return;
+
+    for( long i = 0; i < ms && o_instance->pending() > 0; i++ )
+        usleep( 1000 );
+}
+
+
+//-----------------------------------------------------------------------------
+// name: shutdown()
+// desc: send what the network thread is holding, then join and free it
+//-----------------------------------------------------------------------------
+void OSC_Send_Queue::shutdown()
+{
+    if( o_instance == NULL ) return;
+    OSC_Send_Queue * q = o_instance;
+
+    q->m_thread_exit = TRUE;
+    q->m_wake->post();
+    q->m_thread->wait( -1, false );
+    q->m_thread->clear();
+
+    o_instance = NULL;
+    delete q;
+}
+
+
+OSC_Send_Queue::OSC_Send_Queue()
+{
+    m_lock = new XMutex;
+    m_thread = new XThread;
+    m_wake = new XSemaphore;
+    m_thread_exit = FALSE;
+    m_out = new UDP_Transmitter;
+    m_out->init();
+
+    m_ring = NULL;
+    m_capacity = DEFAULT_CAPACITY;
+    m_head = 0;
+    m_count = 0;
+    m_coalesce = TRUE;
+
+    m_group = new Packet;
+    m_group_buffer = new char[MAX_DATAGRAM > sizeof(m_group->data) ?
+                              MAX_DATAGRAM : sizeof(m_group->data)];
+    m_group_size = 0;
+    m_group_msgs = 0;
+
+    m_queued = m_dropped = m_high_water = 0;
+    m_datagrams = m_bundles = 0;
+}
+
+
+OSC_Send_Queue::~OSC_Send_Queue()
+{
+    // the thread is joined (see shutdown)
+    SAFE_DELETE_ARRAY( m_ring );
+    SAFE_DELETE( m_group );
+    SAFE_DELETE_ARRAY( m_group_buffer );
+    m_out->close_sock();
+    SAFE_DELETE( m_out );
+    SAFE_DELETE( m_thread );
+    SAFE_DELETE( m_wake );
+    SAFE_DELETE( m_lock );
+}
+
+
+//-----------------------------------------------------------------------------
+// name: push()
+// desc: copy a finished packet into the ring (called from the VM)
+//-----------------------------------------------------------------------------
+bool OSC_Send_Queue::push( const void * sender, UDP_Transmitter * out,
+                           t_CKTIME now, const char * data, int size )
+{
+    if( size <= 0 || size > (int)sizeof(m_group->data) ) return false;
+
+    m_lock->acquire();
+
+    // slots are allocated on first use
+    if( m_ring == NULL ) m_ring = new Packet[m_capacity];
+
+    if( m_count >= m_capacity )
+    {
+        m_dropped++;
+        m_lock->release();
+        return false;
+    }
+
+    Packet & p = m_ring[(m_head + m_count) % m_capacity];
+    p.sender = sender;
+    p.addr = out->host();
+    p.now = now;
+    p.size = size;
+    memcpy( p.data, data, size );
+
+    m_count++;
+    m_queued++;
+    if( m_count > m_high_water ) m_high_water = m_count;
+
+    m_lock->release();
+    m_wake->post();
+    return true;
+}
+
+
+//-----------------------------------------------------------------------------
+// name: set_capacity()
+// desc: resize the ring
+//-----------------------------------------------------------------------------
+void OSC_Send_Queue::set_capacity( t_CKUINT n )
+{
+    if( n == 0 ) n = 1;
+
+    m_lock->acquire();
+    if( m_ring != NULL )
+    {
+        Packet * ring = new Packet[n];
+        t_CKUINT keep = m_count < n ? m_count : n;
+        for( t_CKUINT i = 0; i < keep; i++ )
+            ring[i] = m_ring[(m_head + i) % m_capacity];
+        m_dropped += m_count - keep;
+        SAFE_DELETE_ARRAY( m_ring );
+        m_ring = ring;
+        m_head = 0;
+        m_count = keep;
+    }
+    m_capacity = n;
+    m_lock->release();
+}
+
+
+t_CKUINT OSC_Send_Queue::capacity()
+{
+    m_lock->acquire();
+    t_CKUINT n = m_capacity;
+    m_lock->release();
+    return n;
+}
+
+
+// queued packets not yet sent, including a datagram still being built
+t_CKUINT OSC_Send_Queue::pending()
+{
+    m_lock->acquire();
+    t_CKUINT n = m_count + m_group_msgs;
+    m_lock->release();
+    return n;
+}
+
+
+t_CKUINT OSC_Send_Queue::queued()
+{
+    m_lock->acquire();
+    t_CKUINT n = m_queued;
+    m_lock->release();
+    return n;
+}
+
+
+t_CKUINT OSC_Send_Queue::dropped()
+{
+    m_lock->acquire();
+    t_CKUINT n = m_dropped;
+    m_lock->release();
+    return n;
+}
+
+
+t_CKUINT OSC_Send_Queue::high_water()
+{
+    m_lock->acquire();
+    t_CKUINT n = m_high_water;
+    m_lock->release();
+    return n;
+}
+
+
+t_CKUINT OSC_Send_Queue::datagrams()
+{
+    m_lock->acquire();
+    t_CKUINT n = m_datagrams;
+    m_lock->release();
+    return n;
+}
+
+
+t_CKUINT OSC_Send_Queue::bundles()
+{
+    m_lock->acquire();
+    t_CKUINT n = m_bundles;
+    m_lock->release();
+    return n;
+}
+
+
+//-----------------------------------------------------------------------------
+// name: send_group()
+// desc: send the datagram being built: a lone packet goes out as is,
+//       several are wrapped in one bundle (network thread)
+//-----------------------------------------------------------------------------
+void OSC_Send_Queue::send_group()
+{
+    if( m_group_msgs == 0 ) return;
+
+    t_CKBOOL bundled = m_group_msgs > 1;
+    if( bundled )
+        m_out->send( m_group_buffer, m_group_size, m_group->addr );
+    else
+        m_out->send( m_group->data, m_group->size, m_group->addr );
+
+    m_lock->acquire();
+    m_group_msgs = 0;
+    m_group_size = 0;
+    m_datagrams++;
+    if( bundled ) m_bundles++;
+    m_lock->release();
+}
+
+
+//-----------------------------------------------------------------------------
+// name: send_cb()
+// desc: network thread; sleeps until push() posts.  packets from the same
+//       sender and logical time are collected until the key changes, the
+//       datagram would overflow, or nothing new has arrived for 1 ms
+//-----------------------------------------------------------------------------
+THREAD_RETURN ( THREAD_TYPE OSC_Send_Queue::send_cb )( void * _thiss )
+{
+    OSC_Send_Queue * _this = (OSC_Send_Queue *)_thiss;
+    Packet * group = _this->m_group;
+
+    while( !_this->m_thread_exit )
+    {
+        _this->m_lock->acquire();
+
+        if( _this->m_count == 0 )
+        {
+            _this->m_lock->release();
+            // linger briefly for more packets at the same time
+            if( _this->m_group_msgs == 0 )
+                _this->m_wake->wait();
+            else if( !_this->m_wake->wait( 1 ) )
+                _this->send_group();
+            continue;
+        }
+
+        Packet & p = _this->m_ring[_this->m_head];
+
+        // does p join the datagram being built?
+        if( _this->m_group_msgs > 0 )
+        {
+            t_CKBOOL same = _this->m_coalesce && p.sender == group->sender &&
+                p.now == group->now &&
+                p.addr.sin_port == group->addr.sin_port &&
+                p.addr.sin_addr.s_addr == group->addr.sin_addr.s_addr &&
+                _this->m_group_size + 4 + p.size <= MAX_DATAGRAM;
+            if( !same )
+            {
+                _this->m_lock->release();
+                _this->send_group();
+                continue;
+            }
+        }
+
+        // first packet: keep it whole, and start a bundle around it
+        if( _this->m_group_msgs == 0 )
+        {
+            group->sender = p.sender;
+            group->addr = p.addr;
+            group->now = p.now;
+            group->size = p.size;
+            memcpy( group->data, p.data, p.size );
+
+            char * b = _this->m_group_buffer;
+            memcpy( b, "#bundle\0", 8 );
+            // timetag: immediately
+            *((int4byte *)(b + 8)) = htonl( 0 );
+            *((int4byte *)(b + 12)) = htonl( 1 );
+            _this->m_group_size = 16;
+        }
+
+        // append as a bundle element, if it fits
+        if( _this->m_group_size + 4 + p.size <= MAX_DATAGRAM )
+        {
+            char * b = _this->m_group_buffer + _this->m_group_size;
+            *((int4byte *)b) = htonl( p.size );
+            memcpy( b + 4, p.data, p.size );
+            _this->m_group_size += 4 + p.size;
+        }
+        _this->m_group_msgs++;
+
+        _this->m_head = (_this->m_head + 1) % _this->m_capacity;
+        _this->m_count--;
+        _this->m_lock->release();
+
+        // oversized or not coalescing: send right away
+        if( !_this->m_coalesce || ( _this->m_group_msgs == 1 &&
+            16 + 4 + (t_CKUINT)group->size > MAX_DATAGRAM ) )
+            _this->send_group();
+    }
+
+    // don't lose a datagram still being built
+    _this->send_group();
+
+    return 0;
+}
+
+
 // OSC_RECEIVER
 
 OSC_Receiver::OSC_Receiver( Chuck_VM * vm ):
@@ -1683,6 +2060,7 @@ OSC_Receiver::~OSC_Receiver()
 
     // 1.3.1.1: moving this outside the loop, oops
     free( _inbox );
+    free( _address_space );
     
     // clean up
     SAFE_DELETE( _io_mutex );
@@ -2000,10 +2378,12 @@ void OSC_Receiver::handle_bundle( char * b, int len )
    
    int off = 16; //skip "#bundle\0timetags"
 
-   while ( off < len ) 
+   while ( off + 4 <= len ) 
    { 
       char * z = b+off;
-      unsigned long size = ntohl(*((unsigned long*)z));
+      int size = (int)ntohl(*((int4byte*)z));
+      // element runs past the bundle: drop the rest
+      if( size < 0 || size > len - off - 4 ) break;
 
       char * m = z+4;
 
@@ -2042,6 +2422,7 @@ void OSC_Receiver::add_address( OSC_Address_Space * src )
     }
     // add the source
     _address_space[_address_num++] = src;
+    _address_index[src->address()].push_back( src );
 
     // set the receiver
     src->setReceiver( this );
@@ -2057,11 +2438,21 @@ void OSC_Receiver::remove_address( OSC_Address_Space *odd )
 
     for( int i = 0 ; i < _address_num ; i++ )
     {
-        while( _address_space[i] == odd )
+        while( i < _address_num && _address_space[i] == odd )
         {
             _address_space[i] = _address_space[--_address_num];
         }
     }
+
+    // and from the index
+    std::map<std::string, std::vector<OSC_Address_Space *> >::iterator it;
+    it = _address_index.find( odd->address() );
+    if( it != _address_index.end() )
+    {
+        std::vector<OSC_Address_Space *> & v = it->second;
+        v.erase( std::remove( v.begin(), v.end(), odd ), v.end() );
+        if( v.empty() ) _address_index.erase( it );
+    }
     
     // release (added 1.3.1.1)
     _address_mutex->release();
@@ -2077,14 +2468,32 @@ void OSC_Receiver::distribute_message( OSCMesg * msg )
     // lock (added 1.3.1.1)
     _address_mutex->acquire();
 
-    // iterate
-    for( int i = 0 ; i < _address_num ; i++ )
+    // a literal address can only match listeners with that exact address
+    if( strpbrk( msg->address, "*?[]{}\\" ) == NULL )
     {
-        if( _address_space[i]->try_queue_mesg( msg ) )
+        std::map<std::string, std::vector<OSC_Address_Space *> >::iterator it;
+        it = _address_index.find( msg->address );
+        if( it != _address_index.end() )
         {
-            // CK_FPRINTF_STDERR( "broadcasting %x from %x\n", (uint)_address_space[i]->SELF, (uint)_address_space[i] );
-            // if the event has any shreds queued, fire them off..
-            ((Chuck_Event *)_address_space[i]->SELF)->queue_broadcast( m_event_buffer );
+            std::vector<OSC_Address_Space *> & v = it->second;
+            for( size_t i = 0; i < v.size(); i++ )
+            {
+                if( v[i]->try_queue_mesg( msg ) )
+                    ((Chuck_Event *)v[i]->SELF)->queue_broadcast( m_event_buffer );
+            }
+        }
+    }
+    else
+    {
+        // pattern: match against every listener
+        for( int i = 0 ; i < _address_num ; i++ )
+        {
+            if( _address_space[i]->try_queue_mesg( msg ) )
+            {
+                // CK_FPRINTF_STDERR( "broadcasting %x from %x\n", (uint)_address_space[i]->SELF, (uint)_address_space[i] );
+                // if the event has any shreds queued, fire them off..
+                ((Chuck_Event *)_address_space[i]->SELF)->queue_broadcast( m_event_buffer );
+            }
         }
     }
     
@@ -2117,6 +2526,26 @@ const char * osc_typename_strings[] = {
 
 
 
+// the queue's two sides run on different threads: make writes to a slot
+// visible before the index that publishes it (and the reverse for reads)
+#if defined(__PLATFORM_WIN32__) && !defined(__GNUC__)
+  #define OSC_FENCE() MemoryBarrier()
+#else
+  #define OSC_FENCE() __sync_synchronize()
+#endif
+
+// one ring of the queue; _read is the slot last consumed, _write the
+// next slot to fill, as in the other chuck circular buffers
+struct OSC_Address_Space::Ring
+{
+    opsc_data * slots;
+    int size;
+    volatile int read;
+    volatile int write;
+    Ring * volatile next;
+};
+
+
 OSC_Address_Space::OSC_Address_Space() { 
     init();
     setSpec( "/undefined/default,i" );
@@ -2138,20 +2567,22 @@ OSC_Address_Space::init() {
     _receiver = NULL;
     SELF = NULL;
     _queueSize = 512; // start queue size at 512 // 64. 
+    _dropped = 0;
     _dataSize = 0;
     _cur_mesg = NULL;
-    _queue = NULL;
+    _rd = _wr = NULL;
 	_cur_value = 0;
-    _current_data = NULL;
-    _buffer_mutex = new XMutex();
 }
 
 OSC_Address_Space::~OSC_Address_Space()
 {
     // clean up
-    if( _queue ) free( _queue );
-    // added 1.3.1.1
-    SAFE_DELETE( _buffer_mutex );
+    while( _rd )
+    {
+        Ring * next = _rd->next;
+        freeRing( _rd );
+        _rd = next;
+    }
 }
 
 void
@@ -2161,21 +2592,29 @@ OSC_Address_Space::setReceiver(OSC_Receiver * recv) {
 
 void
 OSC_Address_Space::setSpec( const char *addr, const char * types ) { 
-    if( snprintf( _spec, sizeof _spec, "%s,%s", addr, types ) >= sizeof _spec) {
+    // re-register, so the receiver indexes the new address
+    OSC_Receiver * recv = _receiver;
+    if( recv ) recv->remove_address( this );
+    if( snprintf( _spec, sizeof _spec, "%s,%s", addr, types ) >= (int)sizeof _spec) {
         // TODO: handle the overflow more gracefully.
         EM_log(CK_LOG_SEVERE, "OSC_Address_Space::setSpec: Not enough space in _spec buffer, data was truncated.");
     }
     scanSpec();
     _needparse = true; 
     parseSpec(); 
+    if( recv ) recv->add_address( this );
 }
 
 void   
 OSC_Address_Space::setSpec( const char *c ) { 
-    strncpy ( _spec, c, 512); 
+    OSC_Receiver * recv = _receiver;
+    if( recv ) recv->remove_address( this );
+    strncpy ( _spec, c, sizeof _spec - 1 ); 
+    _spec[sizeof _spec - 1] = '\0';
     scanSpec();
     _needparse = true; 
     parseSpec(); 
+    if( recv ) recv->add_address( this );
 }
  
 void
@@ -2228,85 +2667,44 @@ OSC_Address_Space::parseSpec() {
    int n = strlen ( type );
    _noArgs = ( n == 0 );
    resizeData( ( n < 1 ) ? 1 : n );
-   _qread = 0;
-   _qwrite = 1;
 
    _needparse = false;
 }
 
-void
-OSC_Address_Space::resizeQueue( int n )
-{
-    if( n <= _queueSize )
-        return; // only grows
-    
-    // lock
-    _buffer_mutex->acquire();
-
-    // it's possible that between the test above and now, 
-    // qread has moved on and we actually DO have space..
-
-    EM_log( CK_LOG_INFO, "OSC_Address (%s) -- buffer full ( r:%d , w:%d, of %d(x%d) ), resizing...",
-            _address, _qread, _qwrite, _queueSize, _dataSize );
-    // CK_FPRINTF_STDERR( "--- hasMesg ( %d ) nextMesg ( %d )\n", (int) has_mesg(), (int)next_mesg()  );
-
-    // we're the server... all we know is that the contents of qread are in the current_buffer, 
-    // so we can move the data, but we don't want to move ahead and lose it just yet.
-
-    // compute chunk size
-    size_t chunkSize = _dataSize * sizeof( opsc_data );
-
-    // allocate
-    int _newQSize = n;
-    opsc_data * _new_queue = (opsc_data *)malloc( _newQSize * chunkSize );
-
-    // clear
-    memset( _new_queue, 0, _newQSize * chunkSize ); // out with the old...
-    // copy
-    if( _qread < _qwrite )
-    {
-        // we're doing this because qwrite is out of room.  
-        // so if qwrite is already greater than qread,
-        // just copy the whole thing to the start of the new buffer ( adding more space to the end ) 
-        memcpy( (void*)_new_queue, (const void*)_queue, _queueSize * chunkSize);
-        // _qwrite and _qread can stay right where they are. 
-        // CK_FPRINTF_STDERR( "resize - case 1\n" );
-    }
-    else
-    { 
-        // _qread is in front of _qwrite, so we must unwrap, and place _qread at the
-        // front of the queue, and qwrite at the end, preserving all elements that qread
-        // is waiting to consume.
-        int nread = _queueSize - _qread;
-        memcpy( (void*)_new_queue, 
-                (const void*)(_queue + _qread * _dataSize), 
-                (nread) * chunkSize);
-        memcpy( (void*)(_new_queue + nread * _dataSize),
-                (const void*)_queue,
-                (_qread) * _dataSize * sizeof( opsc_data ));
-        _qread = 0;
-        _qwrite += nread;
-        // EM_log(CK_LOG_INFO, "resize - case 2\n");
-    }
-
-    _queueSize = _newQSize; 
-    opsc_data * trash = _queue; 
-    _queue = _new_queue;
-    free ( (void*)trash );
+OSC_Address_Space::Ring *
+OSC_Address_Space::newRing( int n ) { 
+    Ring * r = new Ring;
+    r->slots = (opsc_data *)calloc( n * _dataSize, sizeof( opsc_data ) );
+    r->size = n;
+    r->read = 0;
+    r->write = 1;
+    r->next = NULL;
+    return r;
+}
 
-    // don't move qread or qwrite until we're done. 
-    _buffer_mutex->release();
+void
+OSC_Address_Space::freeRing( Ring * r ) { 
+    // strings and blobs are owned by their slots
+    for( int i = 0; i < r->size * _dataSize; i++ )
+        if( r->slots[i].s ) free( r->slots[i].s );
+    free( r->slots );
+    delete r;
 }
 
 
 void
 OSC_Address_Space::resizeData( int n ) { 
-    if( _dataSize == n ) return;
+    if( _dataSize == n && _rd != NULL ) return;
+    // the receiver no longer delivers to us (see setSpec)
+    while( _rd )
+    {
+        Ring * next = _rd->next;
+        freeRing( _rd );
+        _rd = next;
+    }
     _dataSize = n;
-    int queueLen = _queueSize * _dataSize * sizeof( opsc_data );
-    _queue = ( opsc_data * ) realloc ( _queue, queueLen );
-    memset ( _queue, 0, queueLen );
-    _current_data = (opsc_data* ) realloc ( _current_data, _dataSize * sizeof( opsc_data) );
+    _rd = _wr = newRing( _queueSize );
+    _cur_mesg = NULL;
 }
 
 
@@ -2346,56 +2744,48 @@ bool OSC_Address_Space::try_queue_mesg( OSCMesg * m )
 bool OSC_Address_Space::has_mesg()
 {
     // EM_log( CK_LOG_FINER, "OSC has mesg" );
-    return ( ( _qread + 1 ) % _queueSize != _qwrite );
+    Ring * r = _rd;
+    if( ( r->read + 1 ) % r->size != r->write ) return true;
+    // the writer may have moved to a larger ring
+    Ring * n = r->next;
+    return n != NULL && ( n->read + 1 ) % n->size != n->write;
 }
 
 
 bool OSC_Address_Space::next_mesg()
 {
-    // 1.3.1.1 update
-    if( !has_mesg() )
-        return false;
+    // consumer side (VM); no lock, see queue_mesg()
+    Ring * r = _rd;
+    Ring * old = NULL;
 
-    // lock
-    _buffer_mutex->acquire();
-
-    // TODO: ge uhhhh should release mutex?
-    if( has_mesg() )
+    if( ( r->read + 1 ) % r->size == r->write )
     {
-        // move qread forward
-        _qread = ( _qread + 1 ) % _queueSize;
-        memcpy( _current_data, _queue + _qread * _dataSize, _dataSize * sizeof( opsc_data ) );
-        _cur_mesg = _current_data;
-        _cur_value = 0;
-
-        // release
-        _buffer_mutex->release();
-        return true;
+        Ring * n = r->next;
+        if( n == NULL ) return false;
+        // writes to r, if any, were published before next
+        OSC_FENCE();
+        if( ( r->read + 1 ) % r->size == r->write )
+        {
+            if( ( n->read + 1 ) % n->size == n->write ) return false;
+            // r is drained and will not be written again
+            old = r;
+            _rd = r = n;
+        }
     }
 
-    // release
-    _buffer_mutex->release();
-    return false;
+    OSC_FENCE();
+    int next = ( r->read + 1 ) % r->size;
+    // read in place: the writer never fills the slot at the read index
+    _cur_mesg = r->slots + next * _dataSize;
+    _cur_value = 0;
+    OSC_FENCE();
+    // move read forward; frees the previous slot for the writer
+    r->read = next;
+
+    // the previous message (the last to point into old) is replaced
+    if( old ) freeRing( old );
 
-//    if( has_mesg() )
-//    {
-//        _buffer_mutex->acquire();
-//        
-//        // TODO: ge uhhhh should release mutex?
-//        if( !has_mesg() ) return false;
-//        
-//        // move qread forward
-//        _qread = ( _qread + 1 ) % _queueSize;
-//        memcpy( _current_data, _queue + _qread * _dataSize, _dataSize * sizeof( opsc_data ) );
-//        _cur_mesg = _current_data;
-//        _cur_value = 0;
-//        
-//        _buffer_mutex->release();
-//        
-//        return true;
-//    }
-//    
-//    return false;
+    return true;
 }
 
 bool OSC_Address_Space::vcheck( osc_datatype tt )
@@ -2449,30 +2839,76 @@ OSC_Address_Space::next_blob() {
     return ( vcheck(OSC_BLOB) )   ?  _cur_mesg[_cur_value++].s : NULL ;
 }
 
+int
+OSC_Address_Space::remaining() { 
+    if( !_cur_mesg || _noArgs ) return 0;
+    return _cur_value < _dataSize ? _dataSize - _cur_value : 0;
+}
+
+int
+OSC_Address_Space::blob_size() { 
+    if( remaining() == 0 || _cur_mesg[_cur_value].t != OSC_BLOB ) return -1;
+    return _cur_mesg[_cur_value].i;
+}
+
+int
+OSC_Address_Space::next_floats( t_CKFLOAT * dest, int n ) { 
+    // numeric arguments from the read position, up to the first other type
+    int count = 0;
+    if( n > remaining() ) n = remaining();
+    opsc_data * v = _cur_mesg + _cur_value;
+    for( ; count < n; count++ ) { 
+        if( v[count].t == OSC_FLOAT ) dest[count] = v[count].f;
+        else if( v[count].t == OSC_INT ) dest[count] = v[count].i;
+        else break;
+    }
+    _cur_value += count;
+    return count;
+}
+
+int
+OSC_Address_Space::next_ints( t_CKINT * dest, int n ) { 
+    int count = 0;
+    if( n > remaining() ) n = remaining();
+    opsc_data * v = _cur_mesg + _cur_value;
+    for( ; count < n; count++ ) { 
+        if( v[count].t == OSC_INT ) dest[count] = v[count].i;
+        else if( v[count].t == OSC_FLOAT ) dest[count] = (t_CKINT)v[count].f;
+        else break;
+    }
+    _cur_value += count;
+    return count;
+}
+
 void
 OSC_Address_Space::queue_mesg( OSCMesg * m ) 
 {
-    // in the server thread. 
-    int nqw = ( _qwrite + 1 ) % _queueSize;
-    EM_log( CK_LOG_FINE, "OSC address(%s): read: %d write: %d size: %d", _address, _qread, _qwrite, _queueSize );
+    // in the server thread; the only writer, so no lock
+    Ring * w = _wr;
+    int nqw = ( w->write + 1 ) % w->size;
 
-    if( nqw == _qread ) {
+    if( nqw == w->read ) {
         if( _queueSize < OSC_ADDRESS_QUEUE_MAX ) { 
-            resizeQueue( _queueSize * 2 );
-            nqw = ( _qwrite + 1 ) % _queueSize; // _qwrite, _qread may have changed.
+            EM_log( CK_LOG_INFO, "OSC_Address (%s) -- buffer full ( %d(x%d) ), growing...",
+                    _address, _queueSize, _dataSize );
+            // continue in a ring twice the size; the reader follows
+            // once it has drained this one
+            _queueSize *= 2;
+            Ring * n = newRing( _queueSize );
+            OSC_FENCE();
+            w->next = n;
+            _wr = w = n;
+            nqw = ( w->write + 1 ) % w->size;
         }
         else { 
-            EM_log( CK_LOG_INFO, "OSC_Address_Space(%s): message queue reached max size %d...", _address, _queueSize );
-            EM_log( CK_LOG_INFO, "...(dropping oldest message %d)", _qread );
-
-            // bump!
-            _buffer_mutex->acquire();
-            _qread = ( _qread + 1 ) % _queueSize; 
-            _buffer_mutex->release();
+            // the reader owns the read index, so drop the new message
+            if( _dropped++ == 0 )
+                EM_log( CK_LOG_INFO, "OSC_Address_Space(%s): message queue reached max size %d, dropping...", _address, _queueSize );
+            return;
         }
     }
 
-    _vals = _queue + _qwrite * _dataSize;
+    _vals = w->slots + w->write * _dataSize;
 
     if( _noArgs ) { // if address takes no arguments, 
         _vals[0].t = OSC_NOARGS;
@@ -2480,6 +2916,9 @@ OSC_Address_Space::queue_mesg( OSCMesg * m )
     else { 
         char * type = m->types+1;
         char * data = m->data;
+        // the arguments come off the network: check each against the end
+        char * end = m->address + m->len;
+        bool bad = false;
         
         unsigned int endy;
         int i=0;
@@ -2487,9 +2926,10 @@ OSC_Address_Space::queue_mesg( OSCMesg * m )
         float *fp;
         int   *ip;
         int   clen;
-        while ( *type != '\0' ) { 
+        while ( *type != '\0' && !bad ) { 
             switch ( *type ) { 
             case 'f':
+                if( end - data < 4 ) { bad = true; break; }
                 endy = ntohl(*((unsigned long*)data));
                 fp = (float*)(&endy);
                 _vals[i].t = OSC_FLOAT;
@@ -2497,6 +2937,7 @@ OSC_Address_Space::queue_mesg( OSCMesg * m )
                 data += 4;
                 break;
             case 'i':
+                if( end - data < 4 ) { bad = true; break; }
                 endy = ntohl(*((unsigned long*)data));
                 ip = (int4byte*)(&endy);
                 _vals[i].t = OSC_INT;
@@ -2505,7 +2946,9 @@ OSC_Address_Space::queue_mesg( OSCMesg * m )
                 break;
             case 's':
                 // string
-                clen = strlen(data) + 1; // terminating!
+                if( end - data < 1 ) { bad = true; break; }
+                clen = strnlen(data, end - data) + 1; // terminating!
+                if( clen > end - data ) { bad = true; break; }
                 _vals[i].t = OSC_STRING;
                 _vals[i].s = (char *) realloc ( _vals[i].s, clen * sizeof(char) );
                 memcpy ( _vals[i].s, data, clen ); // make a copy of the data...
@@ -2514,21 +2957,32 @@ OSC_Address_Space::queue_mesg( OSCMesg * m )
                 // data += clen + 4 - clen % 4;
             break;
             case 'b':
-                // blobs
+                // blobs: int32 size, bytes, padded to 4; size kept in .i
+                if( end - data < 4 ) { bad = true; break; }
                 endy = ntohl(*((unsigned long*)data));
                 clen = *((int*)(&endy));
+                if( clen < 0 || clen > end - data - 4 ) { bad = true; break; }
                 _vals[i].t = OSC_BLOB;
-                _vals[i].s = (char* ) realloc ( _vals[i].s, clen * sizeof(char) );
-                memcpy ( _vals[i].s, data, clen );
-                data += clen + 4 - clen % 4;
+                _vals[i].i = clen;
+                _vals[i].s = (char* ) realloc ( _vals[i].s, ( clen > 0 ? clen : 1 ) * sizeof(char) );
+                memcpy ( _vals[i].s, data + 4, clen );
+                data += 4 + ( ( clen + 3 ) & ~3 );
                 break;
             }
             i++;
             type++;
         }
+
+        // malformed: drop it; the slot was never published
+        if( bad ) { 
+            EM_log( CK_LOG_INFO, "OSC_Address_Space(%s): dropping malformed message", _address );
+            return;
+        }
     }
     
-    _qwrite = nqw;
+    // publish
+    OSC_FENCE();
+    w->write = nqw;
 
     //review
     /*
@@ -387,6 +387,10 @@ int OSC_effectiveStringLength(char *string);
 // from veldt:platform.h - UDP Transmitter / Receiver Pair
 
 #include "chuck_oo.h"
+#include "util_thread.h"
+#include <map>
+#include <string>
+#include <vector>
 
 class OSC_Address_Space;
 class UDP_Transmitter;
@@ -399,6 +403,11 @@ protected:
     OSCbuf            _osc;
     UDP_Transmitter * _out;
     bool              _holdMessage;
+    bool              _async;
+    t_CKTIME          _now;
+
+    // hand a finished packet to the socket (or the send queue)
+    void send( char * buffer, int size );
 
 public:
     OSC_Transmitter();
@@ -423,7 +432,99 @@ public:
     void kickMessage();
 
     void presend( char * buffer , int size );
-    
+
+    // queue packets for the network thread instead of sending inline
+    void setAsync( bool b ) { _async = b; }
+    bool async() const { return _async; }
+    // logical time of the messages being written (for coalescing)
+    void setNow( t_CKTIME now ) { _now = now; }
+};
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: class OSC_Send_Queue
+// desc: bounded queue of outgoing OSC packets, drained by a network thread;
+//       consecutive packets from one sender at the same logical time are
+//       sent as a single bundle.  a full queue drops (and counts) packets
+//       rather than blocking the caller.
+//-----------------------------------------------------------------------------
+class OSC_Send_Queue
+{
+public:
+    // get the shared instance (started on first use)
+    static OSC_Send_Queue * shared();
+    // wait up to ms for queued packets to go out, if the queue exists
+    static void drain( long ms );
+    // stop and join the network thread; the next push() starts a new one
+    static void shutdown();
+
+    const static t_CKUINT DEFAULT_CAPACITY;
+    // largest coalesced datagram
+    const static t_CKUINT MAX_DATAGRAM;
+
+public:
+    // queue a packet; false if the queue is full
+    bool push( const void * sender, UDP_Transmitter * out, t_CKTIME now,
+               const char * data, int size );
+
+    // packets the queue can hold
+    t_CKUINT capacity();
+    // resize; packets already queued are kept (up to the new size)
+    void set_capacity( t_CKUINT n );
+    // coalesce same-time packets into bundles
+    t_CKBOOL coalesce() const { return m_coalesce; }
+    void set_coalesce( t_CKBOOL b ) { m_coalesce = b; }
+
+    // statistics
+    t_CKUINT pending();
+    t_CKUINT queued();
+    t_CKUINT dropped();
+    t_CKUINT high_water();
+    t_CKUINT datagrams();
+    t_CKUINT bundles();
+
+private:
+    OSC_Send_Queue();
+    ~OSC_Send_Queue();
+
+    // network thread
+    static THREAD_RETURN ( THREAD_TYPE send_cb )( void * _thiss );
+    // send whatever is in the outgoing datagram
+    void send_group();
+
+    static OSC_Send_Queue * o_instance;
+
+private:
+    struct Packet;
+
+    XMutex * m_lock;
+    XThread * m_thread;
+    // posted per push, and at shutdown
+    XSemaphore * m_wake;
+    volatile t_CKBOOL m_thread_exit;
+    UDP_Transmitter * m_out;
+
+    // ring of fixed-size slots
+    Packet * m_ring;
+    t_CKUINT m_capacity;
+    t_CKUINT m_head;
+    t_CKUINT m_count;
+    volatile t_CKBOOL m_coalesce;
+
+    // datagram being built by the network thread
+    Packet * m_group;
+    char * m_group_buffer;
+    t_CKUINT m_group_size;
+    t_CKUINT m_group_msgs;
+
+    // statistics
+    t_CKUINT m_queued;
+    t_CKUINT m_dropped;
+    t_CKUINT m_high_water;
+    t_CKUINT m_datagrams;
+    t_CKUINT m_bundles;
 };
 
 #define OSCINBUFSIZE 8192
@@ -493,6 +594,8 @@ protected:
     OSC_Address_Space **      _address_space;
     int             _address_size;
     int             _address_num;
+    // listeners by literal address; wildcard messages still scan them all
+    std::map<std::string, std::vector<OSC_Address_Space *> > _address_index;
     
     CBufferSimple * m_event_buffer;
     
@@ -572,23 +675,26 @@ class OSC_Address_Space : public Chuck_Event
 {
 protected:
     OSC_Receiver * _receiver;
-    XMutex*        _buffer_mutex;
     char  _spec[512];
     bool  _needparse;
     char  _address[512];
     char  _type[512];
-    opsc_data * _queue;
-    opsc_data * _current_data;
-    int   _qread;
-    int   _qwrite;
+    // single-producer (receive thread) / single-consumer (VM) queue;
+    // grows by chaining a larger ring, which the reader moves onto
+    // once it has drained the old one
+    struct Ring;
+    Ring * _rd;
+    Ring * _wr;
     int   _queueSize;
+    int   _dropped;
     int   _cur_value;
     opsc_data *_cur_mesg;
     opsc_data *_vals;
     int   _dataSize;
     bool  _noArgs;
     void resizeData(int n);
-    void resizeQueue(int n);
+    Ring * newRing(int n);
+    void freeRing(Ring * r);
     void parseSpec();
 	void scanSpec();
 
@@ -606,6 +712,9 @@ public:
     void   setSpec( const char * addr, const char * type );
     void   setReceiver( OSC_Receiver * recv );
 
+    // address part of the spec
+    const char * address() const { return _address; }
+
     // distribution
     bool   try_queue_mesg ( OSCMesg * o );
     bool   message_matches ( OSCMesg * o );
@@ -624,6 +733,15 @@ public:
     char *   next_string();
     char *   next_string_dup();
     char *   next_blob();
+
+    // bulk access: arguments left in the current message
+    int      remaining();
+    // size in bytes of the blob at the read position, or -1
+    int      blob_size();
+    // numeric arguments (int or float) into dest, up to n or the first
+    // non-numeric one; returns how many were read
+    int      next_floats( t_CKFLOAT * dest, int n );
+    int      next_ints( t_CKINT * dest, int n );
 };
 
 
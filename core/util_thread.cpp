@@ -36,6 +36,19 @@
 #include "chuck_errmsg.h"
 #ifndef __PLATFORM_WIN32__
 #include <unistd.h> // usleep
+#include <fcntl.h>
+#include <errno.h>
+#include <string.h>
+#include <poll.h>
+#endif
+#if ( defined(__PLATFORM_MACOSX__) || defined(__PLATFORM_LINUX__) || defined(__WINDOWS_PTHREAD__) )
+#include <sys/time.h> // gettimeofday
+#include <errno.h>
+#else
+#include <limits.h>
+#endif
+#ifdef __PLATFORM_LINUX__
+#include <sys/epoll.h>
 #endif
 
 
@@ -44,6 +57,11 @@
 // static instantiation
 const size_t XWriteThread::PRODUCER_BUFFER_SIZE = 1024;
 XWriteThread * XWriteThread::o_defaultWriteThread = NULL;
+const t_CKUINT XThreadPool::DEFAULT_NUM_THREADS = 4;
+XThreadPool * XThreadPool::o_defaultPool = NULL;
+#ifndef __PLATFORM_WIN32__
+XReactor * XReactor::o_defaultReactor = NULL;
+#endif
 
 
 
@@ -210,6 +228,100 @@ void XMutex::release( )
 
 
 
+//-----------------------------------------------------------------------------
+// name: XSemaphore()
+// desc: ...
+//-----------------------------------------------------------------------------
+XSemaphore::XSemaphore( )
+{
+#if ( defined(__PLATFORM_MACOSX__) || defined(__PLATFORM_LINUX__) || defined(__WINDOWS_PTHREAD__) )
+    pthread_mutex_init( &mutex, NULL );
+    pthread_cond_init( &cond, NULL );
+    count = 0;
+#elif defined(__PLATFORM_WIN32__)
+    sem = CreateSemaphore( NULL, 0, LONG_MAX, NULL );
+#endif
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: ~XSemaphore()
+// desc: ...
+//-----------------------------------------------------------------------------
+XSemaphore::~XSemaphore( )
+{
+#if ( defined(__PLATFORM_MACOSX__) || defined(__PLATFORM_LINUX__) || defined(__WINDOWS_PTHREAD__) )
+    pthread_cond_destroy( &cond );
+    pthread_mutex_destroy( &mutex );
+#elif defined(__PLATFORM_WIN32__)
+    CloseHandle( sem );
+#endif
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: post()
+// desc: count up, waking one waiter
+//-----------------------------------------------------------------------------
+void XSemaphore::post( )
+{
+#if ( defined(__PLATFORM_MACOSX__) || defined(__PLATFORM_LINUX__) || defined(__WINDOWS_PTHREAD__) )
+    pthread_mutex_lock( &mutex );
+    count++;
+    pthread_cond_signal( &cond );
+    pthread_mutex_unlock( &mutex );
+#elif defined(__PLATFORM_WIN32__)
+    ReleaseSemaphore( sem, 1, NULL );
+#endif
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: wait()
+// desc: wait for a post, or for milliseconds (if >= 0) to go by
+//-----------------------------------------------------------------------------
+bool XSemaphore::wait( long milliseconds )
+{
+#if ( defined(__PLATFORM_MACOSX__) || defined(__PLATFORM_LINUX__) || defined(__WINDOWS_PTHREAD__) )
+    struct timespec until;
+    if( milliseconds >= 0 )
+    {
+        struct timeval now;
+        gettimeofday( &now, NULL );
+        long long ns = (long long)now.tv_usec * 1000 + (long long)milliseconds * 1000000;
+        until.tv_sec = now.tv_sec + (time_t)( ns / 1000000000 );
+        until.tv_nsec = (long)( ns % 1000000000 );
+    }
+
+    bool result = true;
+    pthread_mutex_lock( &mutex );
+    while( count == 0 )
+    {
+        if( milliseconds < 0 ) pthread_cond_wait( &cond, &mutex );
+        else if( pthread_cond_timedwait( &cond, &mutex, &until ) == ETIMEDOUT )
+        {
+            result = count > 0;
+            break;
+        }
+    }
+    if( result ) count--;
+    pthread_mutex_unlock( &mutex );
+    return result;
+#elif defined(__PLATFORM_WIN32__)
+    DWORD timeout = milliseconds < 0 ? INFINITE : (DWORD)milliseconds;
+    return WaitForSingleObject( sem, timeout ) == WAIT_OBJECT_0;
+#endif
+}
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: shared()
 // desc: get XWriteThread shared instance
@@ -445,6 +557,510 @@ unsigned XWriteThread::write_cb(void * _thiss)
 
 
 
+//-----------------------------------------------------------------------------
+// name: shared()
+// desc: get XThreadPool shared instance
+//-----------------------------------------------------------------------------
+XThreadPool * XThreadPool::shared()
+{
+    // check
+    if( o_defaultPool == NULL )
+        o_defaultPool = new XThreadPool();
+
+    return o_defaultPool;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: XThreadPool()
+// desc: constructor
+//-----------------------------------------------------------------------------
+XThreadPool::XThreadPool( t_CKUINT num_threads )
+{
+    m_thread_exit = FALSE;
+    for( t_CKUINT i = 0; i < num_threads; i++ )
+    {
+        XThread * t = new XThread;
+        t->start( work_cb, this );
+        m_threads.push_back( t );
+    }
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: ~XThreadPool()
+// desc: destructor
+//-----------------------------------------------------------------------------
+XThreadPool::~XThreadPool()
+{
+    for( t_CKUINT i = 0; i < m_threads.size(); i++ )
+        SAFE_DELETE( m_threads[i] );
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: submit()
+// desc: queue a job
+//-----------------------------------------------------------------------------
+void XThreadPool::submit( Job job, void * data )
+{
+    Task task;
+    task.job = job;
+    task.data = data;
+
+    m_lock.acquire();
+    m_tasks.push_back( task );
+    m_lock.release();
+    m_work.post();
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: pending()
+// desc: ...
+//-----------------------------------------------------------------------------
+t_CKUINT XThreadPool::pending()
+{
+    m_lock.acquire();
+    t_CKUINT n = m_tasks.size();
+    m_lock.release();
+
+    return n;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: shutdown()
+// desc: finish queued jobs, stop the workers, and delete
+//-----------------------------------------------------------------------------
+void XThreadPool::shutdown()
+{
+    m_thread_exit = TRUE;
+    for( t_CKUINT i = 0; i < m_threads.size(); i++ )
+        m_work.post();
+    for( t_CKUINT i = 0; i < m_threads.size(); i++ )
+    {
+        m_threads[i]->wait( -1, false );
+        m_threads[i]->clear();
+    }
+
+    if( this == o_defaultPool ) o_defaultPool = NULL;
+    delete this;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: work_cb()
+// desc: worker thread function
+//-----------------------------------------------------------------------------
+THREAD_RETURN ( THREAD_TYPE XThreadPool::work_cb )( void * _thiss )
+{
+    XThreadPool * _this = (XThreadPool *)_thiss;
+    Task task;
+
+    while( true )
+    {
+        t_CKBOOL got = FALSE;
+
+        // sleep until there is a task (or shutdown)
+        _this->m_work.wait();
+        _this->m_lock.acquire();
+        if( !_this->m_tasks.empty() )
+        {
+            task = _this->m_tasks.front();
+            _this->m_tasks.pop_front();
+            got = TRUE;
+        }
+        _this->m_lock.release();
+
+        if( got ) task.job( task.data );
+        else if( _this->m_thread_exit ) break;
+    }
+
+    return 0;
+}
+
+
+
+
+#ifndef __PLATFORM_WIN32__
+//-----------------------------------------------------------------------------
+// name: shared()
+// desc: get XReactor shared instance
+//-----------------------------------------------------------------------------
+XReactor * XReactor::shared()
+{
+    // check
+    if( o_defaultReactor == NULL )
+        o_defaultReactor = new XReactor();
+
+    return o_defaultReactor;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: XReactor()
+// desc: constructor
+//-----------------------------------------------------------------------------
+XReactor::XReactor()
+{
+    int filedes[2];
+
+    m_thread_exit = FALSE;
+    m_thread_running = FALSE;
+    m_epoll = -1;
+    m_wake_r = m_wake_w = -1;
+
+    if( pipe( filedes ) )
+    {
+        EM_log( CK_LOG_SEVERE, "XReactor: unable to create pipe: %s", strerror( errno ) );
+        return;
+    }
+    m_wake_r = filedes[0];
+    m_wake_w = filedes[1];
+    fcntl( m_wake_r, F_SETFL, fcntl( m_wake_r, F_GETFL ) | O_NONBLOCK );
+    fcntl( m_wake_w, F_SETFL, fcntl( m_wake_w, F_GETFL ) | O_NONBLOCK );
+
+#ifdef __PLATFORM_LINUX__
+    m_epoll = epoll_create( 16 );
+    if( m_epoll < 0 )
+    {
+        EM_log( CK_LOG_SEVERE, "XReactor: epoll_create failed: %s", strerror( errno ) );
+        return;
+    }
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = m_wake_r;
+    epoll_ctl( m_epoll, EPOLL_CTL_ADD, m_wake_r, &ev );
+#endif
+
+    m_thread.start( loop_cb, this );
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: ~XReactor()
+// desc: destructor
+//-----------------------------------------------------------------------------
+XReactor::~XReactor()
+{
+    if( m_epoll >= 0 ) close( m_epoll );
+    if( m_wake_r >= 0 ) close( m_wake_r );
+    if( m_wake_w >= 0 ) close( m_wake_w );
+}
+
+
+
+
+#ifdef __PLATFORM_LINUX__
+// epoll event bits for XReactor event bits
+static uint32_t XReactor_epoll_events( t_CKUINT events )
+{
+    uint32_t e = 0;
+    if( events & XReactor::READ ) e |= EPOLLIN;
+    if( events & XReactor::WRITE ) e |= EPOLLOUT;
+    return e;
+}
+#endif
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: add()
+// desc: watch fd
+//-----------------------------------------------------------------------------
+t_CKBOOL XReactor::add( int fd, t_CKUINT events, Handler handler, void * data )
+{
+    t_CKBOOL locked = !on_thread();
+    t_CKBOOL ok = TRUE;
+
+    if( fd < 0 ) return FALSE;
+
+    if( locked ) m_lock.acquire();
+    if( m_watches.count( fd ) ) ok = FALSE;
+    else
+    {
+#ifdef __PLATFORM_LINUX__
+        struct epoll_event ev;
+        ev.events = XReactor_epoll_events( events );
+        ev.data.fd = fd;
+        ok = epoll_ctl( m_epoll, EPOLL_CTL_ADD, fd, &ev ) == 0;
+#endif
+        if( ok )
+        {
+            Watch & w = m_watches[fd];
+            w.handler = handler;
+            w.data = data;
+            w.events = events;
+        }
+    }
+    if( locked ) m_lock.release();
+
+    if( !ok ) EM_log( CK_LOG_WARNING, "XReactor: unable to watch fd %d", fd );
+#ifndef __PLATFORM_LINUX__
+    // poll() picks up the new set on its next pass
+    else if( locked ) wake();
+#endif
+
+    return ok;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: modify()
+// desc: change what fd is watched for
+//-----------------------------------------------------------------------------
+t_CKBOOL XReactor::modify( int fd, t_CKUINT events )
+{
+    t_CKBOOL locked = !on_thread();
+    t_CKBOOL ok = FALSE;
+
+    if( locked ) m_lock.acquire();
+    std::map<int, Watch>::iterator it = m_watches.find( fd );
+    if( it != m_watches.end() )
+    {
+        ok = TRUE;
+        if( it->second.events != events )
+        {
+#ifdef __PLATFORM_LINUX__
+            struct epoll_event ev;
+            ev.events = XReactor_epoll_events( events );
+            ev.data.fd = fd;
+            ok = epoll_ctl( m_epoll, EPOLL_CTL_MOD, fd, &ev ) == 0;
+#endif
+            it->second.events = events;
+        }
+    }
+    if( locked ) m_lock.release();
+
+#ifndef __PLATFORM_LINUX__
+    if( ok && locked ) wake();
+#endif
+
+    return ok;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: remove()
+// desc: stop watching fd
+//-----------------------------------------------------------------------------
+t_CKBOOL XReactor::remove( int fd )
+{
+    t_CKBOOL locked = !on_thread();
+    t_CKBOOL found = FALSE;
+
+    // handlers run with the lock held, so once we have it none is running
+    if( locked ) m_lock.acquire();
+    if( m_watches.erase( fd ) )
+    {
+        found = TRUE;
+#ifdef __PLATFORM_LINUX__
+        epoll_ctl( m_epoll, EPOLL_CTL_DEL, fd, NULL );
+#endif
+    }
+    if( locked ) m_lock.release();
+
+#ifndef __PLATFORM_LINUX__
+    if( found && locked ) wake();
+#endif
+
+    return found;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: notify()
+// desc: call fd's handler with NOTIFY on the reactor thread
+//-----------------------------------------------------------------------------
+void XReactor::notify( int fd )
+{
+    t_CKBOOL locked = !on_thread();
+
+    if( locked ) m_lock.acquire();
+    m_notified.push_back( fd );
+    if( locked ) m_lock.release();
+
+    if( locked ) wake();
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: shutdown()
+// desc: stop the thread and delete
+//-----------------------------------------------------------------------------
+void XReactor::shutdown()
+{
+    m_thread_exit = TRUE;
+    wake();
+    m_thread.wait( -1, false );
+    m_thread.clear();
+
+    if( this == o_defaultReactor ) o_defaultReactor = NULL;
+    delete this;
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: wake()
+// desc: ...
+//-----------------------------------------------------------------------------
+void XReactor::wake()
+{
+    char c = 0;
+    // full pipe is fine: the thread is waking anyway
+    if( write( m_wake_w, &c, 1 ) < 0 ) { }
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: on_thread()
+// desc: ...
+//-----------------------------------------------------------------------------
+t_CKBOOL XReactor::on_thread()
+{
+    return m_thread_running && pthread_equal( pthread_self(), m_thread_id );
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: dispatch()
+// desc: call the handler for fd, if still watched
+//-----------------------------------------------------------------------------
+void XReactor::dispatch( int fd, t_CKUINT events )
+{
+    std::map<int, Watch>::iterator it = m_watches.find( fd );
+    if( it == m_watches.end() ) return;
+    it->second.handler( fd, events, it->second.data );
+}
+
+
+
+
+//-----------------------------------------------------------------------------
+// name: loop_cb()
+// desc: reactor thread function
+//-----------------------------------------------------------------------------
+THREAD_RETURN ( THREAD_TYPE XReactor::loop_cb )( void * _thiss )
+{
+    XReactor * _this = (XReactor *)_thiss;
+    std::vector<int> notified;
+    char drain[64];
+
+    _this->m_thread_id = pthread_self();
+    _this->m_thread_running = TRUE;
+
+#ifdef __PLATFORM_LINUX__
+    const int MAX_EVENTS = 64;
+    struct epoll_event events[MAX_EVENTS];
+
+    while( !_this->m_thread_exit )
+    {
+        int n = epoll_wait( _this->m_epoll, events, MAX_EVENTS, -1 );
+        if( n < 0 && errno != EINTR ) break;
+
+        _this->m_lock.acquire();
+        for( int i = 0; i < n; i++ )
+        {
+            int fd = events[i].data.fd;
+            if( fd == _this->m_wake_r )
+            {
+                while( read( fd, drain, sizeof(drain) ) > 0 ) { }
+                continue;
+            }
+
+            t_CKUINT e = 0;
+            // errors and hangups are reported as readable; read() says which
+            if( events[i].events & ( EPOLLIN | EPOLLERR | EPOLLHUP ) ) e |= READ;
+            if( events[i].events & EPOLLOUT ) e |= WRITE;
+            _this->dispatch( fd, e );
+        }
+#else
+    std::vector<struct pollfd> pollfds;
+
+    while( !_this->m_thread_exit )
+    {
+        // the wake pipe, then everything watched
+        _this->m_lock.acquire();
+        pollfds.resize( 1 );
+        pollfds[0].fd = _this->m_wake_r;
+        pollfds[0].events = POLLIN;
+        for( std::map<int, Watch>::iterator it = _this->m_watches.begin();
+             it != _this->m_watches.end(); it++ )
+        {
+            struct pollfd p;
+            p.fd = it->first;
+            p.events = ( it->second.events & READ ? POLLIN : 0 ) |
+                       ( it->second.events & WRITE ? POLLOUT : 0 );
+            pollfds.push_back( p );
+        }
+        _this->m_lock.release();
+
+        for( size_t i = 0; i < pollfds.size(); i++ ) pollfds[i].revents = 0;
+        int n = poll( &pollfds[0], pollfds.size(), -1 );
+        if( n < 0 && errno != EINTR ) break;
+
+        _this->m_lock.acquire();
+        if( pollfds[0].revents & POLLIN )
+            while( read( _this->m_wake_r, drain, sizeof(drain) ) > 0 ) { }
+        for( size_t i = 1; n > 0 && i < pollfds.size(); i++ )
+        {
+            t_CKUINT e = 0;
+            if( pollfds[i].revents & ( POLLIN | POLLERR | POLLHUP ) ) e |= READ;
+            if( pollfds[i].revents & POLLOUT ) e |= WRITE;
+            if( e ) _this->dispatch( pollfds[i].fd, e );
+        }
+#endif
+
+        // queued notifications (handlers may queue more)
+        while( !_this->m_notified.empty() )
+        {
+            notified.swap( _this->m_notified );
+            for( size_t i = 0; i < notified.size(); i++ )
+                _this->dispatch( notified[i], NOTIFY );
+            notified.clear();
+        }
+        _this->m_lock.release();
+    }
+
+    return 0;
+}
+#endif
+
+
+
+
 #ifdef __MACOSX_CORE__
 t_CKINT XThreadUtil::our_priority = 85;
 #else
@@ -36,6 +36,9 @@
 
 #include "chuck_def.h"
 #include <stdio.h>
+#include <deque>
+#include <vector>
+#include <map>
 
 
 // forward declaration to break circular dependencies
@@ -138,6 +141,37 @@ protected:
 
 
 
+//-----------------------------------------------------------------------------
+// name: struct XSemaphore
+// desc: counting semaphore; post() never blocks for long, so it is safe to
+//       call from the audio thread
+//-----------------------------------------------------------------------------
+struct XSemaphore
+{
+public:
+    XSemaphore();
+    ~XSemaphore();
+
+public:
+    // count up, waking one waiter
+    void post();
+    // wait for the count to be positive, then count down; returns false if
+    // milliseconds (if >= 0) went by first
+    bool wait( long milliseconds = -1 );
+
+protected:
+#if ( defined(__PLATFORM_MACOSX__) || defined(__PLATFORM_LINUX__) || defined(__WINDOWS_PTHREAD__) )
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+    long count;
+#elif defined(__PLATFORM_WIN32__)
+    HANDLE sem;
+#endif
+};
+
+
+
+
 //-----------------------------------------------------------------------------
 // name: XWriteThread()
 // desc: utility class for scheduling writes to be executed on a separate
@@ -230,4 +264,137 @@ private:
 
 
 
+
+//-----------------------------------------------------------------------------
+// name: XThreadPool
+// desc: fixed set of worker threads running queued jobs, in submission order
+//-----------------------------------------------------------------------------
+class XThreadPool
+{
+public:
+    // job routine; runs on a worker thread
+    typedef void (*Job)( void * data );
+
+    // get the shared instance
+    static XThreadPool * shared();
+    // default number of workers
+    const static t_CKUINT DEFAULT_NUM_THREADS;
+
+public:
+    // constructor
+    XThreadPool( t_CKUINT num_threads = DEFAULT_NUM_THREADS );
+
+public:
+    // queue a job for the next free worker
+    void submit( Job job, void * data );
+    // number of jobs not yet picked up
+    t_CKUINT pending();
+
+    // DO NOT DELETE INSTANCES OF XThreadPool
+    // instead call shutdown; queued jobs are finished first
+    void shutdown();
+
+private:
+    ~XThreadPool();
+
+    // worker
+    static THREAD_RETURN ( THREAD_TYPE work_cb )( void * _thiss );
+
+    // shared instance
+    static XThreadPool * o_defaultPool;
+
+private:
+    struct Task
+    {
+        Job job;
+        void * data;
+    };
+
+    std::deque<Task> m_tasks;
+    XMutex m_lock;
+    // one post per task, and one per worker at shutdown
+    XSemaphore m_work;
+    std::vector<XThread *> m_threads;
+    volatile t_CKBOOL m_thread_exit;
+};
+
+
+
+
+#ifndef __PLATFORM_WIN32__
+//-----------------------------------------------------------------------------
+// name: XReactor
+// desc: one thread waiting on any number of file descriptors (epoll on
+//       linux, poll elsewhere), calling each one's handler when it is ready
+//-----------------------------------------------------------------------------
+class XReactor
+{
+public:
+    // what to wait for / what happened
+    enum { READ = 0x1, WRITE = 0x2, NOTIFY = 0x4 };
+    // handler; runs on the reactor thread, and may add/modify/remove
+    typedef void (*Handler)( int fd, t_CKUINT events, void * data );
+
+    // get the shared instance
+    static XReactor * shared();
+
+public:
+    // constructor
+    XReactor();
+
+public:
+    // watch fd for events (READ and/or WRITE)
+    t_CKBOOL add( int fd, t_CKUINT events, Handler handler, void * data );
+    // change what fd is watched for
+    t_CKBOOL modify( int fd, t_CKUINT events );
+    // stop watching fd; once this returns its handler will not run again
+    t_CKBOOL remove( int fd );
+    // call fd's handler with NOTIFY, soon, on the reactor thread
+    void notify( int fd );
+
+    // DO NOT DELETE INSTANCES OF XReactor
+    // instead call shutdown
+    void shutdown();
+
+private:
+    ~XReactor();
+
+    // thread
+    static THREAD_RETURN ( THREAD_TYPE loop_cb )( void * _thiss );
+    // wake the thread from its wait
+    void wake();
+    // on the reactor thread?
+    t_CKBOOL on_thread();
+    // call a handler (lock held)
+    void dispatch( int fd, t_CKUINT events );
+
+    // shared instance
+    static XReactor * o_defaultReactor;
+
+private:
+    struct Watch
+    {
+        Handler handler;
+        void * data;
+        t_CKUINT events;
+    };
+
+    std::map<int, Watch> m_watches;
+    std::vector<int> m_notified;
+    XMutex m_lock;
+    XThread m_thread;
+    pthread_t m_thread_id;
+    volatile t_CKBOOL m_thread_running;
+    // epoll instance (linux), -1 elsewhere
+    int m_epoll;
+    // self-pipe to wake the wait
+    int m_wake_r;
+    int m_wake_w;
+    volatile t_CKBOOL m_thread_exit;
+};
+#endif
+
+
+
+
 #endif